@@ -26,6 +26,8 @@ UserProfile::UserProfile()
     button_misc = Gamepad::BUTTON_MISC;
 
     analog_enabled = 0;
+    reserved = 0;
+    host_poll_ms = 0;
 
     analog_off_up = Gamepad::ANALOG_OFF_UP;
     analog_off_down = Gamepad::ANALOG_OFF_DOWN;
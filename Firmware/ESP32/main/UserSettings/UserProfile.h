@@ -34,7 +34,9 @@ struct UserProfile
     uint16_t button_sys;
     uint16_t button_misc;
 
-    uint8_t analog_enabled;
+    uint8_t analog_enabled : 1;
+    uint8_t reserved : 3;
+    uint8_t host_poll_ms : 4; //USB host IN endpoint interval override in ms, 0 keeps the device's bInterval
 
     uint8_t analog_off_up;
     uint8_t analog_off_down;
@@ -154,17 +154,19 @@ public:
 
     bool commit_profile() {
         bool success = false;
+        //Too large to capture in a task, the profile is stored from here
+        pending_profile_ = profile_;
         if (setup_packet_.device_type != DeviceDriverType::NONE) {
             success = TaskQueue::Core0::queue_delayed_task(TaskQueue::Core0::get_new_task_id(), 1000, false,
-                [driver_type = setup_packet_.device_type, profile = profile_, index = setup_packet_.player_idx]
+                [this, driver_type = setup_packet_.device_type, index = setup_packet_.player_idx]
                 {
-                    UserSettings::get_instance().store_profile_and_driver_type(driver_type, index, profile);
+                    UserSettings::get_instance().store_profile_and_driver_type(driver_type, index, pending_profile_);
                 });
         } else {
             success = TaskQueue::Core0::queue_delayed_task(TaskQueue::Core0::get_new_task_id(), 1000, false,
-                [index = setup_packet_.player_idx, profile = profile_]
+                [this, index = setup_packet_.player_idx]
                 {
-                    UserSettings::get_instance().store_profile(index, profile);
+                    UserSettings::get_instance().store_profile(index, pending_profile_);
                 });
         }
         return success;
@@ -173,6 +175,7 @@ public:
 private:
     SetupPacket setup_packet_;
     UserProfile profile_;
+    UserProfile pending_profile_;
     size_t current_offset_ = 0;
 };
 
@@ -246,7 +249,7 @@ static uint16_t att_read_callback(  hci_con_handle_t connection_handle,
 
         case Handle::GAMEPAD:
             if (buffer) {
-                pad_in = gamepads_.front()->get_pad_in();
+                pad_in = gamepads_.front()->peek_pad_in();
                 std::memcpy(buffer, &pad_in, sizeof(Gamepad::PadIn));
             }
             return static_cast<uint16_t>(sizeof(Gamepad::PadIn));
@@ -20,12 +20,15 @@ static_assert((CONFIG_BLUEPAD32_MAX_DEVICES == MAX_GAMEPADS), "Mismatch between
 
 namespace bluepad32 {
 
-static constexpr uint32_t FEEDBACK_TIME_MS = 250;
+static constexpr uint32_t FEEDBACK_TIME_MS = 250;   //Rumble duration, resent this often while it's on
+static constexpr uint32_t FEEDBACK_CHECK_MS = 8;    //New rumble goes out this fast, also caps the output rate
 static constexpr uint32_t LED_CHECK_TIME_MS = 500;
 
 struct BTDevice {
     bool connected{false};
     Gamepad* gamepad{nullptr};
+    uint32_t rumble_sent_ms{0};
+    bool rumble_on{false};
 };
 
 BTDevice bt_devices_[MAX_GAMEPADS];
@@ -88,23 +91,37 @@ void set_rumble(uni_hid_device_t* bp_device, uint16_t length, uint8_t rumble_l,
 static void send_feedback_cb(btstack_timer_source *ts)
 {
     uni_hid_device_t* bp_device = nullptr;
+    const uint32_t now_ms = board_api::ms_since_boot();
 
     for (uint8_t i = 0; i < MAX_GAMEPADS; ++i)
     {
-        if (!bt_devices_[i].connected || 
+        BTDevice& device = bt_devices_[i];
+        if (!device.connected || 
             !(bp_device = uni_hid_device_get_instance_for_idx(i)))
         {
             continue;
         }
 
-        Gamepad::PadOut gp_out = bt_devices_[i].gamepad->get_pad_out();
-        if (gp_out.rumble_l > 0 || gp_out.rumble_r > 0)
+        //Only new values and the keep alive for running rumble go out
+        const bool keep_alive = device.rumble_on && (now_ms - device.rumble_sent_ms >= FEEDBACK_TIME_MS);
+        if (!device.gamepad->new_pad_out() && !keep_alive)
         {
-            set_rumble(bp_device, static_cast<uint16_t>(FEEDBACK_TIME_MS), gp_out.rumble_l, gp_out.rumble_r);
+            continue;
+        }
+
+        Gamepad::PadOut gp_out = device.gamepad->get_pad_out();
+        const bool rumble_on = (gp_out.rumble_l > 0 || gp_out.rumble_r > 0);
+
+        //Stop running rumble now instead of letting its duration run out
+        if (rumble_on || device.rumble_on)
+        {
+            set_rumble(bp_device, static_cast<uint16_t>(rumble_on ? FEEDBACK_TIME_MS : 0), gp_out.rumble_l, gp_out.rumble_r);
+            device.rumble_sent_ms = now_ms;
         }
+        device.rumble_on = rumble_on;
     }
 
-    btstack_run_loop_set_timer(ts, FEEDBACK_TIME_MS);
+    btstack_run_loop_set_timer(ts, FEEDBACK_CHECK_MS);
     btstack_run_loop_add_timer(ts);
 }
 
@@ -148,6 +165,7 @@ static void device_disconnected_cb(uni_hid_device_t* device) {
     }
 
     bt_devices_[idx].connected = false;
+    bt_devices_[idx].rumble_on = false;
     bt_devices_[idx].gamepad->reset_pad_in();
 
     if (!led_timer_set_ && !any_connected()) {
@@ -180,7 +198,7 @@ static uni_error_t device_ready_cb(uni_hid_device_t* device) {
         feedback_timer_set_ = true;
         feedback_timer_.process = send_feedback_cb;
         feedback_timer_.context = nullptr;
-        btstack_run_loop_set_timer(&feedback_timer_, FEEDBACK_TIME_MS);
+        btstack_run_loop_set_timer(&feedback_timer_, FEEDBACK_CHECK_MS);
         btstack_run_loop_add_timer(&feedback_timer_);
     }
     return UNI_ERROR_SUCCESS;
@@ -206,44 +224,44 @@ static void controller_data_cb(uni_hid_device_t* device, uni_controller_t* contr
     switch (uni_gp->dpad) 
     {
         case DPAD_UP:
-            gp_in.dpad = gamepad->MAP_DPAD_UP;
+            gp_in.dpad = Gamepad::DPAD_UP;
             break;
         case DPAD_DOWN:
-            gp_in.dpad = gamepad->MAP_DPAD_DOWN;
+            gp_in.dpad = Gamepad::DPAD_DOWN;
             break;
         case DPAD_LEFT:
-            gp_in.dpad = gamepad->MAP_DPAD_LEFT;
+            gp_in.dpad = Gamepad::DPAD_LEFT;
             break;
         case DPAD_RIGHT:
-            gp_in.dpad = gamepad->MAP_DPAD_RIGHT;
+            gp_in.dpad = Gamepad::DPAD_RIGHT;
             break;
         case DPAD_UP | DPAD_RIGHT:
-            gp_in.dpad = gamepad->MAP_DPAD_UP_RIGHT;
+            gp_in.dpad = Gamepad::DPAD_UP_RIGHT;
             break;
         case DPAD_DOWN | DPAD_RIGHT:
-            gp_in.dpad = gamepad->MAP_DPAD_DOWN_RIGHT;
+            gp_in.dpad = Gamepad::DPAD_DOWN_RIGHT;
             break;
         case DPAD_DOWN | DPAD_LEFT:
-            gp_in.dpad = gamepad->MAP_DPAD_DOWN_LEFT;
+            gp_in.dpad = Gamepad::DPAD_DOWN_LEFT;
             break;
         case DPAD_UP | DPAD_LEFT:
-            gp_in.dpad = gamepad->MAP_DPAD_UP_LEFT;
+            gp_in.dpad = Gamepad::DPAD_UP_LEFT;
             break;
         default:
             break;
     }
 
-    if (uni_gp->buttons & BUTTON_A) gp_in.buttons |= gamepad->MAP_BUTTON_A;
-    if (uni_gp->buttons & BUTTON_B) gp_in.buttons |= gamepad->MAP_BUTTON_B;
-    if (uni_gp->buttons & BUTTON_X) gp_in.buttons |= gamepad->MAP_BUTTON_X;
-    if (uni_gp->buttons & BUTTON_Y) gp_in.buttons |= gamepad->MAP_BUTTON_Y;
-    if (uni_gp->buttons & BUTTON_SHOULDER_L) gp_in.buttons |= gamepad->MAP_BUTTON_LB;
-    if (uni_gp->buttons & BUTTON_SHOULDER_R) gp_in.buttons |= gamepad->MAP_BUTTON_RB;
-    if (uni_gp->buttons & BUTTON_THUMB_L)    gp_in.buttons |= gamepad->MAP_BUTTON_L3;  
-    if (uni_gp->buttons & BUTTON_THUMB_R)    gp_in.buttons |= gamepad->MAP_BUTTON_R3;
-    if (uni_gp->misc_buttons & MISC_BUTTON_BACK)    gp_in.buttons |= gamepad->MAP_BUTTON_BACK;
-    if (uni_gp->misc_buttons & MISC_BUTTON_START)   gp_in.buttons |= gamepad->MAP_BUTTON_START;
-    if (uni_gp->misc_buttons & MISC_BUTTON_SYSTEM)  gp_in.buttons |= gamepad->MAP_BUTTON_SYS;
+    if (uni_gp->buttons & BUTTON_A) gp_in.buttons |= Gamepad::BUTTON_A;
+    if (uni_gp->buttons & BUTTON_B) gp_in.buttons |= Gamepad::BUTTON_B;
+    if (uni_gp->buttons & BUTTON_X) gp_in.buttons |= Gamepad::BUTTON_X;
+    if (uni_gp->buttons & BUTTON_Y) gp_in.buttons |= Gamepad::BUTTON_Y;
+    if (uni_gp->buttons & BUTTON_SHOULDER_L) gp_in.buttons |= Gamepad::BUTTON_LB;
+    if (uni_gp->buttons & BUTTON_SHOULDER_R) gp_in.buttons |= Gamepad::BUTTON_RB;
+    if (uni_gp->buttons & BUTTON_THUMB_L)    gp_in.buttons |= Gamepad::BUTTON_L3;  
+    if (uni_gp->buttons & BUTTON_THUMB_R)    gp_in.buttons |= Gamepad::BUTTON_R3;
+    if (uni_gp->misc_buttons & MISC_BUTTON_BACK)    gp_in.buttons |= Gamepad::BUTTON_BACK;
+    if (uni_gp->misc_buttons & MISC_BUTTON_START)   gp_in.buttons |= Gamepad::BUTTON_START;
+    if (uni_gp->misc_buttons & MISC_BUTTON_SYSTEM)  gp_in.buttons |= Gamepad::BUTTON_SYS;
 
     gp_in.trigger_l = gamepad->scale_trigger_l<10>(static_cast<uint16_t>(uni_gp->brake));
     gp_in.trigger_r = gamepad->scale_trigger_r<10>(static_cast<uint16_t>(uni_gp->throttle));
@@ -251,7 +269,12 @@ static void controller_data_cb(uni_hid_device_t* device, uni_controller_t* contr
     std::tie(gp_in.joystick_lx, gp_in.joystick_ly) = gamepad->scale_joystick_l<10>(uni_gp->axis_x, uni_gp->axis_y);
     std::tie(gp_in.joystick_rx, gp_in.joystick_ry) = gamepad->scale_joystick_r<10>(uni_gp->axis_rx, uni_gp->axis_ry);
 
+    gp_in.dpad = gamepad->map_dpad(gp_in.dpad);
+    gp_in.buttons = gamepad->map_buttons(gp_in.buttons);
+
+    gamepad->set_pad_in_time(board_api::us_since_boot());
     gamepad->set_pad_in(gp_in);
+    board_api::core0::notify();
 }
 
 const uni_property_t* get_property_cb(uni_property_idx_t idx) 
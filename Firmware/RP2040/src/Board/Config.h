@@ -123,7 +123,21 @@
                          (I2C_SDA_PIN == 26)) ? i2c1 : i2c0
 #endif // defined(I2C_SDA_PIN)
 
+// XInput interfaces on the device port, 4 channel boards chain the other pads to one Pico each
+#if defined(CONFIG_EN_4CH)
+    #define XINPUT_MAX_GAMEPADS 1
+#else
+    #define XINPUT_MAX_GAMEPADS MAX_GAMEPADS
+#endif
+
 #if defined(PIO_USB_DP_PIN)
+    // With EN_SOF_ALIGN FrameSync runs the host frames instead of Pico-PIO-USB's own timer
+    #if defined(CONFIG_EN_SOF_ALIGN)
+        #define PIO_USB_SKIP_ALARM_POOL true
+    #else
+        #define PIO_USB_SKIP_ALARM_POOL false
+    #endif
+
     #define PIO_USB_CONFIG { \
         PIO_USB_DP_PIN, \
         PIO_USB_TX_DEFAULT, \
@@ -135,7 +149,7 @@
         NULL, \
         PIO_USB_DEBUG_PIN_NONE, \
         PIO_USB_DEBUG_PIN_NONE, \
-        false, \
+        PIO_USB_SKIP_ALARM_POOL, \
         PIO_USB_PINOUT_DPDM \
     }
 #endif // defined(PIO_USB_DP_PIN)
@@ -1,3 +1,6 @@
+#include <array>
+#include <atomic>
+#include <algorithm>
 #include <pico/stdlib.h>
 #include <pico/mutex.h>
 #include <pico/multicore.h>
@@ -22,6 +25,13 @@ bool usb::host_connected() {
     return false;
 }
 
+uint32_t usb::host_attach_us() {
+    if (board_api_usbh::host_attach_us) {
+        return board_api_usbh::host_attach_us();
+    }
+    return 0;
+}
+
 //Only call this from core0
 void usb::disconnect_all() {
     OGXM_LOG("Disconnecting USB and resetting Core1\n");
@@ -65,6 +75,61 @@ uint32_t ms_since_boot() {
     return to_ms_since_boot(get_absolute_time());
 }
 
+uint32_t us_since_boot() {
+    return time_us_32();
+}
+
+void core0::notify() {
+#if defined(CONFIG_EN_EVENT_LOOP)
+    __sev();
+#endif
+}
+
+void core0::wait(uint32_t timeout_us) {
+#if defined(CONFIG_EN_EVENT_LOOP)
+    //Returns early on SEV from either core or any IRQ taken on core0 (USB device, TaskQueue alarm)
+    best_effort_wfe_or_timeout(make_timeout_time_us(timeout_us));
+#else
+    sleep_us(timeout_us);
+#endif
+}
+
+namespace core1 {
+    static std::atomic<bool> notified_{false};
+
+    void notify() {
+        notified_.store(true, std::memory_order_release);
+    }
+
+    bool notified() {
+        //Plain load first, the host loop checks this every pass
+        return notified_.load(std::memory_order_relaxed) && notified_.exchange(false, std::memory_order_acquire);
+    }
+} // namespace core1
+
+namespace latency {
+    //Upper bound of each bucket in us, the last bucket catches everything above
+    static constexpr std::array<uint32_t, 7> BUCKET_US = { 50, 100, 250, 500, 1000, 2000, 4000 };
+    static std::array<unsigned int, BUCKET_US.size() + 1> buckets_{0};
+    static unsigned int max_us_{0};
+
+    //Core0 only
+    void record(uint32_t pad_in_us) {
+        const uint32_t elapsed = time_us_32() - pad_in_us;
+        size_t i = 0;
+        while (i < BUCKET_US.size() && elapsed > BUCKET_US[i]) {
+            ++i;
+        }
+        ++buckets_[i];
+        max_us_ = std::max(max_us_, static_cast<unsigned int>(elapsed));
+    }
+
+    void log_stats() {
+        OGXM_LOG("Pad in to report latency (us) <=50: %u, <=100: %u, <=250: %u, <=500: %u, <=1000: %u, <=2000: %u, <=4000: %u, >4000: %u, max: %u\n",
+            buckets_[0], buckets_[1], buckets_[2], buckets_[3], buckets_[4], buckets_[5], buckets_[6], buckets_[7], max_us_);
+    }
+} // namespace latency
+
 //Call after board is initialized
 void init_bluetooth() {
     if (board_api_bt::init) {
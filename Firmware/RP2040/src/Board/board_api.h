@@ -10,11 +10,35 @@ namespace board_api {
     void reboot();
     void set_led(bool state);
     uint32_t ms_since_boot();
+    //Wraps after ~71 minutes, only use for short intervals
+    uint32_t us_since_boot();
 
     namespace usb {
         bool host_connected();
+        //us_since_boot() when a device was first seen on a host port, 0 if never
+        uint32_t host_attach_us();
         void disconnect_all();
     }
+
+    namespace core0 {
+        //Doorbell for the core0 loop, safe to call from either core or an IRQ
+        void notify();
+        //Sleep until notify(), an IRQ or timeout_us, whichever comes first
+        void wait(uint32_t timeout_us = 1000);
+    }
+
+    namespace core1 {
+        //Doorbell for the core1 host loop, safe to call from either core or an IRQ
+        void notify();
+        //True once for any number of notify() calls since the last check, core1 only
+        bool notified();
+    }
+
+    namespace latency {
+        //Record time from a pad_in timestamp (us_since_boot) to the device report being queued
+        void record(uint32_t pad_in_us);
+        void log_stats();
+    }
 }
 
 #endif // _OGXM_BOARD_API_H_
\ No newline at end of file
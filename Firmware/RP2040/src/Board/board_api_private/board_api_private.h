@@ -24,6 +24,7 @@ namespace board_api_rgb {
 namespace board_api_usbh {
     void init() __attribute__((weak));
     bool host_connected() __attribute__((weak));
+    uint32_t host_attach_us() __attribute__((weak));
 }
 
 #endif // BOARD_API_PRIVATE_H
\ No newline at end of file
@@ -4,11 +4,13 @@
 #include <atomic>
 #include <hardware/gpio.h>
 
+#include "Board/board_api.h"
 #include "Board/board_api_private/board_api_private.h"
 
 namespace board_api_usbh {
 
 std::atomic<bool> host_connected_ = false;
+std::atomic<uint32_t> host_attach_us_ = 0;
 
 void host_pin_isr(uint gpio, uint32_t events) {
     gpio_set_irq_enabled(PIO_USB_DP_PIN, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, false);
@@ -19,6 +21,7 @@ void host_pin_isr(uint gpio, uint32_t events) {
         uint32_t dm_state = gpio_get(PIO_USB_DP_PIN + 1);
 
         if (dp_state || dm_state) {
+            host_attach_us_.store(board_api::us_since_boot());
             host_connected_.store(true);
         } else {
             host_connected_.store(false);
@@ -32,6 +35,10 @@ bool host_connected() {
     return host_connected_.load();
 }
 
+uint32_t host_attach_us() {
+    return host_attach_us_.load();
+}
+
 void init() {
 #if defined(VCC_EN_PIN)
     gpio_init(VCC_EN_PIN);
@@ -48,6 +55,7 @@ void init() {
     gpio_pull_down(PIO_USB_DP_PIN + 1);
 
     if (gpio_get(PIO_USB_DP_PIN) || gpio_get(PIO_USB_DP_PIN + 1)) {
+        host_attach_us_.store(board_api::us_since_boot());
         host_connected_.store(true);
     } else {
         gpio_set_irq_enabled_with_callback(PIO_USB_DP_PIN, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true, &host_pin_isr);
@@ -4,6 +4,8 @@
 #include <cstdint>
 #include <cstring>
 
+#include "Board/Config.h"
+
 namespace XInput
 {
 	static constexpr size_t ENDPOINT_IN_SIZE = 20;
@@ -188,9 +190,16 @@ namespace XInput
 		0x12,       // bLength
 		0x01,       // bDescriptorType (Device)
 		0x00, 0x02, // bcdUSB 2.00
+#if XINPUT_MAX_GAMEPADS > 1
+		//Composite, so the host binds a driver to each XInput interface
+		0x00,	      // bDeviceClass
+		0x00,	      // bDeviceSubClass
+		0x00,	      // bDeviceProtocol
+#else
 		0xFF,	      // bDeviceClass
 		0xFF,	      // bDeviceSubClass
 		0xFF,	      // bDeviceProtocol
+#endif
 		0x40,	      // bMaxPacketSize0 64
 		0x5E, 0x04, // idVendor 0x045E
 		0x8E, 0x02, // idProduct 0x028E
@@ -201,55 +210,45 @@ namespace XInput
 		0x01,       // bNumConfigurations 1
 	};
 
+	//One wired controller interface, endpoints _ep_in/_ep_out, 39 bytes
+	#define XINPUT_INTERFACE_DESCRIPTOR(_itf_num, _ep_in, _ep_out) \
+		/* Interface: number, alt 0, 2 endpoints, class 0xFF, subclass 0x5D, protocol 0x01 */ \
+		0x09, 0x04, _itf_num, 0x00, 0x02, 0xFF, 0x5D, 0x01, 0x00, \
+		/* Unknown 0x21: bcdHID 1.00, IN endpoint, report size 20, OUT endpoint */ \
+		0x10, 0x21, 0x00, 0x01, 0x01, 0x24, _ep_in, 0x14, 0x03, 0x00, 0x03, 0x13, _ep_out, 0x00, 0x03, 0x00, \
+		/* Endpoint IN: interrupt, 32 bytes, bInterval 1 */ \
+		0x07, 0x05, _ep_in, 0x03, 0x20, 0x00, 0x01, \
+		/* Endpoint OUT: interrupt, 32 bytes, bInterval 8 */ \
+		0x07, 0x05, _ep_out, 0x03, 0x20, 0x00, 0x08
+
+	static constexpr uint16_t INTERFACE_DESC_LEN = 39;
+	static constexpr uint16_t CONFIG_DESC_LEN = 9 + (INTERFACE_DESC_LEN * XINPUT_MAX_GAMEPADS);
+
+	//Gamepad idx is interface idx, each with its own endpoint pair (0x81 + idx, 0x01 + idx)
 	static const uint8_t DESC_CONFIGURATION[] =
 	{
 		0x09,        // bLength
 		0x02,        // bDescriptorType (Configuration)
-		0x30, 0x00,  // wTotalLength 48
-		0x01,        // bNumInterfaces 1
+		static_cast<uint8_t>(CONFIG_DESC_LEN & 0xFF),
+		static_cast<uint8_t>(CONFIG_DESC_LEN >> 8), // wTotalLength 9 + 39 per gamepad
+		XINPUT_MAX_GAMEPADS, // bNumInterfaces, one per gamepad
 		0x01,        // bConfigurationValue
 		0x00,        // iConfiguration (String Index)
 		0x80,        // bmAttributes
 		0xFA,        // bMaxPower 500mA
 
-		0x09,        // bLength
-		0x04,        // bDescriptorType (Interface)
-		0x00,        // bInterfaceNumber 0
-		0x00,        // bAlternateSetting
-		0x02,        // bNumEndpoints 2
-		0xFF,        // bInterfaceClass
-		0x5D,        // bInterfaceSubClass
-		0x01,        // bInterfaceProtocol
-		0x00,        // iInterface (String Index)
-
-		0x10,        // bLength
-		0x21,        // bDescriptorType (HID)
-		// 0x10, 0x01,  // bcdHID 1.10
-		0x00, 0x01,  // bcdHID 1.00
-		0x01,        // bCountryCode
-		0x24,        // bNumDescriptors
-		0x81,        // bDescriptorType[0] (Unknown 0x81)
-		0x14, 0x03,  // wDescriptorLength[0] 788
-		0x00,        // bDescriptorType[1] (Unknown 0x00)
-		0x03, 0x13,  // wDescriptorLength[1] 4867
-		0x01,        // bDescriptorType[2] (Unknown 0x02)
-		0x00, 0x03,  // wDescriptorLength[2] 768
-		0x00,        // bDescriptorType[3] (Unknown 0x00)
-
-		0x07,        // bLength
-		0x05,        // bDescriptorType (Endpoint)
-		0x81,        // bEndpointAddress (IN/D2H)
-		0x03,        // bmAttributes (Interrupt)
-		0x20, 0x00,  // wMaxPacketSize 32
-		0x01,        // bInterval 1 (unit depends on device speed)
-
-		0x07,        // bLength
-		0x05,        // bDescriptorType (Endpoint)
-		0x01,        // bEndpointAddress (OUT/H2D)
-		0x03,        // bmAttributes (Interrupt)
-		0x20, 0x00,  // wMaxPacketSize 32
-		0x08,        // bInterval 8 (unit depends on device speed)
+		XINPUT_INTERFACE_DESCRIPTOR(0x00, 0x81, 0x01),
+#if XINPUT_MAX_GAMEPADS > 1
+		XINPUT_INTERFACE_DESCRIPTOR(0x01, 0x82, 0x02),
+#endif
+#if XINPUT_MAX_GAMEPADS > 2
+		XINPUT_INTERFACE_DESCRIPTOR(0x02, 0x83, 0x03),
+#endif
+#if XINPUT_MAX_GAMEPADS > 3
+		XINPUT_INTERFACE_DESCRIPTOR(0x03, 0x84, 0x04),
+#endif
 	};
+	static_assert(sizeof(DESC_CONFIGURATION) == CONFIG_DESC_LEN, "XInput::DESC_CONFIGURATION length mismatch");
 };
 
 #endif // _XINPUT_DESCRIPTORS_H_
\ No newline at end of file
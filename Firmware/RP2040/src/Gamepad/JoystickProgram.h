@@ -0,0 +1,241 @@
+#ifndef _JOYSTICK_PROGRAM_H_
+#define _JOYSTICK_PROGRAM_H_
+
+#include <cstdint>
+#include <utility>
+
+#include "libfixmath/fix16.hpp"
+
+#include "Gamepad/Range.h"
+#include "Gamepad/fix16ext.h"
+#include "UserSettings/JoystickSettings.h"
+
+// JoystickSettings compiled for the per sample path.
+// Everything that only depends on the settings is folded when the profile is set, what's left
+// is the same sequence of libfixmath calls apply_joystick_settings made, so the output is the same.
+class JoystickProgram
+{
+public:
+    JoystickProgram() = default;
+    ~JoystickProgram() = default;
+
+    void compile(const JoystickSettings& set)
+    {
+        static const Fix16
+            FIX_0(0.0f),
+            FIX_1(1.0f),
+            FIX_2(2.0f),
+            FIX_90(90.0f);
+
+        invert_x_ = set.invert_x;
+        invert_y_ = set.invert_y;
+
+        axis_restrict_ = set.axis_restrict.value;
+        inv_axis_restrict_ = (FIX_1 / (FIX_1 - set.axis_restrict)).value;
+        dz_inner_ = set.dz_inner.value;
+        dz_outer_ = set.dz_outer.value;
+        cap_radius_ = !set.uncap_radius;
+
+        const Fix16 anti_r_scale = (set.anti_dz_square_y_scale == FIX_0) ? set.anti_dz_square : set.anti_dz_square_y_scale;
+        ellipse_ = (anti_r_scale > FIX_0 && set.anti_dz_circle > FIX_0);
+        anti_dz_circle_ = set.anti_dz_circle.value;
+        anti_dz_k_circle_ = (FIX_1 - set.anti_dz_circle / set.dz_outer).value;
+        anti_dz_k_square_ = (FIX_1 - set.anti_dz_square).value;
+        if (ellipse_)
+        {
+            const Fix16 anti_ellip_scale = anti_r_scale / set.anti_dz_circle;
+            ellipse_inv_scale_ = (FIX_1 / anti_ellip_scale).value;
+            ellipse_scale_sq_ = fix16::sq(anti_ellip_scale).value;
+        }
+        else
+        {
+            anti_dz_c_ = anti_dz_scale(anti_dz_circle_);
+        }
+
+        angle_half_ = (set.angle_restrict / FIX_2).value;
+        angle_span_ = ((FIX_90 - Fix16(angle_half_)) - Fix16(angle_half_)).value;
+
+        magnitude_span_ = (set.anti_dz_outer - set.dz_inner).value;
+        exponent_ = (FIX_1 / set.curve).value;
+
+        diag_min_ = set.diag_scale_min.value;
+        diag_span_ = (set.diag_scale_max - set.diag_scale_min).value;
+        inv_sqrt2_ = (FIX_1 / fix16::sqrt(FIX_2)).value;
+
+        square_x_ = set.anti_dz_square.value;
+        square_x_scale_ = (FIX_1 - set.anti_dz_square / set.dz_outer).value;
+        square_y_ = anti_r_scale.value;
+        square_y_scale_ = (FIX_1 - anti_r_scale / set.dz_outer).value;
+    }
+
+    inline std::pair<int16_t, int16_t> apply(int16_t gp_joy_x, int16_t gp_joy_y, bool invert_y) const
+    {
+        //Fix16(value) / Range::MAX<int16_t> is a plain integer divide
+        const fix16_t x = fix16_from_int(invert_x_ ? Range::invert(gp_joy_x) : gp_joy_x) / Range::MAX<int16_t>;
+        const fix16_t y = fix16_from_int((invert_y_ ^ invert_y) ? Range::invert(gp_joy_y) : gp_joy_y) / Range::MAX<int16_t>;
+
+        const fix16_t abs_x = fix16_abs(x);
+        const fix16_t abs_y = fix16_abs(y);
+
+        //The raw angle is only compared against 45 degrees unless the anti deadzone is elliptical.
+        //With libfixmath's rounding atan(y / x) in degrees is over 45 exactly when |y / x| rounds to 1 + 2 LSB or more
+        fix16_t r_angle = 0;
+        bool steep = false;
+        if (ellipse_)
+        {
+            r_angle = (abs_x < EPSILON) ? DEG_90 : fix16_rad_to_deg(fix16_abs(fix16_atan(fix16_div(y, x))));
+            steep = (r_angle > DEG_45);
+        }
+        else
+        {
+            steep = (abs_x < EPSILON) || (static_cast<int64_t>(abs_y) * 131072 >= static_cast<int64_t>(abs_x) * 131075);
+        }
+
+        const fix16_t axial_x = (abs_x <= axis_restrict_ && steep) ? 0 : fix16_mul(abs_x - axis_restrict_, inv_axis_restrict_);
+        const fix16_t axial_y = (abs_y <= axis_restrict_ && !steep) ? 0 : fix16_mul(abs_y - axis_restrict_, inv_axis_restrict_);
+
+        const fix16_t in_magnitude = fix16_sqrt(fix16_sq(axial_x) + fix16_sq(axial_y));
+        if (in_magnitude < dz_inner_)
+        {
+            return { 0, 0 };
+        }
+
+        fix16_t angle = (fix16_abs(axial_x) < EPSILON) ? DEG_90 : fix16_rad_to_deg(fix16_abs(fix16_atan(fix16_div(axial_y, axial_x))));
+
+        const fix16_t anti_dz_c = ellipse_ ? anti_dz_scale(ellipse_anti_dz(r_angle)) : anti_dz_c_;
+
+        if (abs_x > axis_restrict_ && abs_y > axis_restrict_)
+        {
+            if (angle > 0 && angle < angle_half_)
+            {
+                angle = 0;
+            }
+            if (angle > (DEG_90 - angle_half_))
+            {
+                angle = DEG_90;
+            }
+            if (angle > angle_half_ && angle < (DEG_90 - angle_half_))
+            {
+                //Multiplying by a whole fix16 number never rounds
+                angle = fix16_div((angle - angle_half_) * 90, angle_span_);
+            }
+        }
+
+        const bool zero_x = (angle == DEG_90);
+        const bool zero_y = (angle < EPSILON2);
+        const fix16_t diagonal = (angle > DEG_45) ? (DEG_90 - angle) : angle;
+
+        if (angle < DEG_90 && angle > 0)
+        {
+            angle = fix16_div(fix16_mul(angle, angle_span_), DEG_90) + angle_half_;
+        }
+
+        if (axial_x < 0 && axial_y > 0)
+        {
+            angle = -angle;
+        }
+        if (axial_x > 0 && axial_y < 0)
+        {
+            angle = angle - DEG_180;
+        }
+        if (axial_x < 0 && axial_y < 0)
+        {
+            angle = angle + DEG_180;
+        }
+
+        //Deadzone warp
+        fix16_t out_magnitude = fix16_div(in_magnitude - dz_inner_, magnitude_span_);
+        out_magnitude = fix16_mul(fix16::pow(Fix16(out_magnitude), Fix16(exponent_)).value, dz_outer_ - anti_dz_c) + anti_dz_c;
+        out_magnitude = (out_magnitude > dz_outer_ && cap_radius_) ? dz_outer_ : out_magnitude;
+
+        fix16_t d_scale = fix16_div(fix16_mul(out_magnitude - anti_dz_c, diag_span_), dz_outer_ - anti_dz_c) + diag_min_;
+        if (d_scale != fix16_one)
+        {
+            //Scales the intensity of the warp based on a circular curve to the perfect diagonal
+            fix16_t c_scale = fix16_div(fix16_mul(diagonal, inv_sqrt2_), DEG_45);
+            c_scale = fix16_one - fix16_sqrt(fix16_one - fix16_mul(c_scale, c_scale));
+            d_scale = fix16_div(fix16_mul(c_scale, d_scale - fix16_one), DIAG_DIVISOR) + fix16_one;
+            out_magnitude = fix16_mul(out_magnitude, d_scale);
+        }
+
+        const fix16_t rad = fix16_deg_to_rad(angle);
+        const fix16_t new_x = fix16_mul(fix16_cos(rad), out_magnitude);
+        const fix16_t new_y = fix16_mul(fix16_sin(rad), out_magnitude);
+
+        //Square anti deadzone scaling
+        fix16_t output_x = fix16_mul(fix16_abs(new_x), square_x_scale_) + square_x_;
+        output_x = zero_x ? 0 : ((x < 0) ? -output_x : output_x);
+
+        fix16_t output_y = fix16_mul(fix16_abs(new_y), square_y_scale_) + square_y_;
+        output_y = zero_y ? 0 : ((y < 0) ? -output_y : output_y);
+
+        return { to_int16(output_x), to_int16(output_y) };
+    }
+
+private:
+    static constexpr fix16_t DEG_45 = 45 * fix16_one;
+    static constexpr fix16_t DEG_90 = 90 * fix16_one;
+    static constexpr fix16_t DEG_180 = 180 * fix16_one;
+    static constexpr fix16_t EPSILON = 7;          // Fix16(0.0001f)
+    static constexpr fix16_t EPSILON2 = 66;        // Fix16(0.001f)
+    static constexpr fix16_t ELLIPSE_DEF = 102943; // Fix16(1.570796f)
+    static constexpr fix16_t DIAG_DIVISOR = 19195; // Fix16(0.29289f)
+
+    bool invert_x_{false};
+    bool invert_y_{false};
+    bool cap_radius_{false};
+    bool ellipse_{false};
+
+    fix16_t axis_restrict_{0};
+    fix16_t inv_axis_restrict_{fix16_one};
+    fix16_t dz_inner_{0};
+    fix16_t dz_outer_{fix16_one};
+    fix16_t anti_dz_c_{0};
+    fix16_t anti_dz_circle_{0};
+    fix16_t anti_dz_k_circle_{fix16_one};
+    fix16_t anti_dz_k_square_{fix16_one};
+    fix16_t ellipse_inv_scale_{0};
+    fix16_t ellipse_scale_sq_{0};
+    fix16_t angle_half_{0};
+    fix16_t angle_span_{DEG_90};
+    fix16_t magnitude_span_{fix16_one};
+    fix16_t exponent_{fix16_one};
+    fix16_t diag_min_{fix16_one};
+    fix16_t diag_span_{0};
+    fix16_t inv_sqrt2_{0};
+    fix16_t square_x_{0};
+    fix16_t square_x_scale_{fix16_one};
+    fix16_t square_y_{0};
+    fix16_t square_y_scale_{fix16_one};
+
+    //The anti deadzone circle stretched to an ellipse at the raw angle, in degrees.
+    //apply_joystick_settings divided an uninitialized anti_ellip_scale here and took the tan of
+    //degrees, the scale is anti_r_scale / anti_dz_circle and tan gets radians.
+    inline fix16_t ellipse_anti_dz(fix16_t r_angle) const
+    {
+        fix16_t ellipse_angle = fix16_atan(fix16_mul(ellipse_inv_scale_, fix16_tan(fix16_deg_to_rad(r_angle))));
+        ellipse_angle = (ellipse_angle < 0) ? ELLIPSE_DEF : ellipse_angle;
+
+        const fix16_t ellipse_x = fix16_cos(ellipse_angle);
+        const fix16_t ellipse_y = fix16_sqrt(fix16_mul(ellipse_scale_sq_, fix16_one - fix16_sq(ellipse_x)));
+        return fix16_mul(anti_dz_circle_, fix16_sqrt(fix16_sq(ellipse_x) + fix16_sq(ellipse_y)));
+    }
+
+    //anti_dz_c / ((anti_dz_c * (1 - anti_dz_circle / dz_outer)) / (anti_dz_c * (1 - anti_dz_square)))
+    inline fix16_t anti_dz_scale(fix16_t anti_dz_c) const
+    {
+        if (anti_dz_c <= 0)
+        {
+            return anti_dz_c;
+        }
+        return fix16_div(anti_dz_c, fix16_div(fix16_mul(anti_dz_c, anti_dz_k_circle_), fix16_mul(anti_dz_c, anti_dz_k_square_)));
+    }
+
+    //fix16::clamp(value, -1, 1) * Range::MAX<int16_t>, then fix16_to_int
+    static inline int16_t to_int16(fix16_t value)
+    {
+        return static_cast<int16_t>(fix16_to_int(fix16_clamp(value, -fix16_one, fix16_one) * Range::MAX<int16_t>));
+    }
+};
+
+#endif // _JOYSTICK_PROGRAM_H_
@@ -0,0 +1,161 @@
+#ifndef _PROFILE_PROGRAM_H_
+#define _PROFILE_PROGRAM_H_
+
+#include <cstdint>
+#include <array>
+
+#include "libfixmath/fix16.hpp"
+
+#include "Gamepad/Range.h"
+#include "Gamepad/fix16ext.h"
+#include "UserSettings/UserProfile.h"
+#include "UserSettings/TriggerSettings.h"
+
+// UserProfile mappings and trigger settings compiled into lookup tables.
+// Host drivers build a canonical button/dpad mask (Gamepad::BUTTON_*, Gamepad::DPAD_*)
+// and run it through here, so remapping costs the same regardless of the profile
+// and triggers never touch Fix16 per sample.
+class ProfileProgram
+{
+public:
+    ProfileProgram()
+    {
+        compile_identity();
+    }
+
+    void compile(const UserProfile& profile)
+    {
+        const uint16_t button_map[16] =
+        {
+            profile.button_a,  profile.button_b,  profile.button_x,     profile.button_y,
+            profile.button_l3, profile.button_r3, profile.button_back,  profile.button_start,
+            profile.button_lb, profile.button_rb, profile.button_sys,   profile.button_misc,
+            0x1000, 0x2000, 0x4000, 0x8000
+        };
+        const uint8_t dpad_map[4] =
+        {
+            profile.dpad_up, profile.dpad_down, profile.dpad_left, profile.dpad_right
+        };
+        compile_buttons(button_map);
+        compile_dpad(dpad_map);
+    }
+
+    //An identity curve is compiled when the settings are disabled
+    void compile_trigger_l(const TriggerSettings& set, bool enabled) { compile_trigger(trigger_lut_l_, set, enabled); }
+    void compile_trigger_r(const TriggerSettings& set, bool enabled) { compile_trigger(trigger_lut_r_, set, enabled); }
+
+    inline uint16_t buttons(uint16_t canonical) const
+    {
+        return  button_lut_[0][canonical & 0xF] |
+                button_lut_[1][(canonical >> 4) & 0xF] |
+                button_lut_[2][(canonical >> 8) & 0xF] |
+                button_lut_[3][canonical >> 12];
+    }
+
+    inline uint8_t dpad(uint8_t canonical) const { return dpad_lut_[canonical & 0xF]; }
+
+    inline uint8_t trigger_l(uint8_t value) const { return trigger_lut_l_[value]; }
+    inline uint8_t trigger_r(uint8_t value) const { return trigger_lut_r_[value]; }
+
+private:
+    std::array<std::array<uint16_t, 16>, 4> button_lut_;
+    std::array<uint8_t, 16> dpad_lut_;
+    std::array<uint8_t, 256> trigger_lut_l_;
+    std::array<uint8_t, 256> trigger_lut_r_;
+
+    void compile_identity()
+    {
+        const uint16_t button_map[16] =
+        {
+            0x0001, 0x0002, 0x0004, 0x0008, 0x0010, 0x0020, 0x0040, 0x0080,
+            0x0100, 0x0200, 0x0400, 0x0800, 0x1000, 0x2000, 0x4000, 0x8000
+        };
+        const uint8_t dpad_map[4] = { 0x01, 0x02, 0x04, 0x08 };
+
+        compile_buttons(button_map);
+        compile_dpad(dpad_map);
+        compile_trigger(trigger_lut_l_, TriggerSettings(), false);
+        compile_trigger(trigger_lut_r_, TriggerSettings(), false);
+    }
+
+    //Each nibble of the canonical mask indexes its own table holding the OR of its mapped bits
+    void compile_buttons(const uint16_t (&map)[16])
+    {
+        for (uint8_t nibble = 0; nibble < button_lut_.size(); ++nibble)
+        {
+            for (uint8_t bits = 0; bits < 16; ++bits)
+            {
+                uint16_t out = 0;
+                for (uint8_t bit = 0; bit < 4; ++bit)
+                {
+                    if (bits & (1 << bit))
+                    {
+                        out |= map[nibble * 4 + bit];
+                    }
+                }
+                button_lut_[nibble][bits] = out;
+            }
+        }
+    }
+
+    void compile_dpad(const uint8_t (&map)[4])
+    {
+        for (uint8_t bits = 0; bits < dpad_lut_.size(); ++bits)
+        {
+            uint8_t out = 0;
+            for (uint8_t bit = 0; bit < 4; ++bit)
+            {
+                if (bits & (1 << bit))
+                {
+                    out |= map[bit];
+                }
+            }
+            dpad_lut_[bits] = out;
+        }
+    }
+
+    static void compile_trigger(std::array<uint8_t, 256>& lut, const TriggerSettings& set, bool enabled)
+    {
+        for (uint16_t value = 0; value < lut.size(); ++value)
+        {
+            lut[value] = enabled
+                ? apply_trigger_settings(static_cast<uint8_t>(value), set)
+                : static_cast<uint8_t>(value);
+        }
+    }
+
+    static uint8_t apply_trigger_settings(uint8_t value, const TriggerSettings& set)
+    {
+        Fix16 abs_value = fix16::abs(Fix16(static_cast<int16_t>(value)) / static_cast<int16_t>(Range::MAX<uint8_t>));
+
+        if (abs_value < set.dz_inner)
+        {
+            return 0;
+        }
+
+        static const Fix16
+            FIX_0(0.0f),
+            FIX_1(1.0f);
+
+        Fix16 value_out = (abs_value - set.dz_inner) / (set.anti_dz_outer - set.dz_inner);
+        value_out = fix16::clamp(value_out, FIX_0, FIX_1);
+
+        if (set.anti_dz_inner > FIX_0)
+        {
+            value_out = set.anti_dz_inner + (FIX_1 - set.anti_dz_inner) * value_out;
+        }
+        if (set.curve != FIX_1)
+        {
+            value_out = fix16::pow(value_out, FIX_1 / set.curve);
+        }
+        if (set.anti_dz_outer < FIX_1)
+        {
+            value_out = fix16::clamp(value_out * (FIX_1 / (FIX_1 - set.anti_dz_outer)), FIX_0, FIX_1);
+        }
+
+        value_out *= set.dz_outer;
+        return static_cast<uint8_t>(fix16_to_int(value_out * static_cast<int16_t>(Range::MAX<uint8_t>)));
+    }
+};
+
+#endif // _PROFILE_PROGRAM_H_
@@ -0,0 +1,74 @@
+#ifndef _SEQLOCK_H_
+#define _SEQLOCK_H_
+
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <type_traits>
+
+// Single writer, multi reader exchange. The writer never waits, readers retry
+// if they overlap a write. The sequence is even while the value is stable and
+// doubles as a generation counter readers can compare against.
+// Only one context may write, and a reader must never preempt the writer on
+// the same core (e.g. reading from an IRQ that interrupts a store).
+template <typename T>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock requires a trivially copyable type");
+
+public:
+    SeqLock() = default;
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    inline void store(const T& value)
+    {
+        const uint32_t seq = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        std::memcpy(const_cast<T*>(&value_), &value, sizeof(T));
+
+        sequence_.store(seq + 2, std::memory_order_release);
+    }
+
+    inline T load() const
+    {
+        uint32_t seq;
+        return load(seq);
+    }
+
+    //Returns the value and the generation it was read at
+    inline T load(uint32_t& generation) const
+    {
+        T value;
+        uint32_t seq_start, seq_end;
+        do
+        {
+            while ((seq_start = sequence_.load(std::memory_order_acquire)) & 1)
+            {
+                //Writer in progress
+            }
+
+            std::memcpy(&value, const_cast<const T*>(&value_), sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            seq_end = sequence_.load(std::memory_order_relaxed);
+        }
+        while (seq_start != seq_end);
+
+        generation = seq_start;
+        return value;
+    }
+
+    inline uint32_t generation() const
+    {
+        return sequence_.load(std::memory_order_acquire) & ~static_cast<uint32_t>(1);
+    }
+
+private:
+    std::atomic<uint32_t> sequence_{0};
+    volatile T value_{};
+};
+
+#endif // _SEQLOCK_H_
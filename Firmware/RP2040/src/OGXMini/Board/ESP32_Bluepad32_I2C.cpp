@@ -73,7 +73,9 @@ static inline void slave_handler(i2c_inst_t *i2c, i2c_slave_event_t event) {
             switch (packet_in.packet_id) {
                 case PacketID::SET_PAD:
                     if (packet_in.index < MAX_GAMEPADS) {
+                        _gamepads[packet_in.index].set_pad_in_time(board_api::us_since_boot());
                         _gamepads[packet_in.index].set_pad_in(packet_in.pad_in);
+                        board_api::core0::notify();
                     }
                     break;
                 case PacketID::SET_DRIVER:
@@ -133,7 +135,7 @@ void run_uart_bridge() {
     OGXM_LOG("Entering UART Bridge mode\n");
 
     //Runs UART Bridge task, doesn't return unless programming is complete
-    DeviceManager::get_instance().get_driver()->process(0, _gamepads[0]); 
+    DeviceManager::get_instance().process(0, _gamepads[0]); 
 
     OGXM_LOG("Exiting UART Bridge mode\n");
 
@@ -178,7 +180,7 @@ void esp32_bp32_i2c::run() {
 
     esp32_api::reset();
 
-    DeviceDriver* device_driver = DeviceManager::get_instance().get_driver();
+    DeviceManager& device_manager = DeviceManager::get_instance();
 
     tud_init(BOARD_TUD_RHPORT);
 
@@ -186,10 +188,10 @@ void esp32_bp32_i2c::run() {
         TaskQueue::Core0::process_tasks();
 
         for (uint8_t i = 0; i < MAX_GAMEPADS; ++i) {
-            device_driver->process(i, _gamepads[i]);
+            device_manager.process(i, _gamepads[i]);
             tud_task();
         }
-        sleep_ms(1);
+        board_api::core0::wait();
     }
 }
 
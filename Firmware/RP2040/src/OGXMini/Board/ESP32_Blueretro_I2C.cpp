@@ -102,7 +102,9 @@ static void core1_task() {
             std::memcpy(reinterpret_cast<uint8_t*>(&pad_in), 
                         packet_in.gp_data, 
                         sizeof(packet_in.gp_data));
+            gamepad.set_pad_in_time(board_api::us_since_boot());
             gamepad.set_pad_in(pad_in);
+            board_api::core0::notify();
 
         } else {
             OGXM_LOG("I2C read failed\n");
@@ -132,7 +134,7 @@ void run_uart_bridge() {
     OGXM_LOG("Entering UART Bridge mode\n");
 
     //Runs UART Bridge task, doesn't return unless programming is complete
-    DeviceManager::get_instance().get_driver()->process(0, _gamepads[0]); 
+    DeviceManager::get_instance().process(0, _gamepads[0]); 
 
     OGXM_LOG("Exiting UART Bridge mode\n");
 
@@ -180,15 +182,15 @@ void esp32_br_i2c::run() {
     uint32_t tid_gp_check = TaskQueue::Core0::get_new_task_id();
     set_gp_check_timer(tid_gp_check);
 
-    DeviceDriver* device_driver = DeviceManager::get_instance().get_driver();
+    DeviceManager& device_manager = DeviceManager::get_instance();
 
     tud_init(BOARD_TUD_RHPORT);
 
     while (true) {
         TaskQueue::Core0::process_tasks();
-        device_driver->process(0, _gamepads[0]);
+        device_manager.process(0, _gamepads[0]);
         tud_task();
-        sleep_ms(1);
+        board_api::core0::wait();
     }
 }
 
@@ -15,13 +15,15 @@
 
 #include "USBDevice/DeviceManager.h"
 #include "USBHost/HostManager.h"
+#include "USBHost/HostCache.h"
+#include "USBHost/FrameSync.h"
 #include "Board/board_api.h"
 #include "Board/ogxm_log.h"
 #include "UserSettings/UserSettings.h"
 #include "Gamepad/Gamepad.h"
 #include "TaskQueue/TaskQueue.h"
 
-constexpr uint32_t FEEDBACK_DELAY_MS = 250;
+constexpr uint32_t POLL_STATS_INTERVAL_MS = 1000;
 
 Gamepad _gamepads[MAX_GAMEPADS];
 
@@ -127,7 +129,9 @@ namespace I2C {
                             // instance_->packet_in_ = *packet_in_p;
                             // *packet_out_p = instance_->packet_out_;
                             // instance_->new_pad_in_.store(true);
+                            _gamepads[0].set_pad_in_time(board_api::us_since_boot());
                             _gamepads[0].set_pad_in(packet_in_p->pad_in);
+                            board_api::core0::notify();
                             if (_gamepads[0].new_pad_out()) {
                                 packet_out_p->pad_out = _gamepads[0].get_pad_out();
                             }
@@ -254,7 +258,9 @@ namespace I2C {
                     if (write_blocking(slave.address, &packet_in, sizeof(PacketIn))) {
                         PacketOut packet_out;
                         if (read_blocking(slave.address, &packet_out, sizeof(PacketOut))) {
+                            gamepad.set_pad_out_time(board_api::us_since_boot());
                             gamepad.set_pad_out(packet_out.pad_out);
+                            board_api::core1::notify();
                         }
                     }
                 }
@@ -352,15 +358,16 @@ void core1_task() {
     tuh_configure(BOARD_TUH_RHPORT, TUH_CFGID_RPI_PIO_USB_CONFIGURATION, &pio_cfg);
 
     tuh_init(BOARD_TUH_RHPORT);
+    FrameSync::start_host_frames();
 
-    uint32_t tid_feedback = TaskQueue::Core1::get_new_task_id();
-    TaskQueue::Core1::queue_delayed_task(tid_feedback, FEEDBACK_DELAY_MS, true, 
+    TaskQueue::Core1::queue_delayed_task(TaskQueue::Core1::get_new_task_id(), POLL_STATS_INTERVAL_MS, true, 
     [&host_manager] {
-        host_manager.send_feedback();
+        host_manager.update_poll_stats(POLL_STATS_INTERVAL_MS);
     });
 
     while (true) {
         TaskQueue::Core1::process_tasks();
+        host_manager.feedback_task();
         tuh_task();
     }
 }
@@ -393,6 +400,7 @@ void four_ch_i2c::host_mounted(bool mounted) {
         TaskQueue::Core0::queue_task([]() {
             OGXM_LOG("Disconnecting USB and rebooting.\n");
             board_api::usb::disconnect_all();
+            HostCache::flush();
             board_api::reboot();
         });
     } else if (!tud_is_inited.load() && mounted) {
@@ -414,6 +422,7 @@ void four_ch_i2c::host_mounted_w_type(bool mounted, HostDriverType host_type) {
 void four_ch_i2c::initialize() {
     UserSettings& user_settings = UserSettings::get_instance();
     user_settings.initialize_flash();
+    HostCache::load();
 
     board_api::init_board();
 
@@ -439,22 +448,22 @@ void four_ch_i2c::run() {
     uint32_t tid_gp_check = TaskQueue::Core0::get_new_task_id();
     set_gp_check_timer(tid_gp_check);
 
-    DeviceDriver* device_driver = DeviceManager::get_instance().get_driver();
+    DeviceManager& device_manager = DeviceManager::get_instance();
 
     if (I2C::role() == I2C::Role::MASTER) {
         while (true) {
             TaskQueue::Core0::process_tasks();
             I2C::Master::process();
-            device_driver->process(0, _gamepads[0]);
+            device_manager.process(0, _gamepads[0]);
             tud_task();
-            sleep_ms(1);
+            board_api::core0::wait();
         }
     } else {
         while (true) {
             TaskQueue::Core0::process_tasks();
-            device_driver->process(0, _gamepads[0]);
+            device_manager.process(0, _gamepads[0]);
             tud_task();
-            sleep_ms(1);
+            board_api::core0::wait();
         }
     }
 }
@@ -58,7 +58,7 @@ void pico_w::run() {
     uint32_t tid_gp_check = TaskQueue::Core0::get_new_task_id();
     set_gp_check_timer(tid_gp_check);
 
-    DeviceDriver* device_driver = DeviceManager::get_instance().get_driver();
+    DeviceManager& device_manager = DeviceManager::get_instance();
 
     tud_init(BOARD_TUD_RHPORT);
 
@@ -66,10 +66,10 @@ void pico_w::run() {
         TaskQueue::Core0::process_tasks();
 
         for (uint8_t i = 0; i < MAX_GAMEPADS; ++i) {
-            device_driver->process(i, _gamepads[i]);
+            device_manager.process(i, _gamepads[i]);
             tud_task();
         }
-        sleep_ms(1);
+        board_api::core0::wait();
     }
 }
 
@@ -15,13 +15,16 @@
 // ---------------------------------------------
 
 #include "USBHost/HostManager.h"
+#include "USBHost/HostCache.h"
+#include "USBHost/FrameSync.h"
 #include "USBDevice/DeviceManager.h"
 #include "TaskQueue/TaskQueue.h"
 #include "Gamepad/Gamepad.h"
 #include "Board/board_api.h"
 #include "Board/ogxm_log.h"
 
-constexpr uint32_t FEEDBACK_DELAY_MS = 200;
+constexpr uint32_t LATENCY_LOG_INTERVAL_MS = 5000;
+constexpr uint32_t POLL_STATS_INTERVAL_MS = 1000;
 
 Gamepad _gamepads[MAX_GAMEPADS];
 
@@ -40,14 +43,16 @@ void core1_task() {
 
     tuh_init(BOARD_TUH_RHPORT);
 
-    uint32_t tid_feedback = TaskQueue::Core1::get_new_task_id();
-    TaskQueue::Core1::queue_delayed_task(tid_feedback, FEEDBACK_DELAY_MS, true, 
+    FrameSync::start_host_frames();
+
+    TaskQueue::Core1::queue_delayed_task(TaskQueue::Core1::get_new_task_id(), POLL_STATS_INTERVAL_MS, true, 
     [&host_manager] {
-        host_manager.send_feedback();
+        host_manager.update_poll_stats(POLL_STATS_INTERVAL_MS);
     });
 
     while (true) {
         TaskQueue::Core1::process_tasks();
+        host_manager.feedback_task();
         tuh_task();
     }
 }
@@ -75,6 +80,7 @@ void standard::host_mounted(bool host_mounted) {
         TaskQueue::Core0::queue_task([]() {
             OGXM_LOG("USB disconnected, rebooting.\n");
             board_api::usb::disconnect_all();
+            HostCache::flush();
             board_api::reboot();
         });
     } else if (!tud_is_inited.load()) {
@@ -102,6 +108,7 @@ void standard::initialize() {
 
     UserSettings& user_settings = UserSettings::get_instance();
     user_settings.initialize_flash();
+    HostCache::load();
 
     for (uint8_t i = 0; i < MAX_GAMEPADS; ++i) {
         _gamepads[i].set_profile(user_settings.get_profile_by_index(i));
@@ -130,16 +137,24 @@ void standard::run() {
     uint32_t tid_gp_check = TaskQueue::Core0::get_new_task_id();
     set_gp_check_timer(tid_gp_check);
 
-    DeviceDriver* device_driver = DeviceManager::get_instance().get_driver();
+    DeviceManager& device_manager = DeviceManager::get_instance();
+
+#if defined(CONFIG_OGXM_DEBUG)
+    TaskQueue::Core0::queue_delayed_task(TaskQueue::Core0::get_new_task_id(), LATENCY_LOG_INTERVAL_MS, true, 
+    [&device_manager] {
+        board_api::latency::log_stats();
+        device_manager.get_driver()->log_report_age();
+    });
+#endif
 
     while (true) {
         TaskQueue::Core0::process_tasks();
 
         for (uint8_t i = 0; i < MAX_GAMEPADS; ++i) {
-            device_driver->process(i, _gamepads[i]);
+            device_manager.process(i, _gamepads[i]);
         }
         tud_task();
-        sleep_ms(1);
+        board_api::core0::wait();
     }
 }
 
@@ -0,0 +1,297 @@
+#ifndef TASK_QUEUE_COROUTINE_H
+#define TASK_QUEUE_COROUTINE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <coroutine>
+
+#include "Board/Config.h"
+#include "TaskQueue/TaskQueue.h"
+
+// Coroutine for multi step device protocols, lets an init handshake read as a
+// straight sequence of send, wait for completion, wait for the reply, delay.
+// Frames come from a fixed pool, a coroutine that doesn't fit or finds the pool
+// full never starts and the returned Coroutine is empty (valid() == false).
+// Coroutines and their awaitables run on the core whose TaskQueue they delay on,
+// none of this is thread safe.
+class Coroutine
+{
+public:
+    //One multi step sequence per gamepad at a time
+    static constexpr size_t FRAME_SIZE = 256;
+    static constexpr uint8_t MAX_FRAMES = MAX_GAMEPADS;
+
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    struct promise_type
+    {
+        //Delayed task that resumes this coroutine, cancelled if it's resumed or destroyed first
+        uint32_t tid_resume{0};
+        void (*cancel_task)(uint32_t){nullptr};
+
+        Coroutine get_return_object() { return Coroutine(Handle::from_promise(*this)); }
+        static Coroutine get_return_object_on_allocation_failure() { return Coroutine(); }
+
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; } //Frame is released by the owning Coroutine
+        void return_void() {}
+        void unhandled_exception() {}
+
+        void cancel_resume_task()
+        {
+            if (tid_resume && cancel_task)
+            {
+                cancel_task(tid_resume);
+            }
+            tid_resume = 0;
+        }
+
+        static void* operator new(size_t size) noexcept { return Frames::allocate(size); }
+        static void operator delete(void* frame) { Frames::release(frame); }
+    };
+
+    Coroutine() = default;
+    Coroutine(const Coroutine&) = delete;
+    Coroutine& operator=(const Coroutine&) = delete;
+
+    Coroutine(Coroutine&& other) noexcept
+        : handle_(other.handle_)
+    {
+        other.handle_ = nullptr;
+    }
+
+    Coroutine& operator=(Coroutine&& other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy();
+            handle_ = other.handle_;
+            other.handle_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~Coroutine()
+    {
+        destroy();
+    }
+
+    inline bool valid() const { return static_cast<bool>(handle_); }
+    inline bool done() const { return !handle_ || handle_.done(); }
+
+    //Frame pool usage, for sizing FRAME_SIZE and MAX_FRAMES
+    static inline uint8_t frames_in_use() { return Frames::in_use(); }
+    static inline size_t largest_frame() { return Frames::largest(); }
+
+    //co_await Coroutine::Delay<TaskQueue::Core1>{ms}, resumes from that core's task queue
+    template <typename Core>
+    struct Delay
+    {
+        uint32_t delay_ms;
+
+        bool await_ready() const noexcept { return delay_ms == 0; }
+        bool await_suspend(Handle handle) { return arm_resume<Core>(handle, delay_ms, nullptr); }
+        void await_resume() const noexcept {}
+    };
+
+    //Resumes one waiting coroutine when notified, e.g. from a transfer complete or report received callback.
+    //Must outlive any coroutine waiting on it.
+    class Signal
+    {
+    public:
+        struct Awaiter
+        {
+            Signal& signal;
+            uint32_t timeout_ms;
+            bool (*arm)(Handle, uint32_t, Signal*);
+
+            bool await_ready() const noexcept { return false; }
+            bool await_suspend(Handle handle)
+            {
+                signal.waiter_ = handle;
+                signal.timed_out_ = false;
+                return (arm == nullptr) || arm(handle, timeout_ms, &signal);
+            }
+            //False if the wait timed out
+            bool await_resume() const noexcept { return !signal.timed_out_; }
+        };
+
+        //co_await signal waits indefinitely
+        Awaiter operator co_await() noexcept { return { *this, 0, nullptr }; }
+
+        //co_await signal.wait_for<TaskQueue::Core1>(ms) gives up after timeout_ms and returns false
+        template <typename Core>
+        Awaiter wait_for(uint32_t timeout_ms) noexcept { return { *this, timeout_ms, &arm_resume<Core> }; }
+
+        //Resumes the waiting coroutine before returning, false if nothing was waiting
+        bool notify()
+        {
+            if (!waiter_)
+            {
+                return false;
+            }
+            Handle handle = waiter_;
+            waiter_ = nullptr;
+            handle.promise().cancel_resume_task();
+            handle.resume();
+            return true;
+        }
+
+        inline bool waiting() const { return static_cast<bool>(waiter_); }
+
+    private:
+        friend class Coroutine;
+
+        Handle waiter_{nullptr};
+        bool timed_out_{false};
+    };
+
+private:
+    Handle handle_{nullptr};
+
+    explicit Coroutine(Handle handle)
+        : handle_(handle) {}
+
+    void destroy()
+    {
+        if (handle_)
+        {
+            handle_.promise().cancel_resume_task();
+            handle_.destroy();
+            handle_ = nullptr;
+        }
+    }
+
+    class Frames
+    {
+    public:
+        static void* allocate(size_t size)
+        {
+            if (size > largest_)
+            {
+                largest_ = size;
+            }
+            if (size > FRAME_SIZE)
+            {
+                return nullptr;
+            }
+            for (uint8_t i = 0; i < MAX_FRAMES; ++i)
+            {
+                if (!(used_ & (1u << i)))
+                {
+                    used_ |= (1u << i);
+                    return pool_[i].data;
+                }
+            }
+            return nullptr;
+        }
+
+        static void release(void* frame)
+        {
+            const uint8_t i = index_of(frame);
+            if (i < MAX_FRAMES)
+            {
+                used_ &= ~(1u << i);
+                ++generation_[i];
+            }
+        }
+
+        //Changes every time a frame is released, so a stale resume can tell its coroutine is gone
+        static uint32_t generation(const void* frame)
+        {
+            const uint8_t i = index_of(frame);
+            return (i < MAX_FRAMES) ? generation_[i] : 0;
+        }
+
+        static bool live(const void* frame, uint32_t generation)
+        {
+            const uint8_t i = index_of(frame);
+            return (i < MAX_FRAMES) && (used_ & (1u << i)) && (generation_[i] == generation);
+        }
+
+        static uint8_t in_use()
+        {
+            uint8_t count = 0;
+            for (uint8_t i = 0; i < MAX_FRAMES; ++i)
+            {
+                count = static_cast<uint8_t>(count + ((used_ >> i) & 1u));
+            }
+            return count;
+        }
+
+        static inline size_t largest() { return largest_; }
+
+    private:
+        static_assert(MAX_FRAMES <= 32, "Frame pool tracks use in a uint32_t");
+
+        struct Frame
+        {
+            alignas(std::max_align_t) unsigned char data[FRAME_SIZE];
+        };
+
+        static inline Frame pool_[MAX_FRAMES];
+        static inline uint32_t generation_[MAX_FRAMES]{0};
+        static inline uint32_t used_{0};
+        static inline size_t largest_{0};
+
+        static uint8_t index_of(const void* frame)
+        {
+            const unsigned char* ptr = static_cast<const unsigned char*>(frame);
+            const unsigned char* base = pool_[0].data;
+            if (ptr < base || ptr >= base + sizeof(pool_))
+            {
+                return MAX_FRAMES;
+            }
+            return static_cast<uint8_t>(static_cast<size_t>(ptr - base) / sizeof(Frame));
+        }
+    };
+
+    //Resumes handle after delay_ms, marking signal as timed out if one is given.
+    //Returns false if the timer couldn't be queued so the awaiter resumes straight away.
+    template <typename Core>
+    static bool arm_resume(Handle handle, uint32_t delay_ms, Signal* signal)
+    {
+        promise_type& promise = handle.promise();
+        promise.cancel_resume_task();
+        promise.tid_resume = Core::get_new_task_id();
+        promise.cancel_task = &Core::cancel_delayed_task;
+
+        const uint32_t tid = promise.tid_resume;
+        const uint32_t generation = Frames::generation(handle.address());
+
+        //A resume already moved to the task ring can't be cancelled, so the frame and task id are checked before it runs
+        const bool queued = Core::queue_delayed_task(tid, delay_ms, false,
+        [handle, generation, signal, tid]
+        {
+            if (!Frames::live(handle.address(), generation) || handle.done() || handle.promise().tid_resume != tid)
+            {
+                return;
+            }
+            if (signal)
+            {
+                if (signal->waiter_ != handle)
+                {
+                    return;
+                }
+                signal->waiter_ = nullptr;
+                signal->timed_out_ = true;
+            }
+            handle.promise().tid_resume = 0;
+            handle.resume();
+        });
+
+        if (!queued)
+        {
+            promise.tid_resume = 0;
+            if (signal)
+            {
+                signal->waiter_ = nullptr;
+                signal->timed_out_ = true;
+            }
+        }
+        return queued;
+    }
+};
+
+#endif // TASK_QUEUE_COROUTINE_H
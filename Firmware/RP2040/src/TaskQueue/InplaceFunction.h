@@ -0,0 +1,104 @@
+#ifndef INPLACE_FUNCTION_H
+#define INPLACE_FUNCTION_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Callable wrapper with fixed inline storage, never touches the heap so it's
+// safe to construct, copy and destroy from IRQ context.
+// Captures that don't fit in Capacity fail to compile.
+template <typename Signature, size_t Capacity>
+class InplaceFunction;
+
+template <typename R, typename... Args, size_t Capacity>
+class InplaceFunction<R(Args...), Capacity>
+{
+public:
+    InplaceFunction() = default;
+    InplaceFunction(std::nullptr_t) {}
+
+    template <typename F, typename Fn = std::decay_t<F>,
+              typename = std::enable_if_t<!std::is_same_v<Fn, InplaceFunction> && std::is_invocable_r_v<R, Fn&, Args...>>>
+    InplaceFunction(F&& function)
+    {
+        static_assert(sizeof(Fn) <= Capacity, "Callable captures too much to fit in InplaceFunction, capture by reference or shrink it");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "Callable is over aligned for InplaceFunction");
+        static_assert(std::is_copy_constructible_v<Fn>, "InplaceFunction requires a copyable callable");
+
+        new (storage_) Fn(std::forward<F>(function));
+        ops_ = &OPS<Fn>;
+    }
+
+    InplaceFunction(const InplaceFunction& other)
+    {
+        if (other.ops_)
+        {
+            other.ops_->copy(storage_, other.storage_);
+            ops_ = other.ops_;
+        }
+    }
+
+    InplaceFunction& operator=(const InplaceFunction& other)
+    {
+        if (this != &other)
+        {
+            reset();
+            if (other.ops_)
+            {
+                other.ops_->copy(storage_, other.storage_);
+                ops_ = other.ops_;
+            }
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(std::nullptr_t)
+    {
+        reset();
+        return *this;
+    }
+
+    ~InplaceFunction()
+    {
+        reset();
+    }
+
+    inline explicit operator bool() const { return ops_ != nullptr; }
+
+    inline R operator()(Args... args) const
+    {
+        return ops_->invoke(const_cast<unsigned char*>(storage_), std::forward<Args>(args)...);
+    }
+
+private:
+    struct Ops
+    {
+        R (*invoke)(void* storage, Args&&... args);
+        void (*copy)(void* dst, const void* src);
+        void (*destroy)(void* storage);
+    };
+
+    template <typename Fn>
+    static constexpr Ops OPS =
+    {
+        [](void* storage, Args&&... args) -> R { return (*static_cast<Fn*>(storage))(std::forward<Args>(args)...); },
+        [](void* dst, const void* src) { new (dst) Fn(*static_cast<const Fn*>(src)); },
+        [](void* storage) { static_cast<Fn*>(storage)->~Fn(); }
+    };
+
+    alignas(std::max_align_t) unsigned char storage_[Capacity];
+    const Ops* ops_{nullptr};
+
+    inline void reset()
+    {
+        if (ops_)
+        {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+};
+
+#endif // INPLACE_FUNCTION_H
@@ -1,10 +1,14 @@
 #include "TaskQueue/TaskQueue.h"
+#include "Board/board_api.h"
 
 TaskQueue::TaskQueue(CoreNum core_num) 
 {   
     alarm_num_ = (core_num == CoreNum::Core0) ? 0 : 1;
     alarm_num_ += (OGXM_BOARD == PI_PICOW) ? 1 : 0; //BTStack uses alarm 0
 
+    //Keeps hardware_alarm_claim_unused() users like FrameSync off this alarm
+    hardware_alarm_claim(alarm_num_);
+
     hw_set_bits(&timer_hw->inte, 1u << alarm_num_);
 
     irq_set_exclusive_handler(
@@ -19,143 +23,123 @@ uint32_t TaskQueue::get_new_task_id()
     return new_task_id_++;
 }
 
-bool TaskQueue::queue_delayed_task(uint32_t task_id, uint32_t delay_ms, bool repeating, const std::function<void()>& function)
+bool TaskQueue::queue_delayed_task(uint32_t task_id, uint32_t delay_ms, bool repeating, const Function& function)
 {
+    const uint64_t delay_us = static_cast<uint64_t>(delay_ms) * 1000;
+
     uint32_t irq_state = spin_lock_blocking(spinlock_delayed_);
-    for (const auto& task : task_queue_delayed_) 
+    if (task_queue_delayed_.contains(task_id))
     {
-        if (task.task_id == task_id)
-        {
-            spin_unlock(spinlock_delayed_, irq_state);
-            return false;
-        }
+        spin_unlock(spinlock_delayed_, irq_state);
+        return false;
     }
 
-    hw_set_bits(&timer_hw->inte, 1u << alarm_num_);
-
-    //Might come back to this, there is overflow potential
-    uint64_t target_time = timer_hw->timerawl + static_cast<uint64_t>(delay_ms) * 1000;
-
-    for (auto& task : task_queue_delayed_) 
+    if (!task_queue_delayed_.insert(task_id, time_us_64() + delay_us, repeating ? delay_us : 0, function))
     {
-        if (!task.function) 
-        {
-            task.target_time = target_time;
-            task.interval_ms = repeating ? delay_ms : 0;
-            task.function = function;
-            task.task_id = task_id;
-
-            auto it = std::min_element(task_queue_delayed_.begin(), task_queue_delayed_.end(), [](const DelayedTask& a, const DelayedTask& b) 
-            {
-                return a.function && (!b.function || a.target_time < b.target_time);
-            });
-
-            if (it != task_queue_delayed_.end() && it->function) 
-            {
-                timer_hw->alarm[alarm_num_] = static_cast<uint32_t>(it->target_time);
-            }
-
-            spin_unlock(spinlock_delayed_, irq_state);
-            return true;
-        }
+        ++dropped_delayed_;
+        spin_unlock(spinlock_delayed_, irq_state);
+        return false;
     }
 
+    hw_set_bits(&timer_hw->inte, 1u << alarm_num_);
+    arm_alarm_unsafe();
+
     spin_unlock(spinlock_delayed_, irq_state);
-    return false;
+    return true;
 }
 
 void TaskQueue::cancel_delayed_task(uint32_t task_id)
 {
     uint32_t irq_state = spin_lock_blocking(spinlock_delayed_);
-    bool found = false;
-
-    for (auto& task : task_queue_delayed_) 
+    if (task_queue_delayed_.cancel(task_id))
     {
-        if (task.task_id == task_id) 
-        {
-            task.function = nullptr;
-            task.task_id = 0;
-            task.interval_ms = 0;
-            found = true;
-        }
+        arm_alarm_unsafe();
     }
+    spin_unlock(spinlock_delayed_, irq_state);
+}
 
-    if (!found)
-    {
-        spin_unlock(spinlock_delayed_, irq_state);
-        return;
-    }
+bool TaskQueue::queue_task(const Function& function)
+{
+    TaskRing& ring = task_rings_[get_core_num()];
 
-    hw_set_bits(&timer_hw->inte, 1u << alarm_num_);
+    //Thread and IRQ context on the same core share this ring's producer side
+    uint32_t irq_state = save_and_disable_interrupts();
 
-    int64_t next_target_time = get_next_target_time_unsafe(task_queue_delayed_);
-    if (next_target_time >= 0) 
+    const uint32_t tail = ring.tail.load(std::memory_order_relaxed);
+    if (tail - ring.head.load(std::memory_order_acquire) >= MAX_TASKS)
     {
-        timer_hw->alarm[alarm_num_] = static_cast<uint32_t>(next_target_time);
+        ++ring.dropped;
+        restore_interrupts(irq_state);
+        return false;
     }
-    
-    spin_unlock(spinlock_delayed_, irq_state);
+
+    ring.tasks[tail & (MAX_TASKS - 1)] = function;
+    ring.tail.store(tail + 1, std::memory_order_release);
+
+    restore_interrupts(irq_state);
+
+    //Only core0's loop sleeps, core1 goes through its ring every pass
+    board_api::core0::notify();
+    return true;
 }
 
-bool TaskQueue::queue_task(const std::function<void()>& function)
+void TaskQueue::process_tasks()
 {
-    uint32_t irq_state = spin_lock_blocking(spinlock_queue_);
-    for (auto& task : task_queue_)
+    for (auto& ring : task_rings_)
     {
-        if (!task.function)
+        uint32_t head = ring.head.load(std::memory_order_relaxed);
+        while (head != ring.tail.load(std::memory_order_acquire))
         {
-            task.function = function;
-            spin_unlock(spinlock_queue_, irq_state);
-            return true;
+            Function& slot = ring.tasks[head & (MAX_TASKS - 1)];
+            Function function = slot;
+            slot = nullptr;
+            ring.head.store(++head, std::memory_order_release);
+
+            function();
         }
     }
-    spin_unlock(spinlock_queue_, irq_state);
-    return false;
 }
 
-void TaskQueue::process_tasks()
+uint32_t TaskQueue::dropped_tasks() const
 {
-    uint32_t irq_state = spin_lock_blocking(spinlock_queue_);
-    for (auto& task : task_queue_)
+    uint32_t dropped = dropped_delayed_;
+    for (const auto& ring : task_rings_)
     {
-        if (task.function)
-        {
-            auto function = task.function;
-            task.function = nullptr;
-            spin_unlock(spinlock_queue_, irq_state);
-
-            function();
-
-            irq_state = spin_lock_blocking(spinlock_queue_);
-        }
-        else
-        {
-            break; //No more tasks
-        }
+        dropped += ring.dropped;
     }
-    spin_unlock(spinlock_queue_, irq_state);
+    return dropped;
 }
 
-uint64_t TaskQueue::get_time_64_us()
+//Call with spinlock_delayed_ held
+void TaskQueue::arm_alarm_unsafe()
 {
-    static spin_lock_t* spinlock_time_ = nullptr;
-    if (!spinlock_time_)
+    if (suspended_ || task_queue_delayed_.empty())
     {
-        int spinlock_time_num = spin_lock_claim_unused(true);
-        spinlock_time_ = spin_lock_instance(static_cast<uint>(spinlock_time_num));
+        return;
+    }
+
+    //The alarm only compares the low 32 bits of the timer, so targets more
+    //than half a wrap away get an intermediate wake and are re-armed from there
+    static constexpr uint64_t MAX_ALARM_US = 0x7FFFFFFF;
+
+    const uint64_t target = task_queue_delayed_.next_target();
+    const uint64_t now = time_us_64();
+    const uint64_t alarm_time = std::min(target, now + MAX_ALARM_US);
+
+    timer_hw->alarm[alarm_num_] = static_cast<uint32_t>(alarm_time);
+
+    //The alarm fires on an exact match, if the target passed while arming force the IRQ instead
+    if (time_us_64() >= alarm_time)
+    {
+        hw_set_bits(&timer_hw->intf, 1u << alarm_num_);
     }
-    uint32_t irq_state = spin_lock_blocking(spinlock_time_);
-    uint32_t lo = timer_hw->timelr;
-    uint32_t hi = timer_hw->timehr;
-    spin_unlock(spinlock_time_, irq_state);
-    return ((uint64_t) hi << 32u) | lo;;
 }
 
 void TaskQueue::timer_irq_handler()
 {
+    hw_clear_bits(&timer_hw->intf, 1u << alarm_num_);
     hw_clear_bits(&timer_hw->intr, 1u << alarm_num_);
 
-    uint64_t now = get_time_64_us();
     uint32_t irq_state = spin_lock_blocking(spinlock_delayed_);
     if (suspended_)
     {
@@ -163,33 +147,13 @@ void TaskQueue::timer_irq_handler()
         return;
     }
 
-    for (auto& task : task_queue_delayed_) 
+    //queue_task() only masks IRQs on this core, it's safe to call with the lock held
+    task_queue_delayed_.pop_expired(time_us_64(), [this](const Function& function)
     {
-        if (task.function && task.target_time <= now) 
-        {
-            auto function = task.function;
-            if (task.interval_ms) 
-            {
-                task.target_time += (task.interval_ms * 1000);
-            } 
-            else 
-            {
-                task.function = nullptr;
-                task.task_id = 0;
-            }
-
-            spin_unlock(spinlock_delayed_, irq_state);
-            queue_task(function);
-            irq_state = spin_lock_blocking(spinlock_delayed_);
-        }
-    }
-
-    int64_t next_target_time = get_next_target_time_unsafe(task_queue_delayed_);
-    if (next_target_time >= 0) 
-    {
-        timer_hw->alarm[alarm_num_] = static_cast<uint32_t>(next_target_time);
-    }
+        queue_task(function);
+    });
 
+    arm_alarm_unsafe();
     spin_unlock(spinlock_delayed_, irq_state);
 }
 
@@ -218,7 +182,7 @@ void TaskQueue::suspend_delayed()
         return;
     }
     hw_clear_bits(&timer_hw->intr, 1u << alarm_num_);
-    suspended_time_ = get_time_64_us();
+    suspended_time_ = time_us_64();
     suspended_ = true;
     spin_unlock(spinlock_delayed_, irq_state);
 }
@@ -232,21 +196,10 @@ void TaskQueue::resume_delayed()
         return;
     }
 
-    uint64_t now = get_time_64_us();
-    uint64_t elapsed_time = now - suspended_time_;
+    const uint64_t now = time_us_64();
+    task_queue_delayed_.shift_all(now - suspended_time_, now + 10);
 
-    for (auto& task : task_queue_delayed_) 
-    {
-        if (task.function) 
-        {
-            task.target_time = std::max(task.target_time + elapsed_time, now + 10);
-        }
-    }
-    int64_t next_target_time = get_next_target_time_unsafe(task_queue_delayed_);
-    if (next_target_time >= 0) 
-    {
-        timer_hw->alarm[alarm_num_] = static_cast<uint32_t>(next_target_time);
-    }
     suspended_ = false;
+    arm_alarm_unsafe();
     spin_unlock(spinlock_delayed_, irq_state);
-}
\ No newline at end of file
+}
@@ -2,18 +2,25 @@
 #define TASK_QUEUE_H
 
 #include <cstdint>
-#include <functional>
-#include <memory>
+#include <array>
+#include <atomic>
+#include <algorithm>
 #include <pico/stdlib.h>
 #include <hardware/timer.h>
 #include <hardware/irq.h>
 #include <hardware/sync.h>
 
 #include "Board/Config.h"
+#include "TaskQueue/InplaceFunction.h"
+#include "TaskQueue/TimerHeap.h"
 
 class TaskQueue
 {
 public:
+    //Captures larger than this fail to compile, capture by reference or pointer instead
+    static constexpr size_t TASK_CAPACITY = sizeof(void*) * 4;
+    using Function = InplaceFunction<void(), TASK_CAPACITY>;
+
     struct Core0
     {
         static inline uint32_t get_new_task_id()
@@ -24,11 +31,11 @@ public:
         {
             get_core0().cancel_delayed_task(task_id);
         }
-        static inline bool queue_delayed_task(uint32_t task_id, uint32_t delay_ms, bool repeating, const std::function<void()>& function)
+        static inline bool queue_delayed_task(uint32_t task_id, uint32_t delay_ms, bool repeating, const Function& function)
         {
             return get_core0().queue_delayed_task(task_id, delay_ms, repeating, function);
         }
-        static inline bool queue_task(const std::function<void()>& function)
+        static inline bool queue_task(const Function& function)
         {
             return get_core0().queue_task(function);
         }
@@ -44,6 +51,11 @@ public:
         {
             get_core0().resume_delayed();
         }
+        //Tasks rejected because a queue was full
+        static inline uint32_t dropped_tasks()
+        {
+            return get_core0().dropped_tasks();
+        }
     };
 
 #if (OGXM_BOARD != PI_PICOW) //BTstack uses core1
@@ -57,11 +69,11 @@ public:
         {
             get_core1().cancel_delayed_task(task_id);
         }
-        static inline bool queue_delayed_task(uint32_t task_id, uint32_t delay_ms, bool repeating, const std::function<void()>& function)
+        static inline bool queue_delayed_task(uint32_t task_id, uint32_t delay_ms, bool repeating, const Function& function)
         {
             return get_core1().queue_delayed_task(task_id, delay_ms, repeating, function);
         }
-        static inline bool queue_task(const std::function<void()>& function)
+        static inline bool queue_task(const Function& function)
         {
             return get_core1().queue_task(function);
         }
@@ -77,6 +89,11 @@ public:
         {
             get_core1().resume_delayed();
         }
+        //Tasks rejected because a queue was full
+        static inline uint32_t dropped_tasks()
+        {
+            return get_core1().dropped_tasks();
+        }
     }; // Core1
 #endif // OGXM_BOARD != PI_PICOW
 
@@ -97,23 +114,22 @@ private:
     TaskQueue(CoreNum core_num);
     ~TaskQueue() = default;
 
-    struct Task
-    {
-        // uint32_t task_id = 0;
-        std::function<void()> function = nullptr;
-    };
-
-    struct DelayedTask
+    static constexpr uint8_t MAX_TASKS = 8;
+    //Each core's heap takes about 4.6 KB on the RP2040, 56 bytes per timer and a 1 KB id table
+    static constexpr uint8_t MAX_DELAYED_TASKS = 64;
+    static constexpr uint8_t NUM_CORES = 2;
+    static_assert((MAX_TASKS & (MAX_TASKS - 1)) == 0, "MAX_TASKS must be a power of 2");
+
+    //Single producer (one core, thread or IRQ) single consumer (the owning core) ring.
+    //Indices run freely and wrap, slots are claimed with tail and released with head.
+    struct TaskRing
     {
-        uint32_t task_id = 0;
-        uint32_t interval_ms = 0;
-        uint64_t target_time = 0;
-        std::function<void()> function = nullptr;
+        std::array<Function, MAX_TASKS> tasks;
+        std::atomic<uint32_t> head{0};
+        std::atomic<uint32_t> tail{0};
+        uint32_t dropped{0}; //Only written by the producing core
     };
 
-    static constexpr uint8_t MAX_TASKS = 8;
-    static constexpr uint8_t MAX_DELAYED_TASKS = MAX_TASKS * 2;
-
     // CoreNum core_num_;
     uint32_t alarm_num_;
     uint32_t new_task_id_ = 1;
@@ -121,13 +137,13 @@ private:
     bool suspended_ = false;
     uint64_t suspended_time_ = 0;
 
-    int spinlock_queue_num_ = spin_lock_claim_unused(true);
     int spinlock_delayed_num_ = spin_lock_claim_unused(true);
-    spin_lock_t* spinlock_queue_ = spin_lock_instance(static_cast<uint>(spinlock_queue_num_));
     spin_lock_t* spinlock_delayed_ = spin_lock_instance(static_cast<uint>(spinlock_delayed_num_));
 
-    std::array<Task, MAX_TASKS> task_queue_;
-    std::array<DelayedTask, MAX_DELAYED_TASKS> task_queue_delayed_;
+    //One ring per producing core so neither core has to lock the other out
+    std::array<TaskRing, NUM_CORES> task_rings_;
+    TimerHeap<Function, MAX_DELAYED_TASKS> task_queue_delayed_;
+    uint32_t dropped_delayed_{0}; //Guarded by spinlock_delayed_
 
     static TaskQueue& get_core0()
     {
@@ -141,15 +157,16 @@ private:
     }
 
     uint32_t get_new_task_id();
-    bool queue_delayed_task(uint32_t task_id, uint32_t delay_ms, bool repeating, const std::function<void()>& function);
+    bool queue_delayed_task(uint32_t task_id, uint32_t delay_ms, bool repeating, const Function& function);
     void cancel_delayed_task(uint32_t task_id);
-    bool queue_task(const std::function<void()>& function);
+    bool queue_task(const Function& function);
     void process_tasks();
+    uint32_t dropped_tasks() const;
 
     void suspend_delayed();
     void resume_delayed();
     void timer_irq_handler();
-    static uint64_t get_time_64_us();
+    void arm_alarm_unsafe();
 
     static inline void timer_irq_wrapper_c0()
     {
@@ -163,20 +180,6 @@ private:
     {
         return timer_hardware_alarm_get_irq_num(timer_hw, alarm_num);
     }
-    static inline int64_t get_next_target_time_unsafe(std::array<DelayedTask, MAX_DELAYED_TASKS>& task_queue_delayed)
-    {
-        auto it = std::min_element(task_queue_delayed.begin(), task_queue_delayed.end(), [](const DelayedTask& a, const DelayedTask& b) 
-        {
-            //Get task with the earliest target time
-            return a.function && (!b.function || a.target_time < b.target_time);
-        });
-
-        if (it != task_queue_delayed.end() && it->function) 
-        {
-            return static_cast<int64_t>(it->target_time);
-        }
-        return -1;
-    }
 
 }; // class TaskQueue
 
@@ -0,0 +1,265 @@
+#ifndef TIMER_HEAP_H
+#define TIMER_HEAP_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <utility>
+
+// Fixed capacity binary min-heap of timers keyed by 64-bit target time.
+// Timers are looked up by task id through a small open addressed table,
+// so insert, cancel and expiry are O(log n) and nothing is scanned linearly.
+// Not thread safe, the owner provides locking.
+template <typename Function, size_t CAPACITY>
+class TimerHeap
+{
+    static_assert(CAPACITY > 0 && CAPACITY < 0xFF, "TimerHeap capacity must fit in a uint8_t index");
+
+public:
+    TimerHeap()
+    {
+        for (uint8_t i = 0; i < CAPACITY; ++i)
+        {
+            free_slots_[i] = i;
+        }
+        id_table_.fill(IdEntry());
+    }
+
+    inline bool empty() const { return count_ == 0; }
+    inline size_t size() const { return count_; }
+    inline bool contains(uint32_t task_id) const { return find_id(task_id) != NOT_FOUND; }
+
+    //Only valid if !empty()
+    inline uint64_t next_target() const { return timers_[heap_[0]].target_time; }
+
+    bool insert(uint32_t task_id, uint64_t target_time, uint64_t interval_us, const Function& function)
+    {
+        if (count_ >= CAPACITY || task_id == 0 || contains(task_id))
+        {
+            return false;
+        }
+
+        const uint8_t slot = free_slots_[CAPACITY - 1 - count_];
+        Timer& timer = timers_[slot];
+        timer.task_id = task_id;
+        timer.interval_us = interval_us;
+        timer.target_time = target_time;
+        timer.function = function;
+
+        insert_id(task_id, slot);
+
+        heap_[count_] = slot;
+        timer.heap_pos = count_;
+        ++count_;
+        sift_up(timer.heap_pos);
+        return true;
+    }
+
+    bool cancel(uint32_t task_id)
+    {
+        const size_t id_pos = find_id(task_id);
+        if (id_pos == NOT_FOUND)
+        {
+            return false;
+        }
+        remove_at(timers_[id_table_[id_pos].slot].heap_pos);
+        return true;
+    }
+
+    //Calls on_expired(function) for every timer due at now, repeating timers are rescheduled
+    template <typename Callback>
+    void pop_expired(uint64_t now, Callback&& on_expired)
+    {
+        while (count_ > 0 && timers_[heap_[0]].target_time <= now)
+        {
+            Timer& timer = timers_[heap_[0]];
+            on_expired(timer.function);
+
+            if (timer.interval_us)
+            {
+                //Skip periods that were missed rather than firing them back to back
+                timer.target_time += timer.interval_us;
+                if (timer.target_time <= now)
+                {
+                    timer.target_time = now + timer.interval_us;
+                }
+                sift_down(0);
+            }
+            else
+            {
+                remove_at(0);
+            }
+        }
+    }
+
+    //Moves every timer by offset_us but no earlier than min_time, then restores heap order
+    void shift_all(uint64_t offset_us, uint64_t min_time)
+    {
+        for (uint8_t i = 0; i < count_; ++i)
+        {
+            Timer& timer = timers_[heap_[i]];
+            timer.target_time += offset_us;
+            if (timer.target_time < min_time)
+            {
+                timer.target_time = min_time;
+            }
+        }
+        for (size_t i = count_ / 2; i-- > 0; )
+        {
+            sift_down(static_cast<uint8_t>(i));
+        }
+    }
+
+private:
+    static constexpr size_t ID_TABLE_SIZE = CAPACITY * 2; //Keeps probe chains short
+    static constexpr size_t NOT_FOUND = ID_TABLE_SIZE;
+
+    struct Timer
+    {
+        uint32_t task_id{0};
+        uint64_t interval_us{0};
+        uint64_t target_time{0};
+        Function function{nullptr};
+        uint8_t heap_pos{0};
+    };
+
+    struct IdEntry
+    {
+        uint32_t task_id{0}; //0 marks an empty entry
+        uint8_t slot{0};
+    };
+
+    std::array<Timer, CAPACITY> timers_;
+    std::array<uint8_t, CAPACITY> heap_;
+    std::array<uint8_t, CAPACITY> free_slots_; //Free slots are the first (CAPACITY - count_) entries
+    std::array<IdEntry, ID_TABLE_SIZE> id_table_;
+    uint8_t count_{0};
+
+    static inline size_t hash(uint32_t task_id)
+    {
+        return (task_id * 2654435761u) % ID_TABLE_SIZE;
+    }
+
+    size_t find_id(uint32_t task_id) const
+    {
+        if (task_id == 0)
+        {
+            return NOT_FOUND;
+        }
+        for (size_t i = hash(task_id), probes = 0; probes < ID_TABLE_SIZE; i = (i + 1) % ID_TABLE_SIZE, ++probes)
+        {
+            if (id_table_[i].task_id == task_id)
+            {
+                return i;
+            }
+            if (id_table_[i].task_id == 0)
+            {
+                break;
+            }
+        }
+        return NOT_FOUND;
+    }
+
+    void insert_id(uint32_t task_id, uint8_t slot)
+    {
+        size_t i = hash(task_id);
+        while (id_table_[i].task_id != 0)
+        {
+            i = (i + 1) % ID_TABLE_SIZE;
+        }
+        id_table_[i] = { task_id, slot };
+    }
+
+    //Backward shift deletion, keeps probe chains intact without tombstones
+    void erase_id(size_t pos)
+    {
+        size_t next = (pos + 1) % ID_TABLE_SIZE;
+        while (id_table_[next].task_id != 0)
+        {
+            const size_t home = hash(id_table_[next].task_id);
+            //Move the entry back if its home is not cyclically within (pos, next]
+            const bool in_range = (pos <= next) ? (pos < home && home <= next) : (pos < home || home <= next);
+            if (!in_range)
+            {
+                id_table_[pos] = id_table_[next];
+                pos = next;
+            }
+            next = (next + 1) % ID_TABLE_SIZE;
+        }
+        id_table_[pos] = IdEntry();
+    }
+
+    void remove_at(uint8_t heap_pos)
+    {
+        const uint8_t slot = heap_[heap_pos];
+        Timer& timer = timers_[slot];
+
+        erase_id(find_id(timer.task_id));
+        timer.function = nullptr;
+        timer.task_id = 0;
+
+        --count_;
+        free_slots_[CAPACITY - 1 - count_] = slot;
+
+        if (heap_pos != count_)
+        {
+            heap_[heap_pos] = heap_[count_];
+            timers_[heap_[heap_pos]].heap_pos = heap_pos;
+            sift_down(heap_pos);
+            sift_up(heap_pos);
+        }
+    }
+
+    inline bool earlier(uint8_t a, uint8_t b) const
+    {
+        return timers_[heap_[a]].target_time < timers_[heap_[b]].target_time;
+    }
+
+    inline void swap_nodes(uint8_t a, uint8_t b)
+    {
+        std::swap(heap_[a], heap_[b]);
+        timers_[heap_[a]].heap_pos = a;
+        timers_[heap_[b]].heap_pos = b;
+    }
+
+    void sift_up(uint8_t pos)
+    {
+        while (pos > 0)
+        {
+            const uint8_t parent = (pos - 1) / 2;
+            if (!earlier(pos, parent))
+            {
+                break;
+            }
+            swap_nodes(pos, parent);
+            pos = parent;
+        }
+    }
+
+    void sift_down(uint8_t pos)
+    {
+        while (true)
+        {
+            const size_t left = pos * 2 + 1;
+            const size_t right = left + 1;
+            uint8_t smallest = pos;
+
+            if (left < count_ && earlier(static_cast<uint8_t>(left), smallest))
+            {
+                smallest = static_cast<uint8_t>(left);
+            }
+            if (right < count_ && earlier(static_cast<uint8_t>(right), smallest))
+            {
+                smallest = static_cast<uint8_t>(right);
+            }
+            if (smallest == pos)
+            {
+                break;
+            }
+            swap_nodes(pos, smallest);
+            pos = smallest;
+        }
+    }
+};
+
+#endif // TIMER_HEAP_H
@@ -0,0 +1,111 @@
+#ifndef _BUTTON_TABLE_H_
+#define _BUTTON_TABLE_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+#include "Gamepad/Gamepad.h"
+
+// Compile time Gamepad to device report button translation. A driver lists the report bits
+// each Gamepad::BUTTON_* sets and Scatter bakes that into one lookup per nibble of the button
+// mask, so a report's buttons are four loads and ORs instead of a branch per button.
+// Dpad tables do the same for the 16 Gamepad::DPAD_* bit patterns.
+namespace ButtonTable
+{
+    template<typename T>
+    struct Map
+    {
+        uint16_t gp_mask;
+        T out_mask;
+    };
+
+    //out_mask for bits in byte idx of a report's button byte array, see to_bytes()
+    template<typename T>
+    constexpr T byte_bits(uint8_t idx, uint8_t mask)
+    {
+        return static_cast<T>(static_cast<T>(mask) << (idx * 8));
+    }
+
+    template<typename T>
+    class Scatter
+    {
+    public:
+        template<size_t N>
+        constexpr Scatter(const Map<T> (&maps)[N])
+        {
+            for (size_t nibble = 0; nibble < NIBBLES; ++nibble)
+            {
+                for (size_t value = 0; value < 16; ++value)
+                {
+                    const uint16_t gp_bits = static_cast<uint16_t>(value << (nibble * 4));
+                    T out = 0;
+                    for (const Map<T>& map : maps)
+                    {
+                        if (map.gp_mask & gp_bits)
+                        {
+                            out |= map.out_mask;
+                        }
+                    }
+                    tables_[nibble][value] = out;
+                }
+            }
+        }
+
+        constexpr T operator()(uint16_t buttons) const
+        {
+            return static_cast<T>(tables_[0][buttons & 0xF] | tables_[1][(buttons >> 4) & 0xF] |
+                                  tables_[2][(buttons >> 8) & 0xF] | tables_[3][buttons >> 12]);
+        }
+
+    private:
+        static constexpr size_t NIBBLES = 4;
+        std::array<std::array<T, 16>, NIBBLES> tables_{};
+    };
+
+    //Report value for each Gamepad::DPAD_* bit pattern, opposite directions held together get none
+    template<typename T>
+    constexpr std::array<T, 16> dpad_values(T up, T up_right, T right, T down_right,
+                                            T down, T down_left, T left, T up_left, T none)
+    {
+        std::array<T, 16> table{};
+        table.fill(none);
+        table[Gamepad::DPAD_UP]         = up;
+        table[Gamepad::DPAD_UP_RIGHT]   = up_right;
+        table[Gamepad::DPAD_RIGHT]      = right;
+        table[Gamepad::DPAD_DOWN_RIGHT] = down_right;
+        table[Gamepad::DPAD_DOWN]       = down;
+        table[Gamepad::DPAD_DOWN_LEFT]  = down_left;
+        table[Gamepad::DPAD_LEFT]       = left;
+        table[Gamepad::DPAD_UP_LEFT]    = up_left;
+        return table;
+    }
+
+    //For reports with a bit per direction
+    template<typename T>
+    constexpr std::array<T, 16> dpad_bits(T up, T down, T left, T right)
+    {
+        return dpad_values<T>(up, static_cast<T>(up | right), right, static_cast<T>(down | right),
+                              down, static_cast<T>(down | left), left, static_cast<T>(up | left), 0);
+    }
+
+    //Gamepad dpad only uses the low 4 bits
+    template<typename T>
+    constexpr T dpad(const std::array<T, 16>& table, uint8_t dpad)
+    {
+        return table[dpad & 0x0F];
+    }
+
+    //Writes a byte_bits() based value to a report's button bytes, byte 0 first
+    template<typename T, size_t N>
+    inline void to_bytes(T bits, uint8_t (&bytes)[N])
+    {
+        static_assert(N <= sizeof(T), "ButtonTable value is narrower than the report's button bytes");
+        for (size_t i = 0; i < N; ++i)
+        {
+            bytes[i] = static_cast<uint8_t>(bits >> (i * 8));
+        }
+    }
+}
+
+#endif // _BUTTON_TABLE_H_
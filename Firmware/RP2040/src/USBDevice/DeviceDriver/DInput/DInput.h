@@ -8,7 +8,7 @@
 #include "USBDevice/DeviceDriver/DeviceDriver.h"
 #include "Descriptors/DInput.h"
 
-class DInputDevice : public DeviceDriver 
+class DInputDevice final : public DeviceDriver 
 {
 public:
     void initialize() override;
@@ -2,6 +2,19 @@
 #include "bsp/board_api.h"
 #include "USBDevice/DeviceDriver/DeviceDriver.h"
 
+bool DeviceDriver::report_complete(const uint8_t idx, Gamepad& gamepad)
+{
+    report_age_.complete(idx);
+
+#if defined(CONFIG_EN_PULL_REPORTS)
+    //The endpoint is free right now, send the newest pad input instead of waiting for the next loop pass
+    return gamepad.new_pad_in();
+#else
+    (void)gamepad;
+    return false;
+#endif
+}
+
 uint16_t* DeviceDriver::get_string_descriptor(const char* value, uint8_t index)
 {
     static uint16_t string_desc_buffer[32];
@@ -8,6 +8,7 @@
 #include "device/usbd_pvt.h"
 
 #include "Gamepad/Gamepad.h"
+#include "USBDevice/DeviceDriver/ReportAge.h"
 
 #if CFG_TUSB_DEBUG >= CFG_TUD_LOG_LEVEL
     #define TUD_DRV_NAME(name) name
@@ -31,8 +32,17 @@ public:
     
     const usbd_class_driver_t* get_class_driver() { return &class_driver_; };
 
+    //TinyUSB calls class driver SOF handlers from the USB IRQ, once SOF is enabled with tud_sof_cb_enable()
+    void set_sof_cb(void (*sof)(uint8_t rhport, uint32_t frame_count)) { class_driver_.sof = sof; }
+
+    //IN transfer of gamepad idx's report completed, true if the next report should be built right
+    //away (EN_PULL_REPORTS), DeviceManager calls process() so it doesn't go through the vtable
+    bool report_complete(const uint8_t idx, Gamepad& gamepad);
+    void log_report_age() const { report_age_.log_stats(); }
+
 protected:
     usbd_class_driver_t class_driver_;
+    ReportAge report_age_;
 
     uint16_t* get_string_descriptor(const char* value, uint8_t index);
 };
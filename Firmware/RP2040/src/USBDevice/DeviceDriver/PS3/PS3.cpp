@@ -2,6 +2,29 @@
 #include <algorithm>
 
 #include "USBDevice/DeviceDriver/PS3/PS3.h"
+#include "USBDevice/DeviceDriver/ButtonTable.h"
+
+static constexpr ButtonTable::Scatter<uint32_t> BUTTON_MAP(
+{
+    {Gamepad::BUTTON_X,     ButtonTable::byte_bits<uint32_t>(1, PS3::Buttons1::SQUARE)},
+    {Gamepad::BUTTON_A,     ButtonTable::byte_bits<uint32_t>(1, PS3::Buttons1::CROSS)},
+    {Gamepad::BUTTON_Y,     ButtonTable::byte_bits<uint32_t>(1, PS3::Buttons1::TRIANGLE)},
+    {Gamepad::BUTTON_B,     ButtonTable::byte_bits<uint32_t>(1, PS3::Buttons1::CIRCLE)},
+    {Gamepad::BUTTON_LB,    ButtonTable::byte_bits<uint32_t>(1, PS3::Buttons1::L1)},
+    {Gamepad::BUTTON_RB,    ButtonTable::byte_bits<uint32_t>(1, PS3::Buttons1::R1)},
+    {Gamepad::BUTTON_BACK,  ButtonTable::byte_bits<uint32_t>(0, PS3::Buttons0::SELECT)},
+    {Gamepad::BUTTON_START, ButtonTable::byte_bits<uint32_t>(0, PS3::Buttons0::START)},
+    {Gamepad::BUTTON_L3,    ButtonTable::byte_bits<uint32_t>(0, PS3::Buttons0::L3)},
+    {Gamepad::BUTTON_R3,    ButtonTable::byte_bits<uint32_t>(0, PS3::Buttons0::R3)},
+    {Gamepad::BUTTON_SYS,   ButtonTable::byte_bits<uint32_t>(2, PS3::Buttons2::SYS)},
+    {Gamepad::BUTTON_MISC,  ButtonTable::byte_bits<uint32_t>(2, PS3::Buttons2::TP)},
+});
+
+static constexpr auto DPAD_MAP = ButtonTable::dpad_bits<uint32_t>(
+    ButtonTable::byte_bits<uint32_t>(0, PS3::Buttons0::DPAD_UP),
+    ButtonTable::byte_bits<uint32_t>(0, PS3::Buttons0::DPAD_DOWN),
+    ButtonTable::byte_bits<uint32_t>(0, PS3::Buttons0::DPAD_LEFT),
+    ButtonTable::byte_bits<uint32_t>(0, PS3::Buttons0::DPAD_RIGHT));
 
 void PS3Device::initialize() 
 {
@@ -22,51 +45,11 @@ void PS3Device::process(const uint8_t idx, Gamepad& gamepad)
 {
     if (gamepad.new_pad_in())
     {
+        report_age_.built(idx, gamepad.pad_in_time_us());
         Gamepad::PadIn gp_in = gamepad.get_pad_in();
         report_in_ = PS3::InReport();
 
-        switch (gp_in.dpad)
-        {
-            case Gamepad::DPAD_UP:
-                report_in_.buttons[0] = PS3::Buttons0::DPAD_UP;
-                break;
-            case Gamepad::DPAD_DOWN:
-                report_in_.buttons[0] = PS3::Buttons0::DPAD_DOWN;
-                break;
-            case Gamepad::DPAD_LEFT:
-                report_in_.buttons[0] = PS3::Buttons0::DPAD_LEFT;
-                break;
-            case Gamepad::DPAD_RIGHT:
-                report_in_.buttons[0] = PS3::Buttons0::DPAD_RIGHT;
-                break;
-            case Gamepad::DPAD_UP_LEFT:
-                report_in_.buttons[0] = PS3::Buttons0::DPAD_UP | PS3::Buttons0::DPAD_LEFT;
-                break;
-            case Gamepad::DPAD_UP_RIGHT:
-                report_in_.buttons[0] = PS3::Buttons0::DPAD_UP | PS3::Buttons0::DPAD_RIGHT;
-                break;
-            case Gamepad::DPAD_DOWN_LEFT:
-                report_in_.buttons[0] = PS3::Buttons0::DPAD_DOWN | PS3::Buttons0::DPAD_LEFT;
-                break;
-            case Gamepad::DPAD_DOWN_RIGHT:
-                report_in_.buttons[0] = PS3::Buttons0::DPAD_DOWN | PS3::Buttons0::DPAD_RIGHT;
-                break;
-            default:
-                break;
-        }
-
-        if (gp_in.buttons & Gamepad::BUTTON_X)        report_in_.buttons[1] |= PS3::Buttons1::SQUARE;
-        if (gp_in.buttons & Gamepad::BUTTON_A)        report_in_.buttons[1] |= PS3::Buttons1::CROSS;
-        if (gp_in.buttons & Gamepad::BUTTON_Y)        report_in_.buttons[1] |= PS3::Buttons1::TRIANGLE;
-        if (gp_in.buttons & Gamepad::BUTTON_B)        report_in_.buttons[1] |= PS3::Buttons1::CIRCLE;
-        if (gp_in.buttons & Gamepad::BUTTON_LB)       report_in_.buttons[1] |= PS3::Buttons1::L1;
-        if (gp_in.buttons & Gamepad::BUTTON_RB)       report_in_.buttons[1] |= PS3::Buttons1::R1;
-        if (gp_in.buttons & Gamepad::BUTTON_BACK)     report_in_.buttons[0] |= PS3::Buttons0::SELECT;
-        if (gp_in.buttons & Gamepad::BUTTON_START)    report_in_.buttons[0] |= PS3::Buttons0::START;
-        if (gp_in.buttons & Gamepad::BUTTON_L3)       report_in_.buttons[0] |= PS3::Buttons0::L3;
-        if (gp_in.buttons & Gamepad::BUTTON_R3)       report_in_.buttons[0] |= PS3::Buttons0::R3;
-        if (gp_in.buttons & Gamepad::BUTTON_SYS)      report_in_.buttons[2] |= PS3::Buttons2::SYS;
-        if (gp_in.buttons & Gamepad::BUTTON_MISC)     report_in_.buttons[2] |= PS3::Buttons2::TP;
+        ButtonTable::to_bytes(BUTTON_MAP(gp_in.buttons) | ButtonTable::dpad(DPAD_MAP, gp_in.dpad), report_in_.buttons);
 
         if (gp_in.trigger_l) report_in_.buttons[1] |= PS3::Buttons1::L2;
         if (gp_in.trigger_r) report_in_.buttons[1] |= PS3::Buttons1::R2;
@@ -113,10 +96,11 @@ void PS3Device::process(const uint8_t idx, Gamepad& gamepad)
         tud_remote_wakeup();
     }
 
-    if (tud_hid_ready())
+    //PS3 seems to start using stale data if a report isn't sent every frame
+    if (tud_hid_ready() &&
+        tud_hid_report(0, reinterpret_cast<uint8_t*>(&report_in_), sizeof(PS3::InReport)))
     {
-        //PS3 seems to start using stale data if a report isn't sent every frame
-        tud_hid_report(0, reinterpret_cast<uint8_t*>(&report_in_), sizeof(PS3::InReport));
+        report_age_.queued(idx);
     }
 
     if (new_report_out_)
@@ -7,7 +7,7 @@
 #include "USBDevice/DeviceDriver/DeviceDriver.h"
 #include "Descriptors/PS3.h"
 
-class PS3Device : public DeviceDriver 
+class PS3Device final : public DeviceDriver 
 {
 public:
     void initialize() override;
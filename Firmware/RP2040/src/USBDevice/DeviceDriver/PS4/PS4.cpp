@@ -139,6 +139,7 @@ void PS4Device::process(const uint8_t idx, Gamepad& gamepad)
     static bool     psActive          = false;
     static constexpr uint32_t PS_MS   = 350;
 
+    report_age_.built(idx, gamepad.pad_in_time_us());
     Gamepad::PadIn gp_in = gamepad.get_pad_in();
     const uint16_t btn   = gp_in.buttons;
 
@@ -285,13 +286,14 @@ void PS4Device::process(const uint8_t idx, Gamepad& gamepad)
         tud_remote_wakeup();
     }
 
-    if (tud_hid_ready())
-    {
+    if (tud_hid_ready() &&
         tud_hid_report(
             0, 
             reinterpret_cast<uint8_t*>(&report_in_),
             sizeof(PS4Dev::InReport)
-        );
+        ))
+    {
+        report_age_.queued(idx);
     }
 }
 
@@ -7,7 +7,7 @@
 #include "USBDevice/DeviceDriver/DeviceDriver.h"
 #include "Descriptors/PS4Device.h"
 
-class PS4Device : public DeviceDriver
+class PS4Device final : public DeviceDriver
 {
 public:
     void initialize() override;
@@ -1,6 +1,25 @@
 #include <cstring>
 
 #include "USBDevice/DeviceDriver/PSClassic/PSClassic.h"
+#include "USBDevice/DeviceDriver/ButtonTable.h"
+
+static constexpr ButtonTable::Scatter<uint16_t> BUTTON_MAP(
+{
+    {Gamepad::BUTTON_A,     PSClassic::Buttons::CROSS},
+    {Gamepad::BUTTON_B,     PSClassic::Buttons::CIRCLE},
+    {Gamepad::BUTTON_X,     PSClassic::Buttons::SQUARE},
+    {Gamepad::BUTTON_Y,     PSClassic::Buttons::TRIANGLE},
+    {Gamepad::BUTTON_LB,    PSClassic::Buttons::L1},
+    {Gamepad::BUTTON_RB,    PSClassic::Buttons::R1},
+    {Gamepad::BUTTON_BACK,  PSClassic::Buttons::SELECT},
+    {Gamepad::BUTTON_START, PSClassic::Buttons::START},
+});
+
+//The dpad is a field in the button word rather than a bit per direction
+static constexpr auto DPAD_MAP = ButtonTable::dpad_values<uint16_t>(
+    PSClassic::Buttons::UP, PSClassic::Buttons::UP_RIGHT, PSClassic::Buttons::RIGHT, PSClassic::Buttons::DOWN_RIGHT,
+    PSClassic::Buttons::DOWN, PSClassic::Buttons::DOWN_LEFT, PSClassic::Buttons::LEFT, PSClassic::Buttons::UP_LEFT,
+    PSClassic::Buttons::CENTER);
 
 void PSClassicDevice::initialize()
 {
@@ -21,37 +40,9 @@ void PSClassicDevice::process(const uint8_t idx, Gamepad& gamepad)
 {
     if (gamepad.new_pad_in())
     {
+        report_age_.built(idx, gamepad.pad_in_time_us());
         Gamepad::PadIn gp_in = gamepad.get_pad_in();
-        switch (gp_in.dpad)
-        {
-            case Gamepad::DPAD_UP:
-                in_report_.buttons = PSClassic::Buttons::UP;
-                break;
-            case Gamepad::DPAD_DOWN:
-                in_report_.buttons = PSClassic::Buttons::DOWN;
-                break;
-            case Gamepad::DPAD_LEFT:
-                in_report_.buttons = PSClassic::Buttons::LEFT;
-                break;
-            case Gamepad::DPAD_RIGHT:
-                in_report_.buttons = PSClassic::Buttons::RIGHT;
-                break;
-            case Gamepad::DPAD_UP_LEFT:
-                in_report_.buttons = PSClassic::Buttons::UP_LEFT;
-                break;
-            case Gamepad::DPAD_UP_RIGHT:
-                in_report_.buttons = PSClassic::Buttons::UP_RIGHT;
-                break;
-            case Gamepad::DPAD_DOWN_LEFT:
-                in_report_.buttons = PSClassic::Buttons::DOWN_LEFT;
-                break;
-            case Gamepad::DPAD_DOWN_RIGHT:
-                in_report_.buttons = PSClassic::Buttons::DOWN_RIGHT;
-                break;
-            default:
-                in_report_.buttons = PSClassic::Buttons::CENTER;
-                break;
-        }
+        in_report_.buttons = ButtonTable::dpad(DPAD_MAP, gp_in.dpad);
 
         int16_t joy_lx = gp_in.joystick_lx;
         int16_t joy_ly = Range::invert(gp_in.joystick_ly);
@@ -97,14 +88,7 @@ void PSClassicDevice::process(const uint8_t idx, Gamepad& gamepad)
             in_report_.buttons = PSClassic::Buttons::UP;
         }
 
-        if (gp_in.buttons & Gamepad::BUTTON_A) in_report_.buttons |= PSClassic::Buttons::CROSS;
-        if (gp_in.buttons & Gamepad::BUTTON_B) in_report_.buttons |= PSClassic::Buttons::CIRCLE;
-        if (gp_in.buttons & Gamepad::BUTTON_X) in_report_.buttons |= PSClassic::Buttons::SQUARE;
-        if (gp_in.buttons & Gamepad::BUTTON_Y) in_report_.buttons |= PSClassic::Buttons::TRIANGLE;
-        if (gp_in.buttons & Gamepad::BUTTON_LB)    in_report_.buttons |= PSClassic::Buttons::L1;
-        if (gp_in.buttons & Gamepad::BUTTON_RB)    in_report_.buttons |= PSClassic::Buttons::R1;
-        if (gp_in.buttons & Gamepad::BUTTON_BACK)  in_report_.buttons |= PSClassic::Buttons::SELECT;
-        if (gp_in.buttons & Gamepad::BUTTON_START) in_report_.buttons |= PSClassic::Buttons::START;
+        in_report_.buttons |= BUTTON_MAP(gp_in.buttons);
         
         if (gp_in.trigger_l) in_report_.buttons |= PSClassic::Buttons::L2;
         if (gp_in.trigger_r) in_report_.buttons |= PSClassic::Buttons::R2;
@@ -114,9 +98,10 @@ void PSClassicDevice::process(const uint8_t idx, Gamepad& gamepad)
     {
         tud_remote_wakeup();
     }
-    if (tud_hid_n_ready(idx))
+    if (tud_hid_n_ready(idx) &&
+        tud_hid_n_report(idx, 0, reinterpret_cast<uint8_t*>(&in_report_), sizeof(PSClassic::InReport)))
     {
-        tud_hid_n_report(idx, 0, reinterpret_cast<uint8_t*>(&in_report_), sizeof(PSClassic::InReport));
+        report_age_.queued(idx);
     }
 }
 
@@ -8,7 +8,7 @@
 #include "Descriptors/PSClassic.h"
 #include "USBDevice/DeviceDriver/DeviceDriver.h"
 
-class PSClassicDevice : public DeviceDriver
+class PSClassicDevice final : public DeviceDriver
 {
 public:
     void initialize() override;
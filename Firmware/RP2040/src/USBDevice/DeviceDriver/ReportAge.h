@@ -0,0 +1,79 @@
+#ifndef _REPORT_AGE_H_
+#define _REPORT_AGE_H_
+
+#include <cstdint>
+#include <array>
+#include <algorithm>
+
+#include "Board/Config.h"
+#include "Board/board_api.h"
+#include "Board/ogxm_log.h"
+
+// Age of the pad input in a device report at the moment the console takes it, from the
+// input's Gamepad::pad_in_time_us() to the IN transfer completing. New input also goes to
+// board_api::latency the first time it's queued, whichever driver is running. Core0 only.
+class ReportAge
+{
+public:
+    //Pad input from pad_in_us is now in gamepad idx's report, fresh if it's new since the last one queued
+    inline void built(uint8_t idx, uint32_t pad_in_us, bool fresh = true)
+    {
+        if (idx < MAX_GAMEPADS)
+        {
+            built_us_[idx] = pad_in_us;
+            fresh_[idx] = fresh_[idx] || fresh;
+        }
+    }
+
+    //The report was queued on the IN endpoint
+    inline void queued(uint8_t idx)
+    {
+        if (idx < MAX_GAMEPADS)
+        {
+            in_flight_us_[idx] = built_us_[idx];
+            if (fresh_[idx])
+            {
+                fresh_[idx] = false;
+                board_api::latency::record(built_us_[idx]);
+            }
+        }
+    }
+
+    //The IN transfer completed, the console has the report
+    inline void complete(uint8_t idx)
+    {
+        if (idx >= MAX_GAMEPADS || in_flight_us_[idx] == 0)
+        {
+            return;
+        }
+        const uint32_t age_us = board_api::us_since_boot() - in_flight_us_[idx];
+        in_flight_us_[idx] = 0;
+
+        size_t i = 0;
+        while (i < BUCKET_US.size() && age_us > BUCKET_US[i])
+        {
+            ++i;
+        }
+        ++buckets_[i];
+        max_us_ = std::max(max_us_, age_us);
+    }
+
+    void log_stats() const
+    {
+        OGXM_LOG("Report age at transmit (us) <=250: %u, <=500: %u, <=1000: %u, <=2000: %u, <=4000: %u, <=8000: %u, <=16000: %u, >16000: %u, max: %u\n",
+            buckets_[0], buckets_[1], buckets_[2], buckets_[3], buckets_[4], buckets_[5], buckets_[6], buckets_[7], 
+            static_cast<unsigned int>(max_us_));
+    }
+
+private:
+    //Upper bound of each bucket in us, the last bucket catches everything above
+    static constexpr std::array<uint32_t, 7> BUCKET_US = { 250, 500, 1000, 2000, 4000, 8000, 16000 };
+
+    std::array<unsigned int, BUCKET_US.size() + 1> buckets_{0};
+    uint32_t max_us_{0};
+    uint32_t built_us_[MAX_GAMEPADS]{0};
+    uint32_t in_flight_us_[MAX_GAMEPADS]{0}; //0 when nothing is in flight or the report has no pad input yet
+    bool fresh_[MAX_GAMEPADS]{false};
+};
+
+#endif // _REPORT_AGE_H_
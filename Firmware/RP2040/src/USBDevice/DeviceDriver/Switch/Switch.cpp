@@ -1,6 +1,28 @@
 #include <cstring>
 
 #include "USBDevice/DeviceDriver/Switch/Switch.h"
+#include "USBDevice/DeviceDriver/ButtonTable.h"
+
+static constexpr ButtonTable::Scatter<uint16_t> BUTTON_MAP(
+{
+    {Gamepad::BUTTON_X,     SwitchWired::Buttons::Y},
+    {Gamepad::BUTTON_A,     SwitchWired::Buttons::B},
+    {Gamepad::BUTTON_Y,     SwitchWired::Buttons::X},
+    {Gamepad::BUTTON_B,     SwitchWired::Buttons::A},
+    {Gamepad::BUTTON_LB,    SwitchWired::Buttons::L},
+    {Gamepad::BUTTON_RB,    SwitchWired::Buttons::R},
+    {Gamepad::BUTTON_BACK,  SwitchWired::Buttons::MINUS},
+    {Gamepad::BUTTON_START, SwitchWired::Buttons::PLUS},
+    {Gamepad::BUTTON_L3,    SwitchWired::Buttons::L3},
+    {Gamepad::BUTTON_R3,    SwitchWired::Buttons::R3},
+    {Gamepad::BUTTON_SYS,   SwitchWired::Buttons::HOME},
+    {Gamepad::BUTTON_MISC,  SwitchWired::Buttons::CAPTURE},
+});
+
+static constexpr auto DPAD_MAP = ButtonTable::dpad_values<uint8_t>(
+    SwitchWired::DPad::UP, SwitchWired::DPad::UP_RIGHT, SwitchWired::DPad::RIGHT, SwitchWired::DPad::DOWN_RIGHT,
+    SwitchWired::DPad::DOWN, SwitchWired::DPad::DOWN_LEFT, SwitchWired::DPad::LEFT, SwitchWired::DPad::UP_LEFT,
+    SwitchWired::DPad::CENTER);
 
 void SwitchDevice::initialize() 
 {
@@ -25,53 +47,11 @@ void SwitchDevice::process(const uint8_t idx, Gamepad& gamepad)
 
     if (gamepad.new_pad_in())
     {
+        report_age_.built(idx, gamepad.pad_in_time_us());
         Gamepad::PadIn gp_in = gamepad.get_pad_in();
     
-        switch (gp_in.dpad)
-        {
-            case Gamepad::DPAD_UP:
-                in_report.dpad = SwitchWired::DPad::UP;
-                break;
-            case Gamepad::DPAD_DOWN:
-                in_report.dpad = SwitchWired::DPad::DOWN;
-                break;
-            case Gamepad::DPAD_LEFT:
-                in_report.dpad = SwitchWired::DPad::LEFT;
-                break;
-            case Gamepad::DPAD_RIGHT:
-                in_report.dpad = SwitchWired::DPad::RIGHT;
-                break;
-            case Gamepad::DPAD_UP_LEFT:
-                in_report.dpad = SwitchWired::DPad::UP_LEFT;
-                break;
-            case Gamepad::DPAD_UP_RIGHT:
-                in_report.dpad = SwitchWired::DPad::UP_RIGHT;
-                break;
-            case Gamepad::DPAD_DOWN_LEFT:
-                in_report.dpad = SwitchWired::DPad::DOWN_LEFT;
-                break;
-            case Gamepad::DPAD_DOWN_RIGHT:
-                in_report.dpad = SwitchWired::DPad::DOWN_RIGHT;
-                break;
-            default:
-                in_report.dpad = SwitchWired::DPad::CENTER;
-                break;
-        }
-
-        in_report.buttons = 0;
-
-        if (gp_in.buttons & Gamepad::BUTTON_X)        in_report.buttons |= SwitchWired::Buttons::Y;
-        if (gp_in.buttons & Gamepad::BUTTON_A)        in_report.buttons |= SwitchWired::Buttons::B;
-        if (gp_in.buttons & Gamepad::BUTTON_Y)        in_report.buttons |= SwitchWired::Buttons::X;
-        if (gp_in.buttons & Gamepad::BUTTON_B)        in_report.buttons |= SwitchWired::Buttons::A;
-        if (gp_in.buttons & Gamepad::BUTTON_LB)       in_report.buttons |= SwitchWired::Buttons::L;
-        if (gp_in.buttons & Gamepad::BUTTON_RB)       in_report.buttons |= SwitchWired::Buttons::R;
-        if (gp_in.buttons & Gamepad::BUTTON_BACK)     in_report.buttons |= SwitchWired::Buttons::MINUS;
-        if (gp_in.buttons & Gamepad::BUTTON_START)    in_report.buttons |= SwitchWired::Buttons::PLUS;
-        if (gp_in.buttons & Gamepad::BUTTON_L3)       in_report.buttons |= SwitchWired::Buttons::L3;
-        if (gp_in.buttons & Gamepad::BUTTON_R3)       in_report.buttons |= SwitchWired::Buttons::R3;
-        if (gp_in.buttons & Gamepad::BUTTON_SYS)      in_report.buttons |= SwitchWired::Buttons::HOME;
-        if (gp_in.buttons & Gamepad::BUTTON_MISC)     in_report.buttons |= SwitchWired::Buttons::CAPTURE;
+        in_report.dpad = ButtonTable::dpad(DPAD_MAP, gp_in.dpad);
+        in_report.buttons = BUTTON_MAP(gp_in.buttons);
 
         if (gp_in.trigger_l) in_report.buttons |= SwitchWired::Buttons::ZL;
         if (gp_in.trigger_r) in_report.buttons |= SwitchWired::Buttons::ZR;
@@ -86,9 +66,10 @@ void SwitchDevice::process(const uint8_t idx, Gamepad& gamepad)
     {
 		tud_remote_wakeup();
     }
-	if (tud_hid_n_ready(idx))
+	if (tud_hid_n_ready(idx) &&
+        tud_hid_n_report(idx, 0, reinterpret_cast<uint8_t*>(&in_report), sizeof(SwitchWired::InReport)))
     {
-        tud_hid_n_report(idx, 0, reinterpret_cast<uint8_t*>(&in_report), sizeof(SwitchWired::InReport));
+        report_age_.queued(idx);
     }
 }
 
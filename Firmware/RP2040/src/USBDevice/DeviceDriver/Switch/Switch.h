@@ -7,7 +7,7 @@
 #include "USBDevice/DeviceDriver/DeviceDriver.h"
 #include "Descriptors/SwitchWired.h"
 
-class SwitchDevice : public DeviceDriver 
+class SwitchDevice final : public DeviceDriver 
 {
 public:
     void initialize() override;
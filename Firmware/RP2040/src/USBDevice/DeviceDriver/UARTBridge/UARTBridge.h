@@ -5,7 +5,7 @@
 #include "UserSettings/UserProfile.h"
 
 //process() only needs to be called once to start the UART bridge
-class UARTBridgeDevice : public DeviceDriver 
+class UARTBridgeDevice final : public DeviceDriver 
 {
 public:
     void initialize() override;
@@ -4,6 +4,13 @@
 #include "Board/ogxm_log.h"
 #include "Descriptors/CDCDev.h"
 #include "USBDevice/DeviceDriver/WebApp/WebApp.h"
+#if defined(CONFIG_EN_REPORT_CAPTURE)
+#include "USBHost/ReportCapture.h"
+#endif
+#if defined(CONFIG_EN_USB_HOST)
+#include "USBHost/ConnectTimeline.h"
+#include "USBHost/FrameSync.h"
+#endif
 
 void WebAppDevice::initialize() 
 {
@@ -212,6 +219,117 @@ bool WebAppDevice::write_gamepad(uint8_t index, const Gamepad::PadIn& pad_in)
     return true;
 }
 
+//Sends the host report capture and starts a new one, an empty dump if capture isn't built in
+bool WebAppDevice::write_capture()
+{
+    Packet packet_in;
+    packet_in.header.packet_id = PacketID::GET_CAPTURE;
+    packet_in.header.max_gamepads = MAX_GAMEPADS;
+
+#if defined(CONFIG_EN_REPORT_CAPTURE)
+    static_assert((sizeof(ReportCapture::DumpHeader) + (ReportCapture::MAX_RECORDS - 1) * sizeof(ReportCapture::Record) + 
+                   sizeof(Packet::data) - 1) / sizeof(Packet::data) <= UINT8_MAX, "Report capture doesn't fit in a chunked packet stream");
+
+    ReportCapture::freeze();
+    const size_t dump_size = ReportCapture::dump_size();
+    const uint8_t total_chunks = static_cast<uint8_t>((dump_size + packet_in.data.size() - 1) / packet_in.data.size());
+    uint8_t current_chunk = 0;
+
+    OGXM_LOG("Writing report capture, %u bytes\n", static_cast<unsigned int>(dump_size));
+
+    packet_in.header.chunks_total = total_chunks;
+
+    while (current_chunk < total_chunks)
+    {
+        size_t offset = current_chunk * packet_in.data.size();
+
+        packet_in.header.chunk_idx = current_chunk;
+        packet_in.header.chunk_len = static_cast<uint8_t>(ReportCapture::read_dump(offset, packet_in.data.data(), packet_in.data.size()));
+
+        if (!write_packet(packet_in))
+        {
+            OGXM_LOG("Failed to write report capture packet\n");
+            return false;
+        }
+        current_chunk++;
+    }
+
+    ReportCapture::resume();
+    return true;
+#else
+    packet_in.header.chunks_total = 0;
+    return write_packet(packet_in);
+#endif
+}
+
+//Sends the last few host connect timelines as a count byte followed by the entries oldest first,
+//an empty response if USB host isn't built in
+bool WebAppDevice::write_connect_times()
+{
+    Packet packet_in;
+    packet_in.header.packet_id = PacketID::GET_CONNECT_TIMES;
+    packet_in.header.max_gamepads = MAX_GAMEPADS;
+
+#if defined(CONFIG_EN_USB_HOST)
+    uint8_t buffer[1 + ConnectTimeline::MAX_ENTRIES * sizeof(ConnectTimeline::Entry)];
+    ConnectTimeline::Entry entries[ConnectTimeline::MAX_ENTRIES];
+
+    const uint8_t count = ConnectTimeline::read(entries, ConnectTimeline::MAX_ENTRIES);
+    const size_t data_len = 1 + count * sizeof(ConnectTimeline::Entry);
+    buffer[0] = count;
+    std::memcpy(buffer + 1, entries, count * sizeof(ConnectTimeline::Entry));
+
+    const uint8_t total_chunks = static_cast<uint8_t>((data_len + packet_in.data.size() - 1) / packet_in.data.size());
+    uint8_t current_chunk = 0;
+
+    packet_in.header.chunks_total = total_chunks;
+
+    while (current_chunk < total_chunks)
+    {
+        size_t offset = current_chunk * packet_in.data.size();
+        size_t remaining = data_len - offset;
+        uint8_t current_chunk_len = static_cast<uint8_t>(std::min(remaining, packet_in.data.size()));
+
+        packet_in.header.chunk_idx = current_chunk;
+        packet_in.header.chunk_len = current_chunk_len;
+
+        std::memcpy(packet_in.data.data(), buffer + offset, current_chunk_len);
+
+        if (!write_packet(packet_in))
+        {
+            OGXM_LOG("Failed to write connect times packet\n");
+            return false;
+        }
+        current_chunk++;
+    }
+    return true;
+#else
+    packet_in.header.chunks_total = 0;
+    return write_packet(packet_in);
+#endif
+}
+
+//Sends FrameSync::Stats in one packet, an empty response if USB host isn't built in
+bool WebAppDevice::write_frame_sync()
+{
+    Packet packet_in;
+    packet_in.header.packet_id = PacketID::GET_FRAME_SYNC;
+    packet_in.header.max_gamepads = MAX_GAMEPADS;
+
+#if defined(CONFIG_EN_USB_HOST)
+    static_assert(sizeof(FrameSync::Stats) <= sizeof(packet_in.data), "FrameSync::Stats must fit in one packet");
+    const FrameSync::Stats stats = FrameSync::get_stats();
+
+    packet_in.header.chunks_total = 1;
+    packet_in.header.chunk_idx = 0;
+    packet_in.header.chunk_len = sizeof(stats);
+    std::memcpy(packet_in.data.data(), &stats, sizeof(stats));
+#else
+    packet_in.header.chunks_total = 0;
+#endif
+    return write_packet(packet_in);
+}
+
 void WebAppDevice::write_error()
 {
     Packet packet_in;
@@ -289,11 +407,42 @@ void WebAppDevice::process(const uint8_t idx, Gamepad& gamepad)
                 }
                 break;
 
+            case PacketID::GET_CAPTURE:
+                if (!write_capture())
+                {
+                    write_error();
+                    return;
+                }
+                break;
+
+            case PacketID::GET_CONNECT_TIMES:
+                if (!write_connect_times())
+                {
+                    write_error();
+                    return;
+                }
+                break;
+
+            case PacketID::GET_FRAME_SYNC:
+                if (!write_frame_sync())
+                {
+                    write_error();
+                    return;
+                }
+                break;
+
             default:
                 // write_response(PacketID::RESP_ERROR);
                 return;
         }
     } 
+#if defined(CONFIG_EN_REPORT_CAPTURE)
+    else if (ReportCapture::frozen())
+    {
+        //Frozen with the button combo, send it without waiting to be asked
+        write_capture();
+    }
+#endif
     else if (gamepad.new_pad_in())
     {
         OGXM_LOG("Writing gamepad input\n");
@@ -7,7 +7,7 @@
 #include "UserSettings/UserSettings.h"
 #include "UserSettings/UserProfile.h"
 
-class WebAppDevice : public DeviceDriver 
+class WebAppDevice final : public DeviceDriver 
 {
 public:
     void initialize() override;
@@ -31,6 +31,9 @@ private:
         SET_PROFILE = 0x61,
         SET_GP_IN = 0x80,
         SET_GP_OUT = 0x81,
+        GET_CAPTURE = 0x90,
+        GET_CONNECT_TIMES = 0x91,
+        GET_FRAME_SYNC = 0x92,
         RESP_ERROR = 0xFF
     };
     
@@ -67,6 +70,9 @@ private:
     bool write_packet(const Packet& packet);
     bool write_profile(uint8_t index, const UserProfile& profile, PacketID packet_id);
     bool write_gamepad(uint8_t index, const Gamepad::PadIn& pad_in);
+    bool write_capture();
+    bool write_connect_times();
+    bool write_frame_sync();
     void write_error();  
 };
 
@@ -1,19 +1,45 @@
 #include <cstring>
 #include "USBDevice/DeviceDriver/XInput/tud_xinput/tud_xinput.h"
 #include "USBDevice/DeviceDriver/XInput/XInput.h"
+#include "USBDevice/DeviceDriver/ButtonTable.h"
 
 // --- INCLUDES ---
 #include "Board/Config.h"
+#include "Board/board_api.h"
 #include "hardware/uart.h"
 #include "hardware/gpio.h"
 // ----------------
 
-static uint32_t turbo_tick = 0;
+static uint32_t turbo_tick[MAX_GAMEPADS] = {0};
+
+//BACK lands on LB and MISC on BACK, LB is the turbo A below
+static constexpr ButtonTable::Scatter<uint16_t> BUTTON_MAP(
+{
+    {Gamepad::BUTTON_START, ButtonTable::byte_bits<uint16_t>(0, XInput::Buttons0::START)},
+    {Gamepad::BUTTON_BACK,  ButtonTable::byte_bits<uint16_t>(1, XInput::Buttons1::LB)},
+    {Gamepad::BUTTON_L3,    ButtonTable::byte_bits<uint16_t>(0, XInput::Buttons0::L3)},
+    {Gamepad::BUTTON_R3,    ButtonTable::byte_bits<uint16_t>(0, XInput::Buttons0::R3)},
+    {Gamepad::BUTTON_MISC,  ButtonTable::byte_bits<uint16_t>(0, XInput::Buttons0::BACK)},
+    {Gamepad::BUTTON_X,     ButtonTable::byte_bits<uint16_t>(1, XInput::Buttons1::X)},
+    {Gamepad::BUTTON_A,     ButtonTable::byte_bits<uint16_t>(1, XInput::Buttons1::A)},
+    {Gamepad::BUTTON_Y,     ButtonTable::byte_bits<uint16_t>(1, XInput::Buttons1::Y)},
+    {Gamepad::BUTTON_B,     ButtonTable::byte_bits<uint16_t>(1, XInput::Buttons1::B)},
+    {Gamepad::BUTTON_RB,    ButtonTable::byte_bits<uint16_t>(1, XInput::Buttons1::RB)},
+    {Gamepad::BUTTON_SYS,   ButtonTable::byte_bits<uint16_t>(1, XInput::Buttons1::HOME)},
+});
+
+static constexpr auto DPAD_MAP = ButtonTable::dpad_bits<uint16_t>(
+    ButtonTable::byte_bits<uint16_t>(0, XInput::Buttons0::DPAD_UP),
+    ButtonTable::byte_bits<uint16_t>(0, XInput::Buttons0::DPAD_DOWN),
+    ButtonTable::byte_bits<uint16_t>(0, XInput::Buttons0::DPAD_LEFT),
+    ButtonTable::byte_bits<uint16_t>(0, XInput::Buttons0::DPAD_RIGHT));
 
 // VARIABLES ESTÁTICAS PARA EL AIMBOT
 static int16_t aim_x = 0;
 static int16_t aim_y = 0;
-static int safety_timer = 0; 
+static uint32_t safety_start_ms = 0;
+static bool safety_active = false;
+static constexpr uint32_t SAFETY_TIMEOUT_MS = 200;
 
 // Función auxiliar para limitar valores (Clamping)
 // Evita que si sumas dos números grandes, el mando se vuelva loco
@@ -30,11 +56,15 @@ void XInputDevice::initialize()
 
 void XInputDevice::process(const uint8_t idx, Gamepad& gamepad)
 {
+    XInput::InReport& in_report = in_reports_[idx];
+    XInput::OutReport& out_report = out_reports_[idx];
+
     // ====================================================================
     // 1. LEER DATOS DEL AIMBOT (UART)
     // ====================================================================
+    // Solo se mezcla en el primer mando
     #ifdef AIMBOT_UART_ID
-    while (uart_is_readable(AIMBOT_UART_ID)) {
+    while (idx == 0 && uart_is_readable(AIMBOT_UART_ID)) {
         uint8_t byte1 = uart_getc(AIMBOT_UART_ID);
 
         if (byte1 == 0xA5) {
@@ -44,7 +74,8 @@ void XInputDevice::process(const uint8_t idx, Gamepad& gamepad)
             aim_x = (int16_t)((data[0] << 8) | data[1]);
             aim_y = (int16_t)((data[2] << 8) | data[3]);
             
-            safety_timer = 200; // 200ms de vida para la orden
+            safety_start_ms = board_api::ms_since_boot(); // 200ms de vida para la orden
+            safety_active = true;
 
             #ifdef LED_INDICATOR_PIN
             gpio_xor_mask(1u << LED_INDICATOR_PIN); 
@@ -56,9 +87,11 @@ void XInputDevice::process(const uint8_t idx, Gamepad& gamepad)
     // ====================================================================
     // 2. SISTEMA DE SEGURIDAD
     // ====================================================================
-    if (safety_timer > 0) {
-        safety_timer--;
-    } else {
+    // Basado en tiempo, el bucle ya no itera a un ritmo fijo de 1ms
+    if (safety_active && (board_api::ms_since_boot() - safety_start_ms) >= SAFETY_TIMEOUT_MS) {
+        safety_active = false;
+    }
+    if (!safety_active) {
         aim_x = 0;
         aim_y = 0;
     }
@@ -67,51 +100,30 @@ void XInputDevice::process(const uint8_t idx, Gamepad& gamepad)
     // 3. PROCESAR INPUT FÍSICO
     // ====================================================================
     bool physical_active = gamepad.new_pad_in();
+    uint32_t pad_in_us = gamepad.pad_in_time_us();
+    bool aim_active = (idx == 0) && (aim_x != 0 || aim_y != 0);
 
     // Procesamos siempre si hay actividad física O del aimbot
-    if (physical_active || aim_x != 0 || aim_y != 0)
+    if (physical_active || aim_active)
     {
-        in_report_.buttons[0] = 0;
-        in_report_.buttons[1] = 0;
-
         Gamepad::PadIn gp_in = gamepad.get_pad_in();
+        report_age_.built(idx, pad_in_us, physical_active);
 
-        // Mapeo de botones normal
-        switch (gp_in.dpad) {
-            case Gamepad::DPAD_UP:         in_report_.buttons[0] |= XInput::Buttons0::DPAD_UP; break;
-            case Gamepad::DPAD_DOWN:       in_report_.buttons[0] |= XInput::Buttons0::DPAD_DOWN; break;
-            case Gamepad::DPAD_LEFT:       in_report_.buttons[0] |= XInput::Buttons0::DPAD_LEFT; break;
-            case Gamepad::DPAD_RIGHT:      in_report_.buttons[0] |= XInput::Buttons0::DPAD_RIGHT; break;
-            case Gamepad::DPAD_UP_LEFT:    in_report_.buttons[0] |= XInput::Buttons0::DPAD_UP | XInput::Buttons0::DPAD_LEFT; break;
-            case Gamepad::DPAD_UP_RIGHT:   in_report_.buttons[0] |= XInput::Buttons0::DPAD_UP | XInput::Buttons0::DPAD_RIGHT; break;
-            case Gamepad::DPAD_DOWN_LEFT:  in_report_.buttons[0] |= XInput::Buttons0::DPAD_DOWN | XInput::Buttons0::DPAD_LEFT; break;
-            case Gamepad::DPAD_DOWN_RIGHT: in_report_.buttons[0] |= XInput::Buttons0::DPAD_DOWN | XInput::Buttons0::DPAD_RIGHT; break;
-        }
-        if (gp_in.buttons & Gamepad::BUTTON_START) in_report_.buttons[0] |= XInput::Buttons0::START;
-        if (gp_in.buttons & Gamepad::BUTTON_BACK)  in_report_.buttons[1] |= XInput::Buttons1::LB;
-        if (gp_in.buttons & Gamepad::BUTTON_L3)    in_report_.buttons[0] |= XInput::Buttons0::L3;
-        if (gp_in.buttons & Gamepad::BUTTON_R3)    in_report_.buttons[0] |= XInput::Buttons0::R3;
-        if (gp_in.buttons & Gamepad::BUTTON_MISC)  in_report_.buttons[0] |= XInput::Buttons0::BACK;
-        if (gp_in.buttons & Gamepad::BUTTON_X)     in_report_.buttons[1] |= XInput::Buttons1::X;
-        if (gp_in.buttons & Gamepad::BUTTON_A)     in_report_.buttons[1] |= XInput::Buttons1::A;
-        if (gp_in.buttons & Gamepad::BUTTON_Y)     in_report_.buttons[1] |= XInput::Buttons1::Y;
-        if (gp_in.buttons & Gamepad::BUTTON_B)     in_report_.buttons[1] |= XInput::Buttons1::B;
-        if (gp_in.buttons & Gamepad::BUTTON_RB)    in_report_.buttons[1] |= XInput::Buttons1::RB;
-        if (gp_in.buttons & Gamepad::BUTTON_SYS)   in_report_.buttons[1] |= XInput::Buttons1::HOME;
+        ButtonTable::to_bytes(static_cast<uint16_t>(BUTTON_MAP(gp_in.buttons) | ButtonTable::dpad(DPAD_MAP, gp_in.dpad)), in_report.buttons);
         
         if (gp_in.buttons & Gamepad::BUTTON_LB) {
-            turbo_tick++;
-            if ((turbo_tick / 5) % 2 == 0) in_report_.buttons[1] |= XInput::Buttons1::A; 
+            turbo_tick[idx]++;
+            if ((turbo_tick[idx] / 5) % 2 == 0) in_report.buttons[1] |= XInput::Buttons1::A; 
         } else {
-            turbo_tick = 0; 
+            turbo_tick[idx] = 0; 
         }
 
-        in_report_.trigger_l = (gp_in.trigger_l > 13) ? 255 : 0;
-        in_report_.trigger_r = (gp_in.trigger_r > 13) ? 255 : 0;
+        in_report.trigger_l = (gp_in.trigger_l > 13) ? 255 : 0;
+        in_report.trigger_r = (gp_in.trigger_r > 13) ? 255 : 0;
         
         // Sticks Izquierdos (Movimiento personaje)
-        in_report_.joystick_lx = gp_in.joystick_lx;
-        in_report_.joystick_ly = Range::invert(gp_in.joystick_ly);
+        in_report.joystick_lx = gp_in.joystick_lx;
+        in_report.joystick_ly = Range::invert(gp_in.joystick_ly);
 
 
         // ====================================================================
@@ -124,7 +136,7 @@ void XInputDevice::process(const uint8_t idx, Gamepad& gamepad)
 
         // 2. Le SUMAMOS el movimiento del aimbot (si existe)
         #ifdef AIMBOT_UART_ID
-        if (aim_x != 0 || aim_y != 0) {
+        if (aim_active) {
             final_rx += aim_x;
             final_ry += aim_y;
         }
@@ -133,21 +145,23 @@ void XInputDevice::process(const uint8_t idx, Gamepad& gamepad)
         // 3. Limitamos para que no se pase del máximo (Clamp)
         // Si tú das +30000 y el aimbot da +5000, daría 35000 (error).
         // Esto lo recorta a 32767.
-        in_report_.joystick_rx = (int16_t)clamp_axis(final_rx);
-        in_report_.joystick_ry = (int16_t)clamp_axis(final_ry);
+        in_report.joystick_rx = (int16_t)clamp_axis(final_rx);
+        in_report.joystick_ry = (int16_t)clamp_axis(final_ry);
 
         // ====================================================================
 
         if (tud_suspended()) tud_remote_wakeup();
-        tud_xinput::send_report((uint8_t*)&in_report_, sizeof(XInput::InReport));
+        if (tud_xinput::send_report(idx, (uint8_t*)&in_report, sizeof(XInput::InReport))) {
+            report_age_.queued(idx);
+        }
     }
 
-    if (tud_xinput::receive_report(reinterpret_cast<uint8_t*>(&out_report_), sizeof(XInput::OutReport)) &&
-        out_report_.report_id == XInput::OutReportID::RUMBLE)
+    if (tud_xinput::receive_report(idx, reinterpret_cast<uint8_t*>(&out_report), sizeof(XInput::OutReport)) &&
+        out_report.report_id == XInput::OutReportID::RUMBLE)
     {
         Gamepad::PadOut gp_out;
-        gp_out.rumble_l = out_report_.rumble_l;
-        gp_out.rumble_r = out_report_.rumble_r;
+        gp_out.rumble_l = out_report.rumble_l;
+        gp_out.rumble_r = out_report.rumble_r;
         gamepad.set_pad_out(gp_out);
     }
 }
@@ -155,7 +169,11 @@ void XInputDevice::process(const uint8_t idx, Gamepad& gamepad)
 // CALLBACKS
 uint16_t XInputDevice::get_report_cb(uint8_t itf, uint8_t report_id, hid_report_type_t report_type, uint8_t *buffer, uint16_t reqlen) 
 {
-    std::memcpy(buffer, &in_report_, sizeof(XInput::InReport));
+    if (itf >= MAX_GAMEPADS)
+    {
+        return 0;
+    }
+    std::memcpy(buffer, &in_reports_[itf], sizeof(XInput::InReport));
     return sizeof(XInput::InReport);
 }
 void XInputDevice::set_report_cb(uint8_t itf, uint8_t report_id, hid_report_type_t report_type, uint8_t const *buffer, uint16_t bufsize) {}
@@ -1,10 +1,14 @@
 #ifndef _XINPUT_DEVICE_H_
 #define _XINPUT_DEVICE_H_
 
+#include <cstdint>
+#include <array>
+
+#include "Board/Config.h"
 #include "USBDevice/DeviceDriver/DeviceDriver.h"
 #include "Descriptors/XInput.h"
 
-class XInputDevice : public DeviceDriver 
+class XInputDevice final : public DeviceDriver 
 {
 public:
     void initialize() override;
@@ -19,8 +23,9 @@ public:
     const uint8_t* get_descriptor_device_qualifier_cb() override;
 
 private:
-    XInput::InReport in_report_;
-    XInput::OutReport out_report_;
+    //Indexed by gamepad, which is also the XInput interface it reports on
+    std::array<XInput::InReport, MAX_GAMEPADS> in_reports_;
+    std::array<XInput::OutReport, MAX_GAMEPADS> out_reports_;
 };
 
 #endif // _XINPUT_DEVICE_H_
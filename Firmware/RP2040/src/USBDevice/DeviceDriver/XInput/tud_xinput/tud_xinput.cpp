@@ -2,6 +2,7 @@
 #if (TUSB_OPT_DEVICE_ENABLED && CFG_TUD_XINPUT)
 
 #include <cstring>
+#include <array>
 #include <algorithm>
 
 #include "tusb.h"
@@ -13,20 +14,62 @@
 namespace tud_xinput {
 
 static constexpr uint16_t ENDPOINT_SIZE = 32;
+static constexpr uint8_t INTERFACE_CLASS = 0xFF;
+static constexpr uint8_t INTERFACE_SUBCLASS = 0x5D;
+static constexpr uint8_t INTERFACE_PROTOCOL = 0x01;
 
-uint8_t endpoint_in_ = 0xFF;
-uint8_t endpoint_out_ = 0xFF;
-uint8_t ep_in_buffer_[ENDPOINT_SIZE];
-uint8_t ep_out_buffer_[ENDPOINT_SIZE];
+//One per XInput interface in the configuration, index is the gamepad index
+struct Interface
+{
+    uint8_t itf_num{0xFF};
+
+    uint8_t ep_in{0xFF};
+    uint8_t ep_out{0xFF};
+
+    std::array<uint8_t, ENDPOINT_SIZE> ep_in_buffer;
+    std::array<uint8_t, ENDPOINT_SIZE> ep_out_buffer;
+
+    Interface()
+    {
+        ep_in_buffer.fill(0);
+        ep_out_buffer.fill(0);
+    }
+};
+
+static std::array<Interface, CFG_TUD_XINPUT> interfaces_;
+
+static inline uint8_t get_idx_by_edpt(uint8_t edpt)
+{
+    for (uint8_t i = 0; i < interfaces_.size(); i++)
+    {
+        if (interfaces_[i].ep_in == edpt || interfaces_[i].ep_out == edpt)
+        {
+            return i;
+        }
+    }
+    return 0xFF;
+}
+
+static inline Interface* find_available_interface()
+{
+    for (Interface &itf : interfaces_)
+    {
+        if (itf.itf_num == 0xFF)
+        {
+            return &itf;
+        }
+    }
+    return nullptr;
+}
 
 //Class Driver 
 
 static void init(void)
 {
-    endpoint_in_ = 0xFF;
-    endpoint_out_ = 0xFF;
-    std::memset(ep_out_buffer_, 0, ENDPOINT_SIZE);
-    std::memset(ep_in_buffer_, 0, ENDPOINT_SIZE);
+    for (Interface &itf : interfaces_)
+    {
+        itf = Interface();
+    }
 }
 
 static bool deinit(void)
@@ -42,10 +85,17 @@ static void reset(uint8_t rhport)
 
 static uint16_t open(uint8_t rhport, tusb_desc_interface_t const *itf_descriptor, uint16_t max_length)
 {
+    TU_VERIFY(itf_descriptor->bInterfaceClass == INTERFACE_CLASS, 0);
+    TU_VERIFY(itf_descriptor->bInterfaceSubClass == INTERFACE_SUBCLASS, 0);
+    TU_VERIFY(itf_descriptor->bInterfaceProtocol == INTERFACE_PROTOCOL, 0);
+
 	uint16_t driver_length = sizeof(tusb_desc_interface_t) + (itf_descriptor->bNumEndpoints * sizeof(tusb_desc_endpoint_t)) + 16;
 
 	TU_VERIFY(max_length >= driver_length, 0);
 
+    Interface *interface = find_available_interface();
+    TU_ASSERT(interface != nullptr, 0);
+
 	uint8_t const *current_descriptor = tu_desc_next(itf_descriptor);
 	uint8_t found_endpoints = 0;
 	while ((found_endpoints < itf_descriptor->bNumEndpoints) && (driver_length <= max_length))
@@ -57,11 +107,11 @@ static uint16_t open(uint8_t rhport, tusb_desc_interface_t const *itf_descriptor
 
 			if (tu_edpt_dir(endpoint_descriptor->bEndpointAddress) == TUSB_DIR_IN)
             {
-				endpoint_in_ = endpoint_descriptor->bEndpointAddress;
+				interface->ep_in = endpoint_descriptor->bEndpointAddress;
             }
 			else
             {
-				endpoint_out_ = endpoint_descriptor->bEndpointAddress;
+				interface->ep_out = endpoint_descriptor->bEndpointAddress;
             }
             
 			++found_endpoints;
@@ -69,6 +119,8 @@ static uint16_t open(uint8_t rhport, tusb_desc_interface_t const *itf_descriptor
 
 		current_descriptor = tu_desc_next(current_descriptor);
 	}
+
+    interface->itf_num = itf_descriptor->bInterfaceNumber;
 	return driver_length;
 }
 
@@ -79,9 +131,18 @@ static bool control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_
 
 static bool xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes)
 {
-	if (ep_addr == endpoint_out_) 
+    const uint8_t index = get_idx_by_edpt(ep_addr);
+    TU_VERIFY(index != 0xFF, true);
+
+    Interface& interface = interfaces_[index];
+
+	if (ep_addr == interface.ep_out) 
+    {
+        usbd_edpt_xfer(BOARD_TUD_RHPORT, interface.ep_out, interface.ep_out_buffer.data(), ENDPOINT_SIZE);
+    }
+    else if (ep_addr == interface.ep_in && report_complete_cb)
     {
-        usbd_edpt_xfer(BOARD_TUD_RHPORT, endpoint_out_, ep_out_buffer_, ENDPOINT_SIZE);
+        report_complete_cb(index);
     }
 	return true;
 }
@@ -108,51 +169,47 @@ const usbd_class_driver_t* class_driver()
     return &tud_class_driver_;
 }
 
-bool send_report_ready()
+bool send_report_ready(uint8_t index)
 {
-    if (tud_ready() && 
-        (endpoint_in_ != 0xFF) && 
-        (!usbd_edpt_busy(BOARD_TUD_RHPORT, endpoint_in_)))
-    {
-        return true;
-    }
-    return false;
+    TU_VERIFY(index < interfaces_.size(), false);
+    TU_VERIFY(interfaces_[index].ep_in != 0xFF, false);
+    return (tud_ready() && !usbd_edpt_busy(BOARD_TUD_RHPORT, interfaces_[index].ep_in));
 }
 
-bool receive_report_ready()
+static bool receive_report_ready(uint8_t index)
 {
-    if (tud_ready() && 
-        (endpoint_out_ != 0xFF) && 
-        (!usbd_edpt_busy(BOARD_TUD_RHPORT, endpoint_out_)))
-    {
-        return true;
-    }
-    return false;
+    TU_VERIFY(index < interfaces_.size(), false);
+    TU_VERIFY(interfaces_[index].ep_out != 0xFF, false);
+    return (tud_ready() && !usbd_edpt_busy(BOARD_TUD_RHPORT, interfaces_[index].ep_out));
 }
 
-bool send_report(const uint8_t *report, uint16_t len)
+bool send_report(uint8_t index, const uint8_t *report, uint16_t len)
 {
-    if (send_report_ready())
+    if (send_report_ready(index))
     {
-        std::memcpy(ep_in_buffer_, report, std::min(len, ENDPOINT_SIZE));
-        usbd_edpt_claim(BOARD_TUD_RHPORT, endpoint_in_);
-        usbd_edpt_xfer(BOARD_TUD_RHPORT, endpoint_in_, ep_in_buffer_, sizeof(XInput::InReport));
-        usbd_edpt_release(BOARD_TUD_RHPORT, endpoint_in_);
+        Interface& interface = interfaces_[index];
+        std::memcpy(interface.ep_in_buffer.data(), report, std::min(len, ENDPOINT_SIZE));
+        usbd_edpt_claim(BOARD_TUD_RHPORT, interface.ep_in);
+        usbd_edpt_xfer(BOARD_TUD_RHPORT, interface.ep_in, interface.ep_in_buffer.data(), sizeof(XInput::InReport));
+        usbd_edpt_release(BOARD_TUD_RHPORT, interface.ep_in);
         return true;
     }
     return false;
 }
 
-bool receive_report(uint8_t *report, uint16_t len)
+bool receive_report(uint8_t index, uint8_t *report, uint16_t len)
 {
-    if (receive_report_ready())
+    TU_VERIFY(index < interfaces_.size(), false);
+
+    Interface& interface = interfaces_[index];
+    if (receive_report_ready(index))
     {
-        usbd_edpt_claim(BOARD_TUD_RHPORT, endpoint_out_);
-        usbd_edpt_xfer(BOARD_TUD_RHPORT, endpoint_out_, ep_out_buffer_, ENDPOINT_SIZE);
-        usbd_edpt_release(BOARD_TUD_RHPORT, endpoint_out_);
+        usbd_edpt_claim(BOARD_TUD_RHPORT, interface.ep_out);
+        usbd_edpt_xfer(BOARD_TUD_RHPORT, interface.ep_out, interface.ep_out_buffer.data(), ENDPOINT_SIZE);
+        usbd_edpt_release(BOARD_TUD_RHPORT, interface.ep_out);
     }
 
-    std::memcpy(report, ep_out_buffer_, std::min(len, ENDPOINT_SIZE));
+    std::memcpy(report, interface.ep_out_buffer.data(), std::min(len, ENDPOINT_SIZE));
     return true;
 }
 
@@ -8,10 +8,14 @@
 
 namespace tud_xinput 
 {
-    bool send_report_ready();
-    bool send_report(const uint8_t *report, uint16_t len);
-    bool receive_report(uint8_t *report, uint16_t len);
+    //index is the XInput interface, one per gamepad in the order they appear in the configuration
+    bool send_report_ready(uint8_t index);
+    bool send_report(uint8_t index, const uint8_t *report, uint16_t len);
+    bool receive_report(uint8_t index, uint8_t *report, uint16_t len);
     const usbd_class_driver_t* class_driver();
+
+    //Defined by the app, called from tud_task() when the console has taken the last IN report of an interface
+    void report_complete_cb(uint8_t index) __attribute__((weak));
     
 } // namespace tud_xinput
 
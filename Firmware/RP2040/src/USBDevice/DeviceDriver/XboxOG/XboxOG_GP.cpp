@@ -3,6 +3,20 @@
 
 #include "USBDevice/DeviceDriver/XboxOG/tud_xid/tud_xid.h"
 #include "USBDevice/DeviceDriver/XboxOG/XboxOG_GP.h"
+#include "USBDevice/DeviceDriver/ButtonTable.h"
+
+//Face buttons and white/black are analog bytes, only these are bits
+static constexpr ButtonTable::Scatter<uint8_t> BUTTON_MAP(
+{
+    {Gamepad::BUTTON_BACK,  XboxOG::GP::Buttons::BACK},
+    {Gamepad::BUTTON_START, XboxOG::GP::Buttons::START},
+    {Gamepad::BUTTON_L3,    XboxOG::GP::Buttons::L3},
+    {Gamepad::BUTTON_R3,    XboxOG::GP::Buttons::R3},
+});
+
+static constexpr auto DPAD_MAP = ButtonTable::dpad_bits<uint8_t>(
+    XboxOG::GP::Buttons::DPAD_UP, XboxOG::GP::Buttons::DPAD_DOWN,
+    XboxOG::GP::Buttons::DPAD_LEFT, XboxOG::GP::Buttons::DPAD_RIGHT);
 
 void XboxOGDevice::initialize() 
 {
@@ -17,43 +31,11 @@ void XboxOGDevice::process(const uint8_t idx, Gamepad& gamepad)
 {
     if (gamepad.new_pad_in())
     {
+        report_age_.built(idx, gamepad.pad_in_time_us());
         std::memset(&in_report_.buttons, 0, 8);
         Gamepad::PadIn gp_in = gamepad.get_pad_in();
 
-        switch (gp_in.dpad)
-        {
-            case Gamepad::DPAD_UP:
-                in_report_.buttons = XboxOG::GP::Buttons::DPAD_UP;
-                break;
-            case Gamepad::DPAD_DOWN:
-                in_report_.buttons = XboxOG::GP::Buttons::DPAD_DOWN;
-                break;
-            case Gamepad::DPAD_LEFT:
-                in_report_.buttons = XboxOG::GP::Buttons::DPAD_LEFT;
-                break;
-            case Gamepad::DPAD_RIGHT:
-                in_report_.buttons = XboxOG::GP::Buttons::DPAD_RIGHT;
-                break;
-            case Gamepad::DPAD_UP_LEFT:
-                in_report_.buttons = XboxOG::GP::Buttons::DPAD_UP | XboxOG::GP::Buttons::DPAD_LEFT;
-                break;
-            case Gamepad::DPAD_UP_RIGHT:
-                in_report_.buttons = XboxOG::GP::Buttons::DPAD_UP | XboxOG::GP::Buttons::DPAD_RIGHT;
-                break;
-            case Gamepad::DPAD_DOWN_LEFT:
-                in_report_.buttons = XboxOG::GP::Buttons::DPAD_DOWN | XboxOG::GP::Buttons::DPAD_LEFT;
-                break;
-            case Gamepad::DPAD_DOWN_RIGHT:
-                in_report_.buttons = XboxOG::GP::Buttons::DPAD_DOWN | XboxOG::GP::Buttons::DPAD_RIGHT;
-                break;
-            default:
-                break;
-        }
-        
-        if (gp_in.buttons & Gamepad::BUTTON_BACK)     in_report_.buttons |= XboxOG::GP::Buttons::BACK;
-        if (gp_in.buttons & Gamepad::BUTTON_START)    in_report_.buttons |= XboxOG::GP::Buttons::START;
-        if (gp_in.buttons & Gamepad::BUTTON_L3)       in_report_.buttons |= XboxOG::GP::Buttons::L3;
-        if (gp_in.buttons & Gamepad::BUTTON_R3)       in_report_.buttons |= XboxOG::GP::Buttons::R3;
+        in_report_.buttons = BUTTON_MAP(gp_in.buttons) | ButtonTable::dpad(DPAD_MAP, gp_in.dpad);
 
         if (gamepad.analog_enabled())
         {
@@ -86,9 +68,10 @@ void XboxOGDevice::process(const uint8_t idx, Gamepad& gamepad)
         {
             tud_remote_wakeup();
         }
-        if (tud_xid::send_report_ready(0))
+        if (tud_xid::send_report_ready(0) &&
+            tud_xid::send_report(0, reinterpret_cast<uint8_t*>(&in_report_), sizeof(XboxOG::GP::InReport)))
         {
-            tud_xid::send_report(0, reinterpret_cast<uint8_t*>(&in_report_), sizeof(XboxOG::GP::InReport));
+            report_age_.queued(idx);
         }
     }
 
@@ -6,7 +6,7 @@
 #include "USBDevice/DeviceDriver/DeviceDriver.h"
 #include "Descriptors/XboxOG.h"
 
-class XboxOGDevice : public DeviceDriver 
+class XboxOGDevice final : public DeviceDriver 
 {
 public:
     void initialize() override;
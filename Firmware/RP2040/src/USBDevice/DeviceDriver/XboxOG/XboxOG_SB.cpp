@@ -87,6 +87,10 @@ void XboxOGSBDevice::initialize()
 
 void XboxOGSBDevice::process(const uint8_t idx, Gamepad& gamepad) 
 {
+    if (gamepad.new_pad_in())
+    {
+        report_age_.built(idx, gamepad.pad_in_time_us());
+    }
     Gamepad::PadIn gp_in = gamepad.get_pad_in();
     Gamepad::ChatpadIn gp_in_chatpad = gamepad.get_chatpad_in();
 
@@ -282,6 +286,7 @@ void XboxOGSBDevice::process(const uint8_t idx, Gamepad& gamepad)
         tud_xid::send_report(0, reinterpret_cast<uint8_t*>(&in_report_), sizeof(XboxOG::SB::InReport)))
     {
         std::memcpy(&prev_in_report_, &in_report_, sizeof(XboxOG::SB::InReport));
+        report_age_.queued(idx);
     }
 
     if (chatpad_pressed(gp_in_chatpad, XInput::Chatpad::CODE_ORANGE))
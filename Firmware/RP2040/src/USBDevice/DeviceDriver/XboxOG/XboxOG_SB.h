@@ -7,7 +7,7 @@
 #include "USBDevice/DeviceDriver/DeviceDriver.h"
 #include "Descriptors/XboxOG.h"
 
-class XboxOGSBDevice : public DeviceDriver 
+class XboxOGSBDevice final : public DeviceDriver 
 {
 public:
     struct ButtonMap
@@ -6,7 +6,7 @@
 #include "USBDevice/DeviceDriver/DeviceDriver.h"
 #include "Descriptors/XboxOG.h"
 
-class XboxOGXRDevice : public DeviceDriver 
+class XboxOGXRDevice final : public DeviceDriver 
 {
 public:
     void initialize() override;
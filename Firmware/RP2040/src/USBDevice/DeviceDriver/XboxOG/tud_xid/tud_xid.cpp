@@ -237,6 +237,14 @@ static bool xid_xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, u
     // TU_VERIFY(index != 0xFF, true);
     // TU_VERIFY(xferred_bytes < ENDPOINT_SIZE, true);
 
+    if ((ep_addr & TUSB_DIR_IN_MASK) && report_complete_cb)
+    {
+        const uint8_t index = get_idx_by_edpt(ep_addr);
+        if (index != 0xFF && interfaces_[index].type != Type::XREMOTE)
+        {
+            report_complete_cb(index);
+        }
+    }
     return true;
 }
 
@@ -50,6 +50,9 @@ namespace tud_xid
     bool send_report_ready(uint8_t idx);
     bool xremote_rom_available();
 
+    //Defined by the app, called from tud_task() when the host has taken the last IN report of a gamepad interface
+    void report_complete_cb(uint8_t idx) __attribute__((weak));
+
 } // namespace TUDXID
 
 #endif // _TUD_XID_H_
\ No newline at end of file
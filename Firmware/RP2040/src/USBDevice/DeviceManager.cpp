@@ -1,21 +1,11 @@
 #include "tusb.h"
 
 #include "Board/Config.h"
-#include "USBDevice/DeviceDriver/PSClassic/PSClassic.h"
-#include "USBDevice/DeviceDriver/XInput/XInput.h"   
-#include "USBDevice/DeviceDriver/Switch/Switch.h"
-#include "USBDevice/DeviceDriver/DInput/DInput.h"
-#include "USBDevice/DeviceDriver/PS3/PS3.h"
-#include "USBDevice/DeviceDriver/XboxOG/XboxOG_GP.h"
-#include "USBDevice/DeviceDriver/XboxOG/XboxOG_SB.h"
-#include "USBDevice/DeviceDriver/XboxOG/XboxOG_XR.h"
-#include "USBDevice/DeviceDriver/WebApp/WebApp.h"
-#include "USBDevice/DeviceDriver/PS4/PS4.h"
 #include "USBDevice/DeviceManager.h"
 
-#if defined(CONFIG_EN_UART_BRIDGE)
-#include "USBDevice/DeviceDriver/UARTBridge/UARTBridge.h"
-#endif // defined(CONFIG_EN_UART_BRIDGE)
+#if defined(CONFIG_EN_USB_HOST)
+#include "USBHost/FrameSync.h"
+#endif // defined(CONFIG_EN_USB_HOST)
 
 void DeviceManager::initialize_driver(DeviceDriverType driver_type, 
                                       Gamepad(&gamepads)[MAX_GAMEPADS]) {
@@ -25,51 +15,51 @@ void DeviceManager::initialize_driver(DeviceDriverType driver_type,
     switch (driver_type) {
         case DeviceDriverType::DINPUT:
             has_analog = true;
-            device_driver_ = std::make_unique<DInputDevice>();
+            driver_.emplace<DInputDevice>();
             break;
 
         case DeviceDriverType::PS3:
             has_analog = true;
-            device_driver_ = std::make_unique<PS3Device>();
+            driver_.emplace<PS3Device>();
             break;
 
         case DeviceDriverType::PSCLASSIC:
-            device_driver_ = std::make_unique<PSClassicDevice>();
+            driver_.emplace<PSClassicDevice>();
             break;
 
         case DeviceDriverType::SWITCH:
-            device_driver_ = std::make_unique<SwitchDevice>();
+            driver_.emplace<SwitchDevice>();
             break;
 
         case DeviceDriverType::XINPUT:
-            device_driver_ = std::make_unique<XInputDevice>();
+            driver_.emplace<XInputDevice>();
             break;
 
         case DeviceDriverType::XBOXOG:
             has_analog = true;
-            device_driver_ = std::make_unique<XboxOGDevice>();
+            driver_.emplace<XboxOGDevice>();
             break;
 
         case DeviceDriverType::XBOXOG_SB:
-            device_driver_ = std::make_unique<XboxOGSBDevice>();
+            driver_.emplace<XboxOGSBDevice>();
             break;
 
         case DeviceDriverType::XBOXOG_XR:
-            device_driver_ = std::make_unique<XboxOGXRDevice>();
+            driver_.emplace<XboxOGXRDevice>();
             break;
 
         case DeviceDriverType::WEBAPP:
-            device_driver_ = std::make_unique<WebAppDevice>();
+            driver_.emplace<WebAppDevice>();
             break;
 
         case DeviceDriverType::PS4:
             has_analog = true;
-            device_driver_ = std::make_unique<PS4Device>();
+            driver_.emplace<PS4Device>();
             break;
 
 #if defined(CONFIG_EN_UART_BRIDGE)
         case DeviceDriverType::UART_BRIDGE:
-            device_driver_ = std::make_unique<UARTBridgeDevice>();
+            driver_.emplace<UARTBridgeDevice>();
             break;
 #endif //defined(CONFIG_EN_UART_BRIDGE)
 
@@ -83,5 +73,12 @@ void DeviceManager::initialize_driver(DeviceDriverType driver_type,
         }
     }
 
-    device_driver_->initialize();
+    gamepads_ = gamepads;
+    driver_base_ = dispatch<DeviceDriver*>(nullptr, [](auto& driver) -> DeviceDriver* { return &driver; });
+    dispatch([](auto& driver) { driver.initialize(); });
+
+#if defined(CONFIG_EN_USB_HOST)
+    //Console frame timestamps for lining the host port's frames up with them
+    driver_base_->set_sof_cb(FrameSync::device_sof);
+#endif
 }
@@ -2,10 +2,26 @@
 #define _DEVICE_MANAGER_H_
 
 #include <cstdint>
-#include <memory>
+#include <variant>
+#include <type_traits>
 
+#include "Board/board_api.h"
 #include "USBDevice/DeviceDriver/DeviceDriverTypes.h"
 #include "USBDevice/DeviceDriver/DeviceDriver.h"
+#include "USBDevice/DeviceDriver/PSClassic/PSClassic.h"
+#include "USBDevice/DeviceDriver/XInput/XInput.h"
+#include "USBDevice/DeviceDriver/Switch/Switch.h"
+#include "USBDevice/DeviceDriver/DInput/DInput.h"
+#include "USBDevice/DeviceDriver/PS3/PS3.h"
+#include "USBDevice/DeviceDriver/XboxOG/XboxOG_GP.h"
+#include "USBDevice/DeviceDriver/XboxOG/XboxOG_SB.h"
+#include "USBDevice/DeviceDriver/XboxOG/XboxOG_XR.h"
+#include "USBDevice/DeviceDriver/WebApp/WebApp.h"
+#include "USBDevice/DeviceDriver/PS4/PS4.h"
+
+#if defined(CONFIG_EN_UART_BRIDGE)
+#include "USBDevice/DeviceDriver/UARTBridge/UARTBridge.h"
+#endif // defined(CONFIG_EN_UART_BRIDGE)
 
 class DeviceManager {
 public:
@@ -19,14 +35,138 @@ public:
 
 	//Must be called before any other method
 	void initialize_driver(DeviceDriverType driver_type, Gamepad(&gamepads)[MAX_GAMEPADS]);
-	
-	DeviceDriver* get_driver() { return device_driver_.get(); }
-	
+
+	//For the non virtual DeviceDriver helpers, nullptr if no driver was set up
+	DeviceDriver* get_driver() { return driver_base_; }
+
+	//The driver is fixed for the whole boot, so calls switch on the variant index straight
+	//into the final driver class instead of going through the vtable
+	void process(uint8_t idx, Gamepad& gamepad)
+	{
+		dispatch([&](auto& driver) { process(driver, idx, gamepad); });
+	}
+
+	uint16_t get_report_cb(uint8_t itf, uint8_t report_id, hid_report_type_t report_type, uint8_t* buffer, uint16_t req_len)
+	{
+		return dispatch<uint16_t>(0, [&](auto& driver) { return driver.get_report_cb(itf, report_id, report_type, buffer, req_len); });
+	}
+
+	void set_report_cb(uint8_t itf, uint8_t report_id, hid_report_type_t report_type, uint8_t const* buffer, uint16_t buffer_size)
+	{
+		dispatch([&](auto& driver) { driver.set_report_cb(itf, report_id, report_type, buffer, buffer_size); });
+	}
+
+	bool vendor_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const* request)
+	{
+		return dispatch<bool>(false, [&](auto& driver) { return driver.vendor_control_xfer_cb(rhport, stage, request); });
+	}
+
+	const uint16_t* get_descriptor_string_cb(uint8_t index, uint16_t langid)
+	{
+		return dispatch<const uint16_t*>(nullptr, [&](auto& driver) { return driver.get_descriptor_string_cb(index, langid); });
+	}
+
+	const uint8_t* get_descriptor_device_cb()
+	{
+		return dispatch<const uint8_t*>(nullptr, [](auto& driver) { return driver.get_descriptor_device_cb(); });
+	}
+
+	const uint8_t* get_hid_descriptor_report_cb(uint8_t itf)
+	{
+		return dispatch<const uint8_t*>(nullptr, [&](auto& driver) { return driver.get_hid_descriptor_report_cb(itf); });
+	}
+
+	const uint8_t* get_descriptor_configuration_cb(uint8_t index)
+	{
+		return dispatch<const uint8_t*>(nullptr, [&](auto& driver) { return driver.get_descriptor_configuration_cb(index); });
+	}
+
+	const uint8_t* get_descriptor_device_qualifier_cb()
+	{
+		return dispatch<const uint8_t*>(nullptr, [](auto& driver) { return driver.get_descriptor_device_qualifier_cb(); });
+	}
+
+	//Called from the class drivers when the console has taken a report
+	void report_complete(uint8_t idx)
+	{
+		if (gamepads_ && idx < MAX_GAMEPADS)
+		{
+			dispatch([&](auto& driver)
+			{
+				if (driver.report_complete(idx, gamepads_[idx]))
+				{
+					process(driver, idx, gamepads_[idx]);
+				}
+			});
+		}
+	}
+
 private:
     DeviceManager() = default;
 	~DeviceManager() = default;
 
-	std::unique_ptr<DeviceDriver> device_driver_{nullptr};
+	using DriverVariant = std::variant<
+		std::monostate,
+		DInputDevice,
+		PS3Device,
+		PSClassicDevice,
+		SwitchDevice,
+		XInputDevice,
+		XboxOGDevice,
+		XboxOGSBDevice,
+		XboxOGXRDevice,
+		WebAppDevice,
+		PS4Device
+#if defined(CONFIG_EN_UART_BRIDGE)
+		, UARTBridgeDevice
+#endif // defined(CONFIG_EN_UART_BRIDGE)
+		>;
+
+	//Stored inline, only the largest driver's worth of RAM and no heap allocation
+	DriverVariant driver_;
+	DeviceDriver* driver_base_{nullptr};
+	Gamepad* gamepads_{nullptr};
+
+	//Stamps any pad_out the driver writes and rings core1 so the host side sends it right away
+	template<typename Driver>
+	void process(Driver& driver, uint8_t idx, Gamepad& gamepad)
+	{
+		const uint32_t generation = gamepad.pad_out_generation();
+		gamepad.set_pad_out_time(board_api::us_since_boot());
+		driver.process(idx, gamepad);
+		if (gamepad.pad_out_generation() != generation)
+		{
+			board_api::core1::notify();
+		}
+	}
+
+	template<typename Fn>
+	void dispatch(Fn&& fn)
+	{
+		std::visit([&](auto& driver)
+		{
+			if constexpr (!std::is_same_v<std::decay_t<decltype(driver)>, std::monostate>)
+			{
+				fn(driver);
+			}
+		}, driver_);
+	}
+
+	template<typename Ret, typename Fn>
+	Ret dispatch(Ret fallback, Fn&& fn)
+	{
+		return std::visit([&](auto& driver) -> Ret
+		{
+			if constexpr (std::is_same_v<std::decay_t<decltype(driver)>, std::monostate>)
+			{
+				return fallback;
+			}
+			else
+			{
+				return fn(driver);
+			}
+		}, driver_);
+	}
 };
 
-#endif // _DEVICE_MANAGER_H_
\ No newline at end of file
+#endif // _DEVICE_MANAGER_H_
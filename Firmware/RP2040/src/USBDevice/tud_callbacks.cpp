@@ -5,6 +5,8 @@
 #include "device/usbd_pvt.h"
 
 #include "USBDevice/DeviceManager.h"
+#include "USBDevice/DeviceDriver/XInput/tud_xinput/tud_xinput.h"
+#include "USBDevice/DeviceDriver/XboxOG/tud_xid/tud_xid.h"
 
 const usbd_class_driver_t *usbd_app_driver_get_cb(uint8_t *driver_count) 
 {
@@ -14,41 +16,66 @@ const usbd_class_driver_t *usbd_app_driver_get_cb(uint8_t *driver_count)
 
 uint16_t tud_hid_get_report_cb(uint8_t itf, uint8_t report_id, hid_report_type_t report_type, uint8_t *buffer, uint16_t reqlen) 
 {
-	return DeviceManager::get_instance().get_driver()->get_report_cb(itf, report_id, report_type, buffer, reqlen);
+	return DeviceManager::get_instance().get_report_cb(itf, report_id, report_type, buffer, reqlen);
 }
 
 void tud_hid_set_report_cb(uint8_t itf, uint8_t report_id, hid_report_type_t report_type, uint8_t const *buffer, uint16_t bufsize) 
 {
-	DeviceManager::get_instance().get_driver()->set_report_cb(itf, report_id, report_type, buffer, bufsize);
+	DeviceManager::get_instance().set_report_cb(itf, report_id, report_type, buffer, bufsize);
 	tud_hid_report(report_id, buffer, bufsize);
 }
 
+void tud_hid_report_complete_cb(uint8_t instance, uint8_t const* report, uint16_t len)
+{
+	(void)report;
+	(void)len;
+	DeviceManager::get_instance().report_complete(instance);
+}
+
+void tud_xinput::report_complete_cb(uint8_t index)
+{
+	DeviceManager::get_instance().report_complete(index);
+}
+
+void tud_xid::report_complete_cb(uint8_t index)
+{
+	DeviceManager::get_instance().report_complete(index);
+}
+
+#if defined(CONFIG_EN_USB_HOST)
+//The SOF interrupt is off until something asks for it, the class driver SOF handler feeds FrameSync
+void tud_mount_cb()
+{
+	tud_sof_cb_enable(true);
+}
+#endif
+
 bool tud_vendor_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const *request) 
 {
-	return DeviceManager::get_instance().get_driver()->vendor_control_xfer_cb(rhport, stage, request);
+	return DeviceManager::get_instance().vendor_control_xfer_cb(rhport, stage, request);
 }
 
 uint16_t const *tud_descriptor_string_cb(uint8_t index, uint16_t langid) 
 {
-	return DeviceManager::get_instance().get_driver()->get_descriptor_string_cb(index, langid);
+	return DeviceManager::get_instance().get_descriptor_string_cb(index, langid);
 }
 
 uint8_t const *tud_descriptor_device_cb() 
 {
-	return DeviceManager::get_instance().get_driver()->get_descriptor_device_cb();
+	return DeviceManager::get_instance().get_descriptor_device_cb();
 }
 
 uint8_t const *tud_hid_descriptor_report_cb(uint8_t itf) 
 {
-	return DeviceManager::get_instance().get_driver()->get_hid_descriptor_report_cb(itf);
+	return DeviceManager::get_instance().get_hid_descriptor_report_cb(itf);
 }
 
 uint8_t const *tud_descriptor_configuration_cb(uint8_t index) 
 {
-	return DeviceManager::get_instance().get_driver()->get_descriptor_configuration_cb(index);
+	return DeviceManager::get_instance().get_descriptor_configuration_cb(index);
 }
 
 uint8_t const* tud_descriptor_device_qualifier_cb() 
 {
-	return DeviceManager::get_instance().get_driver()->get_descriptor_device_qualifier_cb();
+	return DeviceManager::get_instance().get_descriptor_device_qualifier_cb();
 }
\ No newline at end of file
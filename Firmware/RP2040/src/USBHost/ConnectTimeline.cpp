@@ -0,0 +1,29 @@
+#include <atomic>
+#include <algorithm>
+
+#include "USBHost/ConnectTimeline.h"
+
+namespace ConnectTimeline
+{
+    static Entry entries_[MAX_ENTRIES];
+    static std::atomic<uint32_t> total_{0}; //Connects added since boot, written by core1 only
+
+    void add(const Entry& entry)
+    {
+        const uint32_t total = total_.load(std::memory_order_relaxed);
+        entries_[total % MAX_ENTRIES] = entry;
+        total_.store(total + 1, std::memory_order_release);
+    }
+
+    uint8_t read(Entry* entries, uint8_t max_entries)
+    {
+        const uint32_t total = total_.load(std::memory_order_acquire);
+        const uint8_t count = static_cast<uint8_t>(std::min<uint32_t>({ total, MAX_ENTRIES, max_entries }));
+
+        for (uint8_t i = 0; i < count; ++i)
+        {
+            entries[i] = entries_[(total - count + i) % MAX_ENTRIES];
+        }
+        return count;
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef _CONNECT_TIMELINE_H_
+#define _CONNECT_TIMELINE_H_
+
+#include <cstdint>
+#include <cstddef>
+
+// Plug in to first PadIn timing of the last few connects, for finding where connect time goes.
+// Core1 adds a connect once its first PadIn is out, either core can read them back.
+namespace ConnectTimeline
+{
+    static constexpr uint8_t MAX_ENTRIES = 8;
+
+    enum class Stage : uint8_t
+    {
+        ATTACH = 0,   //Host port pins saw the device, only known for the first device after boot
+        ENUMERATED,   //Configuration descriptor read, class drivers opening
+        DRIVER_SETUP, //HostManager::setup_driver()
+        INIT_DONE,    //Driver's init sequence finished
+        FIRST_PAD_IN, //First report translated after init
+        COUNT
+    };
+
+    #pragma pack(push, 1)
+    struct Entry
+    {
+        uint16_t vid;
+        uint16_t pid;
+        uint8_t address;
+        uint8_t instance;
+        uint8_t driver_type; //HostDriverType
+        uint8_t cached;      //1 if HostCache knew the VID/PID
+        uint32_t stage_us[static_cast<size_t>(Stage::COUNT)]; //us_since_boot(), 0 if the stage wasn't seen
+    };
+    static_assert(sizeof(Entry) == 28, "ConnectTimeline::Entry size mismatch");
+    #pragma pack(pop)
+
+    inline void mark(Entry& entry, Stage stage, uint32_t time_us)
+    {
+        entry.stage_us[static_cast<size_t>(stage)] = time_us;
+    }
+
+    inline uint32_t get(const Entry& entry, Stage stage)
+    {
+        return entry.stage_us[static_cast<size_t>(stage)];
+    }
+
+    //Core1 only
+    void add(const Entry& entry);
+
+    //Copies up to max_entries connects oldest first, returns how many were copied
+    uint8_t read(Entry* entries, uint8_t max_entries);
+}
+
+#endif // _CONNECT_TIMELINE_H_
@@ -0,0 +1,159 @@
+#include <atomic>
+#include <algorithm>
+
+#include "pico/platform.h"
+#include "hardware/timer.h"
+
+#if defined(CONFIG_EN_SOF_ALIGN)
+#include "pio_usb.h"
+#endif
+
+#include "USBHost/FrameSync.h"
+
+namespace FrameSync
+{
+    //Longer than this without a console SOF and the bus is suspended or gone
+    static constexpr uint32_t SOF_TIMEOUT_US = FRAME_US * 3;
+
+    //Written from the core0 USB IRQ only
+    static std::atomic<uint32_t> last_sof_us_{0};
+    static std::atomic<uint32_t> sof_count_{0};
+    static std::atomic<uint32_t> sof_interval_min_us_{UINT16_MAX};
+    static std::atomic<uint32_t> sof_interval_max_us_{0};
+
+    //Written from core1 only
+    static std::atomic<uint32_t> phase_buckets_[PHASE_BUCKETS];
+    static std::atomic<bool> locked_{false};
+
+    void __not_in_flash_func(device_sof)(uint8_t rhport, uint32_t frame_count)
+    {
+        (void)rhport;
+        (void)frame_count;
+
+        const uint32_t now_us = time_us_32();
+        const uint32_t count = sof_count_.load(std::memory_order_relaxed);
+        const uint32_t interval_us = now_us - last_sof_us_.load(std::memory_order_relaxed);
+
+        //A gap means the bus was suspended, it says nothing about jitter
+        if (count > 0 && interval_us < SOF_TIMEOUT_US)
+        {
+            if (interval_us < sof_interval_min_us_.load(std::memory_order_relaxed))
+            {
+                sof_interval_min_us_.store(interval_us, std::memory_order_relaxed);
+            }
+            if (interval_us > sof_interval_max_us_.load(std::memory_order_relaxed))
+            {
+                sof_interval_max_us_.store(interval_us, std::memory_order_relaxed);
+            }
+        }
+        last_sof_us_.store(now_us, std::memory_order_release);
+        sof_count_.store(count + 1, std::memory_order_release);
+    }
+
+    static inline bool sof_running(uint32_t now_us, uint32_t sof_us)
+    {
+        return sof_count_.load(std::memory_order_acquire) > 0 && (now_us - sof_us) < SOF_TIMEOUT_US;
+    }
+
+#if defined(CONFIG_EN_SOF_ALIGN)
+
+    //Start of the host frame running now, only touched by the alarm IRQ on core1
+    static uint64_t frame_us_{0};
+
+    //How far a host frame starting at frame_us is from LEAD_US before the SOF after sof_us,
+    //wrapped to half a frame either way
+    static inline int32_t phase_error(uint32_t frame_us, uint32_t sof_us)
+    {
+        constexpr int32_t TARGET_US = static_cast<int32_t>(FRAME_US - LEAD_US);
+        constexpr int32_t FRAME = static_cast<int32_t>(FRAME_US);
+
+        int32_t phase_us = static_cast<int32_t>(frame_us - sof_us) % FRAME;
+        if (phase_us < 0)
+        {
+            phase_us += FRAME;
+        }
+        int32_t error_us = phase_us - TARGET_US;
+        if (error_us >= FRAME / 2)
+        {
+            error_us -= FRAME;
+        }
+        else if (error_us < -FRAME / 2)
+        {
+            error_us += FRAME;
+        }
+        return error_us;
+    }
+
+    //Stands in for Pico-PIO-USB's frame timer, with no console SOF it keeps the same free running 1ms
+    static void __not_in_flash_func(frame_alarm_cb)(uint alarm_num)
+    {
+        pio_usb_host_frame();
+
+        uint64_t next_us = frame_us_ + FRAME_US;
+        const uint32_t sof_us = last_sof_us_.load(std::memory_order_acquire);
+        bool locked = false;
+
+        if (sof_running(time_us_32(), sof_us))
+        {
+            constexpr int32_t SLEW = static_cast<int32_t>(SLEW_US);
+            const int32_t error_us = phase_error(static_cast<uint32_t>(next_us), sof_us);
+            next_us = static_cast<uint64_t>(static_cast<int64_t>(next_us) - std::clamp(error_us, -SLEW, SLEW));
+            locked = (error_us >= -SLEW) && (error_us <= SLEW);
+        }
+        locked_.store(locked, std::memory_order_relaxed);
+
+        //A frame that ran long skips the slots it overran, same as Pico-PIO-USB's own timer
+        while (hardware_alarm_set_target(alarm_num, from_us_since_boot(next_us)))
+        {
+            next_us += FRAME_US;
+        }
+        frame_us_ = next_us;
+    }
+
+#endif // defined(CONFIG_EN_SOF_ALIGN)
+
+    void start_host_frames()
+    {
+#if defined(CONFIG_EN_SOF_ALIGN)
+        //The alarm IRQ fires on the core that sets the callback, which keeps host frames on core1
+        const uint alarm_num = static_cast<uint>(hardware_alarm_claim_unused(true));
+        hardware_alarm_set_callback(alarm_num, frame_alarm_cb);
+
+        frame_us_ = time_us_64() + FRAME_US;
+        while (hardware_alarm_set_target(alarm_num, from_us_since_boot(frame_us_)))
+        {
+            frame_us_ += FRAME_US;
+        }
+#endif
+    }
+
+    void host_report()
+    {
+        const uint32_t now_us = time_us_32();
+        const uint32_t sof_us = last_sof_us_.load(std::memory_order_acquire);
+        if (!sof_running(now_us, sof_us))
+        {
+            return;
+        }
+        std::atomic<uint32_t>& bucket = phase_buckets_[((now_us - sof_us) % FRAME_US) / PHASE_BUCKET_US];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    Stats get_stats()
+    {
+        Stats stats{};
+#if defined(CONFIG_EN_SOF_ALIGN)
+        stats.aligned = 1;
+#endif
+        stats.locked = locked_.load(std::memory_order_relaxed) ? 1 : 0;
+        stats.lead_us = static_cast<uint16_t>(LEAD_US);
+        stats.sof_count = sof_count_.load(std::memory_order_acquire);
+        stats.sof_interval_min_us = static_cast<uint16_t>(std::min<uint32_t>(sof_interval_min_us_.load(std::memory_order_relaxed), UINT16_MAX));
+        stats.sof_interval_max_us = static_cast<uint16_t>(std::min<uint32_t>(sof_interval_max_us_.load(std::memory_order_relaxed), UINT16_MAX));
+        for (uint8_t i = 0; i < PHASE_BUCKETS; ++i)
+        {
+            stats.phase_buckets[i] = phase_buckets_[i].load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef _FRAME_SYNC_H_
+#define _FRAME_SYNC_H_
+
+#include <cstdint>
+#include <cstddef>
+
+// Lines the host port's 1ms frames up with the console's. The device side SOF handler timestamps
+// every console frame, with EN_SOF_ALIGN core1 runs Pico-PIO-USB's frames from its own alarm so the
+// controller is polled LEAD_US before the console's next SOF, instead of at a free running phase.
+// The phase stats are kept either way so both builds can be compared.
+namespace FrameSync
+{
+    static constexpr uint32_t FRAME_US = 1000;
+    //Host frame start to console SOF, covers the IN transaction and handing the report to core0
+    static constexpr uint32_t LEAD_US = 250;
+    //Most a host frame is moved per frame while catching up, keeps frames within what devices accept
+    static constexpr uint32_t SLEW_US = 20;
+    static constexpr uint8_t PHASE_BUCKETS = 8;
+    static constexpr uint32_t PHASE_BUCKET_US = FRAME_US / PHASE_BUCKETS;
+
+    #pragma pack(push, 1)
+    struct Stats
+    {
+        uint8_t aligned;  //1 if host frames follow the console's SOF
+        uint8_t locked;   //1 if the last host frame was within SLEW_US of its target
+        uint16_t lead_us;
+        uint32_t sof_count;
+        uint16_t sof_interval_min_us; //Spread between console SOF timestamps, any jitter is IRQ latency
+        uint16_t sof_interval_max_us;
+        uint32_t phase_buckets[PHASE_BUCKETS]; //Host reports by time since the console's last SOF
+    };
+    static_assert(sizeof(Stats) == 44, "FrameSync::Stats size mismatch");
+    #pragma pack(pop)
+
+    //Device side class driver SOF handler, runs in the USB IRQ on core0
+    void device_sof(uint8_t rhport, uint32_t frame_count);
+
+    //Core1, after tuh_init() and any extra host ports. Takes over Pico-PIO-USB's frame timer
+    //when built with EN_SOF_ALIGN, does nothing otherwise
+    void start_host_frames();
+
+    //Core1, for every IN report from the host port
+    void host_report();
+
+    Stats get_stats();
+}
+
+#endif // _FRAME_SYNC_H_
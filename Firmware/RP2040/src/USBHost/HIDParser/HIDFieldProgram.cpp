@@ -0,0 +1,240 @@
+#include "USBHost/HIDParser/HIDFieldProgram.h"
+#include "USBHost/HIDParser/HIDUtils.h"
+
+/* ----------------------------------------------- */
+
+static int16_t mapAxis(uint32_t raw, const HIDFieldProgram::Field &field)
+{
+    int32_t value = static_cast<int32_t>(raw);
+
+    //Signed logical ranges are reported in two's complement
+    if (field.logical_min < 0 && field.bit_size < 32 && (raw & (1u << (field.bit_size - 1))))
+        value = static_cast<int32_t>(raw | (~0u << field.bit_size));
+
+    if (field.logical_max <= field.logical_min)
+        return 0;
+
+    if (value <= field.logical_min)
+        return -32768;
+    if (value >= field.logical_max)
+        return 32767;
+
+    const uint32_t range = static_cast<uint32_t>(field.logical_max - field.logical_min);
+    const uint32_t offset = static_cast<uint32_t>(value - field.logical_min);
+
+    //offset * 65535 fits in 32 bits for ranges up to 16 bits, wider ranges fall back to 64 bit math
+    if (range <= 0xFFFF)
+        return static_cast<int16_t>(static_cast<int32_t>(offset * 65535u / range) - 32768);
+
+    return static_cast<int16_t>(static_cast<int64_t>(offset) * 65535 / range - 32768);
+}
+
+/* ----------------------------------------------- */
+
+static bool toTarget(HIDIOType type, HIDFieldProgram::Target &target)
+{
+    switch (type)
+    {
+    case HIDIOType::Button:
+        target = HIDFieldProgram::Target::Button;
+        return true;
+    case HIDIOType::X:
+        target = HIDFieldProgram::Target::X;
+        return true;
+    case HIDIOType::Y:
+        target = HIDFieldProgram::Target::Y;
+        return true;
+    case HIDIOType::Z:
+        target = HIDFieldProgram::Target::Z;
+        return true;
+    case HIDIOType::Rx:
+        target = HIDFieldProgram::Target::Rx;
+        return true;
+    case HIDIOType::Ry:
+        target = HIDFieldProgram::Target::Ry;
+        return true;
+    case HIDIOType::Rz:
+        target = HIDFieldProgram::Target::Rz;
+        return true;
+    case HIDIOType::Slider:
+        target = HIDFieldProgram::Target::Slider;
+        return true;
+    case HIDIOType::Dial:
+        target = HIDFieldProgram::Target::Dial;
+        return true;
+    case HIDIOType::HatSwitch:
+        target = HIDFieldProgram::Target::HatSwitch;
+        return true;
+    default:
+        return false;
+    }
+}
+
+/* ----------------------------------------------- */
+
+bool HIDFieldProgram::compile(const std::vector<HIDIOReport> &reports)
+{
+    m_block_count = 0;
+    m_field_count = 0;
+    uint8_t joystick_count = 0;
+
+    for (const auto &report : reports)
+    {
+        if (report.report_type != HIDIOReportType::Joystick && report.report_type != HIDIOReportType::GamePad)
+            continue;
+
+        joystick_count += 1;
+
+        for (const auto &ioblock : report.inputs)
+        {
+            if (ioblock.data.empty())
+                continue;
+
+            if (m_block_count >= MAX_BLOCKS)
+            {
+                m_block_count = 0;
+                return false;
+            }
+
+            Block &block = m_blocks[m_block_count];
+            block.report_id = -1;
+            block.report_id_size = 0;
+            block.joystick_index = joystick_count - 1;
+            block.first_field = m_field_count;
+            block.field_count = 0;
+
+            uint32_t bit_offset = 0;
+
+            for (const auto &input : ioblock.data)
+            {
+                const uint32_t offset = bit_offset;
+                bit_offset += input.size;
+
+                //Report ids always open a block, see HIDReportDescriptor::parse()
+                if (input.type == HIDIOType::ReportId)
+                {
+                    block.report_id = static_cast<int16_t>(input.id);
+                    block.report_id_size = static_cast<uint8_t>(input.size);
+                    continue;
+                }
+
+                Target target;
+                if (!toTarget(input.type, target) || input.size == 0 || input.size > 32)
+                    continue; //Padding, vendor defined and unhandled usages only take up space
+
+                //Buttons past the end of HIDJoystickData are dropped instead of failing the whole report
+                if (target == Target::Button && input.id >= MAX_BUTTONS)
+                    continue;
+
+                if (m_field_count >= MAX_FIELDS || offset > UINT16_MAX)
+                {
+                    m_block_count = 0;
+                    return false;
+                }
+
+                Field &field = m_fields[m_field_count++];
+                field.bit_offset = static_cast<uint16_t>(offset);
+                field.bit_size = static_cast<uint8_t>(input.size);
+                field.target = target;
+                field.button = static_cast<uint8_t>((target == Target::Button) ? input.id : 0);
+                field.logical_min = input.logical_min;
+                field.logical_max = input.logical_max;
+                block.field_count++;
+            }
+
+            if (bit_offset > UINT16_MAX)
+            {
+                m_block_count = 0;
+                return false;
+            }
+
+            block.bit_length = static_cast<uint16_t>(bit_offset);
+            m_block_count++;
+        }
+    }
+
+    return isValid();
+}
+
+/* ----------------------------------------------- */
+
+bool HIDFieldProgram::parseData(const uint8_t *data, uint16_t datalen, HIDJoystickData *joystick_data) const
+{
+    const uint32_t data_bits = static_cast<uint32_t>(datalen) * 8;
+    uint32_t values[MAX_FIELDS];
+
+    for (uint8_t b = 0; b < m_block_count; b++)
+    {
+        const Block &block = m_blocks[b];
+
+        if (block.report_id >= 0)
+        {
+            if (block.report_id_size > data_bits)
+                return false;
+
+            if (HIDUtils::readBitsLE(data, 0, block.report_id_size) != static_cast<uint32_t>(block.report_id))
+                continue;
+        }
+
+        if (block.bit_length > data_bits)
+            return false;
+
+        joystick_data->index = block.joystick_index;
+
+        const Field *field = &m_fields[block.first_field];
+        HIDUtils::readFieldsLE(data, datalen, field, block.field_count, values);
+
+        for (uint8_t i = 0; i < block.field_count; ++i, ++field)
+        {
+            const uint32_t value = values[i];
+
+            switch (field->target)
+            {
+            case Target::Button:
+                joystick_data->buttons[field->button] = value;
+                if (joystick_data->button_count < field->button)
+                    joystick_data->button_count = field->button;
+                break;
+            case Target::X:
+                joystick_data->support |= JOYSTICK_SUPPORT_X;
+                joystick_data->X = mapAxis(value, *field);
+                break;
+            case Target::Y:
+                joystick_data->support |= JOYSTICK_SUPPORT_Y;
+                joystick_data->Y = mapAxis(value, *field);
+                break;
+            case Target::Z:
+                joystick_data->support |= JOYSTICK_SUPPORT_Z;
+                joystick_data->Z = mapAxis(value, *field);
+                break;
+            case Target::Rx:
+                joystick_data->support |= JOYSTICK_SUPPORT_Rx;
+                joystick_data->Rx = mapAxis(value, *field);
+                break;
+            case Target::Ry:
+                joystick_data->support |= JOYSTICK_SUPPORT_Ry;
+                joystick_data->Ry = mapAxis(value, *field);
+                break;
+            case Target::Rz:
+                joystick_data->support |= JOYSTICK_SUPPORT_Rz;
+                joystick_data->Rz = mapAxis(value, *field);
+                break;
+            case Target::Slider:
+                joystick_data->support |= JOYSTICK_SUPPORT_Slider;
+                joystick_data->Slider = mapAxis(value, *field);
+                break;
+            case Target::Dial:
+                joystick_data->support |= JOYSTICK_SUPPORT_Dial;
+                joystick_data->Dial = mapAxis(value, *field);
+                break;
+            case Target::HatSwitch:
+                joystick_data->support |= JOYSTICK_SUPPORT_HatSwitch;
+                joystick_data->hat_switch = static_cast<HIDJoystickHatSwitch>(value);
+                break;
+            }
+        }
+        return true;
+    }
+
+    return false;
+}
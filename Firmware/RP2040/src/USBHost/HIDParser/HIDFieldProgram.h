@@ -0,0 +1,69 @@
+#pragma once
+
+#include <stdint.h>
+#include <array>
+#include <vector>
+
+#include "USBHost/HIDParser/HIDReportDescriptor.h"
+#include "USBHost/HIDParser/HIDJoystick.h"
+
+// Joystick/gamepad inputs of a parsed HIDReportDescriptor lowered to flat arrays.
+// Compiled once when the device is mounted, parseData() then reads each field at
+// a precomputed bit offset without walking the descriptor or allocating.
+class HIDFieldProgram
+{
+public:
+    static constexpr uint8_t MAX_BLOCKS = 8;
+    static constexpr uint8_t MAX_FIELDS = 64;
+
+    enum class Target : uint8_t
+    {
+        Button = 0,
+        X,
+        Y,
+        Z,
+        Rx,
+        Ry,
+        Rz,
+        Slider,
+        Dial,
+        HatSwitch
+    };
+
+    struct Field
+    {
+        uint16_t bit_offset;
+        uint8_t bit_size;
+        Target target;
+        uint8_t button; //Button index, only used by Target::Button
+        int32_t logical_min;
+        int32_t logical_max;
+    };
+
+    //One input block per report id, same layout HIDJoystick::parseData() walks
+    struct Block
+    {
+        int16_t report_id; //-1 if the block has no report id
+        uint8_t report_id_size;
+        uint8_t joystick_index;
+        uint16_t bit_length;
+        uint8_t first_field;
+        uint8_t field_count;
+    };
+
+    HIDFieldProgram() {}
+    ~HIDFieldProgram() {}
+
+    //Returns false if the descriptor has no joystick inputs or doesn't fit the fixed tables
+    bool compile(const std::vector<HIDIOReport> &reports);
+    bool isValid() const { return m_block_count > 0; }
+
+    //Same semantics as HIDJoystick::parseData()
+    bool parseData(const uint8_t *data, uint16_t datalen, HIDJoystickData *joystick_data) const;
+
+private:
+    std::array<Block, MAX_BLOCKS> m_blocks;
+    std::array<Field, MAX_FIELDS> m_fields;
+    uint8_t m_block_count{0};
+    uint8_t m_field_count{0};
+};
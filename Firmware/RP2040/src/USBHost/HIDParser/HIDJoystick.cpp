@@ -66,6 +66,12 @@ HIDJoystick::HIDJoystick(const std::shared_ptr<HIDReportDescriptor> &descriptor)
 
 /* ----------------------------------------------- */
 
+HIDJoystick::HIDJoystick(const std::vector<HIDIOReport> &reports) : m_reports(reports)
+{
+}
+
+/* ----------------------------------------------- */
+
 HIDJoystick::~HIDJoystick()
 {
 }
@@ -83,7 +89,7 @@ uint8_t HIDJoystick::getCount()
 {
     uint8_t count = 0;
 
-    for (auto report : this->m_reports)
+    for (const auto &report : this->m_reports)
     {
         if (report.report_type == HIDIOReportType::Joystick || report.report_type == HIDIOReportType::GamePad)
             count++;
@@ -94,25 +100,25 @@ uint8_t HIDJoystick::getCount()
 
 /* ----------------------------------------------- */
 
-bool HIDJoystick::parseData(uint8_t *data, uint16_t datalen, HIDJoystickData *joystick_data)
+bool HIDJoystick::parseData(const uint8_t *data, uint16_t datalen, HIDJoystickData *joystick_data)
 {
     bool found = false;
     uint8_t joystick_count = 0;
 
     for (uint32_t i = 0; i < this->m_reports.size(); i++)
     {
-        auto report = this->m_reports[i];
+        const auto &report = this->m_reports[i];
 
         if (report.report_type != HIDIOReportType::Joystick && report.report_type != HIDIOReportType::GamePad)
             continue;
 
         joystick_count += 1;
 
-        for (auto ioblock : report.inputs)
+        for (const auto &ioblock : report.inputs)
         {
             uint32_t bitOffset = 0;
 
-            for (auto input : ioblock.data)
+            for (const auto &input : ioblock.data)
             {
                 uint32_t value = HIDUtils::readBitsLE(data, bitOffset, input.size);
                 bitOffset += input.size;
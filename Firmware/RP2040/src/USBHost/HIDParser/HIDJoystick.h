@@ -22,6 +22,8 @@
     SOFTWARE.
 */
 
+#pragma once
+
 #include "USBHost/HIDParser/HIDReportDescriptor.h"
 #include <memory>
 #include <vector>
@@ -80,12 +82,13 @@ class HIDJoystick
 {
 public:
     HIDJoystick(const std::shared_ptr<HIDReportDescriptor> &descriptor);
+    HIDJoystick(const std::vector<HIDIOReport> &reports);
     ~HIDJoystick();
 
     bool isValid();
     uint8_t getCount();
 
-    bool parseData(uint8_t *data, uint16_t datalen, HIDJoystickData *joystick_data);
+    bool parseData(const uint8_t *data, uint16_t datalen, HIDJoystickData *joystick_data);
 
 private:
     std::vector<HIDIOReport> m_reports;
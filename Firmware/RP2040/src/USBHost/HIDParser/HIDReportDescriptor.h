@@ -116,7 +116,7 @@ public:
     HIDReportDescriptor(const uint8_t *hid_report_data, uint16_t hid_report_data_size);
     ~HIDReportDescriptor();
 
-    std::vector<HIDIOReport> GetReports() const { return m_reports; }
+    const std::vector<HIDIOReport> &GetReports() const { return m_reports; }
     
 private:
     void parse(const uint8_t *hid_report_data, uint16_t hid_report_data_len);
@@ -101,9 +101,13 @@ HIDUsage::~HIDUsage()
 /* -------------------------------------------------------------------------- */
 
 HIDProperty::HIDProperty(uint32_t size, uint32_t count) : logical_min(0),
+                                                          logical_min_unsigned(0),
                                                           logical_max(0),
+                                                          logical_max_unsigned(0),
                                                           physical_min(0),
+                                                          physical_min_unsigned(0),
                                                           physical_max(0),
+                                                          physical_max_unsigned(0),
                                                           unit(0),
                                                           unit_exponent(0),
                                                           size(size),
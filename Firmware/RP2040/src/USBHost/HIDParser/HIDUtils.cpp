@@ -24,27 +24,45 @@
 
 #include "USBHost/HIDParser/HIDUtils.h"
 
-uint32_t HIDUtils::readBitsLE(uint8_t *buffer, uint32_t bitOffset, uint32_t bitLength) {
-    // Calculate the starting byte index and bit index within that byte
-    uint32_t byteIndex = bitOffset / 8;
-    uint32_t bitIndex = bitOffset % 8;  // Little endian, LSB is at index 0
-
-    uint32_t result = 0;
-
-    for (uint32_t i = 0; i < bitLength; ++i) {
-        // Check if we need to move to the next byte
-        if (bitIndex > 7) {
-            ++byteIndex;
-            bitIndex = 0;
-        }
-
-        // Get the bit at the current position and add it to the result
-        uint8_t bit = (buffer[byteIndex] >> bitIndex) & 0x01;
-        result |= (bit << i);
-
-        // Move to the next bit
-        ++bitIndex;
+// Cortex-M0+ faults on unaligned word loads, so only the bytes a field covers
+// are gathered into a word and the field is shifted out of it in one go.
+uint32_t HIDUtils::readBitsLE(const uint8_t *buffer, uint32_t bitOffset, uint32_t bitLength) {
+    if (bitLength > 32) {
+        bitLength = 32;
     }
 
-    return result;
-}
\ No newline at end of file
+    const uint8_t *bytes = buffer + (bitOffset / 8);
+    const uint32_t bitIndex = bitOffset % 8;  // Little endian, LSB is at index 0
+    const uint32_t byteCount = (bitIndex + bitLength + 7) / 8;
+
+    if (byteCount == 1) {
+        return (bytes[0] >> bitIndex) & maskBits(bitLength);
+    }
+
+    uint32_t word = 0;
+    for (uint32_t i = 0; i < byteCount && i < 4; ++i) {
+        word |= static_cast<uint32_t>(bytes[i]) << (i * 8);
+    }
+    word >>= bitIndex;
+
+    // A 32 bit field that isn't byte aligned spills into a fifth byte
+    if (byteCount > 4) {
+        word |= static_cast<uint32_t>(bytes[4]) << (32 - bitIndex);
+    }
+
+    return word & maskBits(bitLength);
+}
+
+uint64_t HIDUtils::loadWindowLE(const uint8_t *buffer, uint32_t bufferLength, uint32_t byteIndex) {
+    uint32_t low = 0;
+    uint32_t high = 0;
+
+    for (uint32_t i = 0; i < 4 && byteIndex + i < bufferLength; ++i) {
+        low |= static_cast<uint32_t>(buffer[byteIndex + i]) << (i * 8);
+    }
+    for (uint32_t i = 0; i < 4 && byteIndex + 4 + i < bufferLength; ++i) {
+        high |= static_cast<uint32_t>(buffer[byteIndex + 4 + i]) << (i * 8);
+    }
+
+    return (static_cast<uint64_t>(high) << 32) | low;
+}
@@ -31,5 +31,46 @@ public:
 	HIDUtils() {}
 	~HIDUtils() {}
 
-	static uint32_t readBitsLE(uint8_t *buffer, uint32_t bitOffset, uint32_t bitLength);
-};
\ No newline at end of file
+	static uint32_t readBitsLE(const uint8_t *buffer, uint32_t bitOffset, uint32_t bitLength);
+
+	// Reads count fields from one report in a single pass, Field needs bit_offset and bit_size members.
+	// Fields sorted by offset reuse the bytes already loaded, bytes past bufferLength read as 0.
+	template <typename Field>
+	static void readFieldsLE(const uint8_t *buffer, uint32_t bufferLength, const Field *fields, uint32_t count, uint32_t *values)
+	{
+		uint32_t windowByte = 0;
+		uint32_t windowEnd = 0;
+		uint64_t window = 0;
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const uint32_t bitOffset = fields[i].bit_offset;
+			const uint32_t bitLength = (fields[i].bit_size > 32) ? 32 : fields[i].bit_size;
+			if (bitLength == 0)
+			{
+				values[i] = 0;
+				continue;
+			}
+
+			const uint32_t byteIndex = bitOffset / 8;
+			const uint32_t byteEnd = (bitOffset + bitLength + 7) / 8;
+
+			if (byteIndex < windowByte || byteEnd > windowEnd)
+			{
+				windowByte = byteIndex;
+				windowEnd = byteIndex + 8;
+				window = loadWindowLE(buffer, bufferLength, byteIndex);
+			}
+
+			values[i] = static_cast<uint32_t>(window >> ((byteIndex - windowByte) * 8 + bitOffset % 8)) & maskBits(bitLength);
+		}
+	}
+
+private:
+	static inline uint32_t maskBits(uint32_t bitLength)
+	{
+		return (bitLength >= 32) ? 0xFFFFFFFF : ((1u << bitLength) - 1);
+	}
+
+	static uint64_t loadWindowLE(const uint8_t *buffer, uint32_t bufferLength, uint32_t byteIndex);
+};
@@ -2,8 +2,11 @@
 #define _HW_ID_H_
 
 #include <cstdint>
+#include <cstddef>
+#include <array>
+#include <algorithm>
 
-#include "USBHost/HostDriver/HostDriver.h"
+#include "USBHost/HostDriver/HostDriverTypes.h"
 
 struct HardwareID
 {
@@ -11,79 +14,133 @@ struct HardwareID
     uint16_t pid;
 };
 
-static const HardwareID DINPUT_IDS[] =
+//Per device workarounds, applied by whatever owns that part of the stack
+namespace HardwareQuirk
 {
-    {0x044F, 0xB324}, // ThrustMaster Dual Trigger (PS3 mode)
-    {0x0738, 0x8818}, // MadCatz Street Fighter IV Arcade FightStick
-    {0x0810, 0x0003}, // Personal Communication Systems, Inc. Generic
-    {0x146B, 0x0902}, // BigBen Interactive Wired Mini PS3 Game Controller
-    {0x2563, 0x0575}, // SHANWAN 2In1 USB Joystick
-    {0x046D, 0xC218} // Logitech RumblePad 2
-};
+    static constexpr uint8_t NONE              = 0;
+    static constexpr uint8_t POLL_INTERVAL     = (1 << 0); //Interrupt IN bInterval replaced with HardwareIDEntry::poll_interval_ms
+    static constexpr uint8_t INVERT_Y          = (1 << 1); //Y axes report up as positive
+    static constexpr uint8_t NEEDS_INIT_REPORT = (1 << 2); //Sends nothing until an output report is written
+}
 
-static const HardwareID PS3_IDS[] =
+struct HardwareIDEntry
 {
-    {0x054C, 0x0268}, // Sony Batoh (Dualshock 3)
+    HardwareID id;
+    HostDriverType type;
+    uint8_t quirks{HardwareQuirk::NONE};
+    uint8_t poll_interval_ms{0};
 };
 
-static const HardwareID PS4_IDS[] =
+static constexpr HardwareIDEntry DINPUT_IDS[] =
 {
-    {0x054C, 0x05C4}, // DS4
-    {0x054C, 0x09CC}, // DS4
-    {0x054C, 0x0BA0}, // DS4 wireless adapter
-    {0x2563, 0x0357}, // MPOW Wired Gamepad (ShenZhen ShanWan)
-    {0x0F0D, 0x005E}, // Hori FC4
-    {0x0F0D, 0x00EE}, // Hori PS4 Mini (PS4-099U)
-    {0x1F4F, 0x1002}  // ASW GG Xrd controller
+    { {0x044F, 0xB324}, HostDriverType::DINPUT }, // ThrustMaster Dual Trigger (PS3 mode)
+    { {0x0738, 0x8818}, HostDriverType::DINPUT }, // MadCatz Street Fighter IV Arcade FightStick
+    { {0x0810, 0x0003}, HostDriverType::DINPUT }, // Personal Communication Systems, Inc. Generic
+    { {0x146B, 0x0902}, HostDriverType::DINPUT }, // BigBen Interactive Wired Mini PS3 Game Controller
+    { {0x2563, 0x0575}, HostDriverType::DINPUT }, // SHANWAN 2In1 USB Joystick
+    { {0x046D, 0xC218}, HostDriverType::DINPUT } // Logitech RumblePad 2
 };
 
-static const HardwareID PS5_IDS[] =
+static constexpr HardwareIDEntry PS3_IDS[] =
 {
-    {0x054C, 0x0CE6}, // dualsense
-    {0x054C, 0x0DF2} // dualsense edge
+    { {0x054C, 0x0268}, HostDriverType::PS3 }, // Sony Batoh (Dualshock 3)
 };
 
-static const HardwareID PSCLASSIC_IDS[] =
+static constexpr HardwareIDEntry PS4_IDS[] =
 {
-    {0x054C, 0x0CDA} // psclassic
+    { {0x054C, 0x05C4}, HostDriverType::PS4 }, // DS4
+    { {0x054C, 0x09CC}, HostDriverType::PS4 }, // DS4
+    { {0x054C, 0x0BA0}, HostDriverType::PS4 }, // DS4 wireless adapter
+    { {0x2563, 0x0357}, HostDriverType::PS4 }, // MPOW Wired Gamepad (ShenZhen ShanWan)
+    { {0x0F0D, 0x005E}, HostDriverType::PS4 }, // Hori FC4
+    { {0x0F0D, 0x00EE}, HostDriverType::PS4 }, // Hori PS4 Mini (PS4-099U)
+    { {0x1F4F, 0x1002}, HostDriverType::PS4 }  // ASW GG Xrd controller
 };
 
-static const HardwareID SWITCH_PRO_IDS[] =
+static constexpr HardwareIDEntry PS5_IDS[] =
 {
-    {0x057E, 0x2009}, // Switch Pro
-    // {0x20D6, 0xA711}, // OpenSteamController, emulated pro controller
+    { {0x054C, 0x0CE6}, HostDriverType::PS5 }, // dualsense
+    { {0x054C, 0x0DF2}, HostDriverType::PS5 } // dualsense edge
 };
 
-static const HardwareID SWITCH_WIRED_IDS[] =
+static constexpr HardwareIDEntry PSCLASSIC_IDS[] =
 {
-    {0x20D6, 0xA719}, // PowerA wired
-    {0x20D6, 0xA713}, // PowerA Enhanced wired
-    {0x0F0D, 0x0092}, // Hori Pokken Tournament Pro
-    {0x0F0D, 0x00C1}, // Hori Pokken Horipad
+    { {0x054C, 0x0CDA}, HostDriverType::PSCLASSIC } // psclassic
 };
 
-static const HardwareID N64_IDS[] =
+static constexpr HardwareIDEntry SWITCH_PRO_IDS[] =
 {
-    {0x0079, 0x0006} // Retrolink N64 USB gamepad
+    { {0x057E, 0x2009}, HostDriverType::SWITCH_PRO }, // Switch Pro
+    // { {0x20D6, 0xA711}, HostDriverType::SWITCH_PRO }, // OpenSteamController, emulated pro controller
 };
 
-struct HostTypeMap
+static constexpr HardwareIDEntry SWITCH_WIRED_IDS[] =
 {
-    const HardwareID* ids;
-    size_t num_ids;
-    HostDriverType type;
+    { {0x20D6, 0xA719}, HostDriverType::SWITCH }, // PowerA wired
+    { {0x20D6, 0xA713}, HostDriverType::SWITCH }, // PowerA Enhanced wired
+    { {0x0F0D, 0x0092}, HostDriverType::SWITCH }, // Hori Pokken Tournament Pro
+    { {0x0F0D, 0x00C1}, HostDriverType::SWITCH }, // Hori Pokken Horipad
 };
 
-static const HostTypeMap HOST_TYPE_MAP[] = 
+static constexpr HardwareIDEntry N64_IDS[] =
 {
-    { DINPUT_IDS, sizeof(DINPUT_IDS) / sizeof(HardwareID), HostDriverType::DINPUT },
-    { PS4_IDS, sizeof(PS4_IDS) / sizeof(HardwareID), HostDriverType::PS4 },
-    { PS5_IDS, sizeof(PS5_IDS) / sizeof(HardwareID), HostDriverType::PS5 },
-    { PS3_IDS, sizeof(PS3_IDS) / sizeof(HardwareID), HostDriverType::PS3 },
-    { SWITCH_WIRED_IDS, sizeof(SWITCH_WIRED_IDS) / sizeof(HardwareID), HostDriverType::SWITCH },
-    { SWITCH_PRO_IDS, sizeof(SWITCH_PRO_IDS) / sizeof(HardwareID), HostDriverType::SWITCH_PRO },
-    { PSCLASSIC_IDS, sizeof(PSCLASSIC_IDS) / sizeof(HardwareID), HostDriverType::PSCLASSIC },
-    { N64_IDS, sizeof(N64_IDS) / sizeof(HardwareID), HostDriverType::N64 },
+    { {0x0079, 0x0006}, HostDriverType::N64 } // Retrolink N64 USB gamepad
 };
 
-#endif // _HW_ID_H_
\ No newline at end of file
+
+namespace HardwareIDs
+{
+    constexpr uint32_t key(const HardwareID& id)
+    {
+        return (static_cast<uint32_t>(id.vid) << 16) | id.pid;
+    }
+
+    //Merges the per driver lists above into one table sorted by VID/PID
+    template <size_t... Ns>
+    constexpr auto sorted_table(const HardwareIDEntry (&... lists)[Ns])
+    {
+        std::array<HardwareIDEntry, (Ns + ...)> table{};
+        size_t pos = 0;
+        ((std::copy(lists, lists + Ns, table.begin() + pos), pos += Ns), ...);
+
+        std::sort(table.begin(), table.end(), 
+            [](const HardwareIDEntry& a, const HardwareIDEntry& b) { return key(a.id) < key(b.id); });
+        return table;
+    }
+
+    //Sorted, so any repeated VID/PID ends up next to itself
+    template <size_t N>
+    constexpr bool unique_ids(const std::array<HardwareIDEntry, N>& table)
+    {
+        for (size_t i = 1; i < N; ++i)
+        {
+            if (key(table[i - 1].id) == key(table[i].id))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //Binary search over a table sorted by key(), nullptr if the device isn't listed
+    constexpr const HardwareIDEntry* find(const HardwareIDEntry* table, size_t count, const HardwareID& id)
+    {
+        const uint32_t target = key(id);
+        const HardwareIDEntry* entry = std::lower_bound(table, table + count, target, 
+            [](const HardwareIDEntry& e, uint32_t k) { return key(e.id) < k; });
+
+        return (entry != table + count && key(entry->id) == target) ? entry : nullptr;
+    }
+}
+
+inline constexpr auto HARDWARE_ID_TABLE = HardwareIDs::sorted_table(
+    DINPUT_IDS, PS3_IDS, PS4_IDS, PS5_IDS, PSCLASSIC_IDS, SWITCH_PRO_IDS, SWITCH_WIRED_IDS, N64_IDS);
+
+static_assert(HardwareIDs::unique_ids(HARDWARE_ID_TABLE), "A VID/PID is listed more than once in HardwareIDs.h");
+
+inline const HardwareIDEntry* find_hardware_id(const HardwareID& id)
+{
+    return HardwareIDs::find(HARDWARE_ID_TABLE.data(), HARDWARE_ID_TABLE.size(), id);
+}
+
+#endif // _HW_ID_H_
@@ -0,0 +1,88 @@
+#include <cstring>
+#include <string>
+#include <algorithm>
+
+#include "UserSettings/NVSTool.h"
+#include "Board/ogxm_log.h"
+#include "USBHost/HostCache.h"
+
+namespace HostCache
+{
+    static constexpr uint8_t VERSION = 1;
+
+    struct Table
+    {
+        uint8_t version{VERSION};
+        uint8_t count{0};
+        Entry entries[MAX_ENTRIES]; //Newest first
+    };
+    static_assert(sizeof(Table) <= NVSTool::VALUE_LEN_MAX, "HostCache table doesn't fit in an NVS entry");
+
+    static Table table_;
+    static bool dirty_{false};
+
+    static const std::string KEY()
+    {
+        return std::string("host_cache");
+    }
+
+    void load()
+    {
+        if (!NVSTool::get_instance().read(KEY(), &table_, sizeof(Table)) || 
+            table_.version != VERSION || table_.count > MAX_ENTRIES)
+        {
+            table_ = Table();
+        }
+        dirty_ = false;
+        OGXM_LOG("Host cache: %u entries\n", static_cast<unsigned int>(table_.count));
+    }
+
+    void flush()
+    {
+        if (!dirty_)
+        {
+            return;
+        }
+        NVSTool::get_instance().write(KEY(), &table_, sizeof(Table));
+        dirty_ = false;
+    }
+
+    const Entry* find(uint16_t vid, uint16_t pid)
+    {
+        for (uint8_t i = 0; i < table_.count; ++i)
+        {
+            if (table_.entries[i].vid == vid && table_.entries[i].pid == pid)
+            {
+                return &table_.entries[i];
+            }
+        }
+        return nullptr;
+    }
+
+    void store(uint16_t vid, uint16_t pid, HostDriverType type, uint8_t init_hint)
+    {
+        const Entry entry = { vid, pid, static_cast<uint8_t>(type), init_hint };
+
+        for (uint8_t i = 0; i < table_.count; ++i)
+        {
+            Entry& cached = table_.entries[i];
+            if (cached.vid == vid && cached.pid == pid)
+            {
+                //Only rewrite flash when something changed
+                if (std::memcmp(&cached, &entry, sizeof(Entry)) != 0)
+                {
+                    cached = entry;
+                    dirty_ = true;
+                }
+                return;
+            }
+        }
+
+        //New VID/PID goes in front, the oldest one drops off the end when full
+        const uint8_t count = std::min<uint8_t>(table_.count, MAX_ENTRIES - 1);
+        std::copy_backward(table_.entries, table_.entries + count, table_.entries + count + 1);
+        table_.entries[0] = entry;
+        table_.count = static_cast<uint8_t>(count + 1);
+        dirty_ = true;
+    }
+}
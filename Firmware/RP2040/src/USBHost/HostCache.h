@@ -0,0 +1,41 @@
+#ifndef _HOST_CACHE_H_
+#define _HOST_CACHE_H_
+
+#include <cstdint>
+
+#include "USBHost/HostDriver/HostDriverTypes.h"
+
+// Driver type and init hint that last got each VID/PID to a working pad, so the next
+// connect can skip the init steps that only slowed it down last time.
+// Only the init hint is reused, the driver is still picked from the VID/PID and report descriptor
+// since the cache can't tell which interface was the gamepad. The stored type has to match it.
+// Lives in RAM while running, core1 updates it and core0 saves it to NVS while core1 is stopped.
+namespace HostCache
+{
+    static constexpr uint8_t MAX_ENTRIES = 16;
+
+    #pragma pack(push, 1)
+    struct Entry
+    {
+        uint16_t vid;
+        uint16_t pid;
+        uint8_t driver_type; //HostDriverType
+        uint8_t init_hint;   //HostDriver::init_hint()
+    };
+    static_assert(sizeof(Entry) == 6, "HostCache::Entry size mismatch");
+    #pragma pack(pop)
+
+    //Core0, before core1 is launched
+    void load();
+
+    //Core0, only after board_api::usb::disconnect_all() has stopped core1, flash writes stall both cores
+    void flush();
+
+    //Core1, nullptr if the VID/PID hasn't connected before
+    const Entry* find(uint16_t vid, uint16_t pid);
+
+    //Core1, the oldest VID/PID is dropped when the cache is full
+    void store(uint16_t vid, uint16_t pid, HostDriverType type, uint8_t init_hint);
+}
+
+#endif // _HOST_CACHE_H_
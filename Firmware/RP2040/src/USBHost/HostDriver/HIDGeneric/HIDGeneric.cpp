@@ -1,9 +1,7 @@
-#include <cstring>
-#include <memory>
-
 #include "host/usbh.h"
 #include "class/hid/hid_host.h"
 
+#include "Board/ogxm_log.h"
 #include "USBHost/HIDParser/HIDReportDescriptor.h"
 #include "USBHost/HostDriver/HIDGeneric/HIDGeneric.h"
 
@@ -13,24 +11,32 @@ void HIDHost::initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, co
     {
         return;
     }
-    
-    report_desc_len_ = desc_len;
-    std::memcpy(report_desc_buffer_.data(), report_desc, std::min(static_cast<size_t>(report_desc_len_), report_desc_buffer_.size()));
-    hid_joystick_ = std::make_unique<HIDJoystick>(std::make_shared<HIDReportDescriptor>(report_desc_buffer_.data(), report_desc_len_));
+
+    //The parse tree only lives in this scope, TinyUSB's enumeration buffer bounds desc_len.
+    //Descriptors with more blocks or fields than HIDFieldProgram holds keep a copy of their reports in HIDJoystick.
+    {
+        HIDReportDescriptor descriptor(report_desc, desc_len);
+        if (!field_program_.compile(descriptor.GetReports()))
+        {
+            joystick_.emplace(descriptor.GetReports());
+            if (!joystick_->isValid())
+            {
+                OGXM_LOG("HID descriptor has no joystick inputs\n");
+                joystick_.reset();
+                return;
+            }
+            OGXM_LOG("HID descriptor doesn't fit HIDFieldProgram, parsed by HIDJoystick\n");
+        }
+    }
 
     tuh_hid_receive_report(address, instance);
 }
 
 void HIDHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len)
 {
-    if (std::memcmp(prev_report_in_.data(), report, len) == 0)
-    {
-        tuh_hid_receive_report(address, instance);
-        return;
-    }
-
-    std::memcpy(prev_report_in_.data(), report, len);
-    if (!hid_joystick_->parseData(const_cast<uint8_t*>(report), len, &hid_joystick_data_))
+    const bool parsed = joystick_ ? joystick_->parseData(report, len, &hid_joystick_data_)
+                                  : field_program_.parseData(report, len, &hid_joystick_data_);
+    if (!parsed)
     {
         tuh_hid_receive_report(address, instance);
         return;
@@ -41,28 +47,28 @@ void HIDHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance
     switch (hid_joystick_data_.hat_switch)
     {
         case HIDJoystickHatSwitch::UP:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP;
+            gp_in.dpad |= Gamepad::DPAD_UP;
             break;
         case HIDJoystickHatSwitch::UP_RIGHT:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP_RIGHT;
+            gp_in.dpad |= Gamepad::DPAD_UP_RIGHT;
             break;
         case HIDJoystickHatSwitch::RIGHT:
-            gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
+            gp_in.dpad |= Gamepad::DPAD_RIGHT;
             break;
         case HIDJoystickHatSwitch::DOWN_RIGHT:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN_RIGHT;
+            gp_in.dpad |= Gamepad::DPAD_DOWN_RIGHT;
             break;
         case HIDJoystickHatSwitch::DOWN:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
+            gp_in.dpad |= Gamepad::DPAD_DOWN;
             break;
         case HIDJoystickHatSwitch::DOWN_LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN_LEFT;
+            gp_in.dpad |= Gamepad::DPAD_DOWN_LEFT;
             break;
         case HIDJoystickHatSwitch::LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
+            gp_in.dpad |= Gamepad::DPAD_LEFT;
             break;
         case HIDJoystickHatSwitch::UP_LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP_LEFT;
+            gp_in.dpad |= Gamepad::DPAD_UP_LEFT;
             break;
         default:
             break;
@@ -71,20 +77,23 @@ void HIDHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance
     std::tie(gp_in.joystick_lx, gp_in.joystick_ly) = gamepad.scale_joystick_l(hid_joystick_data_.X, hid_joystick_data_.Y);
     std::tie(gp_in.joystick_rx, gp_in.joystick_ry) = gamepad.scale_joystick_r(hid_joystick_data_.Z, hid_joystick_data_.Rz);
 
-    if (hid_joystick_data_.buttons[1])  gp_in.buttons |= gamepad.MAP_BUTTON_X;
-    if (hid_joystick_data_.buttons[2])  gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (hid_joystick_data_.buttons[3])  gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (hid_joystick_data_.buttons[4])  gp_in.buttons |= gamepad.MAP_BUTTON_Y;
-    if (hid_joystick_data_.buttons[5])  gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (hid_joystick_data_.buttons[6])  gp_in.buttons |= gamepad.MAP_BUTTON_RB;
+    if (hid_joystick_data_.buttons[1])  gp_in.buttons |= Gamepad::BUTTON_X;
+    if (hid_joystick_data_.buttons[2])  gp_in.buttons |= Gamepad::BUTTON_A;
+    if (hid_joystick_data_.buttons[3])  gp_in.buttons |= Gamepad::BUTTON_B;
+    if (hid_joystick_data_.buttons[4])  gp_in.buttons |= Gamepad::BUTTON_Y;
+    if (hid_joystick_data_.buttons[5])  gp_in.buttons |= Gamepad::BUTTON_LB;
+    if (hid_joystick_data_.buttons[6])  gp_in.buttons |= Gamepad::BUTTON_RB;
     if (hid_joystick_data_.buttons[7])  gp_in.trigger_l = Range::MAX<uint8_t>;
     if (hid_joystick_data_.buttons[8])  gp_in.trigger_r = Range::MAX<uint8_t>;
-    if (hid_joystick_data_.buttons[9])  gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (hid_joystick_data_.buttons[10]) gp_in.buttons |= gamepad.MAP_BUTTON_START;
-    if (hid_joystick_data_.buttons[11]) gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-    if (hid_joystick_data_.buttons[12]) gp_in.buttons |= gamepad.MAP_BUTTON_R3;
-    if (hid_joystick_data_.buttons[13]) gp_in.buttons |= gamepad.MAP_BUTTON_SYS;
-    if (hid_joystick_data_.buttons[14]) gp_in.buttons |= gamepad.MAP_BUTTON_MISC;
+    if (hid_joystick_data_.buttons[9])  gp_in.buttons |= Gamepad::BUTTON_BACK;
+    if (hid_joystick_data_.buttons[10]) gp_in.buttons |= Gamepad::BUTTON_START;
+    if (hid_joystick_data_.buttons[11]) gp_in.buttons |= Gamepad::BUTTON_L3;
+    if (hid_joystick_data_.buttons[12]) gp_in.buttons |= Gamepad::BUTTON_R3;
+    if (hid_joystick_data_.buttons[13]) gp_in.buttons |= Gamepad::BUTTON_SYS;
+    if (hid_joystick_data_.buttons[14]) gp_in.buttons |= Gamepad::BUTTON_MISC;
+
+    gp_in.dpad = gamepad.map_dpad(gp_in.dpad);
+    gp_in.buttons = gamepad.map_buttons(gp_in.buttons);
 
     gamepad.set_pad_in(gp_in);
 
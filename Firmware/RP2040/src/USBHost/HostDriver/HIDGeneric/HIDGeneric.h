@@ -2,12 +2,12 @@
 #define _HID_GENERIC_HOST_H_
 
 #include <cstdint>
-#include <array>
-#include <memory>
+#include <optional>
 
 #include "tusb_option.h"
 
 #include "USBHost/HIDParser/HIDJoystick.h"
+#include "USBHost/HIDParser/HIDFieldProgram.h"
 #include "USBHost/HostDriver/HostDriver.h"
 
 class HIDHost : public HostDriver
@@ -19,12 +19,13 @@ public:
     void initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, uint8_t const* report_desc, uint16_t desc_len) override;
     void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
     bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    std::span<const uint8_t> report_mask() const override { return IN_REPORT_MASK; }
 
 private:
-    std::array<uint8_t, 0x100> report_desc_buffer_;
-    uint16_t report_desc_len_{0};
-    std::array<uint8_t, CFG_TUH_HID_EPIN_BUFSIZE> prev_report_in_{0};
-    std::unique_ptr<HIDJoystick> hid_joystick_;
+    static constexpr auto IN_REPORT_MASK = ReportFilter::Mask<ReportFilter::MAX_REPORT_SIZE>().keep_all();
+    HIDFieldProgram field_program_;
+    //Only for descriptors too big for field_program_'s tables, its parsed reports stay on the heap until unmount
+    std::optional<HIDJoystick> joystick_;
     HIDJoystickData hid_joystick_data_;
 };
 
@@ -2,7 +2,9 @@
 #define _HOST_DRIVER_H_
 
 #include <cstdint>
+#include <span>
 
+#include "USBHost/ReportFilter.h"
 #include "UserSettings/UserProfile.h"
 #include "UserSettings/UserSettings.h"
 #include "Gamepad/Gamepad.h"
@@ -23,29 +25,66 @@ public:
 
     virtual void connect_cb(Gamepad& gamepad, uint8_t address, uint8_t instance) {}; //Wireless specific
     virtual void disconnect_cb(Gamepad& gamepad, uint8_t address, uint8_t instance) {}; //Wireless specific
+    virtual void report_sent_cb(Gamepad& gamepad, uint8_t address, uint8_t instance) {}; //OUT transfer complete
 
-protected:
-    const uint8_t idx_;
+    //Bits of the IN report that matter, HostManager drops reports where none of them changed.
+    //Empty lets every report through.
+    virtual std::span<const uint8_t> report_mask() const { return {}; }
+
+    //False while a multi step init sequence is still running
+    virtual bool init_done() const { return true; }
+
+    //What the init sequence learned about this pad, HostCache keeps it per VID/PID and
+    //hands it back through set_init_hint() before initialize() on the next connect
+    virtual uint8_t init_hint() const { return 0; }
+    virtual void set_init_hint(uint8_t hint) {}
+
+    //Shortest gap between OUT reports the pad handles, HostManager holds back feedback until it has passed
+    virtual uint32_t feedback_interval_ms() const { return FEEDBACK_INTERVAL_MS; }
 
-    void manage_rumble(Gamepad& gamepad)
+    //True if the last feedback sent rumble that still needs to be cleared
+    bool feedback_pending() const { return rumble_clear_pending_; }
+
+    //What the pad is left with once pending rumble is cleared, max stays on until the device side changes it
+    static Gamepad::PadOut cleared_rumble(Gamepad::PadOut gp_out)
     {
-        Gamepad::PadOut gp_out = gamepad.get_pad_out();
-        bool reset = false;
         if (gp_out.rumble_l != Range::MAX<uint8_t>)
         {
             gp_out.rumble_l = 0;
-            reset = true;
         }
         if (gp_out.rumble_r != Range::MAX<uint8_t>)
         {
             gp_out.rumble_r = 0;
-            reset = true;
-        }
-        if (reset)
-        {
-            gamepad.set_pad_out(gp_out);
         }
+        return gp_out;
     }
+
+protected:
+    static constexpr uint32_t FEEDBACK_INTERVAL_MS = 8;
+
+    const uint8_t idx_;
+
+    //Rumble values below max are only sent once per write from the device side,
+    //pad_out only has one writer so this is tracked here instead of clearing it in the gamepad
+    Gamepad::PadOut get_rumble(Gamepad& gamepad)
+    {
+        Gamepad::PadOut gp_out = gamepad.get_pad_out(rumble_read_gen_);
+        return (rumble_read_gen_ == rumble_reset_gen_) ? cleared_rumble(gp_out) : gp_out;
+    }
+
+    void manage_rumble(const Gamepad::PadOut& gp_out)
+    {
+        rumble_reset_gen_ = rumble_read_gen_;
+        rumble_clear_pending_ = 
+            (gp_out.rumble_l != 0 && gp_out.rumble_l != Range::MAX<uint8_t>) ||
+            (gp_out.rumble_r != 0 && gp_out.rumble_r != Range::MAX<uint8_t>);
+    }
+
+private:
+    //Generations are always even
+    uint32_t rumble_read_gen_{1};
+    uint32_t rumble_reset_gen_{1};
+    bool rumble_clear_pending_{false};
 };
 
 #endif // _HOST_DRIVER_H_
\ No newline at end of file
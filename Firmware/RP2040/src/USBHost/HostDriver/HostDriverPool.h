@@ -0,0 +1,70 @@
+#ifndef _HOST_DRIVER_POOL_H_
+#define _HOST_DRIVER_POOL_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <new>
+#include <type_traits>
+
+#include "USBHost/HostDriver/HostDriver.h"
+
+//Fixed storage for host drivers, one slot per gamepad sized for the largest driver.
+//Drivers are placement constructed on mount and destroyed on unmount, the pool itself never touches the heap.
+template <uint8_t SLOTS, typename... Drivers>
+class HostDriverPool
+{
+    static_assert((std::is_base_of_v<HostDriver, Drivers> && ...), "HostDriverPool only holds HostDriver types");
+
+public:
+    static constexpr size_t SLOT_SIZE = std::max({ sizeof(Drivers)... });
+    static constexpr size_t SLOT_ALIGN = std::max({ alignof(Drivers)... });
+    static constexpr size_t TOTAL_BYTES = SLOT_SIZE * SLOTS;
+
+    HostDriverPool() = default;
+    HostDriverPool(const HostDriverPool&) = delete;
+    HostDriverPool& operator=(const HostDriverPool&) = delete;
+
+    ~HostDriverPool()
+    {
+        for (uint8_t i = 0; i < SLOTS; ++i)
+        {
+            destroy(i);
+        }
+    }
+
+    //The slot is the gamepad index the driver is bound to, whatever is in it is destroyed first
+    template <typename Driver>
+    HostDriver* emplace(uint8_t gp_idx)
+    {
+        static_assert((std::is_same_v<Driver, Drivers> || ...), "Driver must be listed in the pool's driver types");
+
+        if (gp_idx >= SLOTS)
+        {
+            return nullptr;
+        }
+        destroy(gp_idx);
+        drivers_[gp_idx] = new (storage_[gp_idx].data) Driver(gp_idx);
+        return drivers_[gp_idx];
+    }
+
+    void destroy(uint8_t gp_idx)
+    {
+        if (gp_idx < SLOTS && drivers_[gp_idx])
+        {
+            drivers_[gp_idx]->~HostDriver();
+            drivers_[gp_idx] = nullptr;
+        }
+    }
+
+private:
+    struct Slot
+    {
+        alignas(SLOT_ALIGN) unsigned char data[SLOT_SIZE];
+    };
+
+    Slot storage_[SLOTS];
+    HostDriver* drivers_[SLOTS]{nullptr};
+};
+
+#endif // _HOST_DRIVER_POOL_H_
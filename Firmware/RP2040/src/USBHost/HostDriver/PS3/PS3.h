@@ -18,6 +18,10 @@ public:
     void initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len) override;
     void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
     bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    std::span<const uint8_t> report_mask() const override { return IN_REPORT_MASK; }
+    bool init_done() const override { return init_state_.reports_enabled; }
+    //Spamming set_report doesn't work, limit the rate
+    uint32_t feedback_interval_ms() const override { return 300; }
 
 private:
     enum class InitStage { RESP1, RESP2, RESP3, DONE };
@@ -33,7 +37,8 @@ private:
 
     static const tusb_control_request_t RUMBLE_REQUEST;
 
-    PS3::InReport prev_in_report_;
+    //Everything past the analog buttons is motion data
+    static constexpr auto IN_REPORT_MASK = ReportFilter::Mask<26>().keep_all();
     PS3::OutReport out_report_;
     InitState init_state_;
 
@@ -2,6 +2,7 @@
 #define _PS4_HOST_H_
 
 #include <cstdint>
+#include <cstddef>
 
 #include "Descriptors/PS4.h"
 #include "USBHost/HostDriver/HostDriver.h"
@@ -15,10 +16,14 @@ public:
     void initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len) override;
     void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
     bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    std::span<const uint8_t> report_mask() const override { return IN_REPORT_MASK; }
 
 private:
     PS4::InReport in_report_{};
-    PS4::InReport prev_in_report_{};
+    //The report counter shares a byte with the PS and touchpad buttons
+    static constexpr auto IN_REPORT_MASK = ReportFilter::Mask<sizeof(PS4::InReport)>()
+        .keep_all()
+        .keep(offsetof(PS4::InReport, buttons) + 2, 1, static_cast<uint8_t>(~PS4::COUNTER_MASK));
     PS4::OutReport out_report_{};
 };
 
@@ -3,8 +3,14 @@
 #include "host/usbh.h"
 #include "class/hid/hid_host.h"
 
+#include "TaskQueue/TaskQueue.h"
 #include "USBHost/HostDriver/PS5/PS5.h"
 
+PS5Host::~PS5Host()
+{
+    TaskQueue::Core1::cancel_delayed_task(tid_init_);
+}
+
 void PS5Host::initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len) 
 {
     out_report_.report_id = PS5::OutReportID::CONTROL;
@@ -16,75 +22,90 @@ void PS5Host::initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, co
     out_report_.player_number = idx_ + 1;
     out_report_.lightbar_blue = 0xFF;
 
-    while (!tuh_hid_send_report(address, instance, 0, &out_report_, sizeof(PS5::OutReport)))
+    init_pending_ = true;
+
+    //Retried from the timer while the OUT endpoint is busy, the host stack keeps running in between
+    if (!send_init_report(address, instance))
+    {
+        tid_init_ = TaskQueue::Core1::get_new_task_id();
+        TaskQueue::Core1::queue_delayed_task(tid_init_, INIT_RETRY_MS, true, 
+        [this, address, instance]
+        {
+            if (!init_pending_ || send_init_report(address, instance))
+            {
+                TaskQueue::Core1::cancel_delayed_task(tid_init_);
+            }
+        });
+    }
+
+    tuh_hid_receive_report(address, instance);
+}
+
+bool PS5Host::send_init_report(uint8_t address, uint8_t instance)
+{
+    if (!tuh_hid_send_report(address, instance, 0, &out_report_, sizeof(PS5::OutReport)))
     {
-        tuh_task();
+        return false;
     }
 
+    init_pending_ = false;
+
     out_report_ = PS5::OutReport();
     out_report_.report_id = PS5::OutReportID::RUMBLE;
     out_report_.control_flag[0] = 2;
     out_report_.control_flag[1] = 2;
     out_report_.led_control_flag = 0x04;
-    
-    tuh_hid_receive_report(address, instance);
+    return true;
 }
 
 void PS5Host::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len)
 {
     const PS5::InReport* in_report = reinterpret_cast<const PS5::InReport*>(report);
 
-    if (std::memcmp(&prev_in_report_.joystick_lx, &in_report->joystick_lx, sizeof(uint8_t) * 6) == 0 &&
-        std::memcmp(prev_in_report_.buttons, in_report->buttons, sizeof(in_report->buttons)) == 0)
-    {
-        tuh_hid_receive_report(address, instance);
-        return;
-    }
-
     Gamepad::PadIn gp_in;   
 
     switch (in_report->buttons[0] & PS5::DPAD_MASK)
     {
         case PS5::Buttons0::DPAD_UP:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP;
+            gp_in.dpad |= Gamepad::DPAD_UP;
             break;
         case PS5::Buttons0::DPAD_UP_RIGHT:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP_RIGHT;
+            gp_in.dpad |= Gamepad::DPAD_UP_RIGHT;
             break;
         case PS5::Buttons0::DPAD_RIGHT:
-            gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
+            gp_in.dpad |= Gamepad::DPAD_RIGHT;
             break;
         case PS5::Buttons0::DPAD_RIGHT_DOWN:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN_RIGHT;
+            gp_in.dpad |= Gamepad::DPAD_DOWN_RIGHT;
             break;
         case PS5::Buttons0::DPAD_DOWN:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
+            gp_in.dpad |= Gamepad::DPAD_DOWN;
             break;
         case PS5::Buttons0::DPAD_DOWN_LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN_LEFT;
+            gp_in.dpad |= Gamepad::DPAD_DOWN_LEFT;
             break;
         case PS5::Buttons0::DPAD_LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
+            gp_in.dpad |= Gamepad::DPAD_LEFT;
             break;
         case PS5::Buttons0::DPAD_LEFT_UP:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP_LEFT;
+            gp_in.dpad |= Gamepad::DPAD_UP_LEFT;
             break;
         default:
             break;
     }
 
-    if (in_report->buttons[0] & PS5::Buttons0::SQUARE)   gp_in.buttons |= gamepad.MAP_BUTTON_X;
-    if (in_report->buttons[0] & PS5::Buttons0::CROSS)    gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (in_report->buttons[0] & PS5::Buttons0::CIRCLE)   gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (in_report->buttons[0] & PS5::Buttons0::TRIANGLE) gp_in.buttons |= gamepad.MAP_BUTTON_Y;
-    if (in_report->buttons[1] & PS5::Buttons1::L1)       gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (in_report->buttons[1] & PS5::Buttons1::R1)       gp_in.buttons |= gamepad.MAP_BUTTON_RB;
-    if (in_report->buttons[1] & PS5::Buttons1::L3)       gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-    if (in_report->buttons[1] & PS5::Buttons1::R3)       gp_in.buttons |= gamepad.MAP_BUTTON_R3;
-    if (in_report->buttons[1] & PS5::Buttons1::SHARE)    gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (in_report->buttons[1] & PS5::Buttons1::OPTIONS)  gp_in.buttons |= gamepad.MAP_BUTTON_START;
-    if (in_report->buttons[2] & PS5::Buttons2::PS)       gp_in.buttons |= gamepad.MAP_BUTTON_SYS;
-    if (in_report->buttons[2] & PS5::Buttons2::MUTE)     gp_in.buttons |= gamepad.MAP_BUTTON_MISC;
+    if (in_report->buttons[0] & PS5::Buttons0::SQUARE)   gp_in.buttons |= Gamepad::BUTTON_X;
+    if (in_report->buttons[0] & PS5::Buttons0::CROSS)    gp_in.buttons |= Gamepad::BUTTON_A;
+    if (in_report->buttons[0] & PS5::Buttons0::CIRCLE)   gp_in.buttons |= Gamepad::BUTTON_B;
+    if (in_report->buttons[0] & PS5::Buttons0::TRIANGLE) gp_in.buttons |= Gamepad::BUTTON_Y;
+    if (in_report->buttons[1] & PS5::Buttons1::L1)       gp_in.buttons |= Gamepad::BUTTON_LB;
+    if (in_report->buttons[1] & PS5::Buttons1::R1)       gp_in.buttons |= Gamepad::BUTTON_RB;
+    if (in_report->buttons[1] & PS5::Buttons1::L3)       gp_in.buttons |= Gamepad::BUTTON_L3;
+    if (in_report->buttons[1] & PS5::Buttons1::R3)       gp_in.buttons |= Gamepad::BUTTON_R3;
+    if (in_report->buttons[1] & PS5::Buttons1::SHARE)    gp_in.buttons |= Gamepad::BUTTON_BACK;
+    if (in_report->buttons[1] & PS5::Buttons1::OPTIONS)  gp_in.buttons |= Gamepad::BUTTON_START;
+    if (in_report->buttons[2] & PS5::Buttons2::PS)       gp_in.buttons |= Gamepad::BUTTON_SYS;
+    if (in_report->buttons[2] & PS5::Buttons2::MUTE)     gp_in.buttons |= Gamepad::BUTTON_MISC;
 
     gp_in.trigger_l = gamepad.scale_trigger_l(in_report->trigger_l);
     gp_in.trigger_r = gamepad.scale_trigger_r(in_report->trigger_r);
@@ -92,21 +113,28 @@ void PS5Host::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance
     std::tie(gp_in.joystick_lx, gp_in.joystick_ly) = gamepad.scale_joystick_l(in_report->joystick_lx, in_report->joystick_ly);
     std::tie(gp_in.joystick_rx, gp_in.joystick_ry) = gamepad.scale_joystick_r(in_report->joystick_rx, in_report->joystick_ry);
     
+    gp_in.dpad = gamepad.map_dpad(gp_in.dpad);
+    gp_in.buttons = gamepad.map_buttons(gp_in.buttons);
+
     gamepad.set_pad_in(gp_in);
 
     tuh_hid_receive_report(address, instance);
-    std::memcpy(&prev_in_report_, in_report, sizeof(PS5::InReport));
 }
 
 bool PS5Host::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
 {
-    Gamepad::PadOut gp_out = gamepad.get_pad_out();
+    if (init_pending_)
+    {
+        return false;
+    }
+
+    Gamepad::PadOut gp_out = get_rumble(gamepad);
     out_report_.motor_left = gp_out.rumble_l;
     out_report_.motor_right = gp_out.rumble_r;
 
     if (tuh_hid_send_report(address, instance, 0, &out_report_, sizeof(PS5::OutReport)))
     {
-        manage_rumble(gamepad);
+        manage_rumble(gp_out);
         return true;
     }
     return false;
@@ -2,6 +2,7 @@
 #define _PS5_HOST_H_
 
 #include <cstdint>
+#include <cstddef>
 
 #include "Descriptors/PS5.h"
 #include "USBHost/HostDriver/HostDriver.h"
@@ -12,13 +13,26 @@ public:
     PS5Host(uint8_t idx)
         : HostDriver(idx) {}
 
+    ~PS5Host() override;
+
     void initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len) override;
     void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
     bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    std::span<const uint8_t> report_mask() const override { return IN_REPORT_MASK; }
+    bool init_done() const override { return !init_pending_; }
 
 private:
-    PS5::InReport prev_in_report_{};
+    static constexpr uint32_t INIT_RETRY_MS = 1;
+
+    //Sticks, triggers and buttons, skips the counter, timestamps and motion data
+    static constexpr auto IN_REPORT_MASK = ReportFilter::Mask<sizeof(PS5::InReport)>()
+        .keep(offsetof(PS5::InReport, joystick_lx), 6)
+        .keep(offsetof(PS5::InReport, buttons), sizeof(PS5::InReport::buttons));
     PS5::OutReport out_report_{};
+    bool init_pending_{false};
+    uint32_t tid_init_{0};
+
+    bool send_init_report(uint8_t address, uint8_t instance);
 };
 
 #endif // _PS5_HOST_H_
\ No newline at end of file
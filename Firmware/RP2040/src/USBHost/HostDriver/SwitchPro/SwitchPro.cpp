@@ -4,12 +4,19 @@
 #include "host/usbh.h"
 #include "class/hid/hid_host.h"
 
+#include "Board/board_api.h"
 #include "USBHost/HostDriver/SwitchPro/SwitchPro.h"
 
 void SwitchProHost::initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len) 
 {
     std::memset(&out_report_, 0, sizeof(out_report_));
-    init_switch_host(gamepad, address, instance);
+    init_task_ = init_switch_host(address, instance);
+
+    if (!init_task_.valid())
+    {
+        OGXM_LOG("Switch Pro init coroutine needs %u bytes, frame pool has %u\n", 
+            static_cast<unsigned int>(Coroutine::largest_frame()), static_cast<unsigned int>(Coroutine::FRAME_SIZE));
+    }
 }
 
 uint8_t SwitchProHost::get_output_sequence_counter()
@@ -20,12 +27,49 @@ uint8_t SwitchProHost::get_output_sequence_counter()
 }
 
 // The other way is to write a class driver just for switch pro, we'll see if there are issues with this
-void SwitchProHost::init_switch_host(Gamepad& gamepad, uint8_t address, uint8_t instance)
+Coroutine SwitchProHost::init_switch_host(uint8_t address, uint8_t instance)
 {
     // See: https://github.com/Dan611/hid-procon
     //      https://github.com/dekuNukem/Nintendo_Switch_Reverse_Engineering
     //      https://github.com/HisashiKato/USB_Host_Shield_Library_2.0
 
+    [[maybe_unused]] const uint32_t start_us = board_api::us_since_boot();
+
+    uint8_t no_reply = 0;
+
+    for (size_t step = 0; step < std::size(INIT_SEQUENCE); ++step)
+    {
+        const uint8_t report_size = prepare_init_report(INIT_SEQUENCE[step]);
+        const uint8_t step_bit = static_cast<uint8_t>(1u << step);
+
+        while (!tuh_hid_send_report(address, instance, 0, &out_report_, report_size))
+        {
+            co_await Coroutine::Delay<TaskQueue::Core1>{ SEND_RETRY_MS };
+        }
+        co_await report_sent_.wait_for<TaskQueue::Core1>(SENT_TIMEOUT_MS);
+
+        tuh_hid_receive_report(address, instance);
+
+        //Some third party pads never answer some of these, don't sit through the timeout again
+        if (init_hint_ & step_bit)
+        {
+            no_reply |= step_bit;
+        }
+        else if (!co_await report_received_.wait_for<TaskQueue::Core1>(REPLY_TIMEOUT_MS))
+        {
+            no_reply |= step_bit;
+        }
+    }
+
+    init_hint_ = no_reply;
+    init_done_ = true;
+    tuh_hid_receive_report(address, instance);
+
+    OGXM_LOG("Switch Pro ready in %u us\n", static_cast<unsigned int>(board_api::us_since_boot() - start_us));
+}
+
+uint8_t SwitchProHost::prepare_init_report(InitState state)
+{
     std::memset(&out_report_, 0, sizeof(out_report_));
 
     uint8_t report_size = 10;
@@ -43,29 +87,19 @@ void SwitchProHost::init_switch_host(Gamepad& gamepad, uint8_t address, uint8_t
     out_report_.rumble_r[2] = 0x40;
     out_report_.rumble_r[3] = 0x40;   
 
-    switch (init_state_)
+    switch (state)
     {
         case InitState::HANDSHAKE:
             report_size = 2;
 
             out_report_.command = SwitchPro::CMD::HID;
             out_report_.sequence_counter = SwitchPro::CMD::HANDSHAKE;
-
-            if(tuh_hid_send_report(address, instance, 0, &out_report_, report_size))
-            {
-                init_state_ = InitState::TIMEOUT;
-            }
             break;
         case InitState::TIMEOUT:
             report_size = 2;
 
             out_report_.command = SwitchPro::CMD::HID;
             out_report_.sequence_counter = SwitchPro::CMD::DISABLE_TIMEOUT;
-
-            if(tuh_hid_send_report(address, instance, 0, &out_report_, report_size))
-            {
-                init_state_ = InitState::LED;
-            }
             break;
         case InitState::LED:
             report_size = 12;
@@ -73,11 +107,6 @@ void SwitchProHost::init_switch_host(Gamepad& gamepad, uint8_t address, uint8_t
             out_report_.command = SwitchPro::CMD::AND_RUMBLE;
             out_report_.sub_command = SwitchPro::CMD::LED;
             out_report_.sub_command_args[0] = idx_ + 1;
-
-            if(tuh_hid_send_report(address, instance, 0, &out_report_, report_size))
-            {
-                init_state_ = InitState::LED_HOME;
-            }
             break;
         case InitState::LED_HOME:
             report_size = 14;
@@ -87,11 +116,6 @@ void SwitchProHost::init_switch_host(Gamepad& gamepad, uint8_t address, uint8_t
             out_report_.sub_command_args[0] = (0 /* Number of cycles */ << 4) | (true ? 0xF : 0);
             out_report_.sub_command_args[1] = (0xF /* LED start intensity */ << 4) | 0x0 /* Number of full cycles */;
             out_report_.sub_command_args[2] = (0xF /* Mini Cycle 1 LED intensity */ << 4) | 0x0 /* Mini Cycle 2 LED intensity */;
-
-            if(tuh_hid_send_report(address, instance, 0, &out_report_, report_size))
-            {
-                init_state_ = InitState::FULL_REPORT;
-            }
             break;
         case InitState::FULL_REPORT:
             report_size = 12;
@@ -99,11 +123,6 @@ void SwitchProHost::init_switch_host(Gamepad& gamepad, uint8_t address, uint8_t
             out_report_.command = SwitchPro::CMD::AND_RUMBLE;
             out_report_.sub_command = SwitchPro::CMD::MODE;
             out_report_.sub_command_args[0] = SwitchPro::CMD::FULL_REPORT_MODE;
-            
-            if (tuh_hid_send_report(address, instance, 0, &out_report_, report_size))
-            {
-                init_state_ = InitState::IMU;
-            }
             break;
         case InitState::IMU:
             report_size = 12;
@@ -111,54 +130,47 @@ void SwitchProHost::init_switch_host(Gamepad& gamepad, uint8_t address, uint8_t
             out_report_.command = SwitchPro::CMD::AND_RUMBLE;
             out_report_.sub_command = SwitchPro::CMD::GYRO;
             out_report_.sub_command_args[0] = 1 ? 1 : 0;
-            
-            if (tuh_hid_send_report(address, instance, 0, &out_report_, report_size))
-            {
-                init_state_ = InitState::DONE;
-                tuh_hid_receive_report(address, instance);
-            }
             break;
         default:
             break;
     }
+    return report_size;
+}
 
-    // tuh_hid_receive_report(address, instance);
+void SwitchProHost::report_sent_cb(Gamepad& gamepad, uint8_t address, uint8_t instance)
+{
+    report_sent_.notify();
 }
 
 void SwitchProHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len)
 {
-    if (init_state_ != InitState::DONE)
+    if (!init_done_)
     {
-        init_switch_host(gamepad, address, instance);
+        //Command replies, the init sequence requests the next one itself
+        report_received_.notify();
         return;
     }
 
     const SwitchPro::InReport* in_report = reinterpret_cast<const SwitchPro::InReport*>(report);
-    if (std::memcmp(&prev_in_report_.buttons, in_report->buttons, 9) == 0)
-    {
-        tuh_hid_receive_report(address, instance);
-        return;
-    }
-
     Gamepad::PadIn gp_in;   
 
-    if (in_report->buttons[0] & SwitchPro::Buttons0::Y)  gp_in.buttons |= gamepad.MAP_BUTTON_X;   
-    if (in_report->buttons[0] & SwitchPro::Buttons0::B)  gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (in_report->buttons[0] & SwitchPro::Buttons0::A)  gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (in_report->buttons[0] & SwitchPro::Buttons0::X)  gp_in.buttons |= gamepad.MAP_BUTTON_Y;
-    if (in_report->buttons[2] & SwitchPro::Buttons2::L)  gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (in_report->buttons[0] & SwitchPro::Buttons0::R)  gp_in.buttons |= gamepad.MAP_BUTTON_RB;
-    if (in_report->buttons[1] & SwitchPro::Buttons1::L3) gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-    if (in_report->buttons[1] & SwitchPro::Buttons1::R3) gp_in.buttons |= gamepad.MAP_BUTTON_R3;
-    if (in_report->buttons[1] & SwitchPro::Buttons1::MINUS)     gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (in_report->buttons[1] & SwitchPro::Buttons1::PLUS)      gp_in.buttons |= gamepad.MAP_BUTTON_START;
-    if (in_report->buttons[1] & SwitchPro::Buttons1::HOME)      gp_in.buttons |= gamepad.MAP_BUTTON_SYS;
-    if (in_report->buttons[1] & SwitchPro::Buttons1::CAPTURE)   gp_in.buttons |= gamepad.MAP_BUTTON_MISC;
-
-    if (in_report->buttons[2] & SwitchPro::Buttons2::DPAD_UP)    gp_in.dpad |= gamepad.MAP_DPAD_UP;
-    if (in_report->buttons[2] & SwitchPro::Buttons2::DPAD_DOWN)  gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
-    if (in_report->buttons[2] & SwitchPro::Buttons2::DPAD_LEFT)  gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
-    if (in_report->buttons[2] & SwitchPro::Buttons2::DPAD_RIGHT) gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
+    if (in_report->buttons[0] & SwitchPro::Buttons0::Y)  gp_in.buttons |= Gamepad::BUTTON_X;   
+    if (in_report->buttons[0] & SwitchPro::Buttons0::B)  gp_in.buttons |= Gamepad::BUTTON_A;
+    if (in_report->buttons[0] & SwitchPro::Buttons0::A)  gp_in.buttons |= Gamepad::BUTTON_B;
+    if (in_report->buttons[0] & SwitchPro::Buttons0::X)  gp_in.buttons |= Gamepad::BUTTON_Y;
+    if (in_report->buttons[2] & SwitchPro::Buttons2::L)  gp_in.buttons |= Gamepad::BUTTON_LB;
+    if (in_report->buttons[0] & SwitchPro::Buttons0::R)  gp_in.buttons |= Gamepad::BUTTON_RB;
+    if (in_report->buttons[1] & SwitchPro::Buttons1::L3) gp_in.buttons |= Gamepad::BUTTON_L3;
+    if (in_report->buttons[1] & SwitchPro::Buttons1::R3) gp_in.buttons |= Gamepad::BUTTON_R3;
+    if (in_report->buttons[1] & SwitchPro::Buttons1::MINUS)     gp_in.buttons |= Gamepad::BUTTON_BACK;
+    if (in_report->buttons[1] & SwitchPro::Buttons1::PLUS)      gp_in.buttons |= Gamepad::BUTTON_START;
+    if (in_report->buttons[1] & SwitchPro::Buttons1::HOME)      gp_in.buttons |= Gamepad::BUTTON_SYS;
+    if (in_report->buttons[1] & SwitchPro::Buttons1::CAPTURE)   gp_in.buttons |= Gamepad::BUTTON_MISC;
+
+    if (in_report->buttons[2] & SwitchPro::Buttons2::DPAD_UP)    gp_in.dpad |= Gamepad::DPAD_UP;
+    if (in_report->buttons[2] & SwitchPro::Buttons2::DPAD_DOWN)  gp_in.dpad |= Gamepad::DPAD_DOWN;
+    if (in_report->buttons[2] & SwitchPro::Buttons2::DPAD_LEFT)  gp_in.dpad |= Gamepad::DPAD_LEFT;
+    if (in_report->buttons[2] & SwitchPro::Buttons2::DPAD_RIGHT) gp_in.dpad |= Gamepad::DPAD_RIGHT;
 
     gp_in.trigger_l = in_report->buttons[2] & SwitchPro::Buttons2::ZL ? Range::MAX<uint8_t> : Range::MIN<uint8_t>;
     gp_in.trigger_r = in_report->buttons[0] & SwitchPro::Buttons0::ZR ? Range::MAX<uint8_t> : Range::MIN<uint8_t>;
@@ -174,17 +186,18 @@ void SwitchProHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t in
     std::tie(gp_in.joystick_rx, gp_in.joystick_ry) = 
         gamepad.scale_joystick_r(normalize_axis(joy_rx), normalize_axis(joy_ry), true);
 
+    gp_in.dpad = gamepad.map_dpad(gp_in.dpad);
+    gp_in.buttons = gamepad.map_buttons(gp_in.buttons);
+
     gamepad.set_pad_in(gp_in);
 
     tuh_hid_receive_report(address, instance);
-    std::memcpy(&prev_in_report_, in_report, sizeof(SwitchPro::InReport));
 }
 
 bool SwitchProHost::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
 {
-    if (init_state_ != InitState::DONE)
+    if (!init_done_)
     {
-        init_switch_host(gamepad, address, instance);
         return false;
     }
 
@@ -2,8 +2,11 @@
 #define _SWITCH_PRO_HOST_H_
 
 #include <cstdint>
+#include <cstddef>
+#include <iterator>
 
 #include "Descriptors/SwitchPro.h"
+#include "TaskQueue/Coroutine.h"
 #include "USBHost/HostDriver/HostDriver.h"
 #include "Board/ogxm_log.h"
 
@@ -16,6 +19,14 @@ public:
     void initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len) override;
     void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
     bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    std::span<const uint8_t> report_mask() const override
+    {
+        return init_done_ ? std::span<const uint8_t>(IN_REPORT_MASK) : std::span<const uint8_t>();
+    }
+    void report_sent_cb(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    bool init_done() const override { return init_done_; }
+    uint8_t init_hint() const override { return init_hint_; }
+    void set_init_hint(uint8_t hint) override { init_hint_ = hint; }
 
 private:
     enum class InitState
@@ -25,17 +36,40 @@ private:
         FULL_REPORT,
         LED,
         LED_HOME,
-        IMU,
-        DONE
+        IMU
+    };
+
+    static constexpr InitState INIT_SEQUENCE[] = 
+    {
+        InitState::HANDSHAKE,
+        InitState::TIMEOUT,
+        InitState::LED,
+        InitState::LED_HOME,
+        InitState::FULL_REPORT,
+        InitState::IMU
     };
 
-    InitState init_state_{InitState::HANDSHAKE};
+    static constexpr uint32_t SEND_RETRY_MS = 1;
+    static constexpr uint32_t SENT_TIMEOUT_MS = 50;
+    static constexpr uint32_t REPLY_TIMEOUT_MS = 50; //Replies only pace the sequence, it carries on without one
+
+    static_assert(std::size(INIT_SEQUENCE) <= 8, "Init hint has one bit per init step");
+
+    bool init_done_{false};
+    uint8_t init_hint_{0}; //Init steps the pad didn't reply to, those aren't waited on
     uint8_t sequence_counter_{0};
 
-    SwitchPro::InReport prev_in_report_{};
+    //Buttons and sticks, init replies have to get through unfiltered
+    static constexpr auto IN_REPORT_MASK = ReportFilter::Mask<sizeof(SwitchPro::InReport)>()
+        .keep(offsetof(SwitchPro::InReport, buttons), 9);
     SwitchPro::OutReport out_report_{};
 
-    void init_switch_host(Gamepad& gamepad, uint8_t address, uint8_t instance);
+    Coroutine::Signal report_sent_;
+    Coroutine::Signal report_received_;
+    Coroutine init_task_; //Declared after the signals it waits on so it's destroyed first
+
+    Coroutine init_switch_host(uint8_t address, uint8_t instance);
+    uint8_t prepare_init_report(InitState state);
     uint8_t get_output_sequence_counter();
 
     static inline int16_t normalize_axis(uint16_t value)
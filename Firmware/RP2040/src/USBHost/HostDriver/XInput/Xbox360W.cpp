@@ -45,8 +45,7 @@ void Xbox360WHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t ins
     }
 
     if (!(in_report->command[1] & 1) ||
-        !(in_report->report_size == 0x13) ||
-        std::memcmp(&prev_in_report_, in_report, std::min(static_cast<size_t>(len), sizeof(XInput::InReportWireless))) == 0)
+        !(in_report->report_size == 0x13))
     {
         tuh_xinput::receive_report(address, instance);
         return;
@@ -54,22 +53,22 @@ void Xbox360WHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t ins
 
     Gamepad::PadIn gp_in;
 
-    if (in_report->buttons[0] & XInput::Buttons0::DPAD_UP)    gp_in.dpad |= gamepad.MAP_DPAD_UP;
-    if (in_report->buttons[0] & XInput::Buttons0::DPAD_DOWN)  gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
-    if (in_report->buttons[0] & XInput::Buttons0::DPAD_LEFT)  gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
-    if (in_report->buttons[0] & XInput::Buttons0::DPAD_RIGHT) gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
-
-    if (in_report->buttons[0] & XInput::Buttons0::START)  gp_in.buttons |= gamepad.MAP_BUTTON_START;
-    if (in_report->buttons[0] & XInput::Buttons0::BACK)   gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (in_report->buttons[0] & XInput::Buttons0::L3)     gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-    if (in_report->buttons[0] & XInput::Buttons0::R3)     gp_in.buttons |= gamepad.MAP_BUTTON_R3;
-    if (in_report->buttons[1] & XInput::Buttons1::LB)     gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (in_report->buttons[1] & XInput::Buttons1::RB)     gp_in.buttons |= gamepad.MAP_BUTTON_RB;
-    if (in_report->buttons[1] & XInput::Buttons1::HOME)   gp_in.buttons |= gamepad.MAP_BUTTON_SYS;
-    if (in_report->buttons[1] & XInput::Buttons1::A)      gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (in_report->buttons[1] & XInput::Buttons1::B)      gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (in_report->buttons[1] & XInput::Buttons1::X)      gp_in.buttons |= gamepad.MAP_BUTTON_X;
-    if (in_report->buttons[1] & XInput::Buttons1::Y)      gp_in.buttons |= gamepad.MAP_BUTTON_Y;
+    if (in_report->buttons[0] & XInput::Buttons0::DPAD_UP)    gp_in.dpad |= Gamepad::DPAD_UP;
+    if (in_report->buttons[0] & XInput::Buttons0::DPAD_DOWN)  gp_in.dpad |= Gamepad::DPAD_DOWN;
+    if (in_report->buttons[0] & XInput::Buttons0::DPAD_LEFT)  gp_in.dpad |= Gamepad::DPAD_LEFT;
+    if (in_report->buttons[0] & XInput::Buttons0::DPAD_RIGHT) gp_in.dpad |= Gamepad::DPAD_RIGHT;
+
+    if (in_report->buttons[0] & XInput::Buttons0::START)  gp_in.buttons |= Gamepad::BUTTON_START;
+    if (in_report->buttons[0] & XInput::Buttons0::BACK)   gp_in.buttons |= Gamepad::BUTTON_BACK;
+    if (in_report->buttons[0] & XInput::Buttons0::L3)     gp_in.buttons |= Gamepad::BUTTON_L3;
+    if (in_report->buttons[0] & XInput::Buttons0::R3)     gp_in.buttons |= Gamepad::BUTTON_R3;
+    if (in_report->buttons[1] & XInput::Buttons1::LB)     gp_in.buttons |= Gamepad::BUTTON_LB;
+    if (in_report->buttons[1] & XInput::Buttons1::RB)     gp_in.buttons |= Gamepad::BUTTON_RB;
+    if (in_report->buttons[1] & XInput::Buttons1::HOME)   gp_in.buttons |= Gamepad::BUTTON_SYS;
+    if (in_report->buttons[1] & XInput::Buttons1::A)      gp_in.buttons |= Gamepad::BUTTON_A;
+    if (in_report->buttons[1] & XInput::Buttons1::B)      gp_in.buttons |= Gamepad::BUTTON_B;
+    if (in_report->buttons[1] & XInput::Buttons1::X)      gp_in.buttons |= Gamepad::BUTTON_X;
+    if (in_report->buttons[1] & XInput::Buttons1::Y)      gp_in.buttons |= Gamepad::BUTTON_Y;
 
     gp_in.trigger_l = gamepad.scale_trigger_l(in_report->trigger_l);
     gp_in.trigger_r = gamepad.scale_trigger_r(in_report->trigger_r);
@@ -77,10 +76,12 @@ void Xbox360WHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t ins
     std::tie(gp_in.joystick_lx, gp_in.joystick_ly) = gamepad.scale_joystick_l(in_report->joystick_lx, in_report->joystick_ly, true);
     std::tie(gp_in.joystick_rx, gp_in.joystick_ry) = gamepad.scale_joystick_r(in_report->joystick_rx, in_report->joystick_ry, true);
 
+    gp_in.dpad = gamepad.map_dpad(gp_in.dpad);
+    gp_in.buttons = gamepad.map_buttons(gp_in.buttons);
+
     gamepad.set_pad_in(gp_in);
 
     tuh_xinput::receive_report(address, instance);
-    prev_in_report_ = *in_report;
 }
 
 bool Xbox360WHost::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
@@ -97,7 +98,7 @@ void Xbox360WHost::connect_cb(Gamepad& gamepad, uint8_t address, uint8_t instanc
     TaskQueue::Core1::queue_delayed_task(TaskQueue::Core1::get_new_task_id(), 1000, false, 
     [address, instance, this]
     {
-        tuh_xinput::set_led(address, instance, idx_ + 1, false);
+        tuh_xinput::set_led(address, instance, idx_ + 1, true);
         tuh_xinput::xbox360_chatpad_init(address, instance);
         
         TaskQueue::Core1::queue_delayed_task(tid_chatpad_keepalive_, tuh_xinput::KEEPALIVE_MS, true, 
@@ -8,37 +8,31 @@
 void XboxOGHost::initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len)
 {
     gamepad.set_analog_host(true);
-    std::memset(&prev_in_report_, 0, sizeof(XboxOG::GP::InReport));
     tuh_xinput::receive_report(address, instance);
 }
 
 void XboxOGHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len)
 {
     const XboxOG::GP::InReport* in_report = reinterpret_cast<const XboxOG::GP::InReport*>(report);
-    if (std::memcmp(&prev_in_report_, in_report, std::min(static_cast<size_t>(len), sizeof(XboxOG::GP::InReport))) == 0)
-    {
-        tuh_xinput::receive_report(address, instance);
-        return;
-    }
 
     Gamepad::PadIn gp_in;
 
-    if (in_report->buttons & XboxOG::GP::Buttons::DPAD_UP)    gp_in.dpad |= gamepad.MAP_DPAD_UP;
-    if (in_report->buttons & XboxOG::GP::Buttons::DPAD_DOWN)  gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
-    if (in_report->buttons & XboxOG::GP::Buttons::DPAD_LEFT)  gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
-    if (in_report->buttons & XboxOG::GP::Buttons::DPAD_RIGHT) gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
+    if (in_report->buttons & XboxOG::GP::Buttons::DPAD_UP)    gp_in.dpad |= Gamepad::DPAD_UP;
+    if (in_report->buttons & XboxOG::GP::Buttons::DPAD_DOWN)  gp_in.dpad |= Gamepad::DPAD_DOWN;
+    if (in_report->buttons & XboxOG::GP::Buttons::DPAD_LEFT)  gp_in.dpad |= Gamepad::DPAD_LEFT;
+    if (in_report->buttons & XboxOG::GP::Buttons::DPAD_RIGHT) gp_in.dpad |= Gamepad::DPAD_RIGHT;
 
-    if (in_report->a) gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (in_report->b) gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (in_report->x) gp_in.buttons |= gamepad.MAP_BUTTON_X;
-    if (in_report->y) gp_in.buttons |= gamepad.MAP_BUTTON_Y;
-    if (in_report->black) gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (in_report->white) gp_in.buttons |= gamepad.MAP_BUTTON_RB;
+    if (in_report->a) gp_in.buttons |= Gamepad::BUTTON_A;
+    if (in_report->b) gp_in.buttons |= Gamepad::BUTTON_B;
+    if (in_report->x) gp_in.buttons |= Gamepad::BUTTON_X;
+    if (in_report->y) gp_in.buttons |= Gamepad::BUTTON_Y;
+    if (in_report->black) gp_in.buttons |= Gamepad::BUTTON_LB;
+    if (in_report->white) gp_in.buttons |= Gamepad::BUTTON_RB;
 
-    if (in_report->buttons & XboxOG::GP::Buttons::START)   gp_in.buttons |= gamepad.MAP_BUTTON_START;
-    if (in_report->buttons & XboxOG::GP::Buttons::BACK)    gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (in_report->buttons & XboxOG::GP::Buttons::L3)      gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-    if (in_report->buttons & XboxOG::GP::Buttons::R3)      gp_in.buttons |= gamepad.MAP_BUTTON_R3;
+    if (in_report->buttons & XboxOG::GP::Buttons::START)   gp_in.buttons |= Gamepad::BUTTON_START;
+    if (in_report->buttons & XboxOG::GP::Buttons::BACK)    gp_in.buttons |= Gamepad::BUTTON_BACK;
+    if (in_report->buttons & XboxOG::GP::Buttons::L3)      gp_in.buttons |= Gamepad::BUTTON_L3;
+    if (in_report->buttons & XboxOG::GP::Buttons::R3)      gp_in.buttons |= Gamepad::BUTTON_R3;
 
     if (gamepad.analog_enabled())
     {
@@ -60,10 +54,12 @@ void XboxOGHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t insta
     std::tie(gp_in.joystick_lx, gp_in.joystick_ly) = gamepad.scale_joystick_l(in_report->joystick_lx, in_report->joystick_ly, true);
     std::tie(gp_in.joystick_rx, gp_in.joystick_ry) = gamepad.scale_joystick_r(in_report->joystick_rx, in_report->joystick_ry, true);
 
+    gp_in.dpad = gamepad.map_dpad(gp_in.dpad);
+    gp_in.buttons = gamepad.map_buttons(gp_in.buttons);
+
     gamepad.set_pad_in(gp_in);
 
     tuh_xinput::receive_report(address, instance);
-    std::memcpy(&prev_in_report_, in_report, sizeof(XboxOG::GP::InReport));
 }
 
 bool XboxOGHost::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
@@ -15,9 +15,11 @@ public:
     void initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len) override;
     void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
     bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    std::span<const uint8_t> report_mask() const override { return IN_REPORT_MASK; }
 
 private:
-    XboxOne::InReport prev_in_report_;
+    //Buttons, triggers and sticks
+    static constexpr auto IN_REPORT_MASK = ReportFilter::Mask<sizeof(XboxOne::InReport)>().keep(4, 14);
 };
 
 #endif // _XBOX_ONE_HOST_H_
\ No newline at end of file
@@ -3,8 +3,8 @@
 #if (TUSB_OPT_HOST_ENABLED && CFG_TUH_XINPUT)
 
 #include <cstring>
-#include <chrono>
 
+#include "TaskQueue/TaskQueue.h"
 #include "USBHost/HostDriver/XInput/tuh_xinput/tuh_xinput.h"
 #include "USBHost/HostDriver/XInput/tuh_xinput/tuh_xinput_cmd.h"
 
@@ -95,24 +95,52 @@ TU_ATTR_ALWAYS_INLINE static inline Interface* get_itf_by_instance(uint8_t dev_a
     return &device->interfaces[instance];
 }
 
-static void std_sleep_ms(uint32_t ms)
+static bool transmit(Interface* interface, uint8_t dev_addr, const uint8_t* buffer, uint16_t len)
 {
-    auto start = std::chrono::high_resolution_clock::now();
-    while ( std::chrono::duration_cast<std::chrono::milliseconds>(
-                std::chrono::high_resolution_clock::now() - start).count() < ms) 
+    TU_VERIFY(usbh_edpt_claim(dev_addr, interface->ep_out));
+
+    std::memcpy(interface->ep_out_buffer.data(), buffer, len);
+
+    if (!usbh_edpt_xfer(dev_addr, interface->ep_out, interface->ep_out_buffer.data(), len))
     {
-        tuh_task();
+        usbh_edpt_release(dev_addr, interface->ep_out);
+        return false;
     }
+    return true;
 }
 
-static void wait_for_tx_complete(uint8_t dev_addr, uint8_t ep_addr)
+//Called whenever the OUT endpoint may have freed up, packets go out one per transfer complete
+static void send_queued(Interface* interface, uint8_t dev_addr)
 {
-    while (usbh_edpt_busy(dev_addr, ep_addr))
+    while (interface->out_queue_count > 0)
     {
-        tuh_task();
+        if (usbh_edpt_busy(dev_addr, interface->ep_out))
+        {
+            return;
+        }
+
+        const OutPacket& packet = interface->out_queue[interface->out_queue_head];
+        const bool sent = transmit(interface, dev_addr, packet.data.data(), packet.len);
+
+        //A packet that fails to start is dropped so it can't stall the rest of the queue
+        interface->out_queue_head = (interface->out_queue_head + 1) % OUT_QUEUE_SIZE;
+        --interface->out_queue_count;
+
+        if (sent)
+        {
+            return;
+        }
     }
 }
 
+static void clear_queue(Interface* interface)
+{
+    interface->out_queue_head = 0;
+    interface->out_queue_count = 0;
+    TaskQueue::Core1::cancel_delayed_task(interface->tid_connect);
+    interface->tid_connect = 0;
+}
+
 bool send_ctrl_xfer(uint8_t dev_addr, const tusb_control_request_t* request, uint8_t* buffer, tuh_xfer_cb_t complete_cb, uintptr_t user_data)
 {
     tuh_xfer_s transfer = 
@@ -127,29 +155,25 @@ bool send_ctrl_xfer(uint8_t dev_addr, const tusb_control_request_t* request, uin
     return tuh_control_xfer(&transfer);
 }
 
-static void xboxone_init(Interface *interface, uint8_t dev_addr, uint8_t instance)
+static void xboxone_init(uint8_t dev_addr, uint8_t instance)
 {
     uint16_t PID, VID;
     tuh_vid_pid_get(dev_addr, &VID, &PID);
 
-    send_report(dev_addr, instance, XboxOne::POWER_ON, sizeof(XboxOne::POWER_ON));
-    wait_for_tx_complete(dev_addr, interface->ep_out);
-    send_report(dev_addr, instance, XboxOne::S_INIT, sizeof(XboxOne::S_INIT));
-    wait_for_tx_complete(dev_addr, interface->ep_out);
+    //Sent back to back from the OUT transfer complete callback
+    queue_report(dev_addr, instance, XboxOne::POWER_ON, sizeof(XboxOne::POWER_ON));
+    queue_report(dev_addr, instance, XboxOne::S_INIT, sizeof(XboxOne::S_INIT));
 
     if (VID == 0x045e && (PID == 0x0b00))
     {
-        send_report(dev_addr, instance, XboxOne::EXTRA_INPUT_PACKET_INIT, sizeof(XboxOne::EXTRA_INPUT_PACKET_INIT));
-        wait_for_tx_complete(dev_addr, interface->ep_out);
+        queue_report(dev_addr, instance, XboxOne::EXTRA_INPUT_PACKET_INIT, sizeof(XboxOne::EXTRA_INPUT_PACKET_INIT));
     }
 
     //Required for PDP aftermarket controllers
     if (VID == 0x0e6f)
     {
-        send_report(dev_addr, instance, XboxOne::PDP_LED_ON, sizeof(XboxOne::PDP_LED_ON));
-        wait_for_tx_complete(dev_addr, interface->ep_out);
-        send_report(dev_addr, instance, XboxOne::PDP_AUTH, sizeof(XboxOne::PDP_AUTH));
-        wait_for_tx_complete(dev_addr, interface->ep_out);
+        queue_report(dev_addr, instance, XboxOne::PDP_LED_ON, sizeof(XboxOne::PDP_LED_ON));
+        queue_report(dev_addr, instance, XboxOne::PDP_AUTH, sizeof(XboxOne::PDP_AUTH));
     }
 }
 
@@ -251,11 +275,10 @@ static bool set_config(uint8_t dev_addr, uint8_t itf_num)
     {
         case DevType::XBOX360W:
             interface->connected = false;
-            send_report(dev_addr, instance, Xbox360W::INQUIRE_PRESENT, sizeof(Xbox360W::INQUIRE_PRESENT));
-            wait_for_tx_complete(dev_addr, interface->ep_out);
+            queue_report(dev_addr, instance, Xbox360W::INQUIRE_PRESENT, sizeof(Xbox360W::INQUIRE_PRESENT));
             break;
         case DevType::XBOXONE:
-            xboxone_init(interface, dev_addr, instance);
+            xboxone_init(dev_addr, instance);
             break;
         default:
             break;
@@ -312,19 +335,31 @@ static bool xfer_cb(uint8_t dev_addr, uint8_t ep_addr, xfer_result_t result, uin
 
                         TU_LOG1("Xbox 360 wireless controller connected\n");
 
-                        //I think some 3rd party adapters need this:
-                        std_sleep_ms(1000);
-                        send_report(dev_addr, instance, Xbox360W::RUMBLE_ENABLE, sizeof(Xbox360W::RUMBLE_ENABLE));
-
-                        if (xbox360w_connect_cb)
+                        //I think some 3rd party adapters need this, reports keep flowing during the delay
+                        interface->tid_connect = TaskQueue::Core1::get_new_task_id();
+                        TaskQueue::Core1::queue_delayed_task(interface->tid_connect, 1000, false,
+                        [dev_addr, instance]
                         {
-                            xbox360w_connect_cb(dev_addr, instance);
-                        }
+                            Interface* itf = get_itf_by_instance(dev_addr, instance);
+                            if (itf == nullptr || !itf->connected)
+                            {
+                                return;
+                            }
+                            itf->tid_connect = 0;
+
+                            queue_report(dev_addr, instance, Xbox360W::RUMBLE_ENABLE, sizeof(Xbox360W::RUMBLE_ENABLE));
+
+                            if (xbox360w_connect_cb)
+                            {
+                                xbox360w_connect_cb(dev_addr, instance);
+                            }
+                        });
                     }
                     else if (in_buffer[1] == 0x00 && interface->connected)
                     {
                         interface->connected = false;
                         interface->chatpad_inited = false;
+                        clear_queue(interface);
 
                         TU_LOG1("Xbox 360 wireless controller disconnected\n");
 
@@ -358,7 +393,7 @@ static bool xfer_cb(uint8_t dev_addr, uint8_t ep_addr, xfer_result_t result, uin
                         }
                         break;
                     case XboxOne::GIP_CMD_ANNOUNCE:
-                        xboxone_init(interface, dev_addr, instance);
+                        xboxone_init(dev_addr, instance);
                         break;
                 }
                 break;
@@ -386,6 +421,7 @@ static bool xfer_cb(uint8_t dev_addr, uint8_t ep_addr, xfer_result_t result, uin
         {
             report_sent_cb(dev_addr, instance, interface->ep_out_buffer.data(), static_cast<uint16_t>(xferred_bytes));
         }
+        send_queued(interface, dev_addr);
     }
     return true;
 }
@@ -412,6 +448,7 @@ void close(uint8_t dev_addr)
             TU_LOG1("XInput unmount\r\n");
             device->interfaces[i].itf_num = 0xFF;
             device->interfaces[i].connected = false;
+            clear_queue(&device->interfaces[i]);
         }
     }
 }
@@ -441,15 +478,29 @@ bool send_report(uint8_t dev_addr, uint8_t instance, const uint8_t *buffer, uint
 {
     Interface* interface = get_itf_by_instance(dev_addr, instance);
     TU_VERIFY(interface != nullptr);
-    TU_VERIFY(usbh_edpt_claim(dev_addr, interface->ep_out));
+    //Don't jump ahead of queued init packets
+    TU_VERIFY(interface->out_queue_count == 0);
+    return transmit(interface, dev_addr, buffer, len);
+}
 
-    std::memcpy(interface->ep_out_buffer.data(), buffer, len);
+bool queue_report(uint8_t dev_addr, uint8_t instance, const uint8_t *buffer, uint16_t len)
+{
+    Interface* interface = get_itf_by_instance(dev_addr, instance);
+    TU_VERIFY(interface != nullptr && len <= OUT_PACKET_SIZE);
 
-    if (!usbh_edpt_xfer(dev_addr, interface->ep_out, interface->ep_out_buffer.data(), len))
+    if (interface->out_queue_count == 0 && transmit(interface, dev_addr, buffer, len))
     {
-        usbh_edpt_release(dev_addr, interface->ep_out);
-        return false;
+        return true;
     }
+    TU_VERIFY(interface->out_queue_count < OUT_QUEUE_SIZE);
+
+    OutPacket& packet = interface->out_queue[(interface->out_queue_head + interface->out_queue_count) % OUT_QUEUE_SIZE];
+    std::memcpy(packet.data.data(), buffer, len);
+    packet.len = static_cast<uint8_t>(len);
+    ++interface->out_queue_count;
+
+    //Covers a failed transmit above with nothing in flight to drain the queue later
+    send_queued(interface, dev_addr);
     return true;
 }
 
@@ -466,7 +517,7 @@ bool receive_report(uint8_t dev_addr, uint8_t instance)
     return true;
 }
 
-bool set_led(uint8_t dev_addr, uint8_t instance, uint8_t quadrant, bool block)
+bool set_led(uint8_t dev_addr, uint8_t instance, uint8_t quadrant, bool queue)
 {
     Interface* interface = get_itf_by_instance(dev_addr, instance);
     TU_VERIFY(interface != nullptr);
@@ -490,15 +541,10 @@ bool set_led(uint8_t dev_addr, uint8_t instance, uint8_t quadrant, bool block)
             return true;
     }
 
-    bool ret = send_report(dev_addr, instance, buffer, len);
-    if (block && ret)
-    {
-        wait_for_tx_complete(dev_addr, interface->ep_out);
-    }
-    return ret;
+    return queue ? queue_report(dev_addr, instance, buffer, len) : send_report(dev_addr, instance, buffer, len);
 }
 
-bool set_rumble(uint8_t dev_addr, uint8_t instance, uint8_t rumble_l, uint8_t rumble_r, bool block)
+bool set_rumble(uint8_t dev_addr, uint8_t instance, uint8_t rumble_l, uint8_t rumble_r, bool queue)
 {
     Interface* interface = get_itf_by_instance(dev_addr, instance);
     TU_VERIFY(interface != nullptr);
@@ -538,10 +584,13 @@ bool set_rumble(uint8_t dev_addr, uint8_t instance, uint8_t rumble_l, uint8_t ru
             return true;
     }
 
-    bool ret = send_report(dev_addr, instance, buffer, len);
-    if (block && ret)
+    if (queue)
+    {
+        queue_report(dev_addr, instance, buffer, len);
+    }
+    else
     {
-        wait_for_tx_complete(dev_addr, interface->ep_out);
+        send_report(dev_addr, instance, buffer, len);
     }
     return true;
 }
@@ -554,19 +603,15 @@ void xbox360_chatpad_init(uint8_t address, uint8_t instance)
     TU_VERIFY(interface != nullptr && interface->connected, );
     TU_VERIFY(interface->dev_type == DevType::XBOX360W, ); //Only supported on Xbox 360 Wireless atm, wired is more complicated
 
-    send_report(address, instance, Xbox360W::CONTROLLER_INFO, sizeof(Xbox360W::CONTROLLER_INFO));
-    wait_for_tx_complete(address, interface->ep_out);
-    send_report(address, instance, Xbox360W::Chatpad::INIT, sizeof(Xbox360W::Chatpad::INIT));
-    wait_for_tx_complete(address, interface->ep_out);
-    send_report(address, instance, Xbox360W::RUMBLE_ENABLE, sizeof(Xbox360W::RUMBLE_ENABLE));
-    wait_for_tx_complete(address, interface->ep_out);
+    queue_report(address, instance, Xbox360W::CONTROLLER_INFO, sizeof(Xbox360W::CONTROLLER_INFO));
+    queue_report(address, instance, Xbox360W::Chatpad::INIT, sizeof(Xbox360W::Chatpad::INIT));
+    queue_report(address, instance, Xbox360W::RUMBLE_ENABLE, sizeof(Xbox360W::RUMBLE_ENABLE));
 
     uint8_t led_ctrl[4];
     std::memcpy(led_ctrl, Xbox360W::Chatpad::LED_CTRL, sizeof(Xbox360W::Chatpad::LED_CTRL));
     led_ctrl[2] = Xbox360W::Chatpad::LED_ON[0];
 
-    send_report(address, instance, led_ctrl, sizeof(led_ctrl));
-    wait_for_tx_complete(address, interface->ep_out);
+    queue_report(address, instance, led_ctrl, sizeof(led_ctrl));
 
     interface->chatpad_inited = true;
     interface->chatpad_stage = ChatpadStage::KEEPALIVE_1;
@@ -55,6 +55,14 @@ namespace tuh_xinput
 
     static constexpr uint8_t ENDPOINT_SIZE = 64;
     static constexpr uint32_t KEEPALIVE_MS = 1000;
+    static constexpr uint8_t OUT_QUEUE_SIZE = 6;
+    static constexpr uint8_t OUT_PACKET_SIZE = 24; //Largest queued packet is XboxOne::S_INIT
+
+    struct OutPacket
+    {
+        uint8_t len{0};
+        std::array<uint8_t, OUT_PACKET_SIZE> data{0};
+    };
 
     struct Interface
     {
@@ -77,6 +85,12 @@ namespace tuh_xinput
 
         std::array<uint8_t, ENDPOINT_SIZE> ep_in_buffer{0};
         std::array<uint8_t, ENDPOINT_SIZE> ep_out_buffer{0};
+
+        //OUT reports waiting on the endpoint, sent from the transfer complete callback
+        std::array<OutPacket, OUT_QUEUE_SIZE> out_queue{};
+        uint8_t out_queue_head{0};
+        uint8_t out_queue_count{0};
+        uint32_t tid_connect{0}; //Delayed Xbox 360 wireless connect
     };
 
     // API
@@ -84,9 +98,12 @@ namespace tuh_xinput
     const usbh_class_driver_t* class_driver();
 
     bool send_report(uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len);
+    //Sends now if the OUT endpoint is free, else sends once the transfers ahead of it complete
+    bool queue_report(uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len);
     bool receive_report(uint8_t address, uint8_t instance);
-    bool set_rumble(uint8_t address, uint8_t instance, uint8_t rumble_l, uint8_t rumble_r, bool block);
-    bool set_led(uint8_t address, uint8_t instance, uint8_t led_number, bool block);
+    //If queue is false the report is dropped while the OUT endpoint is busy
+    bool set_rumble(uint8_t address, uint8_t instance, uint8_t rumble_l, uint8_t rumble_r, bool queue);
+    bool set_led(uint8_t address, uint8_t instance, uint8_t led_number, bool queue);
 
     //Wireless only atm
     void xbox360_chatpad_init(uint8_t address, uint8_t instance); 
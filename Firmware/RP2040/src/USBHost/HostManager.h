@@ -2,16 +2,28 @@
 #define _HOST_MANAGER_H_
 
 #include <cstdint>
-#include <memory>	
+#include <cstring>
+#include <array>
+#include <algorithm>
 #include <hardware/regs/usb.h>
 #include <hardware/irq.h>
 #include <hardware/structs/usb.h>
 #include <hardware/resets.h>
 
 #include "Board/Config.h"
+#include "Board/ogxm_log.h"
+#include "class/hid/hid_host.h"
+
+#include "Board/board_api.h"
 #include "USBHost/HardwareIDs.h"
+#include "USBHost/ReportFilter.h"
+#include "USBHost/ReportCapture.h"
+#include "USBHost/HostCache.h"
+#include "USBHost/ConnectTimeline.h"
+#include "USBHost/FrameSync.h"
 #include "USBHost/HostDriver/XInput/tuh_xinput/tuh_xinput.h"
 #include "USBHost/HostDriver/HostDriver.h"
+#include "USBHost/HostDriver/HostDriverPool.h"
 #include "USBHost/HostDriver/PS5/PS5.h"
 #include "USBHost/HostDriver/PS4/PS4.h"
 #include "USBHost/HostDriver/PS3/PS3.h"
@@ -48,81 +60,104 @@ public:
 		{
 			gamepads_[i] = &gamepads[i];
 		}
+		OGXM_LOG("Host driver pool: %u bytes, %u per gamepad\n", 
+			static_cast<unsigned int>(DriverPool::TOTAL_BYTES), static_cast<unsigned int>(DriverPool::SLOT_SIZE));
+#if defined(CONFIG_EN_REPORT_CAPTURE)
+		ReportCapture::init();
+#endif
 	}
 
 	//XInput doesn't need report_desc or desc_len
 	inline bool setup_driver(const HostDriverType driver_type, const uint8_t address, const uint8_t instance, uint8_t const* report_desc = nullptr, uint16_t desc_len = 0)
 	{
-		uint8_t gp_idx = find_free_gamepad();
-		if (gp_idx == INVALID_IDX || instance >= MAX_INTERFACES)
+		if (get_interface(address, instance) == nullptr)
 		{
 			return false;
 		}
 
-		//Check if this device is already mounted
-		uint8_t dev_idx = get_device_slot(address);
-		//If not, find a free device slot
-		if (dev_idx == INVALID_IDX && ((dev_idx = find_free_device_slot()) == INVALID_IDX)) 
+		//Nothing is released until the new driver is sure to be built, a failed mount leaves
+		//whatever already runs at this address and instance alone
+		if (!has_driver(driver_type) && !is_hid_gamepad(report_desc, desc_len))
 		{
 			return false;
 		}
 
-		Device& device_slot = device_slots_[dev_idx];
+		//Device slots are indexed by address, so each interface of a device lands in the same slot
+		Device& device_slot = device_slots_[address - 1];
 		Interface& interface = device_slot.interfaces[instance];
 
+		//A remount keeps the interface's gamepad
+		const uint8_t gp_idx = interface.driver ? interface.gamepad_idx : find_free_gamepad();
+		if (gp_idx == INVALID_IDX)
+		{
+			return false;
+		}
+		release_interface(interface);
+
+		uint16_t vid = 0, pid = 0;
+		tuh_vid_pid_get(address, &vid, &pid);
+		const HostCache::Entry* cached = HostCache::find(vid, pid);
+
 		switch (driver_type)
 		{
 			case HostDriverType::PS5:
-				interface.driver = std::make_unique<PS5Host>(gp_idx);
+				interface.driver = driver_pool_.emplace<PS5Host>(gp_idx);
 				break;
 			case HostDriverType::PS4:
-				interface.driver = std::make_unique<PS4Host>(gp_idx);
+				interface.driver = driver_pool_.emplace<PS4Host>(gp_idx);
 				break;
 			case HostDriverType::PS3:
-				interface.driver = std::make_unique<PS3Host>(gp_idx);
+				interface.driver = driver_pool_.emplace<PS3Host>(gp_idx);
 				break;
 			case HostDriverType::DINPUT:
-				interface.driver = std::make_unique<DInputHost>(gp_idx);
+				interface.driver = driver_pool_.emplace<DInputHost>(gp_idx);
 				break;
 			case HostDriverType::SWITCH:
-				interface.driver = std::make_unique<SwitchWiredHost>(gp_idx);
+				interface.driver = driver_pool_.emplace<SwitchWiredHost>(gp_idx);
 				break;
 			case HostDriverType::SWITCH_PRO:
-				interface.driver = std::make_unique<SwitchProHost>(gp_idx);
+				interface.driver = driver_pool_.emplace<SwitchProHost>(gp_idx);
 				break;
 			case HostDriverType::N64:
-				interface.driver = std::make_unique<N64Host>(gp_idx);
+				interface.driver = driver_pool_.emplace<N64Host>(gp_idx);
 				break;
 			case HostDriverType::PSCLASSIC:
-				interface.driver = std::make_unique<PSClassicHost>(gp_idx);
+				interface.driver = driver_pool_.emplace<PSClassicHost>(gp_idx);
 				break;
 			case HostDriverType::XBOXOG:
-				interface.driver = std::make_unique<XboxOGHost>(gp_idx);
+				interface.driver = driver_pool_.emplace<XboxOGHost>(gp_idx);
 				break;
 			case HostDriverType::XBOXONE:
-				interface.driver = std::make_unique<XboxOneHost>(gp_idx);
+				interface.driver = driver_pool_.emplace<XboxOneHost>(gp_idx);
 				break;
 			case HostDriverType::XBOX360:
-				interface.driver = std::make_unique<Xbox360Host>(gp_idx);
+				interface.driver = driver_pool_.emplace<Xbox360Host>(gp_idx);
 				break;
 			case HostDriverType::XBOX360W: //Composite device, takes up all 4 gamepads when mounted
-				interface.driver = std::make_unique<Xbox360WHost>(gp_idx);
+				interface.driver = driver_pool_.emplace<Xbox360WHost>(gp_idx);
 				break;
-			default:
-				if (is_hid_gamepad(report_desc, desc_len))
-				{
-					interface.driver = std::make_unique<HIDHost>(gp_idx);
-				}
-				else
-				{
-					return false;
-				}
+			default: //Checked with is_hid_gamepad() above
+				interface.driver = driver_pool_.emplace<HIDHost>(gp_idx);
 				break;
 		}
 
 		device_slot.address = address;
 		interface.gamepad_idx = gp_idx;
 		interface.gamepad = gamepads_[gp_idx];
+		interface.type = driver_type;
+		interface.mount_time_us = board_api::us_since_boot();
+		//Rumble written before this pad was plugged in isn't replayed to it
+		interface.feedback.generation = interface.gamepad->pad_out_generation();
+		start_timeline(interface, device_slot, address, instance, vid, pid, cached != nullptr);
+
+		//Lets the init sequence skip what it learned last time, e.g. steps this pad never answers
+		if (cached && cached->driver_type == static_cast<uint8_t>(driver_type))
+		{
+			interface.driver->set_init_hint(cached->init_hint);
+		}
+#if defined(CONFIG_EN_REPORT_CAPTURE)
+		ReportCapture::record(ReportCapture::Kind::MOUNT, address, instance, driver_type, report_desc, desc_len);
+#endif
 		interface.driver->initialize(*interface.gamepad, device_slot.address, instance, report_desc, desc_len);
 
 		return true;
@@ -130,45 +165,127 @@ public:
 
 	inline void process_report(uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len)
 	{
-		for (auto& device_slot : device_slots_)
+		Interface* interface = get_interface(address, instance);
+		if (interface && interface->driver)
 		{
-			if (device_slot.address == address && 
-				device_slot.interfaces[instance].driver &&
-				device_slot.interfaces[instance].gamepad)
+			++interface->report_count;
+			FrameSync::host_report();
+#if defined(CONFIG_EN_REPORT_CAPTURE)
+			ReportCapture::record(ReportCapture::Kind::REPORT, address, instance, interface->type, report, len);
+#endif
+			if (interface->first_report_us == 0)
+			{
+				log_first_report(address, instance, *interface);
+			}
+			//Unchanged reports never reach the driver, so the next one has to be requested here
+			if (!interface->filter.changed(interface->driver->report_mask(), report, len))
 			{
-				device_slot.interfaces[instance].driver->process_report(*device_slot.interfaces[instance].gamepad, address, instance, report, len);
+				receive_report(address, instance, interface->type);
+				return;
 			}
+			const bool init_was_done = interface->driver->init_done();
+			const uint32_t generation = interface->gamepad->pad_in_generation();
+			interface->gamepad->set_pad_in_time(board_api::us_since_boot());
+			interface->driver->process_report(*interface->gamepad, address, instance, report, len);
+			if (interface->gamepad->pad_in_generation() != generation)
+			{
+				board_api::core0::notify();
+			}
+			if (!interface->timeline_done)
+			{
+				update_timeline(*interface, init_was_done);
+			}
+		}
+	}
+
+	//Called from the enumerated app driver in tuh_callbacks.cpp, which sees every interface as enumeration finishes
+	inline void device_enumerated(uint8_t address)
+	{
+		if (address > 0 && address <= CFG_TUH_DEVICE_MAX && device_slots_[address - 1].enumerated_us == 0)
+		{
+			device_slots_[address - 1].enumerated_us = board_api::us_since_boot();
 		}
 	}
 
 	inline void connect_cb(uint8_t address, uint8_t instance)
 	{
-		for (auto& device_slot : device_slots_)
+		Interface* interface = get_interface(address, instance);
+		if (interface && interface->driver)
 		{
-			if (device_slot.address == address && 
-				device_slot.interfaces[instance].driver &&
-				device_slot.interfaces[instance].gamepad)
-			{
-				device_slot.interfaces[instance].driver->connect_cb(*device_slot.interfaces[instance].gamepad, address, instance);
-			}
+			interface->driver->connect_cb(*interface->gamepad, address, instance);
+		}
+	}
+
+	inline void report_sent(uint8_t address, uint8_t instance)
+	{
+		Interface* interface = get_interface(address, instance);
+		if (interface && interface->driver)
+		{
+			interface->driver->report_sent_cb(*interface->gamepad, address, instance);
 		}
 	}
 
 	inline void disconnect_cb(uint8_t address, uint8_t instance)
 	{
+		Interface* interface = get_interface(address, instance);
+		if (interface && interface->driver)
+		{
+			interface->driver->disconnect_cb(*interface->gamepad, address, instance);
+		}
+	}
+
+	//Call every pass of the core1 loop, runs feedback as soon as a device driver writes pad_out
+	//or when held back feedback is due
+	inline void feedback_task()
+	{
+		if (board_api::core1::notified() ||
+			(feedback_waiting_ && static_cast<int32_t>(board_api::us_since_boot() - feedback_due_us_) >= 0))
+		{
+			send_feedback();
+		}
+	}
+
+	inline void send_feedback()
+	{
+		const uint32_t now_us = board_api::us_since_boot();
+		feedback_waiting_ = false;
+
 		for (auto& device_slot : device_slots_)
 		{
-			if (device_slot.address == address && 
-				device_slot.interfaces[instance].driver &&
-				device_slot.interfaces[instance].gamepad)
+			if (device_slot.address == INVALID_IDX)
+			{
+				continue;
+			}
+			for (uint8_t i = 0; i < MAX_INTERFACES; ++i)
 			{
-				device_slot.interfaces[instance].driver->disconnect_cb(*device_slot.interfaces[instance].gamepad, address, instance);
+				if (device_slot.interfaces[i].driver)
+				{
+					send_feedback(device_slot.interfaces[i], device_slot.address, i, now_us);
+				}
 			}
 		}
 	}
 
-	//Call on a timer
-	inline void send_feedback()
+	//IN endpoint interval override for the next interface to be mounted, 0 keeps the device's bInterval.
+	//The profile setting wins over a device quirk. Endpoints are opened before any interface of the device
+	//mounts, so every interface of a device gets the interval of the gamepad its first interface lands on.
+	inline uint8_t poll_interval_override(const HardwareID& ids)
+	{
+		uint8_t gp_idx = find_free_gamepad();
+		if (gp_idx == INVALID_IDX || gamepads_[gp_idx] == nullptr)
+		{
+			return 0;
+		}
+		if (uint8_t interval_ms = gamepads_[gp_idx]->host_poll_interval_ms())
+		{
+			return interval_ms;
+		}
+		const HardwareIDEntry* entry = find_hardware_id(ids);
+		return (entry && (entry->quirks & HardwareQuirk::POLL_INTERVAL)) ? entry->poll_interval_ms : 0;
+	}
+
+	//Call on a timer, elapsed_ms is the timer's period
+	inline void update_poll_stats(uint32_t elapsed_ms)
 	{
 		for (auto& device_slot : device_slots_)
 		{
@@ -178,39 +295,89 @@ public:
 			}
 			for (uint8_t i = 0; i < MAX_INTERFACES; ++i)
 			{
-				if (device_slot.interfaces[i].driver && device_slot.interfaces[i].gamepad->new_pad_out())
+				Interface& interface = device_slot.interfaces[i];
+				if (!interface.driver)
 				{
-					device_slot.interfaces[i].driver->send_feedback(*device_slot.interfaces[i].gamepad, device_slot.address, i);
-					tuh_task();
+					continue;
 				}
+				interface.reports_per_sec = static_cast<uint16_t>((interface.report_count * 1000) / elapsed_ms);
+				interface.report_count = 0;
+				OGXM_LOG("Host addr %d itf %d: %d reports/s\n", device_slot.address, i, interface.reports_per_sec);
+				OGXM_LOG("Host addr %u itf %u: %u processed, %u suppressed\n", 
+					static_cast<unsigned int>(device_slot.address), static_cast<unsigned int>(i),
+					static_cast<unsigned int>(interface.filter.processed()), static_cast<unsigned int>(interface.filter.suppressed()));
+				interface.filter.clear_counts();
 			}
 		}
+
+		if (feedback_stats_.sent || feedback_stats_.deduped)
+		{
+			OGXM_LOG("Rumble: %u sent, %u unchanged dropped, pad out to OUT report avg %u us, max %u us\n",
+				static_cast<unsigned int>(feedback_stats_.sent), static_cast<unsigned int>(feedback_stats_.deduped),
+				static_cast<unsigned int>(feedback_stats_.latency_count ? feedback_stats_.latency_sum_us / feedback_stats_.latency_count : 0),
+				static_cast<unsigned int>(feedback_stats_.latency_max_us));
+			feedback_stats_ = {};
+		}
 	}
 
-    void deinit_driver(DriverClass driver_class, uint8_t address, uint8_t instance)
+	//Mount to first report time of the interface bound to gamepad_idx, 0 if nothing has arrived yet
+	inline uint32_t first_report_us(uint8_t gamepad_idx)
 	{
-		for (auto& device_slot : device_slots_)
+		for (const auto& device_slot : device_slots_)
 		{
-			if (device_slot.address == address)
+			for (const auto& interface : device_slot.interfaces)
 			{
-				device_slot.reset();
+				if (interface.gamepad_idx == gamepad_idx)
+				{
+					return interface.first_report_us;
+				}
 			}
 		}
+		return 0;
 	}
 
-	static inline HostDriverType get_type(const HardwareID& ids)
+	//Achieved report rate over the last stats period
+	inline uint16_t reports_per_sec(uint8_t gamepad_idx)
+	{
+		for (const auto& device_slot : device_slots_)
+		{
+			for (const auto& interface : device_slot.interfaces)
+			{
+				if (interface.gamepad_idx == gamepad_idx)
+				{
+					return interface.reports_per_sec;
+				}
+			}
+		}
+		return 0;
+	}
+
+    void deinit_driver(DriverClass driver_class, uint8_t address, uint8_t instance)
 	{
-		for (const auto& map : HOST_TYPE_MAP)
+		if (get_interface(address, instance) != nullptr)
 		{
-			for (size_t i = 0; i < map.num_ids; i++)
+#if defined(CONFIG_EN_REPORT_CAPTURE)
+			ReportCapture::record(ReportCapture::Kind::UNMOUNT, address, instance, HostDriverType::UNKNOWN, nullptr, 0);
+#endif
+			Device& device_slot = device_slots_[address - 1];
+			release_interface(device_slot.interfaces[instance]);
+
+			//The device's other interfaces keep running, the slot is freed with the last one
+			for (const auto& interface : device_slot.interfaces)
 			{
-				if (ids.pid == map.ids[i].pid && ids.vid == map.ids[i].vid)
+				if (interface.driver)
 				{
-					return map.type;
+					return;
 				}
 			}
+			reset_device(device_slot);
 		}
-		return HostDriverType::UNKNOWN;
+	}
+
+	static inline HostDriverType get_type(const HardwareID& ids)
+	{
+		const HardwareIDEntry* entry = find_hardware_id(ids);
+		return entry ? entry->type : HostDriverType::UNKNOWN;
 	}
 
 	static inline HostDriverType get_type(const tuh_xinput::DevType xinput_type)
@@ -234,14 +401,8 @@ public:
 
 	inline uint8_t get_gamepad_idx(DriverClass driver_class, uint8_t address, uint8_t instance)
 	{
-		for (auto& device_slot : device_slots_)
-		{
-			if (device_slot.address == address && instance < MAX_INTERFACES)
-			{
-				return device_slot.interfaces[instance].gamepad_idx;
-			}
-		}
-		return INVALID_IDX;
+		Interface* interface = get_interface(address, instance);
+		return interface ? interface->gamepad_idx : INVALID_IDX;
 	}
 
 	inline bool any_mounted() 
@@ -259,49 +420,262 @@ public:
 private:
 	static constexpr uint8_t INVALID_IDX = 0xFF;
 
+	struct Feedback
+	{
+		uint32_t generation{0}; //pad_out generation last sent or dropped
+		uint32_t sent_us{0};
+		Gamepad::PadOut sent;   //What the pad should be doing now
+	};
+	struct FeedbackStats
+	{
+		uint32_t sent{0};
+		uint32_t deduped{0};
+		uint32_t latency_count{0};
+		uint32_t latency_sum_us{0};
+		uint32_t latency_max_us{0};
+	};
 	struct Interface
 	{
-		std::unique_ptr<HostDriver> driver{nullptr};
+		HostDriver* driver{nullptr}; //Lives in driver_pool_ at gamepad_idx
 		Gamepad* gamepad{nullptr};
 		uint8_t gamepad_idx{INVALID_IDX};
+		uint32_t report_count{0};
+		uint16_t reports_per_sec{0};
+		HostDriverType type{HostDriverType::UNKNOWN};
+		uint32_t mount_time_us{0};
+		uint32_t first_report_us{0}; //Mount to first report, 0 until it arrives
+		ReportFilter filter;
+		ConnectTimeline::Entry timeline{};
+		bool timeline_done{false};
+		Feedback feedback;
 	};
 	struct Device
 	{
 		uint8_t address{INVALID_IDX};
+		uint32_t enumerated_us{0};
 		Interface interfaces[MAX_INTERFACES];
+	};
+
+	//Every driver a gamepad can be bound to, one pool slot per gamepad index
+	using DriverPool = HostDriverPool<	MAX_GAMEPADS,
+										PS5Host, PS4Host, PS3Host, DInputHost, SwitchWiredHost, SwitchProHost,
+										N64Host, PSClassicHost, XboxOGHost, XboxOneHost, Xbox360Host, Xbox360WHost,
+										HIDHost>;
 
-		void reset()
+	static constexpr size_t DRIVER_POOL_BUDGET = 8 * 1024;
+	static_assert(DriverPool::TOTAL_BYTES <= DRIVER_POOL_BUDGET, "Host driver pool exceeds its RAM budget, shrink the largest driver or raise the budget");
+
+	//Indexed by TinyUSB device address - 1, hubs get addresses above CFG_TUH_DEVICE_MAX and never mount here
+	Device device_slots_[CFG_TUH_DEVICE_MAX];
+	Gamepad* gamepads_[MAX_GAMEPADS]{nullptr};
+	DriverPool driver_pool_;
+	FeedbackStats feedback_stats_;
+	uint32_t feedback_due_us_{0};
+	bool feedback_waiting_{false}; //Something was held back, run send_feedback() again at feedback_due_us_
+	bool attach_used_{false}; //Pin detect only happens once, it belongs to the first connect
+
+    HostManager() {}
+
+	inline void release_interface(Interface& interface)
+	{
+		if (interface.driver)
 		{
-			address = INVALID_IDX;
-			for (auto& interface : interfaces)
-			{
-				interface.driver.reset();
-				interface.gamepad_idx = INVALID_IDX;
-				interface.gamepad = nullptr;
-			}
+			driver_pool_.destroy(interface.gamepad_idx);
 		}
-	};
+		interface.driver = nullptr;
+		interface.gamepad_idx = INVALID_IDX;
+		interface.gamepad = nullptr;
+		interface.report_count = 0;
+		interface.reports_per_sec = 0;
+		interface.type = HostDriverType::UNKNOWN;
+		interface.mount_time_us = 0;
+		interface.first_report_us = 0;
+		interface.filter.reset();
+		interface.timeline = {};
+		interface.timeline_done = false;
+		interface.feedback = {};
+	}
 
-	Device device_slots_[MAX_GAMEPADS];
-	Gamepad* gamepads_[MAX_GAMEPADS];
+	static inline void receive_report(uint8_t address, uint8_t instance, HostDriverType type)
+	{
+		switch (type)
+		{
+			case HostDriverType::XBOXOG:
+			case HostDriverType::XBOXONE:
+			case HostDriverType::XBOX360:
+			case HostDriverType::XBOX360W:
+			case HostDriverType::XBOX360_CHATPAD:
+				tuh_xinput::receive_report(address, instance);
+				break;
+			default:
+				tuh_hid_receive_report(address, instance);
+				break;
+		}
+	}
 
-    HostManager() {}
+	//Partial rumble is held for RUMBLE_HOLD_MS and then cleared, unless the device side writes again first
+	static constexpr uint32_t RUMBLE_HOLD_MS = 200;
 
-	inline uint8_t find_free_device_slot()
+	inline void schedule_feedback(uint32_t due_us)
 	{
-		for (uint8_t i = 0; i < MAX_GAMEPADS; ++i)
+		if (!feedback_waiting_ || static_cast<int32_t>(due_us - feedback_due_us_) < 0)
 		{
-			if (device_slots_[i].address == INVALID_IDX)
-			{
-				return i;
-			}
+			feedback_due_us_ = due_us;
 		}
-		return INVALID_IDX;
+		feedback_waiting_ = true;
+	}
+
+	//Sends a new pad_out or a pending rumble clear, no faster than the driver's feedback_interval_ms(),
+	//and drops writes that wouldn't change what the pad is doing
+	inline void send_feedback(Interface& interface, uint8_t address, uint8_t instance, uint32_t now_us)
+	{
+		Feedback& feedback = interface.feedback;
+		HostDriver& driver = *interface.driver;
+		Gamepad& gamepad = *interface.gamepad;
+
+		const uint32_t generation = gamepad.pad_out_generation();
+		const bool fresh = (generation != feedback.generation);
+		if (!fresh && !driver.feedback_pending())
+		{
+			return;
+		}
+
+		const uint32_t wait_us = std::max(driver.feedback_interval_ms(), fresh ? 0 : RUMBLE_HOLD_MS) * 1000;
+		if (now_us - feedback.sent_us < wait_us)
+		{
+			schedule_feedback(feedback.sent_us + wait_us);
+			return;
+		}
+
+		const Gamepad::PadOut pad_out = gamepad.peek_pad_out();
+		//Pending partial rumble is resent even if unchanged, the device side is keeping it going
+		if (fresh && !driver.feedback_pending() && std::memcmp(&pad_out, &feedback.sent, sizeof(Gamepad::PadOut)) == 0)
+		{
+			feedback.generation = generation;
+			++feedback_stats_.deduped;
+			return;
+		}
+
+		//Endpoint busy or driver still initializing
+		if (!driver.send_feedback(gamepad, address, instance))
+		{
+			schedule_feedback(now_us + driver.feedback_interval_ms() * 1000);
+			return;
+		}
+		tuh_task();
+
+		feedback.sent_us = now_us;
+		++feedback_stats_.sent;
+		if (fresh)
+		{
+			feedback.generation = generation;
+			feedback.sent = pad_out;
+
+			const uint32_t latency_us = now_us - gamepad.pad_out_time_us();
+			++feedback_stats_.latency_count;
+			feedback_stats_.latency_sum_us += latency_us;
+			feedback_stats_.latency_max_us = std::max(feedback_stats_.latency_max_us, latency_us);
+		}
+		else
+		{
+			feedback.sent = HostDriver::cleared_rumble(feedback.sent);
+		}
+		if (driver.feedback_pending())
+		{
+			schedule_feedback(now_us + RUMBLE_HOLD_MS * 1000);
+		}
+	}
+
+	inline void start_timeline(Interface& interface, const Device& device, uint8_t address, uint8_t instance, uint16_t vid, uint16_t pid, bool cached)
+	{
+		using ConnectTimeline::Stage;
+
+		ConnectTimeline::Entry& timeline = interface.timeline;
+		timeline = {};
+		timeline.vid = vid;
+		timeline.pid = pid;
+		timeline.address = address;
+		timeline.instance = instance;
+		timeline.driver_type = static_cast<uint8_t>(interface.type);
+		timeline.cached = cached ? 1 : 0;
+
+		if (!attach_used_)
+		{
+			attach_used_ = true;
+			ConnectTimeline::mark(timeline, Stage::ATTACH, board_api::usb::host_attach_us());
+		}
+		ConnectTimeline::mark(timeline, Stage::ENUMERATED, device.enumerated_us);
+		ConnectTimeline::mark(timeline, Stage::DRIVER_SETUP, interface.mount_time_us);
+	}
+
+	//The first report the driver sees after its init sequence is done is the first PadIn
+	inline void update_timeline(Interface& interface, bool init_was_done)
+	{
+		using ConnectTimeline::Stage;
+
+		ConnectTimeline::Entry& timeline = interface.timeline;
+		const uint32_t now_us = board_api::us_since_boot();
+
+		if (ConnectTimeline::get(timeline, Stage::INIT_DONE) == 0 && interface.driver->init_done())
+		{
+			ConnectTimeline::mark(timeline, Stage::INIT_DONE, now_us);
+		}
+		if (!init_was_done)
+		{
+			return;
+		}
+
+		ConnectTimeline::mark(timeline, Stage::FIRST_PAD_IN, now_us);
+		interface.timeline_done = true;
+		ConnectTimeline::add(timeline);
+		HostCache::store(timeline.vid, timeline.pid, interface.type, interface.driver->init_hint());
+
+		[[maybe_unused]] const uint32_t start_us = 
+			ConnectTimeline::get(timeline, Stage::ATTACH) ? ConnectTimeline::get(timeline, Stage::ATTACH) :
+			ConnectTimeline::get(timeline, Stage::ENUMERATED) ? ConnectTimeline::get(timeline, Stage::ENUMERATED) : 
+			ConnectTimeline::get(timeline, Stage::DRIVER_SETUP);
+		OGXM_LOG("Connect %04x:%04x type %u%s: enumerated %u us, setup %u us, init %u us, first pad in %u us\n",
+			static_cast<unsigned int>(timeline.vid), static_cast<unsigned int>(timeline.pid), 
+			static_cast<unsigned int>(timeline.driver_type), timeline.cached ? " (cached)" : "",
+			static_cast<unsigned int>(ConnectTimeline::get(timeline, Stage::ENUMERATED) - start_us),
+			static_cast<unsigned int>(ConnectTimeline::get(timeline, Stage::DRIVER_SETUP) - start_us),
+			static_cast<unsigned int>(ConnectTimeline::get(timeline, Stage::INIT_DONE) - start_us),
+			static_cast<unsigned int>(now_us - start_us));
+	}
+
+	//Time from setup_driver() to the first report, covers the driver's init sequence
+	inline void log_first_report(uint8_t address, uint8_t instance, Interface& interface)
+	{
+		interface.first_report_us = std::max<uint32_t>(board_api::us_since_boot() - interface.mount_time_us, 1);
+		OGXM_LOG("Host addr %u itf %u type %u: first report %u us after mount\n", 
+			static_cast<unsigned int>(address), static_cast<unsigned int>(instance), 
+			static_cast<unsigned int>(interface.type), static_cast<unsigned int>(interface.first_report_us));
 	}
 
+	inline void reset_device(Device& device)
+	{
+		device.address = INVALID_IDX;
+		device.enumerated_us = 0;
+		for (auto& interface : device.interfaces)
+		{
+			release_interface(interface);
+		}
+	}
+
+	//Direct mapped, driver and gamepad are set together in setup_driver() so a non null driver is safe to dispatch to
+	inline Interface* get_interface(uint8_t address, uint8_t instance)
+	{
+		if (address == 0 || address > CFG_TUH_DEVICE_MAX || instance >= MAX_INTERFACES)
+		{
+			return nullptr;
+		}
+		return &device_slots_[address - 1].interfaces[instance];
+	}
+
+	//Lowest gamepad index not in use, so pads unplugged out of order free their slot for the next one
 	inline uint8_t find_free_gamepad()
 	{
-		uint8_t count = 0;
+		uint32_t used = 0;
 
 		for (auto& device_slot : device_slots_)
 		{
@@ -309,20 +683,18 @@ private:
 			{
 				if (interface.gamepad_idx != INVALID_IDX)
 				{
-					++count;
+					used |= (1u << interface.gamepad_idx);
 				}
 			}
 		}
-		return (count < MAX_GAMEPADS) ? count : INVALID_IDX;
-	}
-
-	inline uint8_t get_device_slot(uint8_t address)
-	{
-		if (address > MAX_GAMEPADS)
+		for (uint8_t i = 0; i < MAX_GAMEPADS; ++i)
 		{
-			return INVALID_IDX;
+			if (!(used & (1u << i)))
+			{
+				return i;
+			}
 		}
-		return address - 1;
+		return INVALID_IDX;
 	}
 
 	// inline DriverClass determine_driver_class(HostDriver::Type host_type)
@@ -339,6 +711,29 @@ private:
 	// 	}
 	// }
 
+	//Types setup_driver() has a dedicated driver for, anything else has to be a HID gamepad
+	static inline bool has_driver(HostDriverType driver_type)
+	{
+		switch (driver_type)
+		{
+			case HostDriverType::PS5:
+			case HostDriverType::PS4:
+			case HostDriverType::PS3:
+			case HostDriverType::DINPUT:
+			case HostDriverType::SWITCH:
+			case HostDriverType::SWITCH_PRO:
+			case HostDriverType::N64:
+			case HostDriverType::PSCLASSIC:
+			case HostDriverType::XBOXOG:
+			case HostDriverType::XBOXONE:
+			case HostDriverType::XBOX360:
+			case HostDriverType::XBOX360W:
+				return true;
+			default:
+				return false;
+		}
+	}
+
 	bool is_hid_gamepad(const uint8_t* report_desc, uint16_t desc_len)
 	{
 		std::array<uint8_t, 6> start_bytes = { 0x05, 0x01, 0x09, 0x05, 0xA1, 0x01 };
@@ -364,7 +759,7 @@ private:
 			{
 				if (interface.gamepad_idx == gamepad_idx)
 				{
-					return interface.driver.get();
+					return interface.driver;
 				}
 			}
 		}
@@ -0,0 +1,47 @@
+#include "tusb.h"
+#include "host/usbh.h"
+
+#include "USBHost/HostManager.h"
+#include "USBHost/PollInterval.h"
+#include "Board/ogxm_log.h"
+
+extern "C" bool __real_hcd_edpt_open(uint8_t rhport, uint8_t dev_addr, tusb_desc_endpoint_t const* desc_ep);
+
+namespace PollInterval
+{
+    bool apply(const tusb_desc_endpoint_t& desc_ep, uint8_t interval_ms, tusb_desc_endpoint_t& out)
+    {
+        if (interval_ms == 0 ||
+            desc_ep.bmAttributes.xfer != TUSB_XFER_INTERRUPT ||
+            tu_edpt_dir(desc_ep.bEndpointAddress) != TUSB_DIR_IN ||
+            desc_ep.bInterval == interval_ms)
+        {
+            return false;
+        }
+        out = desc_ep;
+        out.bInterval = interval_ms;
+        return true;
+    }
+}
+
+bool __wrap_hcd_edpt_open(uint8_t rhport, uint8_t dev_addr, tusb_desc_endpoint_t const* desc_ep)
+{
+    //Address 0 is the control endpoint during enumeration, hubs get addresses above CFG_TUH_DEVICE_MAX
+    //and keep their status change endpoint's own interval
+    if (dev_addr == 0 || dev_addr > CFG_TUH_DEVICE_MAX)
+    {
+        return __real_hcd_edpt_open(rhport, dev_addr, desc_ep);
+    }
+
+    uint16_t vid = 0, pid = 0;
+    tuh_vid_pid_get(dev_addr, &vid, &pid);
+
+    tusb_desc_endpoint_t desc_override;
+    if (!PollInterval::apply(*desc_ep, HostManager::get_instance().poll_interval_override({ vid, pid }), desc_override))
+    {
+        return __real_hcd_edpt_open(rhport, dev_addr, desc_ep);
+    }
+
+    OGXM_LOG("Poll override: addr %d ep 0x%02x %d ms -> %d ms\n", dev_addr, desc_ep->bEndpointAddress, desc_ep->bInterval, desc_override.bInterval);
+    return __real_hcd_edpt_open(rhport, dev_addr, &desc_override);
+}
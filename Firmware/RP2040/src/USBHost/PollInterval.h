@@ -0,0 +1,22 @@
+#ifndef _POLL_INTERVAL_H_
+#define _POLL_INTERVAL_H_
+
+#include <cstdint>
+
+#include "tusb.h"
+
+// Interrupt IN endpoint interval override, from the gamepad's profile (UserProfile::host_poll_ms)
+// or a HardwareIDs POLL_INTERVAL quirk, see HostManager::poll_interval_override().
+// hcd_edpt_open() is wrapped at link time (--wrap=hcd_edpt_open), so every endpoint a host class driver
+// opens, HID or XInput, comes through here. The HCD gets a copy of the endpoint descriptor with the new
+// bInterval, TinyUSB's enumeration buffer is left as it was.
+namespace PollInterval
+{
+    //Copies desc_ep to out with bInterval set to interval_ms, false if desc_ep isn't an interrupt IN
+    //endpoint, interval_ms is 0 or bInterval already matches, out is left untouched then.
+    bool apply(const tusb_desc_endpoint_t& desc_ep, uint8_t interval_ms, tusb_desc_endpoint_t& out);
+}
+
+extern "C" bool __wrap_hcd_edpt_open(uint8_t rhport, uint8_t dev_addr, tusb_desc_endpoint_t const* desc_ep);
+
+#endif // _POLL_INTERVAL_H_
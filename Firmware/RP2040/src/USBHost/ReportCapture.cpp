@@ -0,0 +1,146 @@
+#include <cstring>
+#include <atomic>
+#include <algorithm>
+
+#include "pico/platform.h"
+
+#include "Board/board_api.h"
+#include "USBHost/ReportCapture.h"
+
+namespace ReportCapture
+{
+    struct Storage
+    {
+        uint32_t magic;
+        uint32_t frozen;
+        uint32_t total;      //Records written since the last resume(), written by core1 only
+        uint32_t dump_total; //total when the ring was frozen
+        Record records[MAX_RECORDS];
+    };
+
+    //Not zeroed on boot, a frozen capture is still here after a soft reset
+    static Storage __uninitialized_ram(storage_);
+
+    static_assert((UINT32_MAX % MAX_RECORDS) == MAX_RECORDS - 1, "MAX_RECORDS must divide 2^32 so the ring index survives total wrapping");
+
+    static inline std::atomic_ref<uint32_t> shared(uint32_t& value)
+    {
+        return std::atomic_ref<uint32_t>(value);
+    }
+
+    //A record still being written when the ring froze can only be in the slot after the newest,
+    //so one slot is always left out of the dump
+    static inline uint16_t dump_count()
+    {
+        return static_cast<uint16_t>(std::min<uint32_t>(storage_.dump_total, MAX_RECORDS - 1));
+    }
+
+    void init()
+    {
+        if (storage_.magic != MAGIC || storage_.frozen != 1)
+        {
+            resume();
+        }
+    }
+
+    void record(Kind kind, uint8_t address, uint8_t instance, HostDriverType type, const uint8_t* data, uint16_t len)
+    {
+        if (shared(storage_.frozen).load(std::memory_order_acquire))
+        {
+            return;
+        }
+
+        const uint32_t total = storage_.total;
+        Record& slot = storage_.records[total % MAX_RECORDS];
+        const size_t data_len = data ? std::min<size_t>(len, MAX_DATA) : 0;
+
+        slot.timestamp_us = board_api::us_since_boot();
+        slot.kind = kind;
+        slot.address = address;
+        slot.instance = instance;
+        slot.driver_type = static_cast<uint8_t>(type);
+        slot.len = len;
+        if (data_len)
+        {
+            std::memcpy(slot.data, data, data_len);
+        }
+        std::memset(slot.data + data_len, 0, MAX_DATA - data_len);
+
+        shared(storage_.total).store(total + 1, std::memory_order_release);
+    }
+
+    void freeze()
+    {
+        if (shared(storage_.frozen).load(std::memory_order_acquire))
+        {
+            return;
+        }
+        shared(storage_.frozen).store(1, std::memory_order_release);
+        storage_.dump_total = shared(storage_.total).load(std::memory_order_acquire);
+    }
+
+    bool frozen()
+    {
+        return shared(storage_.frozen).load(std::memory_order_acquire) == 1 && storage_.magic == MAGIC;
+    }
+
+    void resume()
+    {
+        storage_.magic = MAGIC;
+        storage_.dump_total = 0;
+        shared(storage_.total).store(0, std::memory_order_release);
+        shared(storage_.frozen).store(0, std::memory_order_release);
+    }
+
+    size_t dump_size()
+    {
+        return frozen() ? sizeof(DumpHeader) + static_cast<size_t>(dump_count()) * sizeof(Record) : 0;
+    }
+
+    size_t read_dump(size_t offset, uint8_t* buffer, size_t len)
+    {
+        const size_t size = dump_size();
+        if (offset >= size)
+        {
+            return 0;
+        }
+        len = std::min(len, size - offset);
+
+        const uint16_t count = dump_count();
+        const DumpHeader header =
+        {
+            .magic = MAGIC,
+            .version = VERSION,
+            .record_size = static_cast<uint8_t>(sizeof(Record)),
+            .record_count = count,
+            .dropped = storage_.dump_total - count
+        };
+        const uint32_t first = storage_.dump_total - count;
+
+        size_t copied = 0;
+        while (copied < len)
+        {
+            const size_t pos = offset + copied;
+            const uint8_t* src = nullptr;
+            size_t available = 0;
+
+            if (pos < sizeof(DumpHeader))
+            {
+                src = reinterpret_cast<const uint8_t*>(&header) + pos;
+                available = sizeof(DumpHeader) - pos;
+            }
+            else
+            {
+                const size_t record_pos = pos - sizeof(DumpHeader);
+                const uint32_t record_idx = first + static_cast<uint32_t>(record_pos / sizeof(Record));
+                src = reinterpret_cast<const uint8_t*>(&storage_.records[record_idx % MAX_RECORDS]) + (record_pos % sizeof(Record));
+                available = sizeof(Record) - (record_pos % sizeof(Record));
+            }
+
+            const size_t chunk = std::min(available, len - copied);
+            std::memcpy(buffer + copied, src, chunk);
+            copied += chunk;
+        }
+        return copied;
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef _REPORT_CAPTURE_H_
+#define _REPORT_CAPTURE_H_
+
+#include <cstdint>
+#include <cstddef>
+
+#include "USBHost/HostDriver/HostDriverTypes.h"
+
+// Raw host report recorder for reproducing field issues, enabled with EN_REPORT_CAPTURE.
+// Core1 records every report HostManager receives into a RAM ring, core0 reads it back
+// once the ring is frozen, the writer never waits on the reader.
+// A frozen capture lives in uninitialized RAM so it survives the reboot into WebApp mode.
+namespace ReportCapture
+{
+    static constexpr uint16_t MAX_RECORDS = 128;
+    static constexpr uint8_t MAX_DATA = 64;
+    static constexpr uint32_t MAGIC = 0x4F43504Eu; //"OCPN"
+    static constexpr uint8_t VERSION = 1;
+
+    enum class Kind : uint8_t
+    {
+        REPORT = 0,
+        MOUNT,  //data holds the start of the HID report descriptor, if there is one
+        UNMOUNT
+    };
+
+    #pragma pack(push, 1)
+    struct Record
+    {
+        uint32_t timestamp_us;
+        Kind kind;
+        uint8_t address;
+        uint8_t instance;
+        uint8_t driver_type; //HostDriverType
+        uint16_t len;        //Length the report arrived with, data holds at most MAX_DATA bytes of it
+        uint8_t data[MAX_DATA];
+    };
+    static_assert(sizeof(Record) == 74, "ReportCapture record size mismatch");
+
+    //Start of a dump, followed by record_count records oldest first
+    struct DumpHeader
+    {
+        uint32_t magic;
+        uint8_t version;
+        uint8_t record_size;
+        uint16_t record_count;
+        uint32_t dropped; //Records overwritten before the dump
+    };
+    static_assert(sizeof(DumpHeader) == 12, "ReportCapture dump header size mismatch");
+    #pragma pack(pop)
+
+    //Call once on core1 before recording, keeps a frozen capture from before the last reboot
+    void init();
+
+    //Core1 only, returns straight away while frozen
+    void record(Kind kind, uint8_t address, uint8_t instance, HostDriverType type, const uint8_t* data, uint16_t len);
+
+    //Stops recording so the ring can be read, safe from either core
+    void freeze();
+    bool frozen();
+
+    //Clears the ring and starts recording again
+    void resume();
+
+    //Dump is a DumpHeader followed by the records, read it in pieces from a frozen ring
+    size_t dump_size();
+    size_t read_dump(size_t offset, uint8_t* buffer, size_t len);
+}
+
+#endif // _REPORT_CAPTURE_H_
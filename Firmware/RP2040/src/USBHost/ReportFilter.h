@@ -0,0 +1,113 @@
+#ifndef _REPORT_FILTER_H_
+#define _REPORT_FILTER_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <array>
+#include <span>
+#include <algorithm>
+
+// Drops IN reports whose significant bits match the last report let through,
+// so unchanged reports never reach a driver's translation code.
+// Drivers describe the bits that matter with a Mask, one mask byte per report byte,
+// report bytes past the end of the mask are ignored.
+class ReportFilter
+{
+public:
+    static constexpr size_t MAX_REPORT_SIZE = 64;
+
+    template <size_t SIZE>
+    struct Mask
+    {
+        static_assert(SIZE > 0 && SIZE <= MAX_REPORT_SIZE, "Report mask must cover 1 to MAX_REPORT_SIZE bytes");
+
+        std::array<uint8_t, SIZE> bytes{0};
+
+        constexpr Mask& keep(size_t offset, size_t len, uint8_t bits = 0xFF)
+        {
+            for (size_t i = offset; i < offset + len && i < SIZE; ++i)
+            {
+                bytes[i] = bits;
+            }
+            return *this;
+        }
+
+        constexpr Mask& keep_all()
+        {
+            return keep(0, SIZE);
+        }
+
+        constexpr operator std::span<const uint8_t>() const { return bytes; }
+    };
+
+    //An empty mask lets every report through. Changing masks always lets the next report through.
+    bool changed(std::span<const uint8_t> mask, const uint8_t* report, uint16_t len)
+    {
+        if (mask.empty())
+        {
+            has_prev_ = false;
+            ++processed_;
+            return true;
+        }
+        if (mask.data() != mask_)
+        {
+            mask_ = mask.data();
+            has_prev_ = false;
+        }
+
+        const size_t mask_len = std::min(mask.size(), MAX_REPORT_SIZE);
+        const size_t words = (mask_len + 3) / 4;
+
+        //Short reports compare as if zero padded
+        uint32_t current[MAX_WORDS];
+        std::memset(current, 0, words * 4);
+        std::memcpy(current, report, std::min(static_cast<size_t>(len), mask_len));
+
+        uint32_t diff = has_prev_ ? 0 : 1;
+        for (size_t i = 0; i < words; ++i)
+        {
+            uint32_t mask_word = 0;
+            std::memcpy(&mask_word, mask_ + i * 4, std::min(static_cast<size_t>(4), mask_len - i * 4));
+            diff |= (current[i] ^ prev_[i]) & mask_word;
+        }
+
+        if (!diff)
+        {
+            ++suppressed_;
+            return false;
+        }
+
+        std::memcpy(prev_, current, words * 4);
+        has_prev_ = true;
+        ++processed_;
+        return true;
+    }
+
+    void reset()
+    {
+        mask_ = nullptr;
+        has_prev_ = false;
+        clear_counts();
+    }
+
+    inline void clear_counts()
+    {
+        processed_ = 0;
+        suppressed_ = 0;
+    }
+
+    inline uint32_t processed() const { return processed_; }
+    inline uint32_t suppressed() const { return suppressed_; }
+
+private:
+    static constexpr size_t MAX_WORDS = MAX_REPORT_SIZE / 4;
+
+    uint32_t prev_[MAX_WORDS]{0};
+    const uint8_t* mask_{nullptr};
+    bool has_prev_{false};
+    uint32_t processed_{0};
+    uint32_t suppressed_{0};
+};
+
+#endif // _REPORT_FILTER_H_
@@ -7,10 +7,68 @@
 #include "USBHost/HostDriver/XInput/tuh_xinput/tuh_xinput.h"
 #include "USBHost/HostManager.h"
 #include "OGXMini/OGXMini.h"
+#include "Board/ogxm_log.h"
+
+//Enumeration timestamp
+
+namespace enumerated {
+
+static bool init() {
+    return true;
+}
+
+static bool deinit() {
+    return true;
+}
+
+//Listed first, usbh tries the app drivers on each interface before the class drivers,
+//so this marks when the device's configuration was read. Never claims the interface.
+//The interrupt IN interval override is applied when the endpoints are opened, see PollInterval.h.
+static bool open(uint8_t rhport, uint8_t dev_addr, tusb_desc_interface_t const* desc_itf, uint16_t max_len) {
+    (void)rhport;
+    (void)desc_itf;
+    (void)max_len;
+
+    HostManager::get_instance().device_enumerated(dev_addr);
+    return false;
+}
+
+static bool set_config(uint8_t dev_addr, uint8_t itf_num) {
+    return false;
+}
+
+static bool xfer_cb(uint8_t dev_addr, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes) {
+    return false;
+}
+
+static void close(uint8_t dev_addr) {
+}
+
+static usbh_class_driver_t class_driver() {
+    return {
+    #if CFG_TUSB_DEBUG >= 2
+        .name       = "Enumerated",
+    #else
+        .name       = nullptr,
+    #endif
+        .init       = init,
+        .deinit     = deinit,
+        .open       = open,
+        .set_config = set_config,
+        .xfer_cb    = xfer_cb,
+        .close      = close
+    };
+}
+
+} // namespace enumerated
 
 usbh_class_driver_t const* usbh_app_driver_get_cb(uint8_t* driver_count) {
-    *driver_count = 1;
-    return tuh_xinput::class_driver();
+    static const usbh_class_driver_t app_drivers[] = {
+        enumerated::class_driver(),
+        *tuh_xinput::class_driver()
+    };
+    *driver_count = static_cast<uint8_t>(sizeof(app_drivers) / sizeof(app_drivers[0]));
+    return app_drivers;
 }
 
 //HID
@@ -39,6 +97,10 @@ void tuh_hid_report_received_cb(uint8_t dev_addr, uint8_t instance, uint8_t cons
     HostManager::get_instance().process_report(dev_addr, instance, report, len);
 }
 
+void tuh_hid_report_sent_cb(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len) {
+    HostManager::get_instance().report_sent(dev_addr, instance);
+}
+
 //XINPUT
 
 void tuh_xinput::mount_cb(uint8_t dev_addr, uint8_t instance, const tuh_xinput::Interface* interface) {
@@ -63,6 +125,10 @@ void tuh_xinput::report_received_cb(uint8_t dev_addr, uint8_t instance, const ui
     HostManager::get_instance().process_report(dev_addr, instance, report, len);
 }
 
+void tuh_xinput::report_sent_cb(uint8_t dev_addr, uint8_t instance, const uint8_t* report, uint16_t len) {
+    HostManager::get_instance().report_sent(dev_addr, instance);
+}
+
 void tuh_xinput::xbox360w_connect_cb(uint8_t dev_addr, uint8_t instance) {
     uint8_t idx = HostManager::get_instance().get_gamepad_idx(  HostManager::DriverClass::XINPUT, 
                                                                 dev_addr, instance);
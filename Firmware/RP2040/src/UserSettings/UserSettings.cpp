@@ -8,6 +8,9 @@
 #include "Board/ogxm_log.h"
 #include "Board/board_api.h"
 #include "UserSettings/UserSettings.h"
+#if defined(CONFIG_EN_REPORT_CAPTURE)
+#include "USBHost/ReportCapture.h"
+#endif
 
 static constexpr uint32_t BUTTON_COMBO(const uint16_t& buttons, const uint8_t& dpad = 0) {
     return (static_cast<uint32_t>(buttons) << 16) | static_cast<uint32_t>(dpad);
@@ -25,6 +28,8 @@ namespace ButtonCombo {
     static constexpr uint32_t WEBAPP = BUTTON_COMBO(Gamepad::BUTTON_START | Gamepad::BUTTON_LB, Gamepad::DPAD_UP);
     // NUEVO: Combo para PS4 (START + Y, sin dpad)
     static constexpr uint32_t PS4       = BUTTON_COMBO(Gamepad::BUTTON_START | Gamepad::BUTTON_Y);
+    //Freezes the host report capture, doesn't change the driver
+    static constexpr uint32_t CAPTURE   = BUTTON_COMBO(Gamepad::BUTTON_START | Gamepad::BUTTON_BACK);
 };
 
 static constexpr DeviceDriverType VALID_DRIVER_TYPES[] = {
@@ -43,6 +48,7 @@ static constexpr DeviceDriverType VALID_DRIVER_TYPES[] = {
 #elif MAX_GAMEPADS > 1
     DeviceDriverType::DINPUT, 
     DeviceDriverType::SWITCH, 
+    DeviceDriverType::XINPUT,        // One XInput interface per gamepad
     DeviceDriverType::WEBAPP,
     DeviceDriverType::PS4,           // NUEVO: PS4 válido cuando hay >1 gamepad
 
@@ -115,7 +121,7 @@ DeviceDriverType UserSettings::DEFAULT_DRIVER()
 //Checks if button combo has been held for 3 seconds, returns true if mode has been changed
 bool UserSettings::check_for_driver_change(Gamepad& gamepad)
 {
-    Gamepad::PadIn gp_in = gamepad.get_pad_in();
+    Gamepad::PadIn gp_in = gamepad.peek_pad_in();
     static uint32_t last_button_combo = BUTTON_COMBO(gp_in.buttons, gp_in.dpad);
     static uint8_t call_count = 0;
 
@@ -138,6 +144,15 @@ bool UserSettings::check_for_driver_change(Gamepad& gamepad)
 
     call_count = 0;
 
+#if defined(CONFIG_EN_REPORT_CAPTURE)
+    if (current_button_combo == ButtonCombo::CAPTURE)
+    {
+        OGXM_LOG("Host report capture frozen\n");
+        ReportCapture::freeze();
+        return false;
+    }
+#endif
+
     DeviceDriverType new_driver = DeviceDriverType::NONE;
 
     for (const auto& combo_map : BUTTON_COMBO_MAP)
@@ -108,7 +108,7 @@
 #define CFG_TUD_MIDI    0
 #define CFG_TUD_VENDOR  0
 #define CFG_TUD_XID     1
-#define CFG_TUD_XINPUT  1
+#define CFG_TUD_XINPUT  XINPUT_MAX_GAMEPADS
 
 // HID buffer size Should be sufficient to hold ID (if any) + Data
 #define CFG_TUD_HID_EP_BUFSIZE 64
@@ -0,0 +1,129 @@
+#ifndef _HOST_BENCH_H_
+#define _HOST_BENCH_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+#endif
+
+// Minimal benchmark runner for the host build.
+// Each case runs for a fixed wall time per repetition, the median repetition is reported.
+// Results go to stdout as JSON so runs can be diffed, progress goes to stderr.
+namespace bench
+{
+    //Keeps value alive so the measured code isn't optimized out
+    template <typename T>
+    inline void keep(T const& value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    inline uint64_t cycles()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    struct Result
+    {
+        std::string name;
+        uint64_t iterations;
+        double ns_per_op;
+        double cycles_per_op; //TSC ticks on x86, 0 where there is no cycle counter
+    };
+
+    class Runner
+    {
+    public:
+        Runner(int argc, char** argv)
+        {
+            for (int i = 1; i < argc; ++i)
+            {
+                if (std::strcmp(argv[i], "--quick") == 0)
+                {
+                    quick_ = true;
+                }
+                else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+                {
+                    filter_ = argv[++i];
+                }
+            }
+        }
+
+        inline bool quick() const { return quick_; }
+
+        //func() does ops_per_call operations per call
+        template <typename Func>
+        void run(const std::string& name, uint64_t ops_per_call, Func&& func)
+        {
+            if (!filter_.empty() && name.find(filter_) == std::string::npos)
+            {
+                return;
+            }
+
+            const auto budget = std::chrono::microseconds(quick_ ? 2000 : 100000);
+            const int repetitions = quick_ ? 1 : 5;
+
+            std::vector<Result> reps;
+            for (int r = 0; r < repetitions; ++r)
+            {
+                uint64_t calls = 0;
+                const auto start = std::chrono::steady_clock::now();
+                const uint64_t start_cycles = cycles();
+                auto now = start;
+                do
+                {
+                    for (int i = 0; i < 16; ++i)
+                    {
+                        func();
+                    }
+                    calls += 16;
+                    now = std::chrono::steady_clock::now();
+                } 
+                while (now - start < budget);
+                const uint64_t elapsed_cycles = cycles() - start_cycles;
+                const double ops = static_cast<double>(calls * ops_per_call);
+                const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count());
+                reps.push_back({ name, calls * ops_per_call, ns / ops, static_cast<double>(elapsed_cycles) / ops });
+            }
+            std::sort(reps.begin(), reps.end(), [](const Result& a, const Result& b) { return a.ns_per_op < b.ns_per_op; });
+
+            const Result& result = reps[reps.size() / 2];
+            std::cerr << name << ": " << result.ns_per_op << " ns/op, " << result.cycles_per_op << " cycles/op\n";
+            results_.push_back(result);
+        }
+
+        void print_json(std::ostream& os) const
+        {
+            os << "{\n  \"benchmarks\": [\n";
+            for (size_t i = 0; i < results_.size(); ++i)
+            {
+                const Result& r = results_[i];
+                os << "    {\"name\": \"" << r.name 
+                   << "\", \"iterations\": " << r.iterations
+                   << ", \"ns_per_op\": " << r.ns_per_op 
+                   << ", \"cycles_per_op\": " << r.cycles_per_op << "}"
+                   << ((i + 1 < results_.size()) ? ",\n" : "\n");
+            }
+            os << "  ]\n}\n";
+        }
+
+    private:
+        bool quick_{false};
+        std::string filter_;
+        std::vector<Result> results_;
+    };
+
+} // namespace bench
+
+#endif // _HOST_BENCH_H_
@@ -0,0 +1,200 @@
+#include <cstdint>
+#include <array>
+#include <memory>
+#include <iostream>
+
+#include "pico/time.h"
+
+#include "Gamepad/Gamepad.h"
+#include "UserSettings/UserProfile.h"
+#include "USBHost/HIDParser/HIDReportDescriptor.h"
+#include "USBHost/HIDParser/HIDJoystick.h"
+#include "USBHost/HIDParser/HIDFieldProgram.h"
+#include "USBDevice/DeviceDriver/XInput/XInput.h"
+#include "USBDevice/DeviceDriver/PS3/PS3.h"
+#include "USBDevice/DeviceDriver/PS4/PS4.h"
+#include "USBDevice/DeviceDriver/DInput/DInput.h"
+#include "USBDevice/DeviceDriver/Switch/Switch.h"
+#include "USBDevice/DeviceDriver/PSClassic/PSClassic.h"
+#include "USBDevice/DeviceDriver/XboxOG/XboxOG_GP.h"
+
+#include "Bench.h"
+
+// Micro benchmarks for the code on the host report -> device report path.
+// ogxm_bench [--quick] [--filter <substring>] > results.json
+
+namespace {
+
+static constexpr size_t SAMPLES = 4096;
+
+//xorshift32, fixed seed so every run sees the same inputs
+struct Random
+{
+    uint32_t state{0x12345678};
+    uint32_t next()
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+};
+
+//Profile with every joystick and trigger stage doing something
+UserProfile shaped_profile()
+{
+    UserProfile profile;
+    JoystickSettingsRaw& joy = profile.joystick_settings_l;
+    joy.dz_inner = F16(0.08);
+    joy.dz_outer = F16(0.98);
+    joy.anti_dz_circle = F16(0.1);
+    joy.anti_dz_outer = F16(1.0);
+    joy.axis_restrict = F16(0.05);
+    joy.angle_restrict = F16(0.1);
+    joy.diag_scale_min = F16(1.0);
+    joy.diag_scale_max = F16(1.1);
+    joy.curve = F16(1.5);
+    profile.joystick_settings_r = joy;
+
+    TriggerSettingsRaw& trig = profile.trigger_settings_l;
+    trig.dz_inner = F16(0.1);
+    trig.curve = F16(1.5);
+    profile.trigger_settings_r = trig;
+    return profile;
+}
+
+std::array<Gamepad::PadIn, SAMPLES> random_pads()
+{
+    Random random;
+    std::array<Gamepad::PadIn, SAMPLES> pads;
+    for (auto& pad : pads)
+    {
+        pad.dpad = static_cast<uint8_t>(random.next() & 0x0F);
+        pad.buttons = static_cast<uint16_t>(random.next());
+        pad.trigger_l = static_cast<uint8_t>(random.next());
+        pad.trigger_r = static_cast<uint8_t>(random.next());
+        pad.joystick_lx = static_cast<int16_t>(random.next());
+        pad.joystick_ly = static_cast<int16_t>(random.next());
+        pad.joystick_rx = static_cast<int16_t>(random.next());
+        pad.joystick_ry = static_cast<int16_t>(random.next());
+        for (auto& analog : pad.analog)
+        {
+            analog = static_cast<uint8_t>(random.next());
+        }
+    }
+    return pads;
+}
+
+void bench_shaping(bench::Runner& runner)
+{
+    static Gamepad gamepad;
+    gamepad.set_profile(shaped_profile());
+    static const auto pads = random_pads();
+
+    size_t i = 0;
+    runner.run("gamepad/scale_joystick", 1, [&]
+    {
+        const Gamepad::PadIn& pad = pads[i++ % SAMPLES];
+        bench::keep(gamepad.scale_joystick_l(pad.joystick_lx, pad.joystick_ly));
+    });
+    runner.run("gamepad/scale_trigger", 1, [&]
+    {
+        bench::keep(gamepad.scale_trigger_l(pads[i++ % SAMPLES].trigger_l));
+    });
+    runner.run("gamepad/map_buttons", 1, [&]
+    {
+        const Gamepad::PadIn& pad = pads[i++ % SAMPLES];
+        bench::keep(gamepad.map_buttons(pad.buttons));
+        bench::keep(gamepad.map_dpad(pad.dpad));
+    });
+}
+
+void bench_hid(bench::Runner& runner)
+{
+    //A generic HID gamepad, the same descriptor the DInput device mode presents
+    const uint8_t* desc = DInput::REPORT_DESCRIPTORS;
+    const uint16_t desc_len = sizeof(DInput::REPORT_DESCRIPTORS);
+
+    runner.run("hid/descriptor_parse", 1, [&]
+    {
+        HIDReportDescriptor descriptor(desc, desc_len);
+        bench::keep(descriptor.GetReports().size());
+    });
+
+    auto descriptor = std::make_shared<HIDReportDescriptor>(desc, desc_len);
+    runner.run("hid/field_program_compile", 1, [&]
+    {
+        HIDFieldProgram program;
+        bench::keep(program.compile(descriptor->GetReports()));
+    });
+
+    HIDJoystick joystick(descriptor);
+    HIDFieldProgram program;
+    program.compile(descriptor->GetReports());
+
+    Random random;
+    std::array<std::array<uint8_t, sizeof(DInput::InReport)>, 64> reports;
+    for (auto& report : reports)
+    {
+        for (auto& byte : report)
+        {
+            byte = static_cast<uint8_t>(random.next());
+        }
+    }
+
+    HIDJoystickData data;
+    size_t i = 0;
+    runner.run("hid/joystick_parse", 1, [&]
+    {
+        auto& report = reports[i++ % reports.size()];
+        bench::keep(joystick.parseData(report.data(), static_cast<uint16_t>(report.size()), &data));
+        bench::keep(data);
+    });
+    runner.run("hid/field_program_parse", 1, [&]
+    {
+        auto& report = reports[i++ % reports.size()];
+        bench::keep(program.parseData(report.data(), static_cast<uint16_t>(report.size()), &data));
+        bench::keep(data);
+    });
+}
+
+//One new pad input and one report build per op, the USB side is the host_usb stand-in
+template <typename Driver>
+void bench_device(bench::Runner& runner, const char* name)
+{
+    static Gamepad gamepad;
+    static const auto pads = random_pads();
+    auto driver = std::make_unique<Driver>();
+    driver->initialize();
+
+    size_t i = 0;
+    runner.run(std::string("device/") + name, 1, [&]
+    {
+        gamepad.set_pad_in(pads[i++ % SAMPLES]);
+        driver->process(0, gamepad);
+    });
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    bench::Runner runner(argc, argv);
+
+    //Timestamps taken on the measured path shouldn't cost a clock read
+    host_time::set_us(1);
+
+    bench_shaping(runner);
+    bench_hid(runner);
+
+    bench_device<XInputDevice>(runner, "xinput");
+    bench_device<PS3Device>(runner, "ps3");
+    bench_device<PS4Device>(runner, "ps4");
+    bench_device<DInputDevice>(runner, "dinput");
+    bench_device<SwitchDevice>(runner, "switch");
+    bench_device<PSClassicDevice>(runner, "psclassic");
+    bench_device<XboxOGDevice>(runner, "xboxog");
+
+    runner.print_json(std::cout);
+    return 0;
+}
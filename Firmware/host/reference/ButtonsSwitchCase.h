@@ -0,0 +1,286 @@
+#ifndef _REFERENCE_BUTTONS_SWITCH_CASE_H_
+#define _REFERENCE_BUTTONS_SWITCH_CASE_H_
+
+#include <cstdint>
+#include <cstring>
+
+#include "Gamepad/Gamepad.h"
+#include "USBDevice/DeviceDriver/XInput/XInput.h"
+#include "USBDevice/DeviceDriver/PS3/PS3.h"
+#include "USBDevice/DeviceDriver/DInput/DInput.h"
+#include "USBDevice/DeviceDriver/Switch/Switch.h"
+#include "USBDevice/DeviceDriver/PSClassic/PSClassic.h"
+#include "USBDevice/DeviceDriver/XboxOG/XboxOG_GP.h"
+
+// The device drivers' button and dpad code before ButtonTable: a dpad switch and one if per button.
+// Each function only writes the report's button and dpad fields, everything else is left alone.
+// Kept as the reference for the device button test.
+namespace buttons_switch_case
+{
+    inline void xinput(const Gamepad::PadIn& gp_in, XInput::InReport& in_report, uint32_t& turbo_tick)
+    {
+        in_report.buttons[0] = 0;
+        in_report.buttons[1] = 0;
+        switch (gp_in.dpad) {
+            case Gamepad::DPAD_UP:         in_report.buttons[0] |= XInput::Buttons0::DPAD_UP; break;
+            case Gamepad::DPAD_DOWN:       in_report.buttons[0] |= XInput::Buttons0::DPAD_DOWN; break;
+            case Gamepad::DPAD_LEFT:       in_report.buttons[0] |= XInput::Buttons0::DPAD_LEFT; break;
+            case Gamepad::DPAD_RIGHT:      in_report.buttons[0] |= XInput::Buttons0::DPAD_RIGHT; break;
+            case Gamepad::DPAD_UP_LEFT:    in_report.buttons[0] |= XInput::Buttons0::DPAD_UP | XInput::Buttons0::DPAD_LEFT; break;
+            case Gamepad::DPAD_UP_RIGHT:   in_report.buttons[0] |= XInput::Buttons0::DPAD_UP | XInput::Buttons0::DPAD_RIGHT; break;
+            case Gamepad::DPAD_DOWN_LEFT:  in_report.buttons[0] |= XInput::Buttons0::DPAD_DOWN | XInput::Buttons0::DPAD_LEFT; break;
+            case Gamepad::DPAD_DOWN_RIGHT: in_report.buttons[0] |= XInput::Buttons0::DPAD_DOWN | XInput::Buttons0::DPAD_RIGHT; break;
+        }
+        if (gp_in.buttons & Gamepad::BUTTON_START) in_report.buttons[0] |= XInput::Buttons0::START;
+        if (gp_in.buttons & Gamepad::BUTTON_BACK)  in_report.buttons[1] |= XInput::Buttons1::LB;
+        if (gp_in.buttons & Gamepad::BUTTON_L3)    in_report.buttons[0] |= XInput::Buttons0::L3;
+        if (gp_in.buttons & Gamepad::BUTTON_R3)    in_report.buttons[0] |= XInput::Buttons0::R3;
+        if (gp_in.buttons & Gamepad::BUTTON_MISC)  in_report.buttons[0] |= XInput::Buttons0::BACK;
+        if (gp_in.buttons & Gamepad::BUTTON_X)     in_report.buttons[1] |= XInput::Buttons1::X;
+        if (gp_in.buttons & Gamepad::BUTTON_A)     in_report.buttons[1] |= XInput::Buttons1::A;
+        if (gp_in.buttons & Gamepad::BUTTON_Y)     in_report.buttons[1] |= XInput::Buttons1::Y;
+        if (gp_in.buttons & Gamepad::BUTTON_B)     in_report.buttons[1] |= XInput::Buttons1::B;
+        if (gp_in.buttons & Gamepad::BUTTON_RB)    in_report.buttons[1] |= XInput::Buttons1::RB;
+        if (gp_in.buttons & Gamepad::BUTTON_SYS)   in_report.buttons[1] |= XInput::Buttons1::HOME;
+
+        if (gp_in.buttons & Gamepad::BUTTON_LB)
+        {
+            turbo_tick++;
+            if ((turbo_tick / 5) % 2 == 0) in_report.buttons[1] |= XInput::Buttons1::A;
+        }
+        else
+        {
+            turbo_tick = 0;
+        }
+    }
+
+    inline void ps3(const Gamepad::PadIn& gp_in, PS3::InReport& in_report)
+    {
+        std::memset(in_report.buttons, 0, sizeof(in_report.buttons));
+        switch (gp_in.dpad)
+        {
+            case Gamepad::DPAD_UP:
+                in_report.buttons[0] = PS3::Buttons0::DPAD_UP;
+                break;
+            case Gamepad::DPAD_DOWN:
+                in_report.buttons[0] = PS3::Buttons0::DPAD_DOWN;
+                break;
+            case Gamepad::DPAD_LEFT:
+                in_report.buttons[0] = PS3::Buttons0::DPAD_LEFT;
+                break;
+            case Gamepad::DPAD_RIGHT:
+                in_report.buttons[0] = PS3::Buttons0::DPAD_RIGHT;
+                break;
+            case Gamepad::DPAD_UP_LEFT:
+                in_report.buttons[0] = PS3::Buttons0::DPAD_UP | PS3::Buttons0::DPAD_LEFT;
+                break;
+            case Gamepad::DPAD_UP_RIGHT:
+                in_report.buttons[0] = PS3::Buttons0::DPAD_UP | PS3::Buttons0::DPAD_RIGHT;
+                break;
+            case Gamepad::DPAD_DOWN_LEFT:
+                in_report.buttons[0] = PS3::Buttons0::DPAD_DOWN | PS3::Buttons0::DPAD_LEFT;
+                break;
+            case Gamepad::DPAD_DOWN_RIGHT:
+                in_report.buttons[0] = PS3::Buttons0::DPAD_DOWN | PS3::Buttons0::DPAD_RIGHT;
+                break;
+            default:
+                break;
+        }
+
+        if (gp_in.buttons & Gamepad::BUTTON_X)        in_report.buttons[1] |= PS3::Buttons1::SQUARE;
+        if (gp_in.buttons & Gamepad::BUTTON_A)        in_report.buttons[1] |= PS3::Buttons1::CROSS;
+        if (gp_in.buttons & Gamepad::BUTTON_Y)        in_report.buttons[1] |= PS3::Buttons1::TRIANGLE;
+        if (gp_in.buttons & Gamepad::BUTTON_B)        in_report.buttons[1] |= PS3::Buttons1::CIRCLE;
+        if (gp_in.buttons & Gamepad::BUTTON_LB)       in_report.buttons[1] |= PS3::Buttons1::L1;
+        if (gp_in.buttons & Gamepad::BUTTON_RB)       in_report.buttons[1] |= PS3::Buttons1::R1;
+        if (gp_in.buttons & Gamepad::BUTTON_BACK)     in_report.buttons[0] |= PS3::Buttons0::SELECT;
+        if (gp_in.buttons & Gamepad::BUTTON_START)    in_report.buttons[0] |= PS3::Buttons0::START;
+        if (gp_in.buttons & Gamepad::BUTTON_L3)       in_report.buttons[0] |= PS3::Buttons0::L3;
+        if (gp_in.buttons & Gamepad::BUTTON_R3)       in_report.buttons[0] |= PS3::Buttons0::R3;
+        if (gp_in.buttons & Gamepad::BUTTON_SYS)      in_report.buttons[2] |= PS3::Buttons2::SYS;
+        if (gp_in.buttons & Gamepad::BUTTON_MISC)     in_report.buttons[2] |= PS3::Buttons2::TP;
+    }
+
+    inline void dinput(const Gamepad::PadIn& gp_in, DInput::InReport& in_report)
+    {
+        switch (gp_in.dpad)
+        {
+            case Gamepad::DPAD_UP:
+                in_report.dpad = DInput::DPad::UP;
+                break;
+            case Gamepad::DPAD_DOWN:
+                in_report.dpad = DInput::DPad::DOWN;
+                break;
+            case Gamepad::DPAD_LEFT:
+                in_report.dpad = DInput::DPad::LEFT;
+                break;
+            case Gamepad::DPAD_RIGHT:
+                in_report.dpad = DInput::DPad::RIGHT;
+                break;
+            case Gamepad::DPAD_UP_LEFT:
+                in_report.dpad = DInput::DPad::UP_LEFT;
+                break;
+            case Gamepad::DPAD_UP_RIGHT:
+                in_report.dpad = DInput::DPad::UP_RIGHT;
+                break;
+            case Gamepad::DPAD_DOWN_LEFT:
+                in_report.dpad = DInput::DPad::DOWN_LEFT;
+                break;
+            case Gamepad::DPAD_DOWN_RIGHT:
+                in_report.dpad = DInput::DPad::DOWN_RIGHT;
+                break;
+            default:
+                in_report.dpad = DInput::DPad::CENTER;
+                break;
+        }
+
+        std::memset(in_report.buttons, 0, sizeof(in_report.buttons));
+
+        if (gp_in.buttons & Gamepad::BUTTON_A)   in_report.buttons[0] |= DInput::Buttons0::CROSS;
+        if (gp_in.buttons & Gamepad::BUTTON_B)   in_report.buttons[0] |= DInput::Buttons0::CIRCLE;
+        if (gp_in.buttons & Gamepad::BUTTON_X)   in_report.buttons[0] |= DInput::Buttons0::SQUARE;
+        if (gp_in.buttons & Gamepad::BUTTON_Y)   in_report.buttons[0] |= DInput::Buttons0::TRIANGLE;
+        if (gp_in.buttons & Gamepad::BUTTON_LB)  in_report.buttons[0] |= DInput::Buttons0::L1;
+        if (gp_in.buttons & Gamepad::BUTTON_RB)  in_report.buttons[0] |= DInput::Buttons0::R1;
+
+        if (gp_in.buttons & Gamepad::BUTTON_L3)    in_report.buttons[1] |= DInput::Buttons1::L3;
+        if (gp_in.buttons & Gamepad::BUTTON_R3)    in_report.buttons[1] |= DInput::Buttons1::R3;
+        if (gp_in.buttons & Gamepad::BUTTON_BACK)  in_report.buttons[1] |= DInput::Buttons1::SELECT;
+        if (gp_in.buttons & Gamepad::BUTTON_START) in_report.buttons[1] |= DInput::Buttons1::START;
+        if (gp_in.buttons & Gamepad::BUTTON_SYS)   in_report.buttons[1] |= DInput::Buttons1::SYS;
+        if (gp_in.buttons & Gamepad::BUTTON_MISC)  in_report.buttons[1] |= DInput::Buttons1::TP;
+    }
+
+    inline void switch_wired(const Gamepad::PadIn& gp_in, SwitchWired::InReport& in_report)
+    {
+        switch (gp_in.dpad)
+        {
+            case Gamepad::DPAD_UP:
+                in_report.dpad = SwitchWired::DPad::UP;
+                break;
+            case Gamepad::DPAD_DOWN:
+                in_report.dpad = SwitchWired::DPad::DOWN;
+                break;
+            case Gamepad::DPAD_LEFT:
+                in_report.dpad = SwitchWired::DPad::LEFT;
+                break;
+            case Gamepad::DPAD_RIGHT:
+                in_report.dpad = SwitchWired::DPad::RIGHT;
+                break;
+            case Gamepad::DPAD_UP_LEFT:
+                in_report.dpad = SwitchWired::DPad::UP_LEFT;
+                break;
+            case Gamepad::DPAD_UP_RIGHT:
+                in_report.dpad = SwitchWired::DPad::UP_RIGHT;
+                break;
+            case Gamepad::DPAD_DOWN_LEFT:
+                in_report.dpad = SwitchWired::DPad::DOWN_LEFT;
+                break;
+            case Gamepad::DPAD_DOWN_RIGHT:
+                in_report.dpad = SwitchWired::DPad::DOWN_RIGHT;
+                break;
+            default:
+                in_report.dpad = SwitchWired::DPad::CENTER;
+                break;
+        }
+
+        in_report.buttons = 0;
+
+        if (gp_in.buttons & Gamepad::BUTTON_X)        in_report.buttons |= SwitchWired::Buttons::Y;
+        if (gp_in.buttons & Gamepad::BUTTON_A)        in_report.buttons |= SwitchWired::Buttons::B;
+        if (gp_in.buttons & Gamepad::BUTTON_Y)        in_report.buttons |= SwitchWired::Buttons::X;
+        if (gp_in.buttons & Gamepad::BUTTON_B)        in_report.buttons |= SwitchWired::Buttons::A;
+        if (gp_in.buttons & Gamepad::BUTTON_LB)       in_report.buttons |= SwitchWired::Buttons::L;
+        if (gp_in.buttons & Gamepad::BUTTON_RB)       in_report.buttons |= SwitchWired::Buttons::R;
+        if (gp_in.buttons & Gamepad::BUTTON_BACK)     in_report.buttons |= SwitchWired::Buttons::MINUS;
+        if (gp_in.buttons & Gamepad::BUTTON_START)    in_report.buttons |= SwitchWired::Buttons::PLUS;
+        if (gp_in.buttons & Gamepad::BUTTON_L3)       in_report.buttons |= SwitchWired::Buttons::L3;
+        if (gp_in.buttons & Gamepad::BUTTON_R3)       in_report.buttons |= SwitchWired::Buttons::R3;
+        if (gp_in.buttons & Gamepad::BUTTON_SYS)      in_report.buttons |= SwitchWired::Buttons::HOME;
+        if (gp_in.buttons & Gamepad::BUTTON_MISC)     in_report.buttons |= SwitchWired::Buttons::CAPTURE;
+    }
+
+    inline void psclassic(const Gamepad::PadIn& gp_in, PSClassic::InReport& in_report)
+    {
+        in_report.buttons = 0;
+        switch (gp_in.dpad)
+        {
+            case Gamepad::DPAD_UP:
+                in_report.buttons = PSClassic::Buttons::UP;
+                break;
+            case Gamepad::DPAD_DOWN:
+                in_report.buttons = PSClassic::Buttons::DOWN;
+                break;
+            case Gamepad::DPAD_LEFT:
+                in_report.buttons = PSClassic::Buttons::LEFT;
+                break;
+            case Gamepad::DPAD_RIGHT:
+                in_report.buttons = PSClassic::Buttons::RIGHT;
+                break;
+            case Gamepad::DPAD_UP_LEFT:
+                in_report.buttons = PSClassic::Buttons::UP_LEFT;
+                break;
+            case Gamepad::DPAD_UP_RIGHT:
+                in_report.buttons = PSClassic::Buttons::UP_RIGHT;
+                break;
+            case Gamepad::DPAD_DOWN_LEFT:
+                in_report.buttons = PSClassic::Buttons::DOWN_LEFT;
+                break;
+            case Gamepad::DPAD_DOWN_RIGHT:
+                in_report.buttons = PSClassic::Buttons::DOWN_RIGHT;
+                break;
+            default:
+                in_report.buttons = PSClassic::Buttons::CENTER;
+                break;
+        }
+        if (gp_in.buttons & Gamepad::BUTTON_A) in_report.buttons |= PSClassic::Buttons::CROSS;
+        if (gp_in.buttons & Gamepad::BUTTON_B) in_report.buttons |= PSClassic::Buttons::CIRCLE;
+        if (gp_in.buttons & Gamepad::BUTTON_X) in_report.buttons |= PSClassic::Buttons::SQUARE;
+        if (gp_in.buttons & Gamepad::BUTTON_Y) in_report.buttons |= PSClassic::Buttons::TRIANGLE;
+        if (gp_in.buttons & Gamepad::BUTTON_LB)    in_report.buttons |= PSClassic::Buttons::L1;
+        if (gp_in.buttons & Gamepad::BUTTON_RB)    in_report.buttons |= PSClassic::Buttons::R1;
+        if (gp_in.buttons & Gamepad::BUTTON_BACK)  in_report.buttons |= PSClassic::Buttons::SELECT;
+        if (gp_in.buttons & Gamepad::BUTTON_START) in_report.buttons |= PSClassic::Buttons::START;
+    }
+
+    inline void xboxog_gp(const Gamepad::PadIn& gp_in, XboxOG::GP::InReport& in_report)
+    {
+        in_report.buttons = 0;
+        switch (gp_in.dpad)
+        {
+            case Gamepad::DPAD_UP:
+                in_report.buttons = XboxOG::GP::Buttons::DPAD_UP;
+                break;
+            case Gamepad::DPAD_DOWN:
+                in_report.buttons = XboxOG::GP::Buttons::DPAD_DOWN;
+                break;
+            case Gamepad::DPAD_LEFT:
+                in_report.buttons = XboxOG::GP::Buttons::DPAD_LEFT;
+                break;
+            case Gamepad::DPAD_RIGHT:
+                in_report.buttons = XboxOG::GP::Buttons::DPAD_RIGHT;
+                break;
+            case Gamepad::DPAD_UP_LEFT:
+                in_report.buttons = XboxOG::GP::Buttons::DPAD_UP | XboxOG::GP::Buttons::DPAD_LEFT;
+                break;
+            case Gamepad::DPAD_UP_RIGHT:
+                in_report.buttons = XboxOG::GP::Buttons::DPAD_UP | XboxOG::GP::Buttons::DPAD_RIGHT;
+                break;
+            case Gamepad::DPAD_DOWN_LEFT:
+                in_report.buttons = XboxOG::GP::Buttons::DPAD_DOWN | XboxOG::GP::Buttons::DPAD_LEFT;
+                break;
+            case Gamepad::DPAD_DOWN_RIGHT:
+                in_report.buttons = XboxOG::GP::Buttons::DPAD_DOWN | XboxOG::GP::Buttons::DPAD_RIGHT;
+                break;
+            default:
+                break;
+        }
+
+        if (gp_in.buttons & Gamepad::BUTTON_BACK)     in_report.buttons |= XboxOG::GP::Buttons::BACK;
+        if (gp_in.buttons & Gamepad::BUTTON_START)    in_report.buttons |= XboxOG::GP::Buttons::START;
+        if (gp_in.buttons & Gamepad::BUTTON_L3)       in_report.buttons |= XboxOG::GP::Buttons::L3;
+        if (gp_in.buttons & Gamepad::BUTTON_R3)       in_report.buttons |= XboxOG::GP::Buttons::R3;
+    }
+}
+
+#endif // _REFERENCE_BUTTONS_SWITCH_CASE_H_
@@ -0,0 +1,32 @@
+#ifndef _REFERENCE_HID_BITS_BITWISE_H_
+#define _REFERENCE_HID_BITS_BITWISE_H_
+
+#include <cstdint>
+
+// HIDUtils::readBitsLE() before it read whole bytes: one bit per loop iteration.
+// Kept as the reference for the bit reader test and its benchmark.
+inline uint32_t read_bits_le_bitwise(const uint8_t* buffer, uint32_t bit_offset, uint32_t bit_length)
+{
+    uint32_t byte_index = bit_offset / 8;
+    uint32_t bit_index = bit_offset % 8;
+
+    uint32_t result = 0;
+
+    for (uint32_t i = 0; i < bit_length; ++i)
+    {
+        if (bit_index > 7)
+        {
+            ++byte_index;
+            bit_index = 0;
+        }
+
+        uint8_t bit = (buffer[byte_index] >> bit_index) & 0x01;
+        result |= (static_cast<uint32_t>(bit) << i);
+
+        ++bit_index;
+    }
+
+    return result;
+}
+
+#endif // _REFERENCE_HID_BITS_BITWISE_H_
@@ -0,0 +1,46 @@
+#ifndef _REFERENCE_HARDWARE_IDS_LINEAR_H_
+#define _REFERENCE_HARDWARE_IDS_LINEAR_H_
+
+#include <cstdint>
+#include <cstddef>
+
+#include "USBHost/HardwareIDs.h"
+
+// HostManager::get_type() before the sorted table: every per driver list scanned in turn,
+// the list decides the driver type. Kept as the reference for the hardware ID test and its benchmark.
+struct HostTypeMap
+{
+    const HardwareIDEntry* ids;
+    size_t num_ids;
+    HostDriverType type;
+};
+
+static const HostTypeMap HOST_TYPE_MAP[] =
+{
+    { DINPUT_IDS, sizeof(DINPUT_IDS) / sizeof(HardwareIDEntry), HostDriverType::DINPUT },
+    { PS4_IDS, sizeof(PS4_IDS) / sizeof(HardwareIDEntry), HostDriverType::PS4 },
+    { PS5_IDS, sizeof(PS5_IDS) / sizeof(HardwareIDEntry), HostDriverType::PS5 },
+    { PS3_IDS, sizeof(PS3_IDS) / sizeof(HardwareIDEntry), HostDriverType::PS3 },
+    { SWITCH_WIRED_IDS, sizeof(SWITCH_WIRED_IDS) / sizeof(HardwareIDEntry), HostDriverType::SWITCH },
+    { SWITCH_PRO_IDS, sizeof(SWITCH_PRO_IDS) / sizeof(HardwareIDEntry), HostDriverType::SWITCH_PRO },
+    { PSCLASSIC_IDS, sizeof(PSCLASSIC_IDS) / sizeof(HardwareIDEntry), HostDriverType::PSCLASSIC },
+    { N64_IDS, sizeof(N64_IDS) / sizeof(HardwareIDEntry), HostDriverType::N64 },
+};
+
+inline HostDriverType get_type_linear(const HostTypeMap* maps, size_t num_maps, const HardwareID& ids)
+{
+    for (size_t m = 0; m < num_maps; ++m)
+    {
+        const HostTypeMap& map = maps[m];
+        for (size_t i = 0; i < map.num_ids; i++)
+        {
+            if (ids.pid == map.ids[i].id.pid && ids.vid == map.ids[i].id.vid)
+            {
+                return map.type;
+            }
+        }
+    }
+    return HostDriverType::UNKNOWN;
+}
+
+#endif // _REFERENCE_HARDWARE_IDS_LINEAR_H_
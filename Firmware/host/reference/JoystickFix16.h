@@ -0,0 +1,179 @@
+#ifndef _REFERENCE_JOYSTICK_FIX16_H_
+#define _REFERENCE_JOYSTICK_FIX16_H_
+
+#include <cstdint>
+#include <utility>
+
+#include "libfixmath/fix16.hpp"
+
+#include "Gamepad/Range.h"
+#include "Gamepad/fix16ext.h"
+#include "UserSettings/JoystickSettings.h"
+
+// Gamepad::apply_joystick_settings as it was before JoystickProgram, all Fix16 per sample, copied unchanged.
+// Its elliptical anti deadzone (anti_dz_circle with a square or y scale anti deadzone) divides an
+// uninitialized anti_ellip_scale and takes the tan of rAngle converted to degrees a second time.
+// fixed_ellipse runs that path the way JoystickProgram does: anti_r_scale / anti_dz_circle, tan of radians.
+inline std::pair<int16_t, int16_t> apply_joystick_settings_fix16(
+    int16_t gp_joy_x, 
+    int16_t gp_joy_y, 
+    const JoystickSettings& set,
+    bool invert_y,
+    bool fixed_ellipse = false)
+{
+    static const Fix16 
+        FIX_0(0.0f),
+        FIX_1(1.0f),
+        FIX_2(2.0f),
+        FIX_45(45.0f),
+        FIX_90(90.0f),
+        FIX_100(100.0f),
+        FIX_180(180.0f),
+        FIX_EPSILON(0.0001f),
+        FIX_EPSILON2(0.001f),
+        FIX_ELLIPSE_DEF(1.570796f),
+        FIX_DIAG_DIVISOR(0.29289f);
+
+    Fix16 x = (set.invert_x ? Fix16(Range::invert(gp_joy_x)) : Fix16(gp_joy_x)) / Range::MAX<int16_t>;
+    Fix16 y = ((set.invert_y ^ invert_y) ? Fix16(Range::invert(gp_joy_y)) : Fix16(gp_joy_y)) / Range::MAX<int16_t>;
+
+    const Fix16 abs_x = fix16::abs(x);
+    const Fix16 abs_y = fix16::abs(y);
+    const Fix16 inv_axis_restrict = FIX_1 / (FIX_1 - set.axis_restrict);
+
+    Fix16 rAngle = (abs_x < FIX_EPSILON) 
+        ? FIX_90 
+        : fix16::rad2deg(fix16::abs(fix16::atan(y / x)));
+
+    Fix16 axial_x = (abs_x <= set.axis_restrict && rAngle > FIX_45) 
+        ? FIX_0 
+        : ((abs_x - set.axis_restrict) * inv_axis_restrict);
+            
+    Fix16 axial_y = (abs_y <= set.axis_restrict && rAngle <= FIX_45) 
+        ? FIX_0 
+        : ((abs_y - set.axis_restrict) * inv_axis_restrict);
+
+    Fix16 in_magnitude = fix16::sqrt(fix16::sq(axial_x) + fix16::sq(axial_y));
+
+    if (in_magnitude < set.dz_inner)
+    {
+        return { 0, 0 };
+    }
+
+    Fix16 angle = 
+        fix16::abs(axial_x) < FIX_EPSILON 
+            ? FIX_90 
+            : fix16::rad2deg(fix16::abs(fix16::atan(axial_y / axial_x)));
+
+    Fix16 anti_r_scale = (set.anti_dz_square_y_scale == FIX_0) ? set.anti_dz_square : set.anti_dz_square_y_scale;
+    Fix16 anti_dz_c = set.anti_dz_circle;
+
+    if (anti_r_scale > FIX_0 && anti_dz_c > FIX_0)
+    {
+        Fix16 anti_ellip_scale = fixed_ellipse ? anti_r_scale / anti_dz_c : anti_ellip_scale / anti_dz_c;
+        Fix16 ellipse_angle = fixed_ellipse
+            ? fix16::atan((FIX_1 / anti_ellip_scale) * fix16::tan(fix16::deg2rad(rAngle)))
+            : fix16::atan((FIX_1 / anti_ellip_scale) * fix16::tan(fix16::rad2deg(rAngle)));
+        ellipse_angle = (ellipse_angle < FIX_0) ? FIX_ELLIPSE_DEF : ellipse_angle;
+
+        Fix16 ellipse_x = fix16::cos(ellipse_angle);
+        Fix16 ellipse_y = fix16::sqrt(fix16::sq(anti_ellip_scale) * (FIX_1 - fix16::sq(ellipse_x)));
+        anti_dz_c *= fix16::sqrt(fix16::sq(ellipse_x) + fix16::sq(ellipse_y));
+    }
+
+    if (anti_dz_c > FIX_0)
+    {
+        anti_dz_c = anti_dz_c / ((anti_dz_c * (FIX_1 - set.anti_dz_circle / set.dz_outer)) / (anti_dz_c * (FIX_1 - set.anti_dz_square)));
+    }
+
+    if (abs_x > set.axis_restrict && abs_y > set.axis_restrict)
+    {
+        const Fix16 FIX_ANGLE_MAX = set.angle_restrict / 2.0f;
+
+        if (angle > FIX_0 && angle < FIX_ANGLE_MAX)
+        {
+            angle = FIX_0;
+        }
+        if (angle > (FIX_90 - FIX_ANGLE_MAX))
+        {
+            angle = FIX_90;
+        }
+        if (angle > FIX_ANGLE_MAX && angle < (FIX_90 - FIX_ANGLE_MAX))
+        {
+            angle = ((angle - FIX_ANGLE_MAX) * FIX_90) / ((FIX_90 - FIX_ANGLE_MAX) - FIX_ANGLE_MAX);
+        }
+    }
+
+    Fix16 ref_angle = (angle < FIX_EPSILON2) ? FIX_0 : angle;
+    Fix16 diagonal = (angle > FIX_45) ? (((angle - FIX_45) * (-FIX_45)) / FIX_45) + FIX_45 : angle;
+
+    const Fix16 angle_comp = set.angle_restrict / FIX_2;
+
+    if (angle < FIX_90 && angle > FIX_0)
+    {
+        angle = ((angle * ((FIX_90 - angle_comp) - angle_comp)) / FIX_90) + angle_comp;
+    }
+
+    if (axial_x < FIX_0 && axial_y > FIX_0)
+    {
+        angle = -angle;
+    }
+    if (axial_x > FIX_0 && axial_y < FIX_0)
+    {
+        angle = angle - FIX_180;
+    }
+    if (axial_x < FIX_0 && axial_y < FIX_0)
+    {
+        angle = angle + FIX_180;
+    }
+
+    //Deadzone Warp
+    Fix16 out_magnitude = (in_magnitude - set.dz_inner) / (set.anti_dz_outer - set.dz_inner);
+    out_magnitude = fix16::pow(out_magnitude, (FIX_1 / set.curve)) * (set.dz_outer - anti_dz_c) + anti_dz_c;
+    out_magnitude = (out_magnitude > set.dz_outer && !set.uncap_radius) ? set.dz_outer : out_magnitude;
+
+		Fix16 d_scale = (((out_magnitude - anti_dz_c) * (set.diag_scale_max - set.diag_scale_min)) / (set.dz_outer - anti_dz_c)) + set.diag_scale_min;		
+		Fix16 c_scale = (diagonal * (FIX_1 / fix16::sqrt(FIX_2))) / FIX_45; //Both these lines scale the intensity of the warping
+		c_scale       = FIX_1 - fix16::sqrt(FIX_1 - c_scale * c_scale);     //based on a circular curve to the perfect diagonal
+		d_scale       = (c_scale * (d_scale - FIX_1)) / FIX_DIAG_DIVISOR + FIX_1;
+
+		out_magnitude = out_magnitude * d_scale;
+
+		//Scaling values for square antideadzone
+		Fix16 new_x = fix16::cos(fix16::deg2rad(angle)) * out_magnitude;
+		Fix16 new_y = fix16::sin(fix16::deg2rad(angle)) * out_magnitude;
+		
+		//Magic angle wobble fix by user ME.
+		// if (angle > 45.0 && angle < 225.0) {
+		// 	newX = inv(Math.sin(deg2rad(angle - 90.0)))*outputMagnitude;
+		// 	newY = inv(Math.cos(deg2rad(angle - 270.0)))*outputMagnitude;
+		// }
+		
+		//Square antideadzone scaling
+		Fix16 output_x = fix16::abs(new_x) * (FIX_1 - set.anti_dz_square / set.dz_outer) + set.anti_dz_square;
+		if (x < FIX_0)
+    {
+        output_x = -output_x;
+    }
+		if (ref_angle == FIX_90)
+    {
+        output_x = FIX_0;
+    }
+		
+		Fix16 output_y = fix16::abs(new_y) * (FIX_1 - anti_r_scale / set.dz_outer) + anti_r_scale;
+		if (y < FIX_0)
+    {
+        output_y = -output_y;
+    }
+		if (ref_angle == FIX_0)
+    {
+        output_y = FIX_0;
+    }
+
+    output_x = fix16::clamp(output_x, -FIX_1, FIX_1) * Range::MAX<int16_t>;
+    output_y = fix16::clamp(output_y, -FIX_1, FIX_1) * Range::MAX<int16_t>;
+
+    return { static_cast<int16_t>(fix16_to_int(output_x)), static_cast<int16_t>(fix16_to_int(output_y)) };
+}
+
+#endif // _REFERENCE_JOYSTICK_FIX16_H_
@@ -0,0 +1,41 @@
+#ifndef _REFERENCE_MUTEX_EXCHANGE_H_
+#define _REFERENCE_MUTEX_EXCHANGE_H_
+
+#include <cstdint>
+
+#include "pico/mutex.h"
+
+// How Gamepad exchanged PadIn/PadOut before SeqLock: a mutex around the copy
+// and a new-data flag any reader clears. Kept for the stress test and benchmark comparisons.
+template <typename T>
+class MutexExchange
+{
+public:
+    MutexExchange() { mutex_init(&mutex_); }
+
+    inline void store(const T& value)
+    {
+        mutex_enter_blocking(&mutex_);
+        value_ = value;
+        new_ = true;
+        mutex_exit(&mutex_);
+    }
+
+    inline T load()
+    {
+        mutex_enter_blocking(&mutex_);
+        T value = value_;
+        new_ = false;
+        mutex_exit(&mutex_);
+        return value;
+    }
+
+    inline bool is_new() const { return new_; }
+
+private:
+    mutex_t mutex_;
+    T value_{};
+    bool new_{false};
+};
+
+#endif // _REFERENCE_MUTEX_EXCHANGE_H_
@@ -0,0 +1,151 @@
+#ifndef _REFERENCE_PROFILE_PER_BIT_H_
+#define _REFERENCE_PROFILE_PER_BIT_H_
+
+#include <cstdint>
+
+#include "libfixmath/fix16.hpp"
+
+#include "Gamepad/Gamepad.h"
+#include "Gamepad/Range.h"
+#include "Gamepad/fix16ext.h"
+#include "UserSettings/UserProfile.h"
+#include "UserSettings/TriggerSettings.h"
+
+// Gamepad's profile mapping before ProfileProgram: MAP_* members set from the profile, host drivers
+// OR one of them into the pad input for every pressed button, pick a dpad member from the hat
+// (diagonals are the OR of their two directions) or OR one per dpad bit, and apply_trigger_settings
+// runs its Fix16 math on every trigger sample. Kept as the reference for the profile program test.
+struct ProfilePerBit
+{
+    uint8_t MAP_DPAD_UP         = Gamepad::DPAD_UP        ;
+    uint8_t MAP_DPAD_DOWN       = Gamepad::DPAD_DOWN      ;
+    uint8_t MAP_DPAD_LEFT       = Gamepad::DPAD_LEFT      ;
+    uint8_t MAP_DPAD_RIGHT      = Gamepad::DPAD_RIGHT     ;
+    uint8_t MAP_DPAD_UP_LEFT    = Gamepad::DPAD_UP_LEFT   ;
+    uint8_t MAP_DPAD_UP_RIGHT   = Gamepad::DPAD_UP_RIGHT  ;
+    uint8_t MAP_DPAD_DOWN_LEFT  = Gamepad::DPAD_DOWN_LEFT ;
+    uint8_t MAP_DPAD_DOWN_RIGHT = Gamepad::DPAD_DOWN_RIGHT;
+    uint8_t MAP_DPAD_NONE       = Gamepad::DPAD_NONE      ;
+
+    uint16_t MAP_BUTTON_A     = Gamepad::BUTTON_A    ;
+    uint16_t MAP_BUTTON_B     = Gamepad::BUTTON_B    ;
+    uint16_t MAP_BUTTON_X     = Gamepad::BUTTON_X    ;
+    uint16_t MAP_BUTTON_Y     = Gamepad::BUTTON_Y    ;
+    uint16_t MAP_BUTTON_L3    = Gamepad::BUTTON_L3   ;
+    uint16_t MAP_BUTTON_R3    = Gamepad::BUTTON_R3   ;
+    uint16_t MAP_BUTTON_BACK  = Gamepad::BUTTON_BACK ;
+    uint16_t MAP_BUTTON_START = Gamepad::BUTTON_START;
+    uint16_t MAP_BUTTON_LB    = Gamepad::BUTTON_LB   ;
+    uint16_t MAP_BUTTON_RB    = Gamepad::BUTTON_RB   ;
+    uint16_t MAP_BUTTON_SYS   = Gamepad::BUTTON_SYS  ;
+    uint16_t MAP_BUTTON_MISC  = Gamepad::BUTTON_MISC ;
+
+    void set_profile_mappings(const UserProfile& profile)
+    {
+        MAP_DPAD_UP         = profile.dpad_up;
+        MAP_DPAD_DOWN       = profile.dpad_down;
+        MAP_DPAD_LEFT       = profile.dpad_left;
+        MAP_DPAD_RIGHT      = profile.dpad_right;
+        MAP_DPAD_UP_LEFT    = profile.dpad_up | profile.dpad_left;
+        MAP_DPAD_UP_RIGHT   = profile.dpad_up | profile.dpad_right;
+        MAP_DPAD_DOWN_LEFT  = profile.dpad_down | profile.dpad_left;
+        MAP_DPAD_DOWN_RIGHT = profile.dpad_down | profile.dpad_right;
+        MAP_DPAD_NONE       = 0;
+
+        MAP_BUTTON_A     = profile.button_a;
+        MAP_BUTTON_B     = profile.button_b;
+        MAP_BUTTON_X     = profile.button_x;
+        MAP_BUTTON_Y     = profile.button_y;
+        MAP_BUTTON_L3    = profile.button_l3;
+        MAP_BUTTON_R3    = profile.button_r3;
+        MAP_BUTTON_BACK  = profile.button_back;
+        MAP_BUTTON_START = profile.button_start;
+        MAP_BUTTON_LB    = profile.button_lb;
+        MAP_BUTTON_RB    = profile.button_rb;
+        MAP_BUTTON_SYS   = profile.button_sys;
+        MAP_BUTTON_MISC  = profile.button_misc;
+    }
+
+    //What a host driver ORed in for the pressed buttons, named by the canonical bit they stood for
+    uint16_t buttons(uint16_t pressed) const
+    {
+        uint16_t out = 0;
+        if (pressed & Gamepad::BUTTON_A)     out |= MAP_BUTTON_A;
+        if (pressed & Gamepad::BUTTON_B)     out |= MAP_BUTTON_B;
+        if (pressed & Gamepad::BUTTON_X)     out |= MAP_BUTTON_X;
+        if (pressed & Gamepad::BUTTON_Y)     out |= MAP_BUTTON_Y;
+        if (pressed & Gamepad::BUTTON_L3)    out |= MAP_BUTTON_L3;
+        if (pressed & Gamepad::BUTTON_R3)    out |= MAP_BUTTON_R3;
+        if (pressed & Gamepad::BUTTON_BACK)  out |= MAP_BUTTON_BACK;
+        if (pressed & Gamepad::BUTTON_START) out |= MAP_BUTTON_START;
+        if (pressed & Gamepad::BUTTON_LB)    out |= MAP_BUTTON_LB;
+        if (pressed & Gamepad::BUTTON_RB)    out |= MAP_BUTTON_RB;
+        if (pressed & Gamepad::BUTTON_SYS)   out |= MAP_BUTTON_SYS;
+        if (pressed & Gamepad::BUTTON_MISC)  out |= MAP_BUTTON_MISC;
+        return out;
+    }
+
+    //Hat drivers (DInput, PS4, PS5, Bluepad32...), the direction the hat points
+    uint8_t dpad_hat(uint8_t direction) const
+    {
+        switch (direction)
+        {
+            case Gamepad::DPAD_UP:         return MAP_DPAD_UP;
+            case Gamepad::DPAD_DOWN:       return MAP_DPAD_DOWN;
+            case Gamepad::DPAD_LEFT:       return MAP_DPAD_LEFT;
+            case Gamepad::DPAD_RIGHT:      return MAP_DPAD_RIGHT;
+            case Gamepad::DPAD_UP_LEFT:    return MAP_DPAD_UP_LEFT;
+            case Gamepad::DPAD_UP_RIGHT:   return MAP_DPAD_UP_RIGHT;
+            case Gamepad::DPAD_DOWN_LEFT:  return MAP_DPAD_DOWN_LEFT;
+            case Gamepad::DPAD_DOWN_RIGHT: return MAP_DPAD_DOWN_RIGHT;
+            default:                       return MAP_DPAD_NONE;
+        }
+    }
+
+    //Bit drivers (XInput, PS3, Switch...), any combination of the four
+    uint8_t dpad_bits(uint8_t pressed) const
+    {
+        uint8_t out = 0;
+        if (pressed & Gamepad::DPAD_UP)    out |= MAP_DPAD_UP;
+        if (pressed & Gamepad::DPAD_DOWN)  out |= MAP_DPAD_DOWN;
+        if (pressed & Gamepad::DPAD_LEFT)  out |= MAP_DPAD_LEFT;
+        if (pressed & Gamepad::DPAD_RIGHT) out |= MAP_DPAD_RIGHT;
+        return out;
+    }
+
+    //Copied unchanged, less an unused constant
+    uint8_t apply_trigger_settings(uint8_t value, const TriggerSettings& set) const
+    {
+        Fix16 abs_value = fix16::abs(Fix16(static_cast<int16_t>(value)) / static_cast<int16_t>(Range::MAX<uint8_t>));
+
+        if (abs_value < set.dz_inner)
+        {
+            return 0;
+        }
+
+        static const Fix16
+            FIX_0(0.0f),
+            FIX_1(1.0f);
+
+        Fix16 value_out = (abs_value - set.dz_inner) / (set.anti_dz_outer - set.dz_inner);
+        value_out = fix16::clamp(value_out, FIX_0, FIX_1);
+
+        if (set.anti_dz_inner > FIX_0)
+        {
+            value_out = set.anti_dz_inner + (FIX_1 - set.anti_dz_inner) * value_out;
+        }
+        if (set.curve != FIX_1)
+        {
+            value_out = fix16::pow(value_out, FIX_1 / set.curve);
+        }
+        if (set.anti_dz_outer < FIX_1)
+        {
+            value_out = fix16::clamp(value_out * (FIX_1 / (FIX_1 - set.anti_dz_outer)), FIX_0, FIX_1);
+        }
+
+        value_out *= set.dz_outer;
+        return static_cast<uint8_t>(fix16_to_int(value_out * static_cast<int16_t>(Range::MAX<uint8_t>)));
+    }
+};
+
+#endif // _REFERENCE_PROFILE_PER_BIT_H_
@@ -0,0 +1,252 @@
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+
+#include "pico/time.h"
+#include "host_usb.h"
+
+#include "USBHost/HostManager.h"
+#include "USBDevice/DeviceDriver/DInput/DInput.h"
+#include "USBDevice/DeviceDriver/PS3/PS3.h"
+#include "USBDevice/DeviceDriver/PS4/PS4.h"
+#include "USBDevice/DeviceDriver/PSClassic/PSClassic.h"
+#include "USBDevice/DeviceDriver/Switch/Switch.h"
+#include "USBDevice/DeviceDriver/XInput/XInput.h"
+#include "USBDevice/DeviceDriver/XboxOG/XboxOG_GP.h"
+
+#include "replay/Replay.h"
+
+namespace replay
+{
+    //Where the host clock starts, HostManager takes a 0 timestamp as "not seen yet"
+    static constexpr uint64_t START_US = 1000000;
+
+    struct DeviceName
+    {
+        const char* name;
+        DeviceDriverType type;
+        bool has_analog; //Same as DeviceManager::initialize_driver()
+    };
+
+    static constexpr DeviceName DEVICE_NAMES[] =
+    {
+        { "xinput",    DeviceDriverType::XINPUT,    false },
+        { "ps3",       DeviceDriverType::PS3,       true },
+        { "dinput",    DeviceDriverType::DINPUT,    true },
+        { "psclassic", DeviceDriverType::PSCLASSIC, false },
+        { "switch",    DeviceDriverType::SWITCH,    false },
+        { "xboxog",    DeviceDriverType::XBOXOG,    true },
+        { "ps4",       DeviceDriverType::PS4,       true },
+    };
+
+    //Order of HostDriverType
+    static constexpr const char* HOST_NAMES[] =
+    {
+        "UNKNOWN", "SWITCH_PRO", "SWITCH", "PSCLASSIC", "DINPUT", "PS3", "PS4", "PS5", "N64",
+        "XBOXOG", "XBOXONE", "XBOX360W", "XBOX360", "XBOX360_CHATPAD", "HID_GENERIC"
+    };
+    static_assert(sizeof(HOST_NAMES) / sizeof(HOST_NAMES[0]) == static_cast<size_t>(HostDriverType::HID_GENERIC) + 1, "HOST_NAMES doesn't match HostDriverType");
+
+    std::string parse(const std::vector<uint8_t>& bytes, Capture& capture)
+    {
+        ReportCapture::DumpHeader header;
+        if (bytes.size() < sizeof(header))
+        {
+            return "capture is too short";
+        }
+        std::memcpy(&header, bytes.data(), sizeof(header));
+
+        if (header.magic != ReportCapture::MAGIC || header.version != ReportCapture::VERSION)
+        {
+            return "not a report capture, or an unsupported version";
+        }
+        if (header.record_size != sizeof(ReportCapture::Record))
+        {
+            return "unexpected record size";
+        }
+        if (bytes.size() < sizeof(header) + static_cast<size_t>(header.record_count) * header.record_size)
+        {
+            return "capture is truncated";
+        }
+
+        capture.dropped = header.dropped;
+        capture.records.resize(header.record_count);
+        if (header.record_count)
+        {
+            std::memcpy(capture.records.data(), bytes.data() + sizeof(header), capture.records.size() * sizeof(ReportCapture::Record));
+        }
+        return {};
+    }
+
+    bool device_type(const std::string& name, DeviceDriverType& type)
+    {
+        for (const DeviceName& device : DEVICE_NAMES)
+        {
+            if (name == device.name)
+            {
+                type = device.type;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const char* device_name(DeviceDriverType type)
+    {
+        for (const DeviceName& device : DEVICE_NAMES)
+        {
+            if (device.type == type)
+            {
+                return device.name;
+            }
+        }
+        return "none";
+    }
+
+    const char* host_name(uint8_t host_driver_type)
+    {
+        return (host_driver_type < sizeof(HOST_NAMES) / sizeof(HOST_NAMES[0])) ? HOST_NAMES[host_driver_type] : "?";
+    }
+
+    Replayer::Replayer(DeviceDriverType device_type)
+    {
+        host_time::set_us(START_US);
+        host_usb::reset();
+
+        switch (device_type)
+        {
+            case DeviceDriverType::DINPUT:
+                device_driver_ = std::make_unique<DInputDevice>();
+                break;
+            case DeviceDriverType::PS3:
+                device_driver_ = std::make_unique<PS3Device>();
+                break;
+            case DeviceDriverType::PSCLASSIC:
+                device_driver_ = std::make_unique<PSClassicDevice>();
+                break;
+            case DeviceDriverType::SWITCH:
+                device_driver_ = std::make_unique<SwitchDevice>();
+                break;
+            case DeviceDriverType::XBOXOG:
+                device_driver_ = std::make_unique<XboxOGDevice>();
+                break;
+            case DeviceDriverType::PS4:
+                device_driver_ = std::make_unique<PS4Device>();
+                break;
+            default:
+                device_driver_ = std::make_unique<XInputDevice>();
+                break;
+        }
+
+        for (const DeviceName& device : DEVICE_NAMES)
+        {
+            if (device.type == device_type && device.has_analog)
+            {
+                for (Gamepad& gamepad : gamepads_)
+                {
+                    gamepad.set_analog_device(true);
+                }
+            }
+        }
+
+        device_driver_->initialize();
+        HostManager::get_instance().initialize(gamepads_);
+    }
+
+    Replayer::~Replayer()
+    {
+        end();
+    }
+
+    void Replayer::begin()
+    {
+        host_time::set_us(START_US);
+        host_usb::reset();
+    }
+
+    void Replayer::end()
+    {
+        HostManager& manager = HostManager::get_instance();
+        for (const auto& [address, instance] : mounted_)
+        {
+            manager.deinit_driver(HostManager::DriverClass::HID, address, instance);
+        }
+        mounted_.clear();
+        known_.clear();
+    }
+
+    Event Replayer::step(const ReportCapture::Record& record, uint64_t elapsed_us)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        HostManager& manager = HostManager::get_instance();
+        const uint16_t data_len = std::min<uint16_t>(record.len, ReportCapture::MAX_DATA);
+        const auto interface = std::make_pair(record.address, record.instance);
+        const auto is_mounted = std::find(mounted_.begin(), mounted_.end(), interface);
+        const HostDriverType type = static_cast<HostDriverType>(record.driver_type);
+        const bool known = std::find(known_.begin(), known_.end(), interface) != known_.end();
+
+        Event event{};
+        event.record = &record;
+        event.elapsed_us = elapsed_us;
+        event.truncated = record.len > ReportCapture::MAX_DATA;
+
+        host_time::set_us(START_US + elapsed_us);
+        const auto host_start = Clock::now();
+
+        switch (record.kind)
+        {
+            case ReportCapture::Kind::MOUNT:
+                if (!known)
+                {
+                    known_.push_back(interface);
+                }
+                if (manager.setup_driver(type, record.address, record.instance, data_len ? record.data : nullptr, data_len) &&
+                    is_mounted == mounted_.end())
+                {
+                    mounted_.push_back(interface);
+                }
+                break;
+            case ReportCapture::Kind::UNMOUNT:
+                if (!known)
+                {
+                    known_.push_back(interface);
+                }
+                manager.deinit_driver(HostManager::DriverClass::HID, record.address, record.instance);
+                if (is_mounted != mounted_.end())
+                {
+                    mounted_.erase(is_mounted);
+                }
+                break;
+            default:
+                //The ring usually wrapped past the mount, reports carry the driver type so the pad is
+                //mounted from the first one. HID generic needs its report descriptor, those stay unmounted.
+                if (!known && is_mounted == mounted_.end() &&
+                    type != HostDriverType::UNKNOWN && type != HostDriverType::HID_GENERIC &&
+                    manager.setup_driver(type, record.address, record.instance))
+                {
+                    mounted_.push_back(interface);
+                }
+                manager.process_report(record.address, record.instance, record.data, data_len);
+                break;
+        }
+        manager.feedback_task();
+
+        const auto device_start = Clock::now();
+        for (uint8_t i = 0; i < MAX_GAMEPADS; ++i)
+        {
+            const uint32_t sent = host_usb::in_report(i).count;
+            device_driver_->process(i, gamepads_[i]);
+            if (host_usb::in_report(i).count != sent)
+            {
+                event.sent_mask |= (1 << i);
+            }
+        }
+        const auto device_end = Clock::now();
+
+        event.host_ns = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(device_start - host_start).count());
+        event.device_ns = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(device_end - device_start).count());
+        event.gamepad_idx = manager.get_gamepad_idx(HostManager::DriverClass::HID, record.address, record.instance);
+        return event;
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef _HOST_REPLAY_H_
+#define _HOST_REPLAY_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Gamepad/Gamepad.h"
+#include "USBHost/ReportCapture.h"
+#include "USBDevice/DeviceDriver/DeviceDriver.h"
+#include "USBDevice/DeviceDriver/DeviceDriverTypes.h"
+
+// Feeds a host report capture (Tools/report-capture.py dump) through HostManager, the host drivers,
+// Gamepad and a device driver, the same path core1 and core0 run on the RP2040.
+// The host clock follows the capture's timestamps, so timeouts and feedback run as they did on the pad.
+namespace replay
+{
+    static constexpr uint8_t INVALID_IDX = 0xFF;
+
+    struct Capture
+    {
+        uint32_t dropped{0}; //Records overwritten before the dump
+        std::vector<ReportCapture::Record> records;
+    };
+
+    //What one record did
+    struct Event
+    {
+        const ReportCapture::Record* record;
+        uint64_t elapsed_us;   //Since the first record, timestamps wrapping at 2^32 are unwrapped
+        uint8_t gamepad_idx;   //Gamepad the interface is bound to, INVALID_IDX if none
+        bool truncated;        //The record holds only the first ReportCapture::MAX_DATA bytes
+        uint8_t sent_mask;     //Bit i set if gamepad i's device report was sent
+        uint32_t host_ns;      //HostManager::process_report()/setup_driver()/deinit_driver() and feedback_task()
+        uint32_t device_ns;    //DeviceDriver::process() for every gamepad
+    };
+
+    //Empty on success, what's wrong with the file otherwise
+    std::string parse(const std::vector<uint8_t>& bytes, Capture& capture);
+
+    //xinput, ps3, dinput, psclassic, switch, xboxog or ps4, the device drivers the host build has
+    bool device_type(const std::string& name, DeviceDriverType& type);
+    const char* device_name(DeviceDriverType type);
+    const char* host_name(uint8_t host_driver_type);
+
+    class Replayer
+    {
+    public:
+        explicit Replayer(DeviceDriverType device_type);
+        ~Replayer();
+
+        //Calls on_event(const Event&) after every record, unmounts what's still mounted at the end.
+        //host_usb is reset first, so in_report() counts start at 0 for every run.
+        template <typename OnEvent>
+        void run(const Capture& capture, OnEvent&& on_event)
+        {
+            begin();
+            uint64_t elapsed_us = 0;
+            for (size_t i = 0; i < capture.records.size(); ++i)
+            {
+                if (i > 0)
+                {
+                    elapsed_us += static_cast<uint32_t>(capture.records[i].timestamp_us - capture.records[i - 1].timestamp_us);
+                }
+                on_event(step(capture.records[i], elapsed_us));
+            }
+            end();
+        }
+
+    private:
+        Gamepad gamepads_[MAX_GAMEPADS];
+        std::unique_ptr<DeviceDriver> device_driver_;
+        std::vector<std::pair<uint8_t, uint8_t>> mounted_;
+        std::vector<std::pair<uint8_t, uint8_t>> known_; //Interfaces with a mount or unmount record so far
+
+        void begin();
+        Event step(const ReportCapture::Record& record, uint64_t elapsed_us);
+        void end();
+    };
+}
+
+#endif // _HOST_REPLAY_H_
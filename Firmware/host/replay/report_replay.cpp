@@ -0,0 +1,225 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <algorithm>
+
+#include "host_usb.h"
+
+#include "replay/Replay.h"
+#include "bench/Bench.h"
+
+// Replays a host report capture through the host drivers, Gamepad and a device driver.
+// Prints every record with the device reports it caused and how long the host and device side took,
+// then per interface timing. --bench times whole passes over the capture instead, JSON on stdout,
+// so a capture of a misbehaving pad doubles as a regression benchmark.
+// report_replay <capture> [--device xinput|ps3|dinput|psclassic|switch|xboxog|ps4] [--changed-only]
+//               [--bench [--quick]]
+
+namespace {
+
+struct Stats
+{
+    uint32_t reports{0};
+    uint32_t device_reports{0};
+    uint32_t host_min_ns{UINT32_MAX};
+    uint32_t host_max_ns{0};
+    uint64_t host_total_ns{0};
+    uint32_t device_min_ns{UINT32_MAX};
+    uint32_t device_max_ns{0};
+    uint64_t device_total_ns{0};
+
+    void add(const replay::Event& event)
+    {
+        ++reports;
+        device_reports += static_cast<uint32_t>(__builtin_popcount(event.sent_mask));
+        host_min_ns = std::min(host_min_ns, event.host_ns);
+        host_max_ns = std::max(host_max_ns, event.host_ns);
+        host_total_ns += event.host_ns;
+        device_min_ns = std::min(device_min_ns, event.device_ns);
+        device_max_ns = std::max(device_max_ns, event.device_ns);
+        device_total_ns += event.device_ns;
+    }
+};
+
+const char* kind_name(ReportCapture::Kind kind)
+{
+    switch (kind)
+    {
+        case ReportCapture::Kind::MOUNT:
+            return "MOUNT";
+        case ReportCapture::Kind::UNMOUNT:
+            return "UNMOUNT";
+        default:
+            return "REPORT";
+    }
+}
+
+void print_hex(const uint8_t* data, size_t len)
+{
+    for (size_t i = 0; i < len; ++i)
+    {
+        std::printf(i ? " %02x" : "%02x", data[i]);
+    }
+}
+
+void print_event(const replay::Event& event)
+{
+    const ReportCapture::Record& record = *event.record;
+    std::printf("%10llu us  addr %u itf %u  ", static_cast<unsigned long long>(event.elapsed_us), record.address, record.instance);
+
+    if (record.kind == ReportCapture::Kind::REPORT)
+    {
+        std::printf("%3u%s", record.len, event.truncated ? "+" : " ");
+    }
+    else
+    {
+        std::printf("%s %s", kind_name(record.kind), replay::host_name(record.driver_type));
+    }
+
+    if (event.gamepad_idx == replay::INVALID_IDX)
+    {
+        std::printf("  no gamepad");
+    }
+    else
+    {
+        std::printf("  gp %u", event.gamepad_idx);
+    }
+    std::printf("  host %u ns  device %u ns\n", event.host_ns, event.device_ns);
+
+    for (uint8_t i = 0; i < MAX_GAMEPADS; ++i)
+    {
+        if (event.sent_mask & (1 << i))
+        {
+            const host_usb::Report& report = host_usb::in_report(i);
+            std::printf("%16s-> gp %u %3u  ", "", i, report.len);
+            print_hex(report.data.data(), std::min<size_t>(report.len, report.data.size()));
+            std::printf("\n");
+        }
+    }
+}
+
+void print_stats(const char* name, const Stats& stats)
+{
+    if (!stats.reports)
+    {
+        return;
+    }
+    std::printf("%s: %u records, %u device reports, host min %u avg %llu max %u ns, device min %u avg %llu max %u ns\n",
+        name, stats.reports, stats.device_reports,
+        stats.host_min_ns, static_cast<unsigned long long>(stats.host_total_ns / stats.reports), stats.host_max_ns,
+        stats.device_min_ns, static_cast<unsigned long long>(stats.device_total_ns / stats.reports), stats.device_max_ns);
+}
+
+int print_replay(const replay::Capture& capture, DeviceDriverType device_type, bool changed_only)
+{
+    std::printf("%zu records, %u dropped before the dump, replayed to %s\n",
+        capture.records.size(), capture.dropped, replay::device_name(device_type));
+
+    std::map<std::pair<uint8_t, uint8_t>, Stats> interfaces;
+    Stats total;
+
+    replay::Replayer replayer(device_type);
+    replayer.run(capture, [&](const replay::Event& event)
+    {
+        const ReportCapture::Record& record = *event.record;
+        if (record.kind == ReportCapture::Kind::REPORT)
+        {
+            interfaces[{ record.address, record.instance }].add(event);
+            total.add(event);
+        }
+        if (!changed_only || event.sent_mask || record.kind != ReportCapture::Kind::REPORT)
+        {
+            print_event(event);
+        }
+    });
+
+    for (const auto& [interface, stats] : interfaces)
+    {
+        const std::string name = "addr " + std::to_string(interface.first) + " itf " + std::to_string(interface.second);
+        print_stats(name.c_str(), stats);
+    }
+    print_stats("all reports", total);
+    return 0;
+}
+
+int bench_replay(int argc, char** argv, const replay::Capture& capture, DeviceDriverType device_type)
+{
+    bench::Runner runner(argc, argv);
+    replay::Replayer replayer(device_type);
+
+    uint32_t sent = 0;
+    runner.run(std::string("replay/") + replay::device_name(device_type) + "/per_record", std::max<size_t>(capture.records.size(), 1), [&]
+    {
+        replayer.run(capture, [&](const replay::Event& event) { sent += event.sent_mask; });
+    });
+    bench::keep(sent);
+
+    runner.print_json(std::cout);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const char* path = nullptr;
+    std::string device = "xinput";
+    bool changed_only = false;
+    bool bench_mode = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--device") == 0 && i + 1 < argc)
+        {
+            device = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--changed-only") == 0)
+        {
+            changed_only = true;
+        }
+        else if (std::strcmp(argv[i], "--bench") == 0)
+        {
+            bench_mode = true;
+        }
+        else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+        {
+            ++i; //bench::Runner's
+        }
+        else if (argv[i][0] != '-' && !path)
+        {
+            path = argv[i];
+        }
+    }
+
+    DeviceDriverType device_type;
+    if (!path || !replay::device_type(device, device_type))
+    {
+        std::fprintf(stderr, "usage: report_replay <capture> [--device xinput|ps3|dinput|psclassic|switch|xboxog|ps4] "
+                             "[--changed-only] [--bench [--quick]]\n");
+        return 2;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        std::fprintf(stderr, "Error: can't open %s\n", path);
+        return 1;
+    }
+    const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    replay::Capture capture;
+    const std::string error = replay::parse(bytes, capture);
+    if (!error.empty())
+    {
+        std::fprintf(stderr, "Error: %s\n", error.c_str());
+        return 1;
+    }
+
+    return bench_mode ? bench_replay(argc, argv, capture, device_type) : print_replay(capture, device_type, changed_only);
+}
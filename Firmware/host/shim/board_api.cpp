@@ -0,0 +1,245 @@
+#include <atomic>
+#include <chrono>
+
+#include "pico/time.h"
+#include "hardware/timer.h"
+#include "hardware/irq.h"
+#include "Board/board_api.h"
+
+// board_api for the host build, the clock is steady_clock unless a test froze it
+
+namespace host_time
+{
+    static std::atomic<bool> frozen_{false};
+    static std::atomic<uint64_t> frozen_us_{0};
+
+    static uint64_t clock_us()
+    {
+        static const auto start = std::chrono::steady_clock::now();
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count()) + 1;
+    }
+
+    uint64_t now_us()
+    {
+        return frozen_.load(std::memory_order_relaxed) ? frozen_us_.load(std::memory_order_relaxed) : clock_us();
+    }
+
+    void set_us(uint64_t us)
+    {
+        frozen_us_.store(us, std::memory_order_relaxed);
+        frozen_.store(true, std::memory_order_relaxed);
+    }
+
+    void advance_us(uint64_t us)
+    {
+        if (frozen_.load(std::memory_order_relaxed))
+        {
+            frozen_us_.fetch_add(us, std::memory_order_relaxed);
+        }
+    }
+
+    void release()
+    {
+        frozen_.store(false, std::memory_order_relaxed);
+    }
+}
+
+namespace host_alarm
+{
+    static constexpr uint NUM_ALARMS = 4;
+
+    struct Alarm
+    {
+        bool claimed{false};
+        bool armed{false};
+        uint64_t target_us{0};
+        hardware_alarm_callback_t callback{nullptr};
+    };
+
+    static Alarm alarms_[NUM_ALARMS];
+
+    //Enters an alarm's IRQ handler if INTE lets the INTR or INTF bit through, false if nothing ran
+    static bool raise_irq(uint alarm_num)
+    {
+        const uint32_t bit = 1u << alarm_num;
+        const uint irq_num = timer_hardware_alarm_get_irq_num(timer_hw, alarm_num);
+        if (!((timer_hw->intr | timer_hw->intf) & timer_hw->inte & bit) ||
+            !host_irq.enabled[irq_num] || !host_irq.handler[irq_num])
+        {
+            return false;
+        }
+        host_irq.handler[irq_num]();
+        return true;
+    }
+
+    void run_until(uint64_t us)
+    {
+        while (true)
+        {
+            //A forced IRQ is taken before the clock moves on, the handler has to clear INTF
+            bool forced = false;
+            for (uint i = 0; i < NUM_ALARMS; ++i)
+            {
+                if (timer_hw->intf & (1u << i))
+                {
+                    forced |= raise_irq(i);
+                }
+            }
+            if (forced)
+            {
+                continue;
+            }
+
+            Alarm* next = nullptr;
+            for (Alarm& alarm : alarms_)
+            {
+                if (alarm.armed && alarm.target_us <= us && (!next || alarm.target_us < next->target_us))
+                {
+                    next = &alarm;
+                }
+            }
+            AlarmRegister* next_register = nullptr;
+            for (AlarmRegister& alarm : timer_hw->alarm)
+            {
+                if (alarm.armed && alarm.match_us <= us && (!next_register || alarm.match_us < next_register->match_us))
+                {
+                    next_register = &alarm;
+                }
+            }
+            if (!next && !next_register)
+            {
+                break;
+            }
+
+            if (next_register && (!next || next_register->match_us < next->target_us))
+            {
+                const uint alarm_num = static_cast<uint>(next_register - timer_hw->alarm);
+                if (next_register->match_us > host_time::now_us())
+                {
+                    host_time::set_us(next_register->match_us);
+                }
+                next_register->armed = false;
+                hw_set_bits(&timer_hw->intr, 1u << alarm_num);
+                raise_irq(alarm_num);
+                continue;
+            }
+
+            if (next->target_us > host_time::now_us())
+            {
+                host_time::set_us(next->target_us);
+            }
+            next->armed = false;
+            if (next->callback)
+            {
+                next->callback(static_cast<uint>(next - alarms_));
+            }
+        }
+        if (us > host_time::now_us())
+        {
+            host_time::set_us(us);
+        }
+    }
+
+    void reset()
+    {
+        for (Alarm& alarm : alarms_)
+        {
+            alarm = Alarm();
+        }
+        for (AlarmRegister& alarm : timer_hw->alarm)
+        {
+            alarm.armed = false;
+        }
+        timer_hw->intr = 0;
+        timer_hw->intf = 0;
+    }
+}
+
+void hardware_alarm_claim(uint alarm_num)
+{
+    host_alarm::alarms_[alarm_num % host_alarm::NUM_ALARMS].claimed = true;
+}
+
+int hardware_alarm_claim_unused(bool)
+{
+    for (uint i = 0; i < host_alarm::NUM_ALARMS; ++i)
+    {
+        if (!host_alarm::alarms_[i].claimed)
+        {
+            host_alarm::alarms_[i].claimed = true;
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void hardware_alarm_set_callback(uint alarm_num, hardware_alarm_callback_t callback)
+{
+    host_alarm::alarms_[alarm_num % host_alarm::NUM_ALARMS].callback = callback;
+}
+
+bool hardware_alarm_set_target(uint alarm_num, absolute_time_t target)
+{
+    host_alarm::Alarm& alarm = host_alarm::alarms_[alarm_num % host_alarm::NUM_ALARMS];
+    alarm.armed = target > host_time::now_us();
+    alarm.target_us = target;
+    return !alarm.armed;
+}
+
+void hardware_alarm_cancel(uint alarm_num)
+{
+    host_alarm::alarms_[alarm_num % host_alarm::NUM_ALARMS].armed = false;
+}
+
+namespace board_api {
+
+void init_board() {}
+void init_bluetooth() {}
+void reboot() {}
+void set_led(bool) {}
+
+uint32_t ms_since_boot()
+{
+    return static_cast<uint32_t>(host_time::now_us() / 1000);
+}
+
+uint32_t us_since_boot()
+{
+    return static_cast<uint32_t>(host_time::now_us());
+}
+
+namespace usb {
+
+static uint32_t attach_us_{0};
+
+bool host_connected() { return true; }
+uint32_t host_attach_us() { return attach_us_; }
+void disconnect_all() {}
+
+} // namespace usb
+
+namespace core0 {
+
+void notify() {}
+void wait(uint32_t) {}
+
+} // namespace core0
+
+namespace core1 {
+
+static std::atomic<bool> notified_{false};
+
+void notify() { notified_.store(true, std::memory_order_relaxed); }
+bool notified() { return notified_.exchange(false, std::memory_order_relaxed); }
+
+} // namespace core1
+
+namespace latency {
+
+void record(uint32_t) {}
+void log_stats() {}
+
+} // namespace latency
+
+} // namespace board_api
@@ -0,0 +1,285 @@
+#include <cstring>
+#include <algorithm>
+
+#include "pico/time.h"
+#include "tusb.h"
+#include "class/hid/hid_host.h"
+#include "class/cdc/cdc_device.h"
+#include "bsp/board_api.h"
+#include "USBHost/HardwareIDs.h"
+#include "USBHost/HostDriver/XInput/tuh_xinput/tuh_xinput.h"
+#include "USBDevice/DeviceDriver/XInput/tud_xinput/tud_xinput.h"
+#include "USBDevice/DeviceDriver/XboxOG/tud_xid/tud_xid.h"
+
+#include "host_usb.h"
+
+namespace host_usb
+{
+    static std::array<Report, MAX_INSTANCES> in_reports_;
+    static std::array<Report, MAX_INSTANCES> out_reports_;
+    static uint32_t in_report_count_{0};
+    static uint32_t hid_receive_count_{0};
+    static uint32_t host_out_count_{0};
+    static Report host_out_report_;
+    static uint32_t host_out_refused_{0};
+    static std::array<HardwareID, 256> vid_pids_{};
+    static std::vector<Endpoint> opened_endpoints_;
+    static std::vector<uint8_t> device_endpoints_;
+    static std::vector<DeviceTransfer> device_transfers_;
+
+    const Report& in_report(uint8_t index)
+    {
+        return in_reports_[index % MAX_INSTANCES];
+    }
+
+    uint32_t in_report_count()
+    {
+        return in_report_count_;
+    }
+
+    uint32_t hid_receive_count()
+    {
+        return hid_receive_count_;
+    }
+
+    uint32_t host_out_count()
+    {
+        return host_out_count_;
+    }
+
+    const Report& host_out_report()
+    {
+        return host_out_report_;
+    }
+
+    void refuse_host_out(uint32_t count)
+    {
+        host_out_refused_ = count;
+    }
+
+    const std::vector<Endpoint>& opened_endpoints()
+    {
+        return opened_endpoints_;
+    }
+
+    const std::vector<uint8_t>& device_endpoints()
+    {
+        return device_endpoints_;
+    }
+
+    const std::vector<DeviceTransfer>& device_transfers()
+    {
+        return device_transfers_;
+    }
+
+    void set_vid_pid(uint8_t address, uint16_t vid, uint16_t pid)
+    {
+        vid_pids_[address] = { vid, pid };
+    }
+
+    void queue_out_report(uint8_t index, const uint8_t* data, uint16_t len)
+    {
+        Report& report = out_reports_[index % MAX_INSTANCES];
+        report.len = static_cast<uint16_t>(std::min<size_t>(len, MAX_REPORT_LEN));
+        std::memcpy(report.data.data(), data, report.len);
+        ++report.count;
+    }
+
+    void reset()
+    {
+        in_reports_.fill(Report());
+        out_reports_.fill(Report());
+        in_report_count_ = 0;
+        hid_receive_count_ = 0;
+        host_out_count_ = 0;
+        host_out_report_ = Report();
+        host_out_refused_ = 0;
+        vid_pids_.fill(HardwareID{});
+        opened_endpoints_.clear();
+        device_endpoints_.clear();
+        device_transfers_.clear();
+    }
+
+    static bool send(uint8_t index, const void* data, uint16_t len)
+    {
+        if (index >= MAX_INSTANCES)
+        {
+            return false;
+        }
+        Report& report = in_reports_[index];
+        report.len = static_cast<uint16_t>(std::min<size_t>(len, MAX_REPORT_LEN));
+        std::memcpy(report.data.data(), data, report.len);
+        ++report.count;
+        ++in_report_count_;
+        return true;
+    }
+
+    static bool receive(uint8_t index, uint8_t* data, uint16_t len)
+    {
+        if (index >= MAX_INSTANCES || out_reports_[index].count == 0)
+        {
+            return false;
+        }
+        Report& report = out_reports_[index];
+        std::memcpy(data, report.data.data(), std::min(len, report.len));
+        report.count = 0;
+        return true;
+    }
+
+    static uint16_t open_none(uint8_t, tusb_desc_interface_t const*, uint16_t) { return 0; }
+    static bool control_none(uint8_t, uint8_t, tusb_control_request_t const*) { return false; }
+    static bool xfer_none(uint8_t, uint8_t, xfer_result_t, uint32_t) { return true; }
+    static void init_none() {}
+    static bool deinit_none() { return true; }
+    static void reset_none(uint8_t) {}
+
+    static const usbd_class_driver_t CLASS_DRIVER =
+    {
+        .name = "host",
+        .init = init_none,
+        .deinit = deinit_none,
+        .reset = reset_none,
+        .open = open_none,
+        .control_xfer_cb = control_none,
+        .xfer_cb = xfer_none,
+        .sof = nullptr
+    };
+}
+
+bool tud_hid_n_ready(uint8_t instance) { return instance < host_usb::MAX_INSTANCES; }
+bool tud_hid_n_report(uint8_t instance, uint8_t report_id, void const* report, uint16_t len)
+{
+    if (report_id == 0)
+    {
+        return host_usb::send(instance, report, len);
+    }
+    uint8_t buffer[host_usb::MAX_REPORT_LEN];
+    buffer[0] = report_id;
+    len = static_cast<uint16_t>(std::min<size_t>(len, sizeof(buffer) - 1));
+    std::memcpy(buffer + 1, report, len);
+    return host_usb::send(instance, buffer, static_cast<uint16_t>(len + 1));
+}
+
+void     hidd_init(void) {}
+bool     hidd_deinit(void) { return true; }
+void     hidd_reset(uint8_t) {}
+uint16_t hidd_open(uint8_t, tusb_desc_interface_t const*, uint16_t) { return 0; }
+bool     hidd_control_xfer_cb(uint8_t, uint8_t, tusb_control_request_t const*) { return false; }
+bool     hidd_xfer_cb(uint8_t, uint8_t, xfer_result_t, uint32_t) { return true; }
+
+bool tuh_hid_receive_report(uint8_t, uint8_t)
+{
+    ++host_usb::hid_receive_count_;
+    return true;
+}
+
+bool tuh_hid_send_report(uint8_t, uint8_t, uint8_t, const void* report, uint16_t len)
+{
+    if (host_usb::host_out_refused_)
+    {
+        --host_usb::host_out_refused_;
+        return false;
+    }
+
+    host_usb::Report& out = host_usb::host_out_report_;
+    out.len = static_cast<uint16_t>(std::min<size_t>(len, host_usb::MAX_REPORT_LEN));
+    std::memcpy(out.data.data(), report, out.len);
+    ++out.count;
+    ++host_usb::host_out_count_;
+    return true;
+}
+
+bool tuh_control_xfer(tuh_xfer_t*) { return false; }
+bool tuh_edpt_open(uint8_t, tusb_desc_endpoint_t const*) { return true; }
+
+bool tuh_vid_pid_get(uint8_t dev_addr, uint16_t* vid, uint16_t* pid)
+{
+    *vid = host_usb::vid_pids_[dev_addr].vid;
+    *pid = host_usb::vid_pids_[dev_addr].pid;
+    return true;
+}
+
+//The firmware links with --wrap=hcd_edpt_open, this is the HCD behind USBHost/PollInterval.cpp's wrapper
+extern "C" bool __real_hcd_edpt_open(uint8_t, uint8_t dev_addr, tusb_desc_endpoint_t const* desc_ep)
+{
+    host_usb::opened_endpoints_.push_back({ dev_addr, desc_ep->bEndpointAddress, desc_ep->bInterval });
+    return true;
+}
+
+bool tud_init(uint8_t) { return true; }
+void tud_task() {}
+bool tud_ready() { return true; }
+bool tud_mounted() { return true; }
+bool tud_suspended() { return false; }
+bool tud_remote_wakeup() { return true; }
+void tud_sof_cb_enable(bool) {}
+bool tud_control_xfer(uint8_t, tusb_control_request_t const*, void*, uint16_t) { return true; }
+bool tud_control_status(uint8_t, tusb_control_request_t const*) { return true; }
+
+bool usbd_edpt_open(uint8_t, tusb_desc_endpoint_t const* desc_ep)
+{
+    host_usb::device_endpoints_.push_back(desc_ep->bEndpointAddress);
+    return true;
+}
+
+bool usbd_edpt_claim(uint8_t, uint8_t) { return true; }
+bool usbd_edpt_release(uint8_t, uint8_t) { return true; }
+bool usbd_edpt_busy(uint8_t, uint8_t) { return false; }
+
+bool usbd_edpt_xfer(uint8_t, uint8_t ep_addr, uint8_t*, uint16_t total_bytes)
+{
+    host_usb::device_transfers_.push_back({ ep_addr, total_bytes });
+    return true;
+}
+
+void     cdcd_init(void) {}
+bool     cdcd_deinit(void) { return true; }
+void     cdcd_reset(uint8_t) {}
+uint16_t cdcd_open(uint8_t, tusb_desc_interface_t const*, uint16_t) { return 0; }
+bool     cdcd_control_xfer_cb(uint8_t, uint8_t, tusb_control_request_t const*) { return false; }
+bool     cdcd_xfer_cb(uint8_t, uint8_t, xfer_result_t, uint32_t) { return true; }
+
+size_t board_usb_get_serial(uint16_t desc_str1[], size_t max_chars)
+{
+    static const char SERIAL[] = "0123456789ABCDEF";
+    const size_t count = std::min(max_chars, sizeof(SERIAL) - 1);
+    for (size_t i = 0; i < count; ++i)
+    {
+        desc_str1[i] = static_cast<uint16_t>(SERIAL[i]);
+    }
+    return count;
+}
+
+//Weak so a test can link the real tud_xinput.cpp over them
+namespace tud_xinput
+{
+    TU_ATTR_WEAK bool send_report_ready(uint8_t index) { return index < host_usb::MAX_INSTANCES; }
+    TU_ATTR_WEAK bool send_report(uint8_t index, const uint8_t* report, uint16_t len) { return host_usb::send(index, report, len); }
+    TU_ATTR_WEAK bool receive_report(uint8_t index, uint8_t* report, uint16_t len) { return host_usb::receive(index, report, len); }
+    TU_ATTR_WEAK const usbd_class_driver_t* class_driver() { return &host_usb::CLASS_DRIVER; }
+}
+
+namespace tud_xid
+{
+    void initialize(tud_xid::Type) {}
+    const usbd_class_driver_t* class_driver() { return &host_usb::CLASS_DRIVER; }
+    uint8_t get_index_by_type(uint8_t type_index, tud_xid::Type) { return type_index; }
+    bool receive_report(uint8_t idx, uint8_t* buffer, uint16_t len) { return host_usb::receive(idx, buffer, len); }
+    bool send_report(uint8_t idx, const uint8_t* buffer, uint16_t len) { return host_usb::send(idx, buffer, len); }
+    bool send_report_ready(uint8_t idx) { return idx < host_usb::MAX_INSTANCES; }
+    bool xremote_rom_available() { return false; }
+}
+
+namespace tuh_xinput
+{
+    static const usbh_class_driver_t CLASS_DRIVER = { .name = "host" };
+
+    const usbh_class_driver_t* class_driver() { return &CLASS_DRIVER; }
+    bool send_report(uint8_t, uint8_t, const uint8_t*, uint16_t) { ++host_usb::host_out_count_; return true; }
+    bool queue_report(uint8_t, uint8_t, const uint8_t*, uint16_t) { ++host_usb::host_out_count_; return true; }
+    bool receive_report(uint8_t, uint8_t) { ++host_usb::hid_receive_count_; return true; }
+    bool set_rumble(uint8_t, uint8_t, uint8_t, uint8_t, bool) { ++host_usb::host_out_count_; return true; }
+    bool set_led(uint8_t, uint8_t, uint8_t, bool) { ++host_usb::host_out_count_; return true; }
+    void xbox360_chatpad_init(uint8_t, uint8_t) {}
+    bool xbox360_chatpad_keepalive(uint8_t, uint8_t) { return true; }
+}
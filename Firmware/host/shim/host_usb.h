@@ -0,0 +1,61 @@
+#ifndef _HOST_USB_H_
+#define _HOST_USB_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+
+// What the device drivers sent through the TinyUSB stand-in.
+// Every HID, XInput and XID IN report lands in the slot of its instance/interface index.
+// Host drivers only get their receive requests and OUT reports counted, and see the VID/PID set here.
+namespace host_usb
+{
+    static constexpr size_t MAX_INSTANCES = 4;
+    static constexpr size_t MAX_REPORT_LEN = 64;
+
+    struct Report
+    {
+        std::array<uint8_t, MAX_REPORT_LEN> data{0};
+        uint16_t len{0};
+        uint32_t count{0};
+    };
+
+    struct Endpoint
+    {
+        uint8_t address;
+        uint8_t ep_addr;
+        uint8_t interval; //bInterval as the HCD got it
+    };
+
+    struct DeviceTransfer
+    {
+        uint8_t ep_addr;
+        uint16_t len;
+    };
+
+    const Report& in_report(uint8_t index);
+    //Total IN reports sent on all instances
+    uint32_t in_report_count();
+    //Host OUT data handed to receive_report() once for index, rumble etc.
+    void queue_out_report(uint8_t index, const uint8_t* data, uint16_t len);
+    //Times a host driver asked for the next IN report with tuh_hid_receive_report() or tuh_xinput::receive_report()
+    uint32_t hid_receive_count();
+    //OUT reports host drivers sent to devices, rumble, LEDs and init
+    uint32_t host_out_count();
+    //The last OUT report a host driver sent with tuh_hid_send_report()
+    const Report& host_out_report();
+    //tuh_hid_send_report() refuses the next count reports, as if the endpoint were busy
+    void refuse_host_out(uint32_t count);
+    //Endpoints handed to the HCD, the host build's __real_hcd_edpt_open() records them
+    const std::vector<Endpoint>& opened_endpoints();
+    //Endpoints device class drivers opened with usbd_edpt_open(), in order
+    const std::vector<uint8_t>& device_endpoints();
+    //Transfers device class drivers started with usbd_edpt_xfer(), in order
+    const std::vector<DeviceTransfer>& device_transfers();
+    //What tuh_vid_pid_get() returns for address until reset()
+    void set_vid_pid(uint8_t address, uint16_t vid, uint16_t pid);
+    void reset();
+}
+
+#endif // _HOST_USB_H_
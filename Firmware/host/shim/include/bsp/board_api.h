@@ -0,0 +1,10 @@
+#ifndef _HOST_BSP_BOARD_API_H_
+#define _HOST_BSP_BOARD_API_H_
+
+#include <cstdint>
+#include <cstddef>
+
+//Writes the board's serial number as UTF-16, returns the number of characters, host_usb.cpp
+size_t board_usb_get_serial(uint16_t desc_str1[], size_t max_chars);
+
+#endif // _HOST_BSP_BOARD_API_H_
@@ -0,0 +1,42 @@
+#ifndef _HOST_TUSB_CDC_DEVICE_H_
+#define _HOST_TUSB_CDC_DEVICE_H_
+
+#include <cstdint>
+
+#include "tusb.h"
+
+#define TUD_CDC_DESC_LEN (8 + 9 + 5 + 5 + 4 + 5 + 7 + 9 + 7 + 7)
+#define TUD_CDC_DESCRIPTOR(_itfnum, _stridx, _ep_notif, _ep_notif_size, _epout, _epin, _epsize) \
+    8, TUSB_DESC_INTERFACE_ASSOCIATION, _itfnum, 2, TUSB_CLASS_CDC, 2, 0, 0,\
+    9, TUSB_DESC_INTERFACE, _itfnum, 0, 1, TUSB_CLASS_CDC, 2, 0, _stridx,\
+    5, TUSB_DESC_CS_INTERFACE, 0, U16_TO_U8S_LE(0x0120),\
+    5, TUSB_DESC_CS_INTERFACE, 1, 0, (uint8_t)((_itfnum) + 1),\
+    4, TUSB_DESC_CS_INTERFACE, 2, 6,\
+    5, TUSB_DESC_CS_INTERFACE, 6, _itfnum, (uint8_t)((_itfnum) + 1),\
+    7, TUSB_DESC_ENDPOINT, _ep_notif, TUSB_XFER_INTERRUPT, U16_TO_U8S_LE(_ep_notif_size), 16,\
+    9, TUSB_DESC_INTERFACE, (uint8_t)((_itfnum)+1), 0, 2, TUSB_CLASS_CDC_DATA, 0, 0, 0,\
+    7, TUSB_DESC_ENDPOINT, _epout, TUSB_XFER_BULK, U16_TO_U8S_LE(_epsize), 0,\
+    7, TUSB_DESC_ENDPOINT, _epin, TUSB_XFER_BULK, U16_TO_U8S_LE(_epsize), 0
+
+static inline bool tud_cdc_n_connected(uint8_t) { return false; }
+static inline uint32_t tud_cdc_n_available(uint8_t) { return 0; }
+static inline uint32_t tud_cdc_n_read(uint8_t, void*, uint32_t) { return 0; }
+static inline uint32_t tud_cdc_n_write(uint8_t, void const*, uint32_t bufsize) { return bufsize; }
+static inline uint32_t tud_cdc_n_write_flush(uint8_t) { return 0; }
+static inline uint32_t tud_cdc_n_write_available(uint8_t) { return 64; }
+static inline bool tud_cdc_connected() { return false; }
+static inline uint32_t tud_cdc_available() { return 0; }
+static inline uint32_t tud_cdc_read(void* buffer, uint32_t bufsize) { return tud_cdc_n_read(0, buffer, bufsize); }
+static inline uint32_t tud_cdc_write(void const* buffer, uint32_t bufsize) { return bufsize; }
+static inline uint32_t tud_cdc_write_flush() { return 0; }
+static inline uint32_t tud_cdc_write_available() { return 64; }
+
+//Class driver entry points, host_usb.cpp
+void     cdcd_init(void);
+bool     cdcd_deinit(void);
+void     cdcd_reset(uint8_t rhport);
+uint16_t cdcd_open(uint8_t rhport, tusb_desc_interface_t const* itf_desc, uint16_t max_len);
+bool     cdcd_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const* request);
+bool     cdcd_xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes);
+
+#endif // _HOST_TUSB_CDC_DEVICE_H_
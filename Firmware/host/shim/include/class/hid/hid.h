@@ -0,0 +1,44 @@
+#ifndef _HOST_TUSB_HID_H_
+#define _HOST_TUSB_HID_H_
+
+#include <cstdint>
+
+typedef enum
+{
+    HID_SUBCLASS_NONE = 0,
+    HID_SUBCLASS_BOOT = 1
+} hid_subclass_enum_t;
+
+typedef enum
+{
+    HID_ITF_PROTOCOL_NONE     = 0,
+    HID_ITF_PROTOCOL_KEYBOARD = 1,
+    HID_ITF_PROTOCOL_MOUSE    = 2
+} hid_interface_protocol_enum_t;
+
+typedef enum
+{
+    HID_DESC_TYPE_HID      = 0x21,
+    HID_DESC_TYPE_REPORT   = 0x22,
+    HID_DESC_TYPE_PHYSICAL = 0x23
+} hid_descriptor_enum_t;
+
+typedef enum
+{
+    HID_REPORT_TYPE_INVALID = 0,
+    HID_REPORT_TYPE_INPUT,
+    HID_REPORT_TYPE_OUTPUT,
+    HID_REPORT_TYPE_FEATURE
+} hid_report_type_t;
+
+typedef enum
+{
+    HID_REQ_CONTROL_GET_REPORT   = 0x01,
+    HID_REQ_CONTROL_GET_IDLE     = 0x02,
+    HID_REQ_CONTROL_GET_PROTOCOL = 0x03,
+    HID_REQ_CONTROL_SET_REPORT   = 0x09,
+    HID_REQ_CONTROL_SET_IDLE     = 0x0a,
+    HID_REQ_CONTROL_SET_PROTOCOL = 0x0b
+} hid_request_enum_t;
+
+#endif // _HOST_TUSB_HID_H_
@@ -0,0 +1,14 @@
+#ifndef _HOST_TUSB_HID_HOST_H_
+#define _HOST_TUSB_HID_HOST_H_
+
+#include <cstdint>
+
+#include "tusb.h"
+#include "host/usbh.h"
+
+//Counted by host_usb::hid_receive_count(), no transfer is queued
+bool tuh_hid_receive_report(uint8_t dev_addr, uint8_t idx);
+//Recorded as a host OUT report, see host_usb::host_out_report()
+bool tuh_hid_send_report(uint8_t dev_addr, uint8_t idx, uint8_t report_id, const void* report, uint16_t len);
+
+#endif // _HOST_TUSB_HID_HOST_H_
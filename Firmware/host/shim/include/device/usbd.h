@@ -0,0 +1,18 @@
+#ifndef _HOST_TUSB_USBD_H_
+#define _HOST_TUSB_USBD_H_
+
+#include <cstdint>
+
+#include "tusb.h"
+
+bool tud_init(uint8_t rhport);
+void tud_task();
+bool tud_ready();
+bool tud_mounted();
+bool tud_suspended();
+bool tud_remote_wakeup();
+void tud_sof_cb_enable(bool en);
+bool tud_control_xfer(uint8_t rhport, tusb_control_request_t const* request, void* buffer, uint16_t len);
+bool tud_control_status(uint8_t rhport, tusb_control_request_t const* request);
+
+#endif // _HOST_TUSB_USBD_H_
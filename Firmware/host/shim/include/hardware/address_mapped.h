@@ -0,0 +1,12 @@
+#ifndef _HOST_HARDWARE_ADDRESS_MAPPED_H_
+#define _HOST_HARDWARE_ADDRESS_MAPPED_H_
+
+#include <cstdint>
+
+typedef volatile uint32_t io_rw_32;
+typedef unsigned int uint;
+
+static inline void hw_set_bits(io_rw_32* addr, uint32_t mask) { *addr = *addr | mask; }
+static inline void hw_clear_bits(io_rw_32* addr, uint32_t mask) { *addr = *addr & ~mask; }
+
+#endif // _HOST_HARDWARE_ADDRESS_MAPPED_H_
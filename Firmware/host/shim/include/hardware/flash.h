@@ -0,0 +1,28 @@
+#ifndef _HOST_HARDWARE_FLASH_H_
+#define _HOST_HARDWARE_FLASH_H_
+
+// Host stand-in for the pico-sdk flash API, flash is a zero filled array instead of XIP memory
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#define FLASH_PAGE_SIZE       (1u << 8)
+#define FLASH_SECTOR_SIZE     (1u << 12)
+#define PICO_FLASH_SIZE_BYTES (2 * 1024 * 1024)
+
+inline uint8_t host_flash[PICO_FLASH_SIZE_BYTES];
+
+#define XIP_BASE reinterpret_cast<uintptr_t>(host_flash)
+
+static inline void flash_range_erase(uint32_t flash_offs, size_t count)
+{
+    std::memset(host_flash + flash_offs, 0xFF, count);
+}
+
+static inline void flash_range_program(uint32_t flash_offs, const uint8_t* data, size_t count)
+{
+    std::memcpy(host_flash + flash_offs, data, count);
+}
+
+#endif // _HOST_HARDWARE_FLASH_H_
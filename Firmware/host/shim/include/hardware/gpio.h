@@ -0,0 +1,9 @@
+#ifndef _HOST_HARDWARE_GPIO_H_
+#define _HOST_HARDWARE_GPIO_H_
+
+#include <cstdint>
+
+static inline void gpio_xor_mask(uint32_t) {}
+static inline void gpio_put(uint32_t, bool) {}
+
+#endif // _HOST_HARDWARE_GPIO_H_
@@ -0,0 +1,20 @@
+#ifndef _HOST_HARDWARE_IRQ_H_
+#define _HOST_HARDWARE_IRQ_H_
+
+#include "hardware/address_mapped.h"
+
+typedef void (*irq_handler_t)(void);
+
+//Only the timer's IRQs are ever raised, by host_alarm::run_until()
+struct host_irq_t
+{
+    irq_handler_t handler[32];
+    bool enabled[32];
+};
+
+inline host_irq_t host_irq{};
+
+static inline void irq_set_exclusive_handler(uint num, irq_handler_t handler) { host_irq.handler[num] = handler; }
+static inline void irq_set_enabled(uint num, bool enabled) { host_irq.enabled[num] = enabled; }
+
+#endif // _HOST_HARDWARE_IRQ_H_
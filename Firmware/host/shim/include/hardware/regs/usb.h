@@ -0,0 +1,4 @@
+#ifndef _HOST_HARDWARE_REGS_USB_H_
+#define _HOST_HARDWARE_REGS_USB_H_
+
+#endif // _HOST_HARDWARE_REGS_USB_H_
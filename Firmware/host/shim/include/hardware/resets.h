@@ -0,0 +1,4 @@
+#ifndef _HOST_HARDWARE_RESETS_H_
+#define _HOST_HARDWARE_RESETS_H_
+
+#endif // _HOST_HARDWARE_RESETS_H_
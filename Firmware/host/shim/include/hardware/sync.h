@@ -0,0 +1,26 @@
+#ifndef _HOST_HARDWARE_SYNC_H_
+#define _HOST_HARDWARE_SYNC_H_
+
+#include <atomic>
+#include <cstdint>
+
+#include "hardware/address_mapped.h"
+
+static inline void __dmb() { std::atomic_thread_fence(std::memory_order_seq_cst); }
+static inline void __sev() {}
+static inline void __wfe() {}
+static inline uint32_t save_and_disable_interrupts() { return 0; }
+static inline void restore_interrupts(uint32_t) {}
+
+//Everything runs on one thread as core 0, spin locks have nothing to wait for
+typedef volatile uint32_t spin_lock_t;
+
+inline spin_lock_t host_spin_locks[32]{};
+
+static inline int spin_lock_claim_unused(bool) { return 0; }
+static inline spin_lock_t* spin_lock_instance(uint lock_num) { return &host_spin_locks[lock_num]; }
+static inline uint32_t spin_lock_blocking(spin_lock_t*) { return 0; }
+static inline void spin_unlock(spin_lock_t*, uint32_t) {}
+static inline uint get_core_num() { return 0; }
+
+#endif // _HOST_HARDWARE_SYNC_H_
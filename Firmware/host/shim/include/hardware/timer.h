@@ -0,0 +1,66 @@
+#ifndef _HOST_HARDWARE_TIMER_H_
+#define _HOST_HARDWARE_TIMER_H_
+
+#include "pico/time.h"
+#include "hardware/address_mapped.h"
+
+namespace host_alarm
+{
+    //ALARMn: writing it arms the alarm, it matches the low 32 bits of the clock once and disarms.
+    //A value the clock already passed, or is at, only matches after the 32 bit wrap, as on the RP2040
+    struct AlarmRegister
+    {
+        uint32_t value{0};
+        bool armed{false};
+        uint64_t match_us{0};
+
+        AlarmRegister& operator=(uint32_t alarm)
+        {
+            const uint64_t now = host_time::now_us();
+            const uint32_t ahead_us = alarm - static_cast<uint32_t>(now);
+            value = alarm;
+            armed = true;
+            match_us = now + (ahead_us ? ahead_us : (1ull << 32));
+            return *this;
+        }
+        operator uint32_t() const { return value; }
+    };
+}
+
+//ALARMn, INTR, INTE and INTF: a match sets the INTR bit, a match or a forced INTF bit raises the
+//alarm's IRQ when its INTE bit is set, from host_alarm::run_until()
+typedef struct
+{
+    host_alarm::AlarmRegister alarm[4];
+    io_rw_32 intr;
+    io_rw_32 inte;
+    io_rw_32 intf;
+} timer_hw_t;
+
+inline timer_hw_t host_timer_hw{};
+#define timer_hw (&host_timer_hw)
+
+static inline uint timer_hardware_alarm_get_irq_num(timer_hw_t*, uint alarm_num) { return alarm_num; }
+
+//The hardware_alarm API fires from host_alarm::run_until() too, on the thread calling it
+typedef void (*hardware_alarm_callback_t)(uint alarm_num);
+
+static inline absolute_time_t from_us_since_boot(uint64_t us) { return us; }
+
+void hardware_alarm_claim(uint alarm_num);
+int hardware_alarm_claim_unused(bool required);
+void hardware_alarm_set_callback(uint alarm_num, hardware_alarm_callback_t callback);
+//True if target has already been reached, nothing is armed then, same as the pico-sdk
+bool hardware_alarm_set_target(uint alarm_num, absolute_time_t target);
+void hardware_alarm_cancel(uint alarm_num);
+
+namespace host_alarm
+{
+    //Steps the frozen host clock to us, stopping at each armed alarm's target or register match to run
+    //its callback or IRQ handler. A forced INTF bit runs its handler at the current time
+    void run_until(uint64_t us);
+    //Frees every alarm, disarms the registers and clears pending IRQs. INTE and the IRQ handlers stay
+    void reset();
+}
+
+#endif // _HOST_HARDWARE_TIMER_H_
@@ -0,0 +1,18 @@
+#ifndef _HOST_HARDWARE_UART_H_
+#define _HOST_HARDWARE_UART_H_
+
+// The host has no UART, nothing is ever readable
+
+#include <cstddef>
+#include <cstdint>
+
+typedef struct uart_inst uart_inst_t;
+
+#define uart0 (static_cast<uart_inst_t*>(nullptr))
+#define uart1 (static_cast<uart_inst_t*>(nullptr))
+
+static inline bool uart_is_readable(uart_inst_t*) { return false; }
+static inline char uart_getc(uart_inst_t*) { return 0; }
+static inline void uart_read_blocking(uart_inst_t*, uint8_t* dst, size_t len) { for (size_t i = 0; i < len; ++i) dst[i] = 0; }
+
+#endif // _HOST_HARDWARE_UART_H_
@@ -0,0 +1,34 @@
+#ifndef _HOST_TUSB_USBH_H_
+#define _HOST_TUSB_USBH_H_
+
+#include <cstdint>
+
+#include "tusb.h"
+
+typedef struct tuh_xfer_s tuh_xfer_t;
+typedef void (*tuh_xfer_cb_t)(tuh_xfer_t* xfer);
+
+struct tuh_xfer_s
+{
+    uint8_t daddr;
+    uint8_t ep_addr;
+    uint8_t reserved;
+    xfer_result_t result;
+    uint32_t actual_len;
+    union
+    {
+        tusb_control_request_t const* setup;
+        uint32_t buflen;
+    };
+    uint8_t* buffer;
+    tuh_xfer_cb_t complete_cb;
+    uintptr_t user_data;
+};
+
+//Transfers are refused, VID/PID come from host_usb::set_vid_pid()
+bool tuh_control_xfer(tuh_xfer_t* xfer);
+bool tuh_edpt_open(uint8_t dev_addr, tusb_desc_endpoint_t const* desc_ep);
+bool tuh_vid_pid_get(uint8_t dev_addr, uint16_t* vid, uint16_t* pid);
+static inline void tuh_task(void) {}
+
+#endif // _HOST_TUSB_USBH_H_
@@ -0,0 +1,19 @@
+#ifndef _HOST_TUSB_USBH_PVT_H_
+#define _HOST_TUSB_USBH_PVT_H_
+
+#include <cstdint>
+
+#include "tusb.h"
+
+typedef struct
+{
+    char const* name;
+    bool (* init       ) (void);
+    bool (* deinit     ) (void);
+    bool (* open       ) (uint8_t rhport, uint8_t dev_addr, tusb_desc_interface_t const* desc_intf, uint16_t max_len);
+    bool (* set_config ) (uint8_t dev_addr, uint8_t itf_num);
+    bool (* xfer_cb    ) (uint8_t dev_addr, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes);
+    void (* close      ) (uint8_t dev_addr);
+} usbh_class_driver_t;
+
+#endif // _HOST_TUSB_USBH_PVT_H_
@@ -0,0 +1,9 @@
+#ifndef _HOST_PICO_MULTICORE_H_
+#define _HOST_PICO_MULTICORE_H_
+
+// Host stand-in for the pico-sdk multicore API, there is no second core to lock out
+
+static inline void multicore_lockout_start_blocking() {}
+static inline void multicore_lockout_end_blocking() {}
+
+#endif // _HOST_PICO_MULTICORE_H_
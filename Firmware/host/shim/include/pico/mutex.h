@@ -0,0 +1,18 @@
+#ifndef _HOST_PICO_MUTEX_H_
+#define _HOST_PICO_MUTEX_H_
+
+// Host stand-in for the pico-sdk mutex, a std::mutex underneath
+
+#include <mutex>
+
+typedef struct
+{
+    std::mutex m;
+} mutex_t;
+
+static inline void mutex_init(mutex_t*) {}
+static inline void mutex_enter_blocking(mutex_t* mtx) { mtx->m.lock(); }
+static inline bool mutex_try_enter(mutex_t* mtx, uint32_t* owner_out) { (void)owner_out; return mtx->m.try_lock(); }
+static inline void mutex_exit(mutex_t* mtx) { mtx->m.unlock(); }
+
+#endif // _HOST_PICO_MUTEX_H_
@@ -0,0 +1,7 @@
+#ifndef _HOST_PICO_PLATFORM_H_
+#define _HOST_PICO_PLATFORM_H_
+
+#define __not_in_flash_func(func_name) func_name
+#define __time_critical_func(func_name) func_name
+
+#endif // _HOST_PICO_PLATFORM_H_
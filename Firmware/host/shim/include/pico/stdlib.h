@@ -0,0 +1,6 @@
+#ifndef _HOST_PICO_STDLIB_H_
+#define _HOST_PICO_STDLIB_H_
+
+#include "pico/time.h"
+
+#endif // _HOST_PICO_STDLIB_H_
@@ -0,0 +1,35 @@
+#ifndef _HOST_PICO_TIME_H_
+#define _HOST_PICO_TIME_H_
+
+// Host stand-in for the pico-sdk time API, backed by a monotonic clock.
+// Tests can freeze and step it with host_time::set_us()/advance_us().
+
+#include <cstdint>
+
+typedef uint64_t absolute_time_t;
+
+namespace host_time
+{
+    uint64_t now_us();
+    //Stops following the system clock, the time only moves with set_us()/advance_us() after this
+    void set_us(uint64_t us);
+    void advance_us(uint64_t us);
+    //Back to following the system clock
+    void release();
+}
+
+static inline absolute_time_t get_absolute_time() { return host_time::now_us(); }
+static inline uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+static inline uint32_t to_ms_since_boot(absolute_time_t t) { return static_cast<uint32_t>(t / 1000); }
+static inline uint64_t time_us_64() { return host_time::now_us(); }
+static inline uint32_t time_us_32() { return static_cast<uint32_t>(host_time::now_us()); }
+
+static inline absolute_time_t make_timeout_time_us(uint64_t us) { return host_time::now_us() + us; }
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) { return host_time::now_us() + static_cast<uint64_t>(ms) * 1000; }
+static inline bool time_reached(absolute_time_t t) { return host_time::now_us() >= t; }
+static inline int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) { return static_cast<int64_t>(to - from); }
+
+static inline void sleep_us(uint64_t us) { host_time::advance_us(us); }
+static inline void sleep_ms(uint32_t ms) { host_time::advance_us(static_cast<uint64_t>(ms) * 1000); }
+
+#endif // _HOST_PICO_TIME_H_
@@ -0,0 +1,9 @@
+#ifndef _HOST_PIO_USB_H_
+#define _HOST_PIO_USB_H_
+
+// Host stand-in for the Pico-PIO-USB call FrameSync makes, a test that builds FrameSync with
+// CONFIG_EN_SOF_ALIGN defines it to see when host frames start.
+
+extern "C" void pio_usb_host_frame(void);
+
+#endif // _HOST_PIO_USB_H_
@@ -0,0 +1,213 @@
+#ifndef _HOST_TUSB_H_
+#define _HOST_TUSB_H_
+
+// Host stand-in for the parts of TinyUSB the drivers touch.
+// Types and descriptor macros follow TinyUSB, transfers are recorded by host_usb (shim/host_usb.h)
+// instead of going anywhere.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#define OPT_MCU_NONE           0
+#define OPT_OS_NONE            1
+#define OPT_MODE_DEFAULT_SPEED 0
+
+#include "tusb_config.h"
+
+#define TU_ATTR_PACKED         __attribute__ ((packed))
+#define TU_ATTR_ALIGNED(x)     __attribute__ ((aligned(x)))
+#define TU_ATTR_WEAK           __attribute__ ((weak))
+#define TU_ATTR_UNUSED         __attribute__ ((unused))
+#define TU_BIT(n)              (1UL << (n))
+#define TU_U16_HIGH(u16)       ((uint8_t) (((u16) >> 8) & 0x00ff))
+#define TU_U16_LOW(u16)        ((uint8_t) ((u16) & 0x00ff))
+#define U16_TO_U8S_LE(u16)     TU_U16_LOW(u16), TU_U16_HIGH(u16)
+#define TU_MIN(a, b)           (((a) < (b)) ? (a) : (b))
+#define TU_MAX(a, b)           (((a) > (b)) ? (a) : (b))
+#define TU_ARRAY_SIZE(a)       (sizeof(a) / sizeof(a[0]))
+
+#define TU_LOG1(...)
+#define TU_LOG2(...)
+//Like TinyUSB, returns false or the value given after the condition
+#define TU_VERIFY_RET(_1, _2, NAME, ...) NAME
+#define TU_VERIFY_1(cond)      do { if (!(cond)) return false; } while (0)
+#define TU_VERIFY_2(cond, ret) do { if (!(cond)) return ret; } while (0)
+#define TU_VERIFY(...)         TU_VERIFY_RET(__VA_ARGS__, TU_VERIFY_2, TU_VERIFY_1, _)(__VA_ARGS__)
+#define TU_ASSERT(...)         TU_VERIFY(__VA_ARGS__)
+
+#define TUSB_OPT_DEVICE_ENABLED CFG_TUD_ENABLED
+#define CFG_TUD_LOG_LEVEL      2
+
+typedef enum
+{
+    TUSB_DIR_OUT = 0,
+    TUSB_DIR_IN  = 1,
+    TUSB_DIR_IN_MASK = 0x80
+} tusb_dir_t;
+
+typedef enum
+{
+    TUSB_XFER_CONTROL = 0,
+    TUSB_XFER_ISOCHRONOUS,
+    TUSB_XFER_BULK,
+    TUSB_XFER_INTERRUPT
+} tusb_xfer_type_t;
+
+typedef enum
+{
+    TUSB_DESC_DEVICE                = 0x01,
+    TUSB_DESC_CONFIGURATION         = 0x02,
+    TUSB_DESC_STRING                = 0x03,
+    TUSB_DESC_INTERFACE             = 0x04,
+    TUSB_DESC_ENDPOINT              = 0x05,
+    TUSB_DESC_DEVICE_QUALIFIER      = 0x06,
+    TUSB_DESC_INTERFACE_ASSOCIATION = 0x0B,
+    TUSB_DESC_CS_INTERFACE          = 0x24,
+    TUSB_DESC_CS_ENDPOINT           = 0x25
+} tusb_desc_type_t;
+
+typedef enum
+{
+    TUSB_CLASS_UNSPECIFIED = 0x00,
+    TUSB_CLASS_CDC         = 0x02,
+    TUSB_CLASS_HID         = 0x03,
+    TUSB_CLASS_HUB         = 0x09,
+    TUSB_CLASS_CDC_DATA    = 0x0A,
+    TUSB_CLASS_MISC        = 0xEF,
+    TUSB_CLASS_VENDOR_SPECIFIC = 0xFF
+} tusb_class_code_t;
+
+typedef enum
+{
+    MISC_SUBCLASS_COMMON = 2
+} misc_subclass_type_t;
+
+typedef enum
+{
+    MISC_PROTOCOL_IAD = 1
+} misc_protocol_type_t;
+
+typedef enum
+{
+    TUSB_REQ_TYPE_STANDARD = 0,
+    TUSB_REQ_TYPE_CLASS,
+    TUSB_REQ_TYPE_VENDOR,
+    TUSB_REQ_TYPE_INVALID
+} tusb_request_type_t;
+
+typedef enum
+{
+    TUSB_REQ_RCPT_DEVICE = 0,
+    TUSB_REQ_RCPT_INTERFACE,
+    TUSB_REQ_RCPT_ENDPOINT,
+    TUSB_REQ_RCPT_OTHER
+} tusb_request_recipient_t;
+
+typedef enum
+{
+    TUSB_DESC_CONFIG_ATT_REMOTE_WAKEUP = TU_BIT(5),
+    TUSB_DESC_CONFIG_ATT_SELF_POWERED  = TU_BIT(6)
+} tusb_desc_config_att_t;
+
+typedef enum
+{
+    XFER_RESULT_SUCCESS = 0,
+    XFER_RESULT_FAILED,
+    XFER_RESULT_STALLED,
+    XFER_RESULT_TIMEOUT,
+    XFER_RESULT_INVALID
+} xfer_result_t;
+
+enum
+{
+    CONTROL_STAGE_IDLE = 0,
+    CONTROL_STAGE_SETUP,
+    CONTROL_STAGE_DATA,
+    CONTROL_STAGE_ACK
+};
+
+typedef struct TU_ATTR_PACKED
+{
+    union
+    {
+        struct TU_ATTR_PACKED
+        {
+            uint8_t recipient :  5;
+            uint8_t type      :  2;
+            uint8_t direction :  1;
+        } bmRequestType_bit;
+        uint8_t bmRequestType;
+    };
+    uint8_t  bRequest;
+    uint16_t wValue;
+    uint16_t wIndex;
+    uint16_t wLength;
+} tusb_control_request_t;
+
+typedef struct TU_ATTR_PACKED
+{
+    uint8_t  bLength;
+    uint8_t  bDescriptorType;
+    uint16_t bcdUSB;
+    uint8_t  bDeviceClass;
+    uint8_t  bDeviceSubClass;
+    uint8_t  bDeviceProtocol;
+    uint8_t  bMaxPacketSize0;
+    uint16_t idVendor;
+    uint16_t idProduct;
+    uint16_t bcdDevice;
+    uint8_t  iManufacturer;
+    uint8_t  iProduct;
+    uint8_t  iSerialNumber;
+    uint8_t  bNumConfigurations;
+} tusb_desc_device_t;
+
+typedef struct TU_ATTR_PACKED
+{
+    uint8_t  bLength;
+    uint8_t  bDescriptorType;
+    uint8_t  bInterfaceNumber;
+    uint8_t  bAlternateSetting;
+    uint8_t  bNumEndpoints;
+    uint8_t  bInterfaceClass;
+    uint8_t  bInterfaceSubClass;
+    uint8_t  bInterfaceProtocol;
+    uint8_t  iInterface;
+} tusb_desc_interface_t;
+
+typedef struct TU_ATTR_PACKED
+{
+    uint8_t  bLength;
+    uint8_t  bDescriptorType;
+    uint8_t  bEndpointAddress;
+    struct TU_ATTR_PACKED
+    {
+        uint8_t xfer  : 2;
+        uint8_t sync  : 2;
+        uint8_t usage : 2;
+        uint8_t       : 2;
+    } bmAttributes;
+    uint16_t wMaxPacketSize;
+    uint8_t  bInterval;
+} tusb_desc_endpoint_t;
+
+static inline uint8_t tu_desc_len(void const* desc) { return static_cast<uint8_t const*>(desc)[0]; }
+static inline uint8_t tu_desc_type(void const* desc) { return static_cast<uint8_t const*>(desc)[1]; }
+static inline uint8_t const* tu_desc_next(void const* desc) { return static_cast<uint8_t const*>(desc) + tu_desc_len(desc); }
+static inline uint8_t tu_edpt_dir(uint8_t addr) { return (addr & TUSB_DIR_IN_MASK) ? TUSB_DIR_IN : TUSB_DIR_OUT; }
+static inline uint8_t tu_edpt_number(uint8_t addr) { return static_cast<uint8_t>(addr & (~TUSB_DIR_IN_MASK)); }
+static inline uint16_t tu_u16(uint8_t high, uint8_t low) { return static_cast<uint16_t>((high << 8) | low); }
+static inline uint8_t tu_u16_high(uint16_t ui16) { return static_cast<uint8_t>(ui16 >> 8); }
+static inline uint8_t tu_u16_low(uint16_t ui16) { return static_cast<uint8_t>(ui16 & 0x00ff); }
+
+#define TUD_CONFIG_DESC_LEN (9)
+#define TUD_CONFIG_DESCRIPTOR(config_num, _itfcount, _stridx, _total_len, _attribute, _power_ma) \
+    9, TUSB_DESC_CONFIGURATION, U16_TO_U8S_LE(_total_len), _itfcount, config_num, _stridx, TU_BIT(7) | _attribute, (_power_ma)/2
+
+#include "class/hid/hid.h"
+#include "device/usbd.h"
+#include "class/hid/hid_device.h"
+#include "class/cdc/cdc_device.h"
+
+#endif // _HOST_TUSB_H_
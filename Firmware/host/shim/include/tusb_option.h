@@ -0,0 +1,6 @@
+#ifndef _HOST_TUSB_OPTION_H_
+#define _HOST_TUSB_OPTION_H_
+
+#include "tusb.h"
+
+#endif // _HOST_TUSB_OPTION_H_
@@ -0,0 +1,43 @@
+#ifndef _HOST_CHECK_H_
+#define _HOST_CHECK_H_
+
+#include <cstdio>
+
+// Assertions for the host tests, a failed CHECK is reported and the test keeps going.
+// main() returns check::result() so ctest sees the failure.
+namespace check
+{
+    inline int failures = 0;
+
+    inline int result()
+    {
+        if (failures)
+        {
+            std::fprintf(stderr, "%d check(s) failed\n", failures);
+            return 1;
+        }
+        return 0;
+    }
+}
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            ++check::failures; \
+        } \
+    } while (0)
+
+//Stops at the first mismatch of a sweep so a broken build doesn't print millions of lines
+#define CHECK_SWEEP(cond, ...) \
+    do { \
+        if (!(cond)) { \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s: ", __FILE__, __LINE__, #cond); \
+            std::fprintf(stderr, __VA_ARGS__); \
+            std::fprintf(stderr, "\n"); \
+            ++check::failures; \
+            return; \
+        } \
+    } while (0)
+
+#endif // _HOST_CHECK_H_
@@ -0,0 +1,172 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+#include "host_usb.h"
+
+#include "Descriptors/DInput.h"
+#include "Descriptors/XInput.h"
+#include "replay/Replay.h"
+
+#include "Check.h"
+
+// A capture in the dump format the firmware sends goes through report_replay's Replayer:
+// a mounted DInput pad and one whose mount the ring wrapped past have to come out as XInput reports
+// on their own gamepads, unchanged reports send nothing, an unmount frees the gamepad and two runs
+// give the same reports. Broken dumps are refused.
+// capture_replay
+
+namespace {
+
+struct Sent
+{
+    uint8_t sent_mask;
+    uint8_t gamepad_idx;
+    XInput::InReport report;
+};
+
+ReportCapture::Record make_record(uint32_t timestamp_us, ReportCapture::Kind kind, uint8_t address, HostDriverType type,
+                                  const void* data = nullptr, uint16_t len = 0)
+{
+    ReportCapture::Record record{};
+    record.timestamp_us = timestamp_us;
+    record.kind = kind;
+    record.address = address;
+    record.instance = 0;
+    record.driver_type = static_cast<uint8_t>(type);
+    record.len = len;
+    if (data)
+    {
+        std::memcpy(record.data, data, std::min<size_t>(len, ReportCapture::MAX_DATA));
+    }
+    return record;
+}
+
+ReportCapture::Record pad_record(uint32_t timestamp_us, uint8_t address, uint8_t buttons)
+{
+    DInput::InReport report;
+    report.buttons[0] = buttons;
+    return make_record(timestamp_us, ReportCapture::Kind::REPORT, address, HostDriverType::DINPUT, &report, sizeof(report));
+}
+
+std::vector<uint8_t> make_dump(const std::vector<ReportCapture::Record>& records, uint32_t dropped)
+{
+    ReportCapture::DumpHeader header{};
+    header.magic = ReportCapture::MAGIC;
+    header.version = ReportCapture::VERSION;
+    header.record_size = sizeof(ReportCapture::Record);
+    header.record_count = static_cast<uint16_t>(records.size());
+    header.dropped = dropped;
+
+    std::vector<uint8_t> bytes(sizeof(header) + records.size() * sizeof(ReportCapture::Record));
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::memcpy(bytes.data() + sizeof(header), records.data(), records.size() * sizeof(ReportCapture::Record));
+    return bytes;
+}
+
+std::vector<Sent> run(replay::Replayer& replayer, const replay::Capture& capture)
+{
+    std::vector<Sent> sent;
+    replayer.run(capture, [&](const replay::Event& event)
+    {
+        Sent entry{ event.sent_mask, event.gamepad_idx, XInput::InReport() };
+        for (uint8_t i = 0; i < MAX_GAMEPADS; ++i)
+        {
+            if (event.sent_mask & (1 << i))
+            {
+                std::memcpy(&entry.report, host_usb::in_report(i).data.data(), sizeof(entry.report));
+            }
+        }
+        sent.push_back(entry);
+    });
+    return sent;
+}
+
+void check_parse()
+{
+    const std::vector<ReportCapture::Record> records = { pad_record(10, 1, 0) };
+    replay::Capture capture;
+
+    std::vector<uint8_t> bytes = make_dump(records, 7);
+    CHECK(replay::parse(bytes, capture).empty());
+    CHECK(capture.records.size() == 1 && capture.dropped == 7);
+
+    CHECK(!replay::parse(std::vector<uint8_t>(bytes.begin(), bytes.end() - 1), capture).empty());
+    CHECK(!replay::parse(std::vector<uint8_t>(bytes.begin(), bytes.begin() + 4), capture).empty());
+    bytes[0] ^= 0xFF;
+    CHECK(!replay::parse(bytes, capture).empty());
+}
+
+void check_replay()
+{
+    //Address 2's mount was overwritten, the timestamps wrap at 2^32
+    const uint32_t start_us = 0xFFFFF000;
+    const std::vector<ReportCapture::Record> records =
+    {
+        make_record(start_us, ReportCapture::Kind::MOUNT, 1, HostDriverType::DINPUT),
+        pad_record(start_us + 1000, 1, DInput::Buttons0::CROSS),
+        pad_record(start_us + 2000, 1, DInput::Buttons0::CROSS),
+        pad_record(start_us + 3000, 2, DInput::Buttons0::CIRCLE),
+        pad_record(start_us + 4000, 1, 0),
+        make_record(start_us + 5000, ReportCapture::Kind::UNMOUNT, 1, HostDriverType::UNKNOWN),
+        pad_record(start_us + 6000, 1, DInput::Buttons0::SQUARE),
+    };
+
+    replay::Capture capture;
+    CHECK(replay::parse(make_dump(records, 0), capture).empty());
+
+    replay::Replayer replayer(DeviceDriverType::XINPUT);
+    uint64_t last_elapsed_us = 0;
+    replayer.run(capture, [&](const replay::Event& event) { last_elapsed_us = event.elapsed_us; });
+    CHECK(last_elapsed_us == 6000);
+
+    const std::vector<Sent> sent = run(replayer, capture);
+    CHECK(sent.size() == records.size());
+    if (sent.size() != records.size())
+    {
+        return;
+    }
+
+    CHECK(sent[0].gamepad_idx == 0);
+
+    CHECK(sent[1].sent_mask == 0x1);
+    CHECK(sent[1].report.buttons[1] == XInput::Buttons1::A);
+
+    //Unchanged, dropped before the driver
+    CHECK(sent[2].sent_mask == 0);
+
+    //Mounted from its report
+    CHECK(sent[3].gamepad_idx == 1);
+    CHECK(sent[3].sent_mask == 0x2);
+    CHECK(sent[3].report.buttons[1] == XInput::Buttons1::B);
+
+    CHECK(sent[4].sent_mask == 0x1);
+    CHECK(sent[4].report.buttons[1] == 0);
+
+    //Unplugged, the report after it has nowhere to go
+    CHECK(sent[5].gamepad_idx == replay::INVALID_IDX);
+    CHECK(sent[6].gamepad_idx == replay::INVALID_IDX);
+    CHECK(sent[6].sent_mask == 0);
+
+    //A second run starts from nothing mounted and sends the same reports
+    const std::vector<Sent> again = run(replayer, capture);
+    CHECK(again.size() == sent.size());
+    for (size_t i = 0; i < std::min(again.size(), sent.size()); ++i)
+    {
+        CHECK(again[i].sent_mask == sent[i].sent_mask);
+        CHECK(again[i].gamepad_idx == sent[i].gamepad_idx);
+        CHECK(std::memcmp(&again[i].report, &sent[i].report, sizeof(XInput::InReport)) == 0);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    check_parse();
+    check_replay();
+
+    return check::result();
+}
@@ -0,0 +1,202 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+#include "pico/time.h"
+#include "hardware/timer.h"
+#include "host_usb.h"
+
+#include "Gamepad/Gamepad.h"
+#include "Descriptors/SwitchPro.h"
+#include "USBHost/HostManager.h"
+#include "USBHost/HostCache.h"
+#include "USBHost/ConnectTimeline.h"
+
+#include "Check.h"
+
+// Connect, unplug and reconnect Switch Pro pads through HostManager, with core 1's TaskQueue
+// driven by the host alarm stand-in and a simulated pad answering the init commands. The first
+// connect has no HostCache entry and stores the steps the pad didn't answer, the reconnect is marked
+// cached and skips waiting on them. Only the init hint comes from the cache, the driver type is still
+// looked up and a cached type that differs from it leaves the hint unused.
+// Prints each connect's ConnectTimeline, setup to init done and to first PadIn, as JSON.
+// connect_timeline
+
+namespace {
+
+constexpr uint8_t ADDRESS = 1;
+constexpr uint8_t INSTANCE = 0;
+constexpr HardwareID SWITCH_PRO_ID = { 0x057E, 0x2009 };
+constexpr uint64_t STEP_US = 100;
+constexpr uint32_t SENT_US = 1000;   //OUT transfer completes
+constexpr uint32_t REPLY_US = 2000;  //Command reply comes in
+constexpr uint32_t POLL_US = 8000;   //Full reports once init is done
+constexpr uint64_t DEADLINE_US = 2000000;
+
+Gamepad gamepads[MAX_GAMEPADS];
+
+struct Pad
+{
+    const char* name;
+    uint16_t pid;
+    uint8_t silent_mask; //Init steps it never answers
+};
+
+struct Connect
+{
+    const char* name;
+    uint32_t init_us;
+    uint32_t first_pad_in_us;
+    bool cached;
+};
+
+//Mounts the pad and plays its side until the first PadIn is in the timeline
+bool connect(HostManager& manager, const Pad& pad, const char* name, Connect& result)
+{
+    host_usb::set_vid_pid(ADDRESS, SWITCH_PRO_ID.vid, pad.pid);
+    manager.device_enumerated(ADDRESS);
+
+    ConnectTimeline::Entry before[ConnectTimeline::MAX_ENTRIES];
+    const uint8_t count_before = ConnectTimeline::read(before, ConnectTimeline::MAX_ENTRIES);
+
+    //setup_driver() sends the first command
+    uint32_t out_count = host_usb::host_out_count();
+    const uint64_t start_us = host_time::now_us();
+    if (!manager.setup_driver(HostDriverType::SWITCH_PRO, ADDRESS, INSTANCE))
+    {
+        return false;
+    }
+
+    uint64_t sent_at = 0;
+    uint64_t reply_at = 0;
+    uint64_t poll_at = 0;
+    uint8_t step = 0;
+    uint8_t buttons = 0;
+
+    ConnectTimeline::Entry after[ConnectTimeline::MAX_ENTRIES];
+    uint8_t count_after = count_before;
+
+    while (host_time::now_us() - start_us < DEADLINE_US)
+    {
+        const uint64_t now = host_time::now_us();
+        if (host_usb::host_out_count() != out_count && step < 6)
+        {
+            out_count = host_usb::host_out_count();
+            sent_at = now + SENT_US;
+            reply_at = (pad.silent_mask & (1u << step)) ? 0 : now + REPLY_US;
+            ++step;
+            if (step == 6)
+            {
+                poll_at = now + POLL_US;
+            }
+        }
+        if (sent_at && now >= sent_at)
+        {
+            sent_at = 0;
+            manager.report_sent(ADDRESS, INSTANCE);
+        }
+        if (reply_at && now >= reply_at)
+        {
+            reply_at = 0;
+            const uint8_t reply[64] = { 0x21, step };
+            manager.process_report(ADDRESS, INSTANCE, reply, sizeof(reply));
+        }
+        if (poll_at && now >= poll_at)
+        {
+            poll_at = now + POLL_US;
+            SwitchPro::InReport report{};
+            report.report_id = 0x30;
+            report.buttons[0] = ++buttons;
+            manager.process_report(ADDRESS, INSTANCE, reinterpret_cast<const uint8_t*>(&report), sizeof(report));
+        }
+
+        count_after = ConnectTimeline::read(after, ConnectTimeline::MAX_ENTRIES);
+        if (count_after != count_before || (count_after == ConnectTimeline::MAX_ENTRIES &&
+            std::memcmp(&after[count_after - 1], &before[count_before - 1], sizeof(ConnectTimeline::Entry)) != 0))
+        {
+            break;
+        }
+
+        host_alarm::run_until(now + STEP_US);
+        TaskQueue::Core1::process_tasks();
+    }
+    manager.deinit_driver(HostManager::DriverClass::HID, ADDRESS, INSTANCE);
+
+    if (count_after == 0 || (count_after == count_before &&
+        std::memcmp(&after[count_after - 1], &before[count_before - 1], sizeof(ConnectTimeline::Entry)) == 0))
+    {
+        return false;
+    }
+
+    using ConnectTimeline::Stage;
+    const ConnectTimeline::Entry& timeline = after[count_after - 1];
+    const uint32_t setup_us = ConnectTimeline::get(timeline, Stage::DRIVER_SETUP);
+    result.name = name;
+    result.init_us = ConnectTimeline::get(timeline, Stage::INIT_DONE) - setup_us;
+    result.first_pad_in_us = ConnectTimeline::get(timeline, Stage::FIRST_PAD_IN) - setup_us;
+    result.cached = (timeline.cached != 0);
+
+    CHECK(timeline.vid == SWITCH_PRO_ID.vid && timeline.pid == pad.pid);
+    CHECK(timeline.driver_type == static_cast<uint8_t>(HostDriverType::SWITCH_PRO));
+    CHECK(ConnectTimeline::get(timeline, Stage::ENUMERATED) <= setup_us);
+    CHECK(result.init_us <= result.first_pad_in_us);
+    return true;
+}
+
+void check_connects(HostManager& manager)
+{
+    host_time::set_us(1000000);
+
+    //A clone that doesn't answer the two LED commands, and a pad that answers everything
+    const Pad clone = { "clone", 0x2009, 0x0C };
+    const Pad genuine = { "genuine", 0x2008, 0 };
+
+    Connect connects[5]{};
+    CHECK(HostCache::find(SWITCH_PRO_ID.vid, clone.pid) == nullptr);
+    CHECK(connect(manager, clone, "clone_first", connects[0]));
+
+    const HostCache::Entry* cached = HostCache::find(SWITCH_PRO_ID.vid, clone.pid);
+    CHECK(cached != nullptr);
+    CHECK(cached && cached->driver_type == static_cast<uint8_t>(HostDriverType::SWITCH_PRO));
+    CHECK(cached && cached->init_hint == clone.silent_mask);
+
+    CHECK(connect(manager, clone, "clone_cached", connects[1]));
+    CHECK(connect(manager, genuine, "genuine_first", connects[2]));
+    CHECK(connect(manager, genuine, "genuine_cached", connects[3]));
+
+    //Cached under another driver type, the hint is left alone and the clone waits out its silent steps again
+    HostCache::store(SWITCH_PRO_ID.vid, clone.pid, HostDriverType::DINPUT, clone.silent_mask);
+    CHECK(connect(manager, clone, "clone_other_type", connects[4]));
+
+    CHECK(!connects[0].cached && connects[1].cached);
+    CHECK(!connects[2].cached && connects[3].cached);
+    CHECK(connects[4].cached);
+
+    //Each silent step costs REPLY_TIMEOUT_MS unless the hint skips it
+    CHECK(connects[0].init_us >= connects[1].init_us + 2 * 48000);
+    CHECK(connects[4].init_us >= connects[1].init_us + 2 * 48000);
+    CHECK(connects[3].init_us <= connects[2].init_us + 1000);
+    CHECK(HostCache::find(SWITCH_PRO_ID.vid, clone.pid)->driver_type == static_cast<uint8_t>(HostDriverType::SWITCH_PRO));
+
+    std::printf("{\n  \"connects\": [\n");
+    for (size_t i = 0; i < std::size(connects); ++i)
+    {
+        std::printf("    {\"name\": \"%s\", \"cached\": %s, \"setup_to_init_us\": %u, \"setup_to_first_pad_in_us\": %u}%s\n",
+            connects[i].name, connects[i].cached ? "true" : "false", connects[i].init_us, connects[i].first_pad_in_us,
+            (i + 1 < std::size(connects)) ? "," : "");
+    }
+    std::printf("  ]\n}\n");
+}
+
+} // namespace
+
+int main()
+{
+    HostManager& manager = HostManager::get_instance();
+    manager.initialize(gamepads);
+
+    check_connects(manager);
+
+    return check::result();
+}
@@ -0,0 +1,328 @@
+#include <cstdint>
+#include <cstdio>
+#include <array>
+#include <vector>
+
+#include "pico/time.h"
+#include "hardware/timer.h"
+#include "host_usb.h"
+
+#include "Gamepad/Gamepad.h"
+#include "TaskQueue/Coroutine.h"
+#include "USBHost/HostDriver/SwitchPro/SwitchPro.h"
+
+#include "Check.h"
+
+// Coroutine stepped through its states on core 1's TaskQueue, with the alarm IRQ driven by the host
+// alarm stand-in: it runs to its first wait when created, a Signal resumes it inside notify(),
+// Delay and wait_for resume it from the task queue at their time and a wait_for that times out
+// returns false. Destroying it cancels its timer, a resume already on the task ring leaves the next
+// coroutine in the same frame alone, a full pool or an oversized frame gives an empty Coroutine and
+// a full timer heap resumes at once. Then SwitchProHost's init coroutine against a simulated pad:
+// the six commands go out in order, a refused send is retried, and time-to-ready is printed as
+// JSON for a pad that replies, one that doesn't, one whose sends never complete and one whose
+// silent steps are already in the init hint.
+// coroutine
+
+namespace {
+
+constexpr uint64_t STEP_US = 100;
+
+using Core = TaskQueue::Core1;
+
+//Core 1's loop: the alarm IRQ, then the tasks it queued, every STEP_US up to us
+void run_until(uint64_t us)
+{
+    do
+    {
+        host_alarm::run_until(std::min(host_time::now_us() + STEP_US, us));
+        Core::process_tasks();
+    } while (host_time::now_us() < us);
+}
+
+void run_for(uint64_t us)
+{
+    run_until(host_time::now_us() + us);
+}
+
+struct Steps
+{
+    Coroutine::Signal signal;
+    int state{0};
+    bool first_wait{true};
+    bool second_wait{false};
+};
+
+Coroutine step_through(Steps& steps)
+{
+    steps.state = 1;
+    co_await steps.signal;
+    steps.state = 2;
+    co_await Coroutine::Delay<Core>{ 10 };
+    steps.state = 3;
+    steps.first_wait = co_await steps.signal.wait_for<Core>(50);
+    steps.state = 4;
+    steps.second_wait = co_await steps.signal.wait_for<Core>(50);
+    steps.state = 5;
+}
+
+Coroutine delay_then_count(uint32_t delay_ms, int& count)
+{
+    co_await Coroutine::Delay<Core>{ delay_ms };
+    ++count;
+}
+
+Coroutine wait_forever(Coroutine::Signal& signal)
+{
+    co_await signal;
+}
+
+Coroutine oversized(int& count)
+{
+    std::array<volatile uint8_t, Coroutine::FRAME_SIZE * 2> buffer{};
+    co_await Coroutine::Delay<Core>{ 1 };
+    buffer[0] = 1;
+    count += buffer[0];
+}
+
+void check_steps()
+{
+    host_time::set_us(1000000);
+
+    Steps steps;
+    Coroutine coroutine = step_through(steps);
+    CHECK(coroutine.valid());
+    CHECK(steps.state == 1);
+    CHECK(Coroutine::frames_in_use() == 1);
+    CHECK(steps.signal.waiting());
+
+    //Resumed inside notify()
+    CHECK(steps.signal.notify());
+    CHECK(steps.state == 2);
+    CHECK(!steps.signal.notify());
+
+    //Delay
+    run_for(9900);
+    CHECK(steps.state == 2);
+    run_for(STEP_US);
+    CHECK(steps.state == 3);
+
+    //wait_for times out
+    run_for(49900);
+    CHECK(steps.state == 3);
+    run_for(STEP_US);
+    CHECK(steps.state == 4);
+    CHECK(!steps.first_wait);
+
+    //wait_for notified before its timeout, the timeout never fires after
+    run_for(20000);
+    CHECK(steps.signal.notify());
+    CHECK(steps.state == 5);
+    CHECK(steps.second_wait);
+    CHECK(coroutine.done());
+    run_for(100000);
+    CHECK(steps.state == 5);
+
+    //The frame stays with the Coroutine until it's destroyed
+    CHECK(Coroutine::frames_in_use() == 1);
+    coroutine = Coroutine();
+    CHECK(Coroutine::frames_in_use() == 0);
+}
+
+void check_destroy()
+{
+    //Destroyed while its Delay is pending, nothing resumes
+    int count = 0;
+    Coroutine coroutine = delay_then_count(5, count);
+    coroutine = Coroutine();
+    run_for(10000);
+    CHECK(count == 0);
+
+    //The resume is already on the task ring when the coroutine is destroyed and another takes its frame
+    coroutine = delay_then_count(5, count);
+    host_alarm::run_until(host_time::now_us() + 5000);
+    coroutine = delay_then_count(100, count);
+    Core::process_tasks();
+    CHECK(count == 0);
+    CHECK(!coroutine.done());
+    run_for(100000);
+    CHECK(count == 1);
+    CHECK(coroutine.done());
+    coroutine = Coroutine();
+
+    //A full pool and a frame larger than FRAME_SIZE never start
+    Coroutine::Signal signals[Coroutine::MAX_FRAMES];
+    std::vector<Coroutine> waiting;
+    for (Coroutine::Signal& signal : signals)
+    {
+        waiting.push_back(wait_forever(signal));
+        CHECK(waiting.back().valid());
+    }
+    Coroutine::Signal extra;
+    CHECK(!wait_forever(extra).valid());
+    CHECK(!extra.waiting());
+    waiting.clear();
+    CHECK(Coroutine::frames_in_use() == 0);
+
+    count = 0;
+    coroutine = oversized(count);
+    CHECK(!coroutine.valid());
+    CHECK(Coroutine::largest_frame() > Coroutine::FRAME_SIZE * 2);
+    run_for(2000);
+    CHECK(count == 0);
+
+    //No room in the timer heap, Delay and wait_for resume at once
+    std::vector<uint32_t> ids;
+    while (true)
+    {
+        ids.push_back(Core::get_new_task_id());
+        if (!Core::queue_delayed_task(ids.back(), 1000, false, [] {}))
+        {
+            break;
+        }
+    }
+    coroutine = delay_then_count(5, count);
+    CHECK(count == 1);
+    CHECK(coroutine.done());
+
+    Steps steps;
+    coroutine = step_through(steps);
+    steps.signal.notify();
+    CHECK(steps.state == 5);
+    CHECK(!steps.first_wait && !steps.second_wait);
+
+    for (uint32_t id : ids)
+    {
+        Core::cancel_delayed_task(id);
+    }
+    coroutine = Coroutine();
+}
+
+struct PadBehavior
+{
+    const char* name;
+    uint32_t sent_us;    //0 never completes
+    uint32_t reply_us;   //0 never replies
+    uint8_t silent_mask; //Steps that get no reply
+    uint8_t init_hint;
+};
+
+//The command each init step sends, sub command for the ones that have one
+const uint8_t INIT_COMMANDS[][2] =
+{
+    { SwitchPro::CMD::HID, SwitchPro::CMD::HANDSHAKE },
+    { SwitchPro::CMD::HID, SwitchPro::CMD::DISABLE_TIMEOUT },
+    { SwitchPro::CMD::AND_RUMBLE, SwitchPro::CMD::LED },
+    { SwitchPro::CMD::AND_RUMBLE, SwitchPro::CMD::LED_HOME },
+    { SwitchPro::CMD::AND_RUMBLE, SwitchPro::CMD::MODE },
+    { SwitchPro::CMD::AND_RUMBLE, SwitchPro::CMD::GYRO },
+};
+
+Gamepad gamepad;
+
+//Runs SwitchProHost's init against the pad, ready_us is the time to ready or 0 if it never got there
+void init_switch_pro(const PadBehavior& pad, uint32_t refused_sends, uint32_t& ready_us)
+{
+    constexpr uint8_t ADDRESS = 1;
+    constexpr uint8_t INSTANCE = 0;
+    constexpr uint64_t DEADLINE_US = 2000000;
+    const uint8_t REPLY[64] = { 0x21 };
+
+    SwitchProHost driver(0);
+    host_usb::refuse_host_out(refused_sends);
+    uint32_t out_count = host_usb::host_out_count();
+    uint64_t sent_at = 0;
+    uint64_t reply_at = 0;
+    size_t step = 0;
+
+    const uint64_t start_us = host_time::now_us();
+    driver.set_init_hint(pad.init_hint);
+    driver.initialize(gamepad, ADDRESS, INSTANCE, nullptr, 0);
+    CHECK_SWEEP(Coroutine::frames_in_use() == 1, "%s: frame", pad.name);
+
+    while (!driver.init_done() && host_time::now_us() - start_us < DEADLINE_US)
+    {
+        const uint64_t now = host_time::now_us();
+        if (host_usb::host_out_count() != out_count)
+        {
+            out_count = host_usb::host_out_count();
+            const host_usb::Report& out = host_usb::host_out_report();
+            const uint8_t sub_command = (out.data[0] == SwitchPro::CMD::HID) ? out.data[1] : out.data[10];
+            CHECK_SWEEP(step < std::size(INIT_COMMANDS) && out.data[0] == INIT_COMMANDS[step][0] &&
+                        sub_command == INIT_COMMANDS[step][1], "%s: step %zu sent %02X %02X", pad.name, step,
+                        out.data[0], sub_command);
+
+            sent_at = pad.sent_us ? now + pad.sent_us : 0;
+            reply_at = (pad.reply_us && !(pad.silent_mask & (1u << step))) ? now + pad.reply_us : 0;
+            ++step;
+        }
+        if (sent_at && now >= sent_at)
+        {
+            sent_at = 0;
+            driver.report_sent_cb(gamepad, ADDRESS, INSTANCE);
+        }
+        if (reply_at && now >= reply_at)
+        {
+            reply_at = 0;
+            driver.process_report(gamepad, ADDRESS, INSTANCE, REPLY, sizeof(REPLY));
+        }
+        run_for(STEP_US);
+    }
+
+    ready_us = driver.init_done() ? static_cast<uint32_t>(host_time::now_us() - start_us) : 0;
+    CHECK_SWEEP(driver.init_done(), "%s: not ready", pad.name);
+    CHECK_SWEEP(step == std::size(INIT_COMMANDS), "%s: %zu steps sent", pad.name, step);
+    CHECK_SWEEP(driver.init_hint() == (pad.reply_us ? (pad.silent_mask | pad.init_hint) : 0x3F),
+                "%s: init hint %02X", pad.name, driver.init_hint());
+}
+
+void check_switch_pro()
+{
+    const PadBehavior PADS[] =
+    {
+        { "replies",       1000, 2000, 0,    0 },
+        { "silent_2",      1000, 2000, 0x0C, 0 },
+        { "hinted_2",      1000, 2000, 0x0C, 0x0C },
+        { "no_replies",    1000, 0,    0,    0 },
+        { "never_sent",    0,    0,    0,    0 },
+    };
+
+    uint32_t ready_us[std::size(PADS)];
+    for (size_t i = 0; i < std::size(PADS); ++i)
+    {
+        init_switch_pro(PADS[i], 0, ready_us[i]);
+        CHECK_SWEEP(Coroutine::frames_in_use() == 0, "%s: frame left in use", PADS[i].name);
+    }
+
+    //Each silent step waits out REPLY_TIMEOUT_MS, unless the hint already says it won't answer
+    CHECK(ready_us[0] < 20000);
+    CHECK(ready_us[1] >= ready_us[0] + 2 * 48000);
+    CHECK(ready_us[2] <= ready_us[0]);
+    CHECK(ready_us[3] >= 6 * 50000 && ready_us[3] < 6 * 52000);
+    CHECK(ready_us[4] >= 6 * 100000 && ready_us[4] < 6 * 102000);
+
+    //A busy endpoint, the send is retried every millisecond
+    uint32_t retried_us = 0;
+    init_switch_pro(PADS[0], 3, retried_us);
+    CHECK(retried_us >= ready_us[0] + 3000 && retried_us < ready_us[0] + 4000);
+
+    std::printf("{\n  \"switch_pro_ready_us\": {");
+    for (size_t i = 0; i < std::size(PADS); ++i)
+    {
+        std::printf("\"%s\": %u, ", PADS[i].name, ready_us[i]);
+    }
+    std::printf("\"retried_3\": %u},\n", retried_us);
+    std::printf("  \"largest_frame\": %zu,\n  \"frame_size\": %zu,\n  \"frames\": %u\n}\n",
+        Coroutine::largest_frame(), Coroutine::FRAME_SIZE, static_cast<unsigned int>(Coroutine::MAX_FRAMES));
+}
+
+} // namespace
+
+int main()
+{
+    check_steps();
+    check_switch_pro();
+    check_destroy();
+
+    return check::result();
+}
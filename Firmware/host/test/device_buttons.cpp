@@ -0,0 +1,93 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+#include "pico/time.h"
+#include "host_usb.h"
+
+#include "Gamepad/Gamepad.h"
+#include "reference/ButtonsSwitchCase.h"
+
+#include "Check.h"
+
+// Every dpad value (all 16 bit combinations, not just the 8 directions) with every button mask
+// goes through the real device driver, the button and dpad fields of the report it sends have to be
+// what the old switch/if code wrote. The rest of the report is taken from the sent report, so only
+// the ButtonTable fields are compared. XInput's turbo A on LB is part of the old code and is mirrored.
+// device_buttons
+
+namespace {
+
+constexpr uint32_t DPAD_VALUES = 16;
+constexpr uint32_t BUTTON_MASKS = 0x10000;
+
+template <typename Driver, typename Report, typename Reference>
+void check_driver(const char* name, Reference reference)
+{
+    static Gamepad gamepad;
+    host_usb::reset();
+    auto driver = std::make_unique<Driver>();
+    driver->initialize();
+
+    uint64_t samples = 0;
+    uint64_t mismatches = 0;
+
+    for (uint32_t dpad = 0; dpad < DPAD_VALUES; ++dpad)
+    {
+        for (uint32_t buttons = 0; buttons < BUTTON_MASKS; ++buttons)
+        {
+            Gamepad::PadIn gp_in;
+            gp_in.dpad = static_cast<uint8_t>(dpad);
+            gp_in.buttons = static_cast<uint16_t>(buttons);
+
+            gamepad.set_pad_in(gp_in);
+            driver->process(0, gamepad);
+
+            //One report per new pad input, at least the size of the report struct
+            const host_usb::Report& sent = host_usb::in_report(0);
+            ++samples;
+            CHECK_SWEEP(sent.count == samples && sent.len == sizeof(Report),
+                "%s dpad 0x%x buttons 0x%04x: %u reports of %u bytes", name, dpad, buttons, sent.count, sent.len);
+
+            Report actual;
+            std::memcpy(&actual, sent.data.data(), sizeof(Report));
+            Report expected = actual;
+            reference(gp_in, expected);
+
+            if (std::memcmp(&actual, &expected, sizeof(Report)) != 0)
+            {
+                if (!mismatches)
+                {
+                    std::fprintf(stderr, "%s dpad 0x%x buttons 0x%04x: report differs from the old code\n", name, dpad, buttons);
+                }
+                ++mismatches;
+            }
+        }
+    }
+
+    std::fprintf(stderr, "%s: %llu samples, %llu mismatches\n", name,
+        static_cast<unsigned long long>(samples), static_cast<unsigned long long>(mismatches));
+    CHECK(samples == DPAD_VALUES * BUTTON_MASKS);
+    CHECK(mismatches == 0);
+}
+
+} // namespace
+
+int main()
+{
+    host_time::set_us(1);
+
+    uint32_t turbo_tick = 0;
+    check_driver<XInputDevice, XInput::InReport>("xinput", [&](const Gamepad::PadIn& gp_in, XInput::InReport& report)
+    {
+        buttons_switch_case::xinput(gp_in, report, turbo_tick);
+    });
+    check_driver<PS3Device, PS3::InReport>("ps3", buttons_switch_case::ps3);
+    check_driver<DInputDevice, DInput::InReport>("dinput", buttons_switch_case::dinput);
+    check_driver<SwitchDevice, SwitchWired::InReport>("switch", buttons_switch_case::switch_wired);
+    check_driver<PSClassicDevice, PSClassic::InReport>("psclassic", buttons_switch_case::psclassic);
+    check_driver<XboxOGDevice, XboxOG::GP::InReport>("xboxog_gp", buttons_switch_case::xboxog_gp);
+
+    return check::result();
+}
@@ -0,0 +1,194 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+
+#include "host_usb.h"
+
+#include "Gamepad/Gamepad.h"
+#include "USBDevice/DeviceManager.h"
+#include "bench/Bench.h"
+
+#include "Check.h"
+
+// DeviceManager's device driver dispatch: the driver lives inline in a std::variant and every call
+// switches on its index straight into the final driver class. Nothing may be called before
+// initialize_driver(), after it process() and the descriptor callbacks have to give the same result as
+// calling the driver through DeviceDriver's vtable, the way the unique_ptr<DeviceDriver> did.
+// Both paths are then timed per call, and the RAM each takes is printed: the variant against a pointer
+// plus a heap block the size of the driver. Sizes are this host's, the RP2040's pointers are 4 bytes.
+// Two JSON objects on stdout, the RAM and then the timings.
+// device_dispatch [--quick] [--filter name]
+
+namespace {
+
+struct Driver
+{
+    const char* name;
+    DeviceDriverType type;
+    size_t size;
+};
+
+const Driver DRIVERS[] =
+{
+    { "dinput",    DeviceDriverType::DINPUT,    sizeof(DInputDevice) },
+    { "ps3",       DeviceDriverType::PS3,       sizeof(PS3Device) },
+    { "psclassic", DeviceDriverType::PSCLASSIC, sizeof(PSClassicDevice) },
+    { "switch",    DeviceDriverType::SWITCH,    sizeof(SwitchDevice) },
+    { "xinput",    DeviceDriverType::XINPUT,    sizeof(XInputDevice) },
+    { "xboxog",    DeviceDriverType::XBOXOG,    sizeof(XboxOGDevice) },
+    { "xboxog_sb", DeviceDriverType::XBOXOG_SB, sizeof(XboxOGSBDevice) },
+    { "xboxog_xr", DeviceDriverType::XBOXOG_XR, sizeof(XboxOGXRDevice) },
+    { "webapp",    DeviceDriverType::WEBAPP,    sizeof(WebAppDevice) },
+    { "ps4",       DeviceDriverType::PS4,       sizeof(PS4Device) },
+};
+
+//newlib's malloc puts a size word in front of every block
+constexpr size_t HEAP_HEADER = sizeof(size_t);
+
+Gamepad gamepads[MAX_GAMEPADS];
+
+Gamepad::PadIn pad_in(uint32_t sequence)
+{
+    Gamepad::PadIn pad_in;
+    pad_in.buttons = (sequence & 1) ? Gamepad::BUTTON_A : Gamepad::BUTTON_B;
+    pad_in.joystick_lx = static_cast<int16_t>(sequence);
+    return pad_in;
+}
+
+void check_uninitialized(DeviceManager& manager)
+{
+    uint8_t buffer[64];
+    CHECK(manager.get_driver() == nullptr);
+    CHECK(manager.get_descriptor_device_cb() == nullptr);
+    CHECK(manager.get_descriptor_configuration_cb(0) == nullptr);
+    CHECK(manager.get_descriptor_string_cb(0, 0) == nullptr);
+    CHECK(manager.get_report_cb(0, 0, HID_REPORT_TYPE_INPUT, buffer, sizeof(buffer)) == 0);
+    CHECK(!manager.vendor_control_xfer_cb(0, 0, nullptr));
+
+    const uint32_t sent = host_usb::in_report_count();
+    gamepads[0].set_pad_in(pad_in(1));
+    manager.process(0, gamepads[0]);
+    manager.report_complete(0);
+    CHECK(host_usb::in_report_count() == sent);
+}
+
+//The variant and the vtable land in the same driver
+void check_same_driver(DeviceManager& manager, const Driver& driver)
+{
+    DeviceDriver* base = manager.get_driver();
+    CHECK(base != nullptr);
+    if (!base)
+    {
+        return;
+    }
+
+    CHECK_SWEEP(manager.get_descriptor_device_cb() == base->get_descriptor_device_cb(), "%s: device descriptor", driver.name);
+    CHECK_SWEEP(manager.get_descriptor_configuration_cb(0) == base->get_descriptor_configuration_cb(0), "%s: configuration descriptor", driver.name);
+    CHECK_SWEEP(manager.get_hid_descriptor_report_cb(0) == base->get_hid_descriptor_report_cb(0), "%s: report descriptor", driver.name);
+    CHECK_SWEEP(manager.get_descriptor_device_qualifier_cb() == base->get_descriptor_device_qualifier_cb(), "%s: qualifier", driver.name);
+
+    //The same input through both paths sends the same report, with another input in between so the
+    //driver sees a change every time
+    static uint32_t sequence = 100;
+    for (uint8_t idx = 0; idx < MAX_GAMEPADS; ++idx)
+    {
+        sequence += 2;
+        uint32_t count = host_usb::in_report(idx).count;
+        gamepads[idx].set_pad_in(pad_in(sequence));
+        manager.process(idx, gamepads[idx]);
+        const host_usb::Report variant_report = host_usb::in_report(idx);
+        const bool variant_sent = (variant_report.count != count);
+
+        gamepads[idx].set_pad_in(pad_in(sequence + 1));
+        manager.process(idx, gamepads[idx]);
+
+        count = host_usb::in_report(idx).count;
+        gamepads[idx].set_pad_in(pad_in(sequence));
+        base->process(idx, gamepads[idx]);
+        const host_usb::Report& virtual_report = host_usb::in_report(idx);
+        const bool virtual_sent = (virtual_report.count != count);
+
+        CHECK_SWEEP(variant_sent == virtual_sent, "%s: gamepad %u sent through one path only", driver.name, idx);
+        if (variant_sent && virtual_sent)
+        {
+            CHECK_SWEEP(virtual_report.len == variant_report.len &&
+                        std::memcmp(virtual_report.data.data(), variant_report.data.data(), variant_report.len) == 0,
+                        "%s: gamepad %u reports differ", driver.name, idx);
+        }
+    }
+}
+
+void benchmark(int argc, char** argv, DeviceManager& manager)
+{
+    bench::Runner runner(argc, argv);
+
+    manager.initialize_driver(DeviceDriverType::XINPUT, gamepads);
+    DeviceDriver* base = manager.get_driver();
+    uint32_t sequence = 0;
+
+    //One report per gamepad, each with a changed input
+    runner.run("device_dispatch/variant_process", MAX_GAMEPADS, [&]
+    {
+        ++sequence;
+        for (uint8_t idx = 0; idx < MAX_GAMEPADS; ++idx)
+        {
+            gamepads[idx].set_pad_in(pad_in(sequence));
+            manager.process(idx, gamepads[idx]);
+        }
+    });
+    runner.run("device_dispatch/virtual_process", MAX_GAMEPADS, [&]
+    {
+        ++sequence;
+        for (uint8_t idx = 0; idx < MAX_GAMEPADS; ++idx)
+        {
+            gamepads[idx].set_pad_in(pad_in(sequence));
+            base->process(idx, gamepads[idx]);
+        }
+    });
+
+    //Next to nothing behind the call, what's left is the dispatch
+    runner.run("device_dispatch/variant_descriptor", 1, [&]
+    {
+        bench::keep(manager.get_descriptor_configuration_cb(0));
+    });
+    runner.run("device_dispatch/virtual_descriptor", 1, [&]
+    {
+        bench::keep(base->get_descriptor_configuration_cb(0));
+    });
+
+    runner.print_json(std::cout);
+}
+
+void print_ram()
+{
+    size_t largest = 0;
+    std::printf("{\n  \"ram\": [\n");
+    for (const Driver& driver : DRIVERS)
+    {
+        largest = std::max(largest, driver.size);
+        std::printf("    {\"driver\": \"%s\", \"bytes\": %zu, \"unique_ptr_bytes\": %zu},\n",
+            driver.name, driver.size, sizeof(void*) + driver.size + HEAP_HEADER);
+    }
+    std::printf("    {\"driver\": \"variant\", \"bytes\": %zu, \"largest_driver\": %zu}\n  ]\n}\n",
+        sizeof(DeviceManager) - 2 * sizeof(void*), largest);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    DeviceManager& manager = DeviceManager::get_instance();
+
+    check_uninitialized(manager);
+    for (const Driver& driver : DRIVERS)
+    {
+        manager.initialize_driver(driver.type, gamepads);
+        check_same_driver(manager, driver);
+    }
+    print_ram();
+    benchmark(argc, argv, manager);
+
+    return check::result();
+}
@@ -0,0 +1,299 @@
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+
+#include "pico/time.h"
+#include "host_usb.h"
+
+#include "Gamepad/Gamepad.h"
+#include "Descriptors/PS4.h"
+#include "USBHost/HostManager.h"
+#include "Board/board_api.h"
+
+#include "Check.h"
+
+// HostManager's feedback path with a PS4 pad on a frozen host clock. The device side writes pad_out
+// the way DeviceManager does (stamp, write, ring core1) and core1's loop runs feedback_task() every
+// pass. A write goes out on the next pass, writes closer together than the driver's feedback interval
+// are held and only the last one is sent when it runs out, an unchanged write is dropped, partial
+// rumble is cleared RUMBLE_HOLD_MS after the device side last wrote it while max rumble stays on, and
+// an OUT report the endpoint refuses is retried after the interval.
+// Then the same random write schedule runs through the doorbell and through the 200 ms feedback task
+// it replaced, pad_out write to OUT report latency for both is printed as JSON.
+// feedback_rumble
+
+namespace {
+
+constexpr uint8_t ADDRESS = 1;
+constexpr uint8_t INSTANCE = 0;
+constexpr HardwareID PS4_ID = { 0x054C, 0x09CC };
+constexpr uint32_t LOOP_US = 50;                //One pass of the core1 loop
+constexpr uint32_t INTERVAL_US = 8 * 1000;      //HostDriver::FEEDBACK_INTERVAL_MS
+constexpr uint32_t HOLD_US = 200 * 1000;        //HostManager::RUMBLE_HOLD_MS
+constexpr uint32_t TIMER_US = 200 * 1000;       //FEEDBACK_DELAY_MS of the old periodic feedback task
+
+Gamepad gamepads[MAX_GAMEPADS];
+
+struct OutReport
+{
+    uint32_t time_us;
+    uint8_t motor_l;
+    uint8_t motor_r;
+};
+
+std::vector<OutReport> out_reports;
+uint32_t out_count = 0;
+
+uint32_t now_us()
+{
+    return board_api::us_since_boot();
+}
+
+//What DeviceManager::process() does around a device driver writing pad_out
+void device_write(Gamepad& gamepad, uint8_t rumble_l, uint8_t rumble_r)
+{
+    Gamepad::PadOut pad_out;
+    pad_out.rumble_l = rumble_l;
+    pad_out.rumble_r = rumble_r;
+    gamepad.set_pad_out_time(now_us());
+    gamepad.set_pad_out(pad_out);
+    board_api::core1::notify();
+}
+
+void collect()
+{
+    if (host_usb::host_out_count() != out_count)
+    {
+        out_count = host_usb::host_out_count();
+        const PS4::OutReport& report = *reinterpret_cast<const PS4::OutReport*>(host_usb::host_out_report().data.data());
+        out_reports.push_back({ now_us(), report.motor_left, report.motor_right });
+    }
+}
+
+//Core1's loop for duration_us
+void run(HostManager& manager, uint32_t duration_us)
+{
+    const uint32_t end_us = now_us() + duration_us;
+    while (static_cast<int32_t>(now_us() - end_us) < 0)
+    {
+        manager.feedback_task();
+        collect();
+        host_time::advance_us(LOOP_US);
+    }
+}
+
+bool mount(HostManager& manager)
+{
+    host_usb::set_vid_pid(ADDRESS, PS4_ID.vid, PS4_ID.pid);
+    const bool mounted = manager.setup_driver(HostManager::get_type(PS4_ID), ADDRESS, INSTANCE);
+    out_count = host_usb::host_out_count();
+    out_reports.clear();
+    return mounted;
+}
+
+void unmount(HostManager& manager)
+{
+    manager.deinit_driver(HostManager::DriverClass::HID, ADDRESS, INSTANCE);
+}
+
+void check_rate_limit(HostManager& manager, Gamepad& gamepad)
+{
+    CHECK(mount(manager));
+
+    //Sent on the pass after the write
+    const uint32_t first_us = now_us();
+    device_write(gamepad, 0xFF, 0xFF);
+    run(manager, LOOP_US);
+    CHECK(out_reports.size() == 1);
+    CHECK(out_reports.size() == 1 && out_reports[0].time_us == first_us && out_reports[0].motor_l == 0xFF);
+
+    //Three more writes inside the interval, only the last goes out once it has passed
+    run(manager, 1000);
+    device_write(gamepad, 0xFF, 0x00);
+    run(manager, 1000);
+    device_write(gamepad, 0x00, 0xFF);
+    run(manager, 1000);
+    device_write(gamepad, 0x00, 0x00);
+    run(manager, INTERVAL_US);
+    CHECK(out_reports.size() == 2);
+    if (out_reports.size() == 2)
+    {
+        CHECK(out_reports[1].time_us == first_us + INTERVAL_US);
+        CHECK(out_reports[1].motor_l == 0x00 && out_reports[1].motor_r == 0x00);
+    }
+
+    //Nothing pending, nothing more
+    run(manager, HOLD_US * 2);
+    CHECK(out_reports.size() == 2);
+
+    //The same pad_out again doesn't change what the pad is doing
+    device_write(gamepad, 0x00, 0x00);
+    run(manager, INTERVAL_US * 2);
+    CHECK(out_reports.size() == 2);
+
+    //Refused by a busy endpoint, retried after the interval
+    host_usb::refuse_host_out(1);
+    const uint32_t refused_us = now_us();
+    device_write(gamepad, 0x40, 0xFF);
+    run(manager, INTERVAL_US + LOOP_US);
+    CHECK(out_reports.size() == 3);
+    CHECK(out_reports.size() == 3 && out_reports[2].time_us == refused_us + INTERVAL_US && out_reports[2].motor_l == 0x40);
+
+    unmount(manager);
+}
+
+void check_rumble_hold(HostManager& manager, Gamepad& gamepad)
+{
+    CHECK(mount(manager));
+
+    //Partial rumble is cleared once the hold runs out
+    const uint32_t start_us = now_us();
+    device_write(gamepad, 0x80, 0x00);
+    run(manager, HOLD_US + INTERVAL_US);
+    CHECK(out_reports.size() == 2);
+    if (out_reports.size() == 2)
+    {
+        CHECK(out_reports[0].time_us == start_us && out_reports[0].motor_l == 0x80);
+        CHECK(out_reports[1].time_us == start_us + HOLD_US && out_reports[1].motor_l == 0x00);
+    }
+
+    //Cleared is what the pad is doing now, zero from the device side is dropped
+    device_write(gamepad, 0x00, 0x00);
+    run(manager, INTERVAL_US * 2);
+    CHECK(out_reports.size() == 2);
+
+    //The device side keeping partial rumble going resends it even unchanged and restarts the hold
+    out_reports.clear();
+    const uint32_t again_us = now_us();
+    device_write(gamepad, 0x80, 0x00);
+    run(manager, HOLD_US / 2);
+    device_write(gamepad, 0x80, 0x00);
+    const uint32_t rewrite_us = now_us();
+    run(manager, HOLD_US + INTERVAL_US);
+    CHECK(out_reports.size() == 3);
+    if (out_reports.size() == 3)
+    {
+        CHECK(out_reports[0].time_us == again_us && out_reports[0].motor_l == 0x80);
+        CHECK(out_reports[1].time_us == rewrite_us && out_reports[1].motor_l == 0x80);
+        CHECK(out_reports[2].time_us == rewrite_us + HOLD_US && out_reports[2].motor_l == 0x00);
+    }
+
+    //Max rumble has nothing to clear, it stays on until the device side changes it
+    out_reports.clear();
+    device_write(gamepad, 0xFF, 0xFF);
+    run(manager, HOLD_US * 2);
+    CHECK(out_reports.size() == 1);
+    CHECK(out_reports.size() == 1 && out_reports[0].motor_l == 0xFF && out_reports[0].motor_r == 0xFF);
+
+    unmount(manager);
+}
+
+struct Latency
+{
+    uint32_t writes{0};
+    uint32_t sent{0};
+    uint64_t sum_us{0};
+    uint32_t max_us{0};
+};
+
+constexpr uint32_t WRITES = 2000;
+uint32_t lcg_state = 2020;
+
+uint32_t lcg()
+{
+    lcg_state = lcg_state * 1664525u + 1013904223u;
+    return lcg_state >> 8;
+}
+
+//Max rumble on and off at random gaps, 10 to 500 ms apart, so nothing is held for RUMBLE_HOLD_MS.
+//With the doorbell core1 runs feedback_task() every loop pass, with the timer send_feedback() runs
+//every TIMER_US and writes in between wait for it or are overwritten.
+Latency measure(HostManager& manager, Gamepad& gamepad, bool doorbell)
+{
+    lcg_state = 2020;
+    Latency latency;
+    CHECK(mount(manager));
+
+    uint32_t next_timer_us = now_us() + TIMER_US;
+    uint32_t next_write_us = now_us() + 1000;
+    uint32_t pending_write_us = 0;
+    bool on = false;
+
+    //The last write gets one more gap to go out in
+    while (latency.writes < WRITES || static_cast<int32_t>(now_us() - next_write_us) < 0)
+    {
+        if (doorbell)
+        {
+            manager.feedback_task();
+        }
+        else if (static_cast<int32_t>(now_us() - next_timer_us) >= 0)
+        {
+            (void)board_api::core1::notified();
+            manager.send_feedback();
+            next_timer_us += TIMER_US;
+        }
+
+        const uint32_t before = out_count;
+        collect();
+        if (out_count != before && pending_write_us)
+        {
+            const uint32_t latency_us = now_us() - pending_write_us;
+            ++latency.sent;
+            latency.sum_us += latency_us;
+            latency.max_us = std::max(latency.max_us, latency_us);
+            pending_write_us = 0;
+        }
+
+        //Core0 writes while core1 is busy elsewhere in its loop
+        if (latency.writes < WRITES && static_cast<int32_t>(now_us() - next_write_us) >= 0)
+        {
+            on = !on;
+            device_write(gamepad, on ? 0xFF : 0x00, on ? 0xFF : 0x00);
+            ++latency.writes;
+            pending_write_us = now_us();
+            next_write_us = now_us() + 10000 + (lcg() % 490) * 1000;
+        }
+        host_time::advance_us(LOOP_US);
+    }
+
+    unmount(manager);
+    return latency;
+}
+
+void print_latency(const char* name, const Latency& latency, const char* end)
+{
+    std::printf("    \"%s\": {\"writes\": %u, \"sent\": %u, \"avg_us\": %llu, \"max_us\": %u}%s\n",
+        name, latency.writes, latency.sent,
+        static_cast<unsigned long long>(latency.sent ? latency.sum_us / latency.sent : 0), latency.max_us, end);
+}
+
+} // namespace
+
+int main()
+{
+    HostManager& manager = HostManager::get_instance();
+    manager.initialize(gamepads);
+    host_time::set_us(1000000);
+
+    //Mount lands on gamepad 0, the lowest free one
+    Gamepad& gamepad = gamepads[0];
+    check_rate_limit(manager, gamepad);
+    check_rumble_hold(manager, gamepad);
+
+    const Latency doorbell = measure(manager, gamepad, true);
+    const Latency timer = measure(manager, gamepad, false);
+
+    //Every write goes out on the next pass, writes further apart than the interval never wait on it
+    CHECK(doorbell.sent == doorbell.writes);
+    CHECK(doorbell.max_us == LOOP_US);
+    CHECK(timer.sent < timer.writes);
+    CHECK(timer.max_us > TIMER_US / 2);
+
+    std::printf("{\n  \"pad_out_to_out_report\": {\n");
+    print_latency("doorbell", doorbell, ",");
+    print_latency("timer_200ms", timer, "");
+    std::printf("  }\n}\n");
+
+    return check::result();
+}
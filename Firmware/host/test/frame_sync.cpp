@@ -0,0 +1,146 @@
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "pico/time.h"
+#include "hardware/timer.h"
+#include "pio_usb.h"
+
+#include "USBHost/FrameSync.h"
+
+#include "Check.h"
+
+// FrameSync built with CONFIG_EN_SOF_ALIGN, its alarm driven by the host alarm stand-in: with no console
+// SOF the host frames run free every 1 ms like Pico-PIO-USB's own timer. Once SOFs arrive the frames
+// move at most SLEW_US per frame until they start LEAD_US before the console's next SOF and report
+// locked, and they fall back to free running when the SOFs stop. A frame that runs long skips the
+// slots it overran. SOF interval spread and report phase buckets are checked on the way.
+// frame_sync
+
+namespace {
+
+constexpr uint64_t START_US = 1000000;
+constexpr int32_t FRAME = static_cast<int32_t>(FrameSync::FRAME_US);
+constexpr int32_t TARGET_PHASE_US = static_cast<int32_t>(FrameSync::FRAME_US - FrameSync::LEAD_US);
+//Console SOFs land here within each 1 ms of the host clock, far from where host frames start
+constexpr uint32_t SOF_OFFSET_US = 370;
+
+std::vector<uint64_t> frames;
+uint32_t overrun_us = 0;
+
+//Where a host frame starting at frame_us sits after the console SOF at sof_us, 0 to FRAME_US - 1
+int32_t phase_of(uint64_t frame_us, uint64_t sof_us)
+{
+    int32_t phase_us = static_cast<int32_t>((frame_us - sof_us) % FrameSync::FRAME_US);
+    return (phase_us < 0) ? phase_us + FRAME : phase_us;
+}
+
+void check_free_running(size_t first, size_t count, const char* name)
+{
+    CHECK(frames.size() >= first + count);
+    for (size_t i = first + 1; i < first + count && i < frames.size(); ++i)
+    {
+        CHECK_SWEEP(frames[i] - frames[i - 1] == FrameSync::FRAME_US, "%s: frame %zu after %llu us", name, i,
+                    static_cast<unsigned long long>(frames[i] - frames[i - 1]));
+    }
+}
+
+void check_frames()
+{
+    host_time::set_us(START_US);
+    FrameSync::start_host_frames();
+
+    //No console, free running from the first frame on
+    host_alarm::run_until(START_US + 10 * FrameSync::FRAME_US);
+    CHECK(frames.size() == 10);
+    CHECK(!frames.empty() && frames[0] == START_US + FrameSync::FRAME_US);
+    check_free_running(0, frames.size(), "no console");
+    CHECK(FrameSync::get_stats().aligned == 1);
+    CHECK(FrameSync::get_stats().locked == 0);
+    CHECK(FrameSync::get_stats().sof_count == 0);
+
+    //Console SOFs every 1 ms, one of every pair 1 us late
+    const size_t first_synced = frames.size();
+    uint64_t sof_us = START_US + 10 * FrameSync::FRAME_US + SOF_OFFSET_US;
+    constexpr uint32_t SOF_FRAMES = 100;
+    for (uint32_t i = 0; i < SOF_FRAMES; ++i, sof_us += FrameSync::FRAME_US)
+    {
+        const uint64_t jittered_us = sof_us + (i & 1);
+        host_alarm::run_until(jittered_us);
+        FrameSync::device_sof(0, i);
+    }
+    const uint64_t last_sof_us = sof_us - FrameSync::FRAME_US + ((SOF_FRAMES - 1) & 1);
+
+    //Each frame moves by SLEW_US at most, then holds LEAD_US ahead of the console's SOF
+    for (size_t i = first_synced + 1; i < frames.size(); ++i)
+    {
+        const int64_t interval_us = static_cast<int64_t>(frames[i] - frames[i - 1]);
+        CHECK_SWEEP(interval_us >= FRAME - static_cast<int32_t>(FrameSync::SLEW_US) &&
+                    interval_us <= FRAME + static_cast<int32_t>(FrameSync::SLEW_US),
+                    "frame %zu after %lld us", i, static_cast<long long>(interval_us));
+    }
+    //Half a frame off at most takes (FRAME_US / 2) / SLEW_US frames, the last 50 have to be on target
+    for (size_t i = frames.size() - 50; i < frames.size(); ++i)
+    {
+        const int32_t phase_us = phase_of(frames[i], START_US + SOF_OFFSET_US);
+        CHECK_SWEEP(phase_us >= TARGET_PHASE_US - 1 && phase_us <= TARGET_PHASE_US + 1,
+                    "frame %zu %d us after the SOF, wanted %d", i, phase_us, TARGET_PHASE_US);
+    }
+
+    FrameSync::Stats stats = FrameSync::get_stats();
+    CHECK(stats.locked == 1);
+    CHECK(stats.sof_count == SOF_FRAMES);
+    CHECK(stats.sof_interval_min_us == FrameSync::FRAME_US - 1);
+    CHECK(stats.sof_interval_max_us == FrameSync::FRAME_US + 1);
+    CHECK(stats.lead_us == FrameSync::LEAD_US);
+
+    //Reports bucketed by time since the last SOF
+    host_time::set_us(last_sof_us + 10);
+    FrameSync::host_report();
+    host_time::set_us(last_sof_us + FrameSync::FRAME_US - 10);
+    FrameSync::host_report();
+    stats = FrameSync::get_stats();
+    CHECK(stats.phase_buckets[0] == 1);
+    CHECK(stats.phase_buckets[FrameSync::PHASE_BUCKETS - 1] == 1);
+
+    //Console gone: free running again once the last SOF is older than the timeout
+    const size_t first_lost = frames.size();
+    host_alarm::run_until(last_sof_us + 20 * FrameSync::FRAME_US);
+    CHECK(FrameSync::get_stats().locked == 0);
+    check_free_running(first_lost + 5, frames.size() - first_lost - 5, "console gone");
+
+    //Reports without a console aren't counted
+    FrameSync::host_report();
+    CHECK(FrameSync::get_stats().phase_buckets[0] + FrameSync::get_stats().phase_buckets[FrameSync::PHASE_BUCKETS - 1] == 2);
+
+    //One frame overruns by 1.5 frames, the slot it ran into is skipped and the grid is kept
+    const size_t overrun_frame = frames.size();
+    overrun_us = FrameSync::FRAME_US + FrameSync::FRAME_US / 2;
+    host_alarm::run_until(host_time::now_us() + 10 * FrameSync::FRAME_US);
+    CHECK(frames.size() > overrun_frame + 2);
+    if (frames.size() > overrun_frame + 2)
+    {
+        CHECK(frames[overrun_frame + 1] - frames[overrun_frame] == 2 * FrameSync::FRAME_US);
+        check_free_running(overrun_frame + 1, frames.size() - overrun_frame - 1, "after overrun");
+    }
+}
+
+} // namespace
+
+//The host frame FrameSync's alarm starts
+extern "C" void pio_usb_host_frame(void)
+{
+    frames.push_back(time_us_64());
+    if (overrun_us)
+    {
+        host_time::advance_us(overrun_us);
+        overrun_us = 0;
+    }
+}
+
+int main()
+{
+    check_frames();
+
+    return check::result();
+}
@@ -0,0 +1,273 @@
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+
+#include "USBHost/HardwareIDs.h"
+#include "reference/HardwareIDsLinear.h"
+#include "bench/Bench.h"
+
+#include "Check.h"
+
+// find_hardware_id() against the old per driver list scan: the table has to be sorted and hold every
+// listed entry, and both lookups have to give the same driver type for every listed ID, their
+// neighbours and random IDs. The same comparison runs over a few thousand synthetic IDs split into
+// driver lists, then cycles per lookup for both, hits and misses, JSON on stdout.
+// hardware_ids [--quick] [--filter name]
+
+namespace {
+
+constexpr size_t SYNTHETIC_IDS = 4096;
+constexpr size_t SYNTHETIC_LISTS = sizeof(HOST_TYPE_MAP) / sizeof(HOST_TYPE_MAP[0]);
+constexpr size_t LOOKUPS = 1024;
+
+uint32_t xorshift(uint32_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+HardwareID random_id(uint32_t& state)
+{
+    const uint32_t value = xorshift(state);
+    return { static_cast<uint16_t>(value >> 16), static_cast<uint16_t>(value) };
+}
+
+//Sorted table, per driver lists like HOST_TYPE_MAP and IDs that are or aren't in them
+struct Synthetic
+{
+    std::vector<HardwareIDEntry> table;
+    std::vector<std::vector<HardwareIDEntry>> lists;
+    std::vector<HostTypeMap> maps;
+    std::vector<HardwareID> hits;
+    std::vector<HardwareID> misses;
+};
+
+Synthetic make_synthetic()
+{
+    Synthetic syn;
+    uint32_t state = 0x0BADF00D;
+
+    while (syn.table.size() < SYNTHETIC_IDS)
+    {
+        HardwareIDEntry entry{ random_id(state), HOST_TYPE_MAP[syn.table.size() % SYNTHETIC_LISTS].type };
+        const bool listed = std::any_of(syn.table.begin(), syn.table.end(),
+            [&](const HardwareIDEntry& e) { return HardwareIDs::key(e.id) == HardwareIDs::key(entry.id); });
+        if (!listed)
+        {
+            syn.table.push_back(entry);
+        }
+    }
+
+    syn.lists.resize(SYNTHETIC_LISTS);
+    for (size_t i = 0; i < syn.table.size(); ++i)
+    {
+        syn.lists[i % SYNTHETIC_LISTS].push_back(syn.table[i]);
+    }
+    for (size_t i = 0; i < SYNTHETIC_LISTS; ++i)
+    {
+        syn.maps.push_back({ syn.lists[i].data(), syn.lists[i].size(), HOST_TYPE_MAP[i].type });
+    }
+
+    std::sort(syn.table.begin(), syn.table.end(),
+        [](const HardwareIDEntry& a, const HardwareIDEntry& b) { return HardwareIDs::key(a.id) < HardwareIDs::key(b.id); });
+
+    while (syn.hits.size() < LOOKUPS)
+    {
+        syn.hits.push_back(syn.table[xorshift(state) % syn.table.size()].id);
+    }
+    while (syn.misses.size() < LOOKUPS)
+    {
+        const HardwareID id = random_id(state);
+        if (!HardwareIDs::find(syn.table.data(), syn.table.size(), id))
+        {
+            syn.misses.push_back(id);
+        }
+    }
+    return syn;
+}
+
+HostDriverType table_type(const HardwareIDEntry* table, size_t count, const HardwareID& id)
+{
+    const HardwareIDEntry* entry = HardwareIDs::find(table, count, id);
+    return entry ? entry->type : HostDriverType::UNKNOWN;
+}
+
+void check_table()
+{
+    size_t listed = 0;
+    for (const HostTypeMap& map : HOST_TYPE_MAP)
+    {
+        listed += map.num_ids;
+    }
+    CHECK(HARDWARE_ID_TABLE.size() == listed);
+
+    for (size_t i = 1; i < HARDWARE_ID_TABLE.size(); ++i)
+    {
+        CHECK(HardwareIDs::key(HARDWARE_ID_TABLE[i - 1].id) < HardwareIDs::key(HARDWARE_ID_TABLE[i].id));
+    }
+
+    //Every entry is found with what it was listed with, in the list for its driver type
+    for (const HostTypeMap& map : HOST_TYPE_MAP)
+    {
+        for (size_t i = 0; i < map.num_ids; ++i)
+        {
+            const HardwareIDEntry& listed_entry = map.ids[i];
+            const HardwareIDEntry* entry = find_hardware_id(listed_entry.id);
+            CHECK(entry != nullptr);
+            if (!entry)
+            {
+                continue;
+            }
+            CHECK(HardwareIDs::key(entry->id) == HardwareIDs::key(listed_entry.id));
+            CHECK(entry->type == map.type && listed_entry.type == map.type);
+            CHECK(entry->quirks == listed_entry.quirks);
+            CHECK(entry->poll_interval_ms == listed_entry.poll_interval_ms);
+            //A poll interval quirk without an interval would keep the device's bInterval
+            CHECK(!(entry->quirks & HardwareQuirk::POLL_INTERVAL) || entry->poll_interval_ms != 0);
+        }
+    }
+
+    CHECK(HardwareIDs::find(HARDWARE_ID_TABLE.data(), 0, HARDWARE_ID_TABLE[0].id) == nullptr);
+}
+
+void check_against_linear()
+{
+    std::vector<HardwareID> ids = { { 0x0000, 0x0000 }, { 0xFFFF, 0xFFFF }, { 0x0000, 0xFFFF }, { 0xFFFF, 0x0000 } };
+
+    //Listed IDs, one off in either half and swapped, misses that sort right next to hits
+    for (const HardwareIDEntry& entry : HARDWARE_ID_TABLE)
+    {
+        const uint16_t vid = entry.id.vid;
+        const uint16_t pid = entry.id.pid;
+        ids.push_back({ vid, pid });
+        ids.push_back({ vid, static_cast<uint16_t>(pid + 1) });
+        ids.push_back({ vid, static_cast<uint16_t>(pid - 1) });
+        ids.push_back({ static_cast<uint16_t>(vid + 1), pid });
+        ids.push_back({ static_cast<uint16_t>(vid - 1), pid });
+        ids.push_back({ pid, vid });
+    }
+
+    //Random PIDs on listed VIDs and random everything
+    uint32_t state = 0x13579BDF;
+    for (int i = 0; i < 100000; ++i)
+    {
+        const HardwareIDEntry& entry = HARDWARE_ID_TABLE[xorshift(state) % HARDWARE_ID_TABLE.size()];
+        ids.push_back({ entry.id.vid, static_cast<uint16_t>(xorshift(state)) });
+        ids.push_back(random_id(state));
+    }
+
+    uint64_t mismatches = 0;
+    for (const HardwareID& id : ids)
+    {
+        const HostDriverType expected = get_type_linear(HOST_TYPE_MAP, SYNTHETIC_LISTS, id);
+        const HostDriverType actual = table_type(HARDWARE_ID_TABLE.data(), HARDWARE_ID_TABLE.size(), id);
+        if (expected != actual)
+        {
+            if (!mismatches)
+            {
+                std::fprintf(stderr, "%04x:%04x: linear %d table %d\n", id.vid, id.pid, static_cast<int>(expected), static_cast<int>(actual));
+            }
+            ++mismatches;
+        }
+    }
+
+    std::fprintf(stderr, "hardware ids: %zu lookups, %llu mismatches\n", ids.size(), static_cast<unsigned long long>(mismatches));
+    CHECK(mismatches == 0);
+}
+
+void check_synthetic(const Synthetic& syn)
+{
+    uint64_t mismatches = 0;
+    for (const auto* list : { &syn.hits, &syn.misses })
+    {
+        for (const HardwareID& id : *list)
+        {
+            const HostDriverType expected = get_type_linear(syn.maps.data(), syn.maps.size(), id);
+            mismatches += (expected != table_type(syn.table.data(), syn.table.size(), id)) ? 1 : 0;
+            CHECK((expected == HostDriverType::UNKNOWN) == (list == &syn.misses));
+        }
+    }
+
+    std::fprintf(stderr, "synthetic %zu ids: %zu lookups, %llu mismatches\n", syn.table.size(),
+        syn.hits.size() + syn.misses.size(), static_cast<unsigned long long>(mismatches));
+    CHECK(mismatches == 0);
+}
+
+void benchmark(int argc, char** argv, const Synthetic& syn)
+{
+    bench::Runner runner(argc, argv);
+
+    std::vector<HardwareID> table_hits;
+    std::vector<HardwareID> table_misses;
+    uint32_t state = 0x2468ACE0;
+    while (table_hits.size() < LOOKUPS)
+    {
+        table_hits.push_back(HARDWARE_ID_TABLE[xorshift(state) % HARDWARE_ID_TABLE.size()].id);
+    }
+    while (table_misses.size() < LOOKUPS)
+    {
+        const HardwareID id = random_id(state);
+        if (!find_hardware_id(id))
+        {
+            table_misses.push_back(id);
+        }
+    }
+
+    size_t i = 0;
+    auto next = [&](const std::vector<HardwareID>& ids) -> const HardwareID& { return ids[i++ % LOOKUPS]; };
+
+    runner.run("hardware_ids/table/linear_hit", 1, [&]
+    {
+        bench::keep(get_type_linear(HOST_TYPE_MAP, SYNTHETIC_LISTS, next(table_hits)));
+    });
+    runner.run("hardware_ids/table/sorted_hit", 1, [&]
+    {
+        bench::keep(table_type(HARDWARE_ID_TABLE.data(), HARDWARE_ID_TABLE.size(), next(table_hits)));
+    });
+    runner.run("hardware_ids/table/linear_miss", 1, [&]
+    {
+        bench::keep(get_type_linear(HOST_TYPE_MAP, SYNTHETIC_LISTS, next(table_misses)));
+    });
+    runner.run("hardware_ids/table/sorted_miss", 1, [&]
+    {
+        bench::keep(table_type(HARDWARE_ID_TABLE.data(), HARDWARE_ID_TABLE.size(), next(table_misses)));
+    });
+
+    runner.run("hardware_ids/synthetic/linear_hit", 1, [&]
+    {
+        bench::keep(get_type_linear(syn.maps.data(), syn.maps.size(), next(syn.hits)));
+    });
+    runner.run("hardware_ids/synthetic/sorted_hit", 1, [&]
+    {
+        bench::keep(table_type(syn.table.data(), syn.table.size(), next(syn.hits)));
+    });
+    runner.run("hardware_ids/synthetic/linear_miss", 1, [&]
+    {
+        bench::keep(get_type_linear(syn.maps.data(), syn.maps.size(), next(syn.misses)));
+    });
+    runner.run("hardware_ids/synthetic/sorted_miss", 1, [&]
+    {
+        bench::keep(table_type(syn.table.data(), syn.table.size(), next(syn.misses)));
+    });
+
+    runner.print_json(std::cout);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    check_table();
+    check_against_linear();
+
+    const Synthetic syn = make_synthetic();
+    check_synthetic(syn);
+
+    benchmark(argc, argv, syn);
+
+    return check::result();
+}
@@ -0,0 +1,325 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "USBHost/HIDParser/HIDUtils.h"
+#include "USBHost/HIDParser/HIDFieldProgram.h"
+#include "reference/HIDBitsBitwise.h"
+#include "bench/Bench.h"
+
+#include "Check.h"
+
+// HIDUtils::readBitsLE() and readFieldsLE() against the old bit at a time reader.
+// Every offset in a 16 byte buffer with every length up to 32, lengths past 32 clamp to 32.
+// Buffers end right before a PROT_NONE page, so reading one byte too far faults:
+// readBitsLE() may only touch the bytes a field covers, readFieldsLE() only the first bufferLength
+// bytes, with fields crossing the end reading the missing bits as 0.
+// Then cycles per field for both readers over a typical gamepad report, JSON on stdout.
+// hid_bits [--quick]
+
+namespace {
+
+constexpr uint32_t BUF_LEN = 16;
+constexpr uint32_t BUF_BITS = BUF_LEN * 8;
+
+using Field = HIDFieldProgram::Field;
+
+uint32_t xorshift(uint32_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+std::vector<std::vector<uint8_t>> patterns()
+{
+    std::vector<std::vector<uint8_t>> list;
+    list.emplace_back(BUF_LEN, 0x00);
+    list.emplace_back(BUF_LEN, 0xFF);
+    list.emplace_back(BUF_LEN, 0xAA);
+    list.emplace_back(BUF_LEN, 0x55);
+
+    std::vector<uint8_t> ramp(BUF_LEN);
+    for (uint32_t i = 0; i < BUF_LEN; ++i)
+    {
+        ramp[i] = static_cast<uint8_t>(i * 17 + 1);
+    }
+    list.push_back(ramp);
+
+    uint32_t state = 0x2545F491;
+    for (int p = 0; p < 27; ++p)
+    {
+        std::vector<uint8_t> random(BUF_LEN);
+        for (auto& byte : random)
+        {
+            byte = static_cast<uint8_t>(xorshift(state));
+        }
+        list.push_back(random);
+    }
+    return list;
+}
+
+//Two pages, the second one unreadable, buffers are placed to end at guard()
+class GuardedBuffer
+{
+public:
+    GuardedBuffer()
+    {
+        page_ = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        base_ = static_cast<uint8_t*>(mmap(nullptr, page_ * 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        CHECK(base_ != MAP_FAILED);
+        CHECK(mprotect(base_ + page_, page_, PROT_NONE) == 0);
+    }
+
+    ~GuardedBuffer()
+    {
+        munmap(base_, page_ * 2);
+    }
+
+    //The first len bytes of data, ending right before the unreadable page
+    const uint8_t* place(const uint8_t* data, uint32_t len)
+    {
+        uint8_t* dst = base_ + page_ - len;
+        std::memcpy(dst, data, len);
+        return dst;
+    }
+
+private:
+    size_t page_;
+    uint8_t* base_;
+};
+
+//What readFieldsLE() should return, bits at or past buffer_len read as 0
+uint32_t expected_field(const std::vector<uint8_t>& pattern, uint32_t buffer_len, uint32_t bit_offset, uint32_t bit_length)
+{
+    std::vector<uint8_t> padded(std::max(BUF_LEN, (bit_offset + 32 + 7) / 8), 0);
+    std::memcpy(padded.data(), pattern.data(), buffer_len);
+    return read_bits_le_bitwise(padded.data(), bit_offset, std::min<uint32_t>(bit_length, 32));
+}
+
+void check_read_bits(GuardedBuffer& guarded)
+{
+    uint64_t samples = 0;
+    uint64_t mismatches = 0;
+
+    for (const auto& pattern : patterns())
+    {
+        for (uint32_t offset = 0; offset < BUF_BITS; ++offset)
+        {
+            for (uint32_t len = 1; len <= 32 && offset + len <= BUF_BITS; ++len)
+            {
+                //Only the bytes the field covers are readable
+                const uint32_t end_byte = (offset + len + 7) / 8;
+                const uint8_t* buffer = guarded.place(pattern.data(), end_byte);
+
+                const uint32_t expected = read_bits_le_bitwise(pattern.data(), offset, len);
+                const uint32_t actual = HIDUtils::readBitsLE(buffer, offset, len);
+                ++samples;
+                if (expected != actual)
+                {
+                    if (!mismatches)
+                    {
+                        std::fprintf(stderr, "readBitsLE offset %u len %u: expected 0x%08x got 0x%08x\n", offset, len, expected, actual);
+                    }
+                    ++mismatches;
+                }
+            }
+        }
+
+        //Lengths past 32 read 32 bits
+        for (uint32_t offset = 0; offset + 32 <= BUF_BITS; ++offset)
+        {
+            for (uint32_t len : { 33u, 40u, 64u, 255u })
+            {
+                const uint32_t expected = read_bits_le_bitwise(pattern.data(), offset, 32);
+                const uint32_t actual = HIDUtils::readBitsLE(guarded.place(pattern.data(), (offset + 32 + 7) / 8), offset, len);
+                ++samples;
+                mismatches += (expected != actual) ? 1 : 0;
+            }
+        }
+    }
+
+    std::fprintf(stderr, "readBitsLE: %llu samples, %llu mismatches\n",
+        static_cast<unsigned long long>(samples), static_cast<unsigned long long>(mismatches));
+    CHECK(mismatches == 0);
+}
+
+void check_read_fields_single(GuardedBuffer& guarded)
+{
+    uint64_t samples = 0;
+    uint64_t mismatches = 0;
+
+    for (const auto& pattern : patterns())
+    {
+        //Every buffer length, so fields start before, cross and start past the end
+        for (uint32_t buffer_len = 0; buffer_len <= BUF_LEN; ++buffer_len)
+        {
+            const uint8_t* buffer = guarded.place(pattern.data(), buffer_len);
+
+            for (uint32_t offset = 0; offset < BUF_BITS + 40; ++offset)
+            {
+                for (uint32_t len : { 0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 9u, 10u, 11u, 12u, 13u, 14u, 15u, 16u,
+                                      17u, 18u, 19u, 20u, 21u, 22u, 23u, 24u, 25u, 26u, 27u, 28u, 29u, 30u, 31u, 32u, 33u, 255u })
+                {
+                    Field field{};
+                    field.bit_offset = static_cast<uint16_t>(offset);
+                    field.bit_size = static_cast<uint8_t>(len);
+
+                    uint32_t value = 0xDEADBEEF;
+                    HIDUtils::readFieldsLE(buffer, buffer_len, &field, 1, &value);
+
+                    const uint32_t expected = len ? expected_field(pattern, buffer_len, offset, len) : 0;
+                    ++samples;
+                    if (expected != value)
+                    {
+                        if (!mismatches)
+                        {
+                            std::fprintf(stderr, "readFieldsLE buffer_len %u offset %u len %u: expected 0x%08x got 0x%08x\n",
+                                buffer_len, offset, len, expected, value);
+                        }
+                        ++mismatches;
+                    }
+                }
+            }
+        }
+    }
+
+    std::fprintf(stderr, "readFieldsLE single: %llu samples, %llu mismatches\n",
+        static_cast<unsigned long long>(samples), static_cast<unsigned long long>(mismatches));
+    CHECK(mismatches == 0);
+}
+
+//Field lists like HIDFieldProgram::compile() builds (ascending offsets) and unsorted or overlapping ones
+void check_read_fields_lists(GuardedBuffer& guarded)
+{
+    uint64_t samples = 0;
+    uint64_t mismatches = 0;
+    uint32_t state = 0x9E3779B9;
+    const auto list = patterns();
+
+    Field fields[HIDFieldProgram::MAX_FIELDS];
+    uint32_t values[HIDFieldProgram::MAX_FIELDS];
+
+    for (int round = 0; round < 100000; ++round)
+    {
+        const auto& pattern = list[round % list.size()];
+        const uint32_t buffer_len = 1 + xorshift(state) % BUF_LEN;
+        const uint32_t count = 1 + xorshift(state) % HIDFieldProgram::MAX_FIELDS;
+        const bool packed = (round % 2) == 0;
+
+        uint32_t offset = xorshift(state) % 8;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const uint32_t len = xorshift(state) % 33;
+            fields[i].bit_offset = static_cast<uint16_t>(packed ? offset : xorshift(state) % (BUF_BITS + 16));
+            fields[i].bit_size = static_cast<uint8_t>(len);
+            offset += len;
+        }
+
+        const uint8_t* buffer = guarded.place(pattern.data(), buffer_len);
+        HIDUtils::readFieldsLE(buffer, buffer_len, fields, count, values);
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const uint32_t expected = fields[i].bit_size ? expected_field(pattern, buffer_len, fields[i].bit_offset, fields[i].bit_size) : 0;
+            ++samples;
+            mismatches += (expected != values[i]) ? 1 : 0;
+        }
+    }
+
+    std::fprintf(stderr, "readFieldsLE lists: %llu samples, %llu mismatches\n",
+        static_cast<unsigned long long>(samples), static_cast<unsigned long long>(mismatches));
+    CHECK(mismatches == 0);
+}
+
+//16 buttons, a hat and its padding, 4 8 bit sticks and 2 16 bit triggers, 13 bytes
+std::vector<Field> gamepad_fields()
+{
+    std::vector<Field> fields;
+    uint16_t offset = 0;
+    auto add = [&](uint8_t size)
+    {
+        Field field{};
+        field.bit_offset = offset;
+        field.bit_size = size;
+        fields.push_back(field);
+        offset = static_cast<uint16_t>(offset + size);
+    };
+    for (int i = 0; i < 16; ++i)
+    {
+        add(1);
+    }
+    add(4);
+    offset += 4;
+    for (int i = 0; i < 4; ++i)
+    {
+        add(8);
+    }
+    add(16);
+    add(16);
+    return fields;
+}
+
+void benchmark(int argc, char** argv)
+{
+    bench::Runner runner(argc, argv);
+
+    constexpr uint32_t REPORT_LEN = 13;
+    constexpr uint32_t REPORTS = 64;
+    uint32_t state = 0x12345678;
+    std::vector<uint8_t> reports(REPORT_LEN * REPORTS);
+    for (auto& byte : reports)
+    {
+        byte = static_cast<uint8_t>(xorshift(state));
+    }
+
+    const std::vector<Field> fields = gamepad_fields();
+    const uint64_t count = fields.size();
+    uint32_t values[HIDFieldProgram::MAX_FIELDS];
+    uint32_t r = 0;
+
+    runner.run("hid_bits/bitwise_per_field", count, [&]
+    {
+        const uint8_t* report = &reports[(r++ % REPORTS) * REPORT_LEN];
+        for (const Field& field : fields)
+        {
+            bench::keep(read_bits_le_bitwise(report, field.bit_offset, field.bit_size));
+        }
+    });
+    runner.run("hid_bits/readBitsLE_per_field", count, [&]
+    {
+        const uint8_t* report = &reports[(r++ % REPORTS) * REPORT_LEN];
+        for (const Field& field : fields)
+        {
+            bench::keep(HIDUtils::readBitsLE(report, field.bit_offset, field.bit_size));
+        }
+    });
+    runner.run("hid_bits/readFieldsLE_per_field", count, [&]
+    {
+        const uint8_t* report = &reports[(r++ % REPORTS) * REPORT_LEN];
+        HIDUtils::readFieldsLE(report, REPORT_LEN, fields.data(), static_cast<uint32_t>(count), values);
+        bench::keep(&values[0]);
+    });
+
+    runner.print_json(std::cout);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    GuardedBuffer guarded;
+    check_read_bits(guarded);
+    check_read_fields_single(guarded);
+    check_read_fields_lists(guarded);
+
+    benchmark(argc, argv);
+
+    return check::result();
+}
@@ -0,0 +1,253 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+#include <malloc.h>
+
+#include "host_usb.h"
+#include "Gamepad/Gamepad.h"
+#include "USBHost/HostDriver/HostDriverPool.h"
+#include "USBHost/HostDriver/HIDGeneric/HIDGeneric.h"
+
+#include "Check.h"
+
+// Mounts and unmounts HIDHost through HostDriverPool the way HostManager does, over a set of
+// descriptors that compile, aren't joysticks, and are too big for HIDFieldProgram so they fall back
+// to HIDJoystick. Every allocation is counted, after each unmount the heap has to be back where it
+// started, nothing from the parse or the fallback may stay behind.
+// hid_generic_soak [cycles]
+
+namespace alloc_count
+{
+    size_t live = 0;
+    size_t live_bytes = 0;
+    size_t peak_bytes = 0;
+    uint64_t total = 0;
+}
+
+void* operator new(size_t size)
+{
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+    ++alloc_count::live;
+    ++alloc_count::total;
+    alloc_count::live_bytes += malloc_usable_size(ptr);
+    if (alloc_count::live_bytes > alloc_count::peak_bytes)
+    {
+        alloc_count::peak_bytes = alloc_count::live_bytes;
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    if (ptr)
+    {
+        --alloc_count::live;
+        alloc_count::live_bytes -= malloc_usable_size(ptr);
+        std::free(ptr);
+    }
+}
+
+void operator delete[](void* ptr) noexcept { operator delete(ptr); }
+void operator delete(void* ptr, size_t) noexcept { operator delete(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { operator delete(ptr); }
+
+namespace {
+
+//16 buttons, hat, X Y Z Rz, no report id. Report: buttons lo, buttons hi, hat, X, Y, Z, Rz
+constexpr uint8_t GAMEPAD_DESC[] =
+{
+    0x05, 0x01, 0x09, 0x05, 0xA1, 0x01,
+    0x05, 0x09, 0x19, 0x01, 0x29, 0x10, 0x15, 0x00, 0x25, 0x01, 0x75, 0x01, 0x95, 0x10, 0x81, 0x02,
+    0x05, 0x01, 0x09, 0x39, 0x15, 0x00, 0x25, 0x07, 0x75, 0x04, 0x95, 0x01, 0x81, 0x42,
+    0x75, 0x04, 0x95, 0x01, 0x81, 0x03,
+    0x09, 0x30, 0x09, 0x31, 0x09, 0x32, 0x09, 0x35, 0x15, 0x00, 0x26, 0xFF, 0x00, 0x75, 0x08, 0x95, 0x04, 0x81, 0x02,
+    0xC0
+};
+
+//Two joysticks behind report ids 1 and 2, 8 buttons and X Y each
+constexpr uint8_t TWO_JOYSTICK_DESC[] =
+{
+    0x05, 0x01, 0x09, 0x04, 0xA1, 0x01, 0x85, 0x01,
+    0x05, 0x09, 0x19, 0x01, 0x29, 0x08, 0x15, 0x00, 0x25, 0x01, 0x75, 0x01, 0x95, 0x08, 0x81, 0x02,
+    0x05, 0x01, 0x09, 0x30, 0x09, 0x31, 0x15, 0x00, 0x26, 0xFF, 0x00, 0x75, 0x08, 0x95, 0x02, 0x81, 0x02,
+    0xC0,
+    0x05, 0x01, 0x09, 0x04, 0xA1, 0x01, 0x85, 0x02,
+    0x05, 0x09, 0x19, 0x01, 0x29, 0x08, 0x15, 0x00, 0x25, 0x01, 0x75, 0x01, 0x95, 0x08, 0x81, 0x02,
+    0x05, 0x01, 0x09, 0x30, 0x09, 0x31, 0x15, 0x00, 0x26, 0xFF, 0x00, 0x75, 0x08, 0x95, 0x02, 0x81, 0x02,
+    0xC0
+};
+
+//No joystick or gamepad collection, nothing to compile
+constexpr uint8_t KEYBOARD_DESC[] =
+{
+    0x05, 0x01, 0x09, 0x06, 0xA1, 0x01,
+    0x05, 0x07, 0x19, 0xE0, 0x29, 0xE7, 0x15, 0x00, 0x25, 0x01, 0x75, 0x01, 0x95, 0x08, 0x81, 0x02,
+    0xC0
+};
+
+struct Descriptor
+{
+    const char* name;
+    std::vector<uint8_t> data;
+    bool mounts;
+};
+
+//One joystick per report id, more blocks than HIDFieldProgram::MAX_BLOCKS and past 0x100 bytes
+std::vector<uint8_t> oversized()
+{
+    std::vector<uint8_t> desc;
+    for (uint8_t id = 1; id <= HIDFieldProgram::MAX_BLOCKS + 4; ++id)
+    {
+        const uint8_t joystick[] =
+        {
+            0x05, 0x01, 0x09, 0x04, 0xA1, 0x01, 0x85, id,
+            0x09, 0x30, 0x15, 0x00, 0x26, 0xFF, 0x00, 0x75, 0x08, 0x95, 0x01, 0x81, 0x02,
+            0xC0
+        };
+        desc.insert(desc.end(), std::begin(joystick), std::end(joystick));
+    }
+    return desc;
+}
+
+//The gamepad descriptor padded past 0x100 bytes with repeated usage page items
+std::vector<uint8_t> too_long()
+{
+    std::vector<uint8_t> desc(std::begin(GAMEPAD_DESC), std::end(GAMEPAD_DESC) - 1);
+    while (desc.size() < 0x100)
+    {
+        desc.push_back(0x05);
+        desc.push_back(0x01);
+    }
+    desc.push_back(0xC0);
+    return desc;
+}
+
+std::vector<Descriptor> descriptors()
+{
+    std::vector<Descriptor> list;
+    list.push_back({ "gamepad", { std::begin(GAMEPAD_DESC), std::end(GAMEPAD_DESC) }, true });
+    list.push_back({ "two_joysticks", { std::begin(TWO_JOYSTICK_DESC), std::end(TWO_JOYSTICK_DESC) }, true });
+    list.push_back({ "keyboard", { std::begin(KEYBOARD_DESC), std::end(KEYBOARD_DESC) }, false });
+    list.push_back({ "oversized", oversized(), true });
+    list.push_back({ "too_long", too_long(), true });
+    return list;
+}
+
+using Pool = HostDriverPool<MAX_GAMEPADS, HIDHost>;
+
+//Mounting is what HostManager does on tuh_hid_mount_cb(), only a driver that found joystick inputs asks for reports
+bool mount(Pool& pool, Gamepad& gamepad, uint8_t slot, const Descriptor& desc, size_t* mounted_bytes = nullptr)
+{
+    HostDriver* driver = pool.emplace<HIDHost>(slot);
+    const uint32_t receives = host_usb::hid_receive_count();
+    const size_t live_bytes = alloc_count::live_bytes;
+    driver->initialize(gamepad, slot + 1, 0, desc.data.data(), static_cast<uint16_t>(desc.data.size()));
+    const bool mounted = host_usb::hid_receive_count() != receives;
+    if (mounted_bytes)
+    {
+        *mounted_bytes = alloc_count::live_bytes - live_bytes;
+    }
+
+    if (mounted)
+    {
+        //Button 2 is A, the hat is left neutral
+        const uint8_t report[] = { 0x02, 0x00, 0x08, 0x80, 0x80, 0x80, 0x80 };
+        driver->process_report(gamepad, slot + 1, 0, report, sizeof(report));
+    }
+    pool.destroy(slot);
+    return mounted;
+}
+
+//Heap the HIDJoystick fallback holds while the oversized descriptor is mounted
+size_t fallback_bytes = 0;
+
+void check_reports(Gamepad& gamepad)
+{
+    static Pool pool;
+    const auto list = descriptors();
+
+    for (const Descriptor& desc : list)
+    {
+        const bool mounted = mount(pool, gamepad, 0, desc);
+        if (mounted != desc.mounts)
+        {
+            std::fprintf(stderr, "%s: mounted %d, expected %d\n", desc.name, mounted, desc.mounts);
+        }
+        CHECK(mounted == desc.mounts);
+    }
+
+    //The gamepad report went all the way through to the pad
+    size_t mounted_bytes = 0;
+    (void)mount(pool, gamepad, 0, list[0], &mounted_bytes);
+    CHECK(gamepad.get_pad_in().buttons & Gamepad::BUTTON_A);
+    CHECK(mounted_bytes == 0);
+
+    //So did the one parsed by the fallback, report id 2 with X at its minimum
+    (void)mount(pool, gamepad, 0, list[3], &mounted_bytes);
+    CHECK(gamepad.get_pad_in().joystick_lx < 0);
+    CHECK(mounted_bytes > 0);
+    fallback_bytes = mounted_bytes;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const uint32_t cycles = (argc > 1) ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 0)) : 100000;
+
+    static Gamepad gamepad;
+    check_reports(gamepad);
+
+    static Pool pool;
+    const auto list = descriptors();
+
+    //One pass over everything first so lazily allocated library state isn't counted as growth
+    for (uint8_t i = 0; i < list.size(); ++i)
+    {
+        (void)mount(pool, gamepad, i % MAX_GAMEPADS, list[i]);
+    }
+
+    const size_t live = alloc_count::live;
+    const size_t live_bytes = alloc_count::live_bytes;
+    const size_t heap_bytes = mallinfo2().uordblks;
+    alloc_count::peak_bytes = live_bytes;
+    const uint64_t total = alloc_count::total;
+
+    uint32_t leaked_cycles = 0;
+    uint32_t mounted = 0;
+    for (uint32_t i = 0; i < cycles; ++i)
+    {
+        const Descriptor& desc = list[i % list.size()];
+        mounted += mount(pool, gamepad, static_cast<uint8_t>(i % MAX_GAMEPADS), desc) ? 1 : 0;
+        if (alloc_count::live != live || alloc_count::live_bytes != live_bytes)
+        {
+            ++leaked_cycles;
+        }
+    }
+
+    const size_t heap_growth = mallinfo2().uordblks - heap_bytes;
+    std::printf("{\"cycles\": %u, \"mounted\": %u, \"allocations\": %llu, \"peak_parse_bytes\": %zu, "
+                "\"slot_bytes\": %zu, \"fallback_bytes\": %zu, "
+                "\"leaked_cycles\": %u, \"live_growth\": %zd, \"heap_growth\": %zd}\n",
+        cycles, mounted, static_cast<unsigned long long>(alloc_count::total - total),
+        alloc_count::peak_bytes - live_bytes, Pool::SLOT_SIZE, fallback_bytes, leaked_cycles,
+        static_cast<ssize_t>(alloc_count::live - live), static_cast<ssize_t>(heap_growth));
+
+    CHECK(leaked_cycles == 0);
+    CHECK(alloc_count::live == live);
+    CHECK(heap_growth == 0);
+
+    return check::result();
+}
@@ -0,0 +1,288 @@
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+
+#include "pico/time.h"
+#include "host_usb.h"
+
+#include "Gamepad/Gamepad.h"
+#include "Descriptors/DInput.h"
+#include "USBHost/HostManager.h"
+#include "bench/Bench.h"
+
+#include "Check.h"
+
+// HostManager's report dispatch: four DInput pads mounted at the addresses TinyUSB hands out with and
+// without a hub, every report has to reach the gamepad the pad was bound to, out of range addresses and
+// instances have to be dropped, and unplugging out of order has to free the lowest gamepad. A mount that
+// fails must not touch the interface it was aimed at, and unmounting one interface keeps the others.
+// Then a 1 kHz poll of all four pads (one changed report per pad per 1 ms frame plus the core1
+// feedback pass) is timed through process_report() and against calling the driver directly,
+// the difference is what dispatch costs per report. JSON on stdout.
+// host_dispatch [--quick] [--filter name]
+
+namespace {
+
+constexpr uint8_t INVALID_IDX = 0xFF;
+
+//Logitech RumblePad 2, listed as DInput in HardwareIDs.h
+constexpr HardwareID PAD_ID = { 0x046D, 0xC218 };
+
+//One face button per pad so each gamepad shows which pad it was fed by
+constexpr uint8_t PAD_BUTTONS[] =
+{
+    DInput::Buttons0::CROSS, DInput::Buttons0::CIRCLE, DInput::Buttons0::SQUARE, DInput::Buttons0::TRIANGLE
+};
+constexpr uint16_t GAMEPAD_BUTTONS[] =
+{
+    Gamepad::BUTTON_A, Gamepad::BUTTON_B, Gamepad::BUTTON_X, Gamepad::BUTTON_Y
+};
+static_assert(MAX_GAMEPADS <= sizeof(PAD_BUTTONS), "One button per gamepad");
+
+Gamepad gamepads[MAX_GAMEPADS];
+
+bool mount(HostManager& manager, uint8_t address)
+{
+    host_usb::set_vid_pid(address, PAD_ID.vid, PAD_ID.pid);
+    return manager.setup_driver(HostManager::get_type(PAD_ID), address, 0);
+}
+
+void unmount(HostManager& manager, uint8_t address)
+{
+    manager.deinit_driver(HostManager::DriverClass::HID, address, 0);
+}
+
+DInput::InReport pad_report(uint8_t pad, uint32_t frame)
+{
+    DInput::InReport report;
+    report.buttons[0] = PAD_BUTTONS[pad];
+    report.joystick_lx = static_cast<uint8_t>(frame);
+    return report;
+}
+
+void send(HostManager& manager, uint8_t address, uint8_t instance, const DInput::InReport& report)
+{
+    manager.process_report(address, instance, reinterpret_cast<const uint8_t*>(&report), sizeof(report));
+}
+
+//Drains new_pad_in() on every gamepad
+void clear_gamepads()
+{
+    for (Gamepad& gamepad : gamepads)
+    {
+        (void)gamepad.get_pad_in();
+    }
+}
+
+//The report from pads[i] lands on the gamepad get_gamepad_idx() says and nowhere else
+void check_routing(HostManager& manager, const uint8_t (&addresses)[MAX_GAMEPADS], const char* name)
+{
+    //Every report differs from the last, unchanged ones are dropped by the report filter
+    static uint32_t sequence = 0;
+
+    for (uint8_t pad = 0; pad < MAX_GAMEPADS; ++pad)
+    {
+        const uint8_t address = addresses[pad];
+        const uint8_t gp_idx = manager.get_gamepad_idx(HostManager::DriverClass::HID, address, 0);
+        CHECK(gp_idx < MAX_GAMEPADS);
+        if (gp_idx >= MAX_GAMEPADS)
+        {
+            continue;
+        }
+
+        clear_gamepads();
+        send(manager, address, 0, pad_report(pad, ++sequence));
+
+        for (uint8_t i = 0; i < MAX_GAMEPADS; ++i)
+        {
+            const bool fed = gamepads[i].new_pad_in();
+            if (fed != (i == gp_idx))
+            {
+                std::fprintf(stderr, "%s: address %u report reached gamepad %u, bound to %u\n", name, address, i, gp_idx);
+            }
+            CHECK(fed == (i == gp_idx));
+        }
+        CHECK(gamepads[gp_idx].get_pad_in().buttons == GAMEPAD_BUTTONS[pad]);
+    }
+}
+
+void check_dispatch(HostManager& manager)
+{
+    //No hub: pads get addresses 1 to MAX_GAMEPADS in plug order
+    uint8_t direct[MAX_GAMEPADS];
+    for (uint8_t pad = 0; pad < MAX_GAMEPADS; ++pad)
+    {
+        direct[pad] = pad + 1;
+        CHECK(mount(manager, direct[pad]));
+        CHECK(manager.get_gamepad_idx(HostManager::DriverClass::HID, direct[pad], 0) == pad);
+    }
+    check_routing(manager, direct, "direct");
+
+    //A second interface on a mounted pad has no gamepad left
+    host_usb::set_vid_pid(direct[0], PAD_ID.vid, PAD_ID.pid);
+    CHECK(!manager.setup_driver(HostManager::get_type(PAD_ID), direct[0], 1));
+    CHECK(manager.get_gamepad_idx(HostManager::DriverClass::HID, direct[0], 0) == 0);
+
+    //Unplugged out of order, the next pad gets the lowest free gamepad
+    if (MAX_GAMEPADS >= 3)
+    {
+        unmount(manager, direct[2]);
+        unmount(manager, direct[0]);
+        CHECK(manager.get_gamepad_idx(HostManager::DriverClass::HID, direct[0], 0) == INVALID_IDX);
+        CHECK(mount(manager, direct[2]));
+        CHECK(manager.get_gamepad_idx(HostManager::DriverClass::HID, direct[2], 0) == 0);
+        CHECK(mount(manager, direct[0]));
+        CHECK(manager.get_gamepad_idx(HostManager::DriverClass::HID, direct[0], 0) == 2);
+        check_routing(manager, direct, "replugged");
+    }
+
+    //Nothing in range of a slot, dropped without touching a gamepad
+    clear_gamepads();
+    send(manager, 0, 0, pad_report(0, 1));
+    send(manager, CFG_TUH_DEVICE_MAX + 1, 0, pad_report(0, 2));
+    send(manager, 0xFF, 0, pad_report(0, 3));
+    send(manager, direct[0], MAX_INTERFACES, pad_report(0, 4));
+    for (Gamepad& gamepad : gamepads)
+    {
+        CHECK(!gamepad.new_pad_in());
+    }
+    CHECK(manager.get_gamepad_idx(HostManager::DriverClass::HID, CFG_TUH_DEVICE_MAX + 1, 0) == INVALID_IDX);
+    CHECK(manager.get_gamepad_idx(HostManager::DriverClass::HID, direct[0], MAX_INTERFACES) == INVALID_IDX);
+
+    for (uint8_t address : direct)
+    {
+        unmount(manager, address);
+    }
+    CHECK(!manager.any_mounted());
+
+    //Behind a hub: the hub takes an address above CFG_TUH_DEVICE_MAX, pads are
+    //plugged into its ports in any order, so addresses don't follow gamepad order
+    uint8_t hub[MAX_GAMEPADS];
+    for (uint8_t pad = 0; pad < MAX_GAMEPADS; ++pad)
+    {
+        hub[pad] = static_cast<uint8_t>(CFG_TUH_DEVICE_MAX - pad);
+        CHECK(mount(manager, hub[pad]));
+    }
+    check_routing(manager, hub, "hub");
+
+    for (uint8_t address : hub)
+    {
+        unmount(manager, address);
+    }
+    CHECK(!manager.any_mounted());
+}
+
+//A failed mount leaves the interface it was aimed at alone, and unmounting one interface of a device
+//leaves the others running
+void check_interfaces(HostManager& manager)
+{
+    //Boot keyboard, not a gamepad
+    static const uint8_t KEYBOARD_DESC[] = { 0x05, 0x01, 0x09, 0x06, 0xA1, 0x01, 0xC0 };
+    const uint8_t address = 1;
+
+    CHECK(mount(manager, address));
+    CHECK(!manager.setup_driver(HostDriverType::UNKNOWN, address, 0, KEYBOARD_DESC, sizeof(KEYBOARD_DESC)));
+    CHECK(!manager.setup_driver(HostDriverType::UNKNOWN, address, 0));
+    CHECK(manager.get_gamepad_idx(HostManager::DriverClass::HID, address, 0) == 0);
+    clear_gamepads();
+    send(manager, address, 0, pad_report(0, 100));
+    CHECK(gamepads[0].new_pad_in());
+
+    //Remounted in place, it keeps its gamepad even with none free
+    for (uint8_t other = address + 1; other <= MAX_GAMEPADS; ++other)
+    {
+        CHECK(mount(manager, other));
+    }
+    CHECK(mount(manager, address));
+    CHECK(manager.get_gamepad_idx(HostManager::DriverClass::HID, address, 0) == 0);
+    for (uint8_t other = address + 1; other <= MAX_GAMEPADS; ++other)
+    {
+        unmount(manager, other);
+    }
+
+    if (MAX_GAMEPADS >= 2)
+    {
+        CHECK(manager.setup_driver(HostManager::get_type(PAD_ID), address, 1));
+        CHECK(manager.get_gamepad_idx(HostManager::DriverClass::HID, address, 1) == 1);
+
+        manager.deinit_driver(HostManager::DriverClass::HID, address, 1);
+        CHECK(manager.get_gamepad_idx(HostManager::DriverClass::HID, address, 1) == INVALID_IDX);
+        CHECK(manager.get_gamepad_idx(HostManager::DriverClass::HID, address, 0) == 0);
+        CHECK(manager.any_mounted());
+        clear_gamepads();
+        send(manager, address, 0, pad_report(0, 101));
+        CHECK(gamepads[0].new_pad_in());
+    }
+
+    unmount(manager, address);
+    CHECK(!manager.any_mounted());
+}
+
+void benchmark(int argc, char** argv, HostManager& manager)
+{
+    bench::Runner runner(argc, argv);
+
+    uint8_t addresses[MAX_GAMEPADS];
+    for (uint8_t pad = 0; pad < MAX_GAMEPADS; ++pad)
+    {
+        addresses[pad] = pad + 1;
+        CHECK(mount(manager, addresses[pad]));
+    }
+
+    //The same drivers on their own, what's left when dispatch costs nothing
+    static HostDriverPool<MAX_GAMEPADS, DInputHost> pool;
+    HostDriver* drivers[MAX_GAMEPADS];
+    for (uint8_t pad = 0; pad < MAX_GAMEPADS; ++pad)
+    {
+        drivers[pad] = pool.emplace<DInputHost>(pad);
+        drivers[pad]->initialize(gamepads[pad], addresses[pad], 0, nullptr, 0);
+    }
+
+    uint32_t frame = 0;
+
+    //One 1 ms frame: every pad's changed report, then core1's feedback pass
+    runner.run("host_dispatch/host_manager_per_report", MAX_GAMEPADS, [&]
+    {
+        host_time::advance_us(1000);
+        ++frame;
+        for (uint8_t pad = 0; pad < MAX_GAMEPADS; ++pad)
+        {
+            send(manager, addresses[pad], 0, pad_report(pad, frame));
+        }
+        manager.feedback_task();
+    });
+    runner.run("host_dispatch/driver_direct_per_report", MAX_GAMEPADS, [&]
+    {
+        host_time::advance_us(1000);
+        ++frame;
+        for (uint8_t pad = 0; pad < MAX_GAMEPADS; ++pad)
+        {
+            const DInput::InReport report = pad_report(pad, frame);
+            drivers[pad]->process_report(gamepads[pad], addresses[pad], 0, reinterpret_cast<const uint8_t*>(&report), sizeof(report));
+        }
+    });
+
+    runner.print_json(std::cout);
+
+    for (uint8_t address : addresses)
+    {
+        unmount(manager, address);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    //Frames are stepped by hand so the 1 kHz schedule doesn't depend on how fast the host runs
+    host_time::set_us(1);
+
+    HostManager& manager = HostManager::get_instance();
+    manager.initialize(gamepads);
+
+    check_dispatch(manager);
+    check_interfaces(manager);
+    benchmark(argc, argv, manager);
+
+    return check::result();
+}
@@ -0,0 +1,254 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "Gamepad/JoystickProgram.h"
+#include "reference/JoystickFix16.h"
+
+#include "Check.h"
+
+// JoystickProgram against the Fix16 implementation it replaced, output must be the same.
+// The elliptical anti deadzone profiles compare against its fixed_ellipse path, the old code read an
+// uninitialized value there.
+// By default every profile runs a strided grid plus bands where the branches flip (the diagonals,
+// the axes, the axis restrict edges), --full runs all 65536 x 65536 samples (hours per profile).
+// joystick_program [--full] [--stride N] [--filter name]
+
+namespace {
+
+struct Profile
+{
+    const char* name;
+    JoystickSettings set;
+};
+
+std::vector<Profile> profiles()
+{
+    std::vector<Profile> list;
+
+    list.push_back({ "default", JoystickSettings() });
+
+    JoystickSettings set;
+    set.dz_inner = Fix16(0.1f);
+    set.dz_outer = Fix16(0.95f);
+    set.anti_dz_circle = Fix16(0.1f);
+    set.anti_dz_outer = Fix16(0.95f);
+    list.push_back({ "deadzone", set });
+
+    set = JoystickSettings();
+    set.dz_inner = Fix16(0.05f);
+    set.anti_dz_square = Fix16(0.15f);
+    set.uncap_radius = false;
+    set.dz_outer = Fix16(0.9f);
+    list.push_back({ "square_anti_dz", set });
+
+    set = JoystickSettings();
+    set.axis_restrict = Fix16(0.1f);
+    set.angle_restrict = Fix16(10.0f);
+    set.dz_inner = Fix16(0.02f);
+    list.push_back({ "restrict", set });
+
+    set = JoystickSettings();
+    set.axis_restrict = Fix16(0.2f);
+    set.angle_restrict = Fix16(30.0f);
+    set.anti_dz_circle = Fix16(0.2f);
+    list.push_back({ "restrict_wide", set });
+
+    set = JoystickSettings();
+    set.dz_inner = Fix16(0.05f);
+    set.diag_scale_min = Fix16(0.9f);
+    set.diag_scale_max = Fix16(1.2f);
+    set.anti_dz_circle = Fix16(0.05f);
+    list.push_back({ "diagonal", set });
+
+    set = JoystickSettings();
+    set.dz_inner = Fix16(0.05f);
+    set.curve = Fix16(0.5f);
+    list.push_back({ "curve_int", set });
+
+    set = JoystickSettings();
+    set.dz_inner = Fix16(0.08f);
+    set.dz_outer = Fix16(0.98f);
+    set.anti_dz_circle = Fix16(0.1f);
+    set.axis_restrict = Fix16(0.05f);
+    set.angle_restrict = Fix16(10.0f);
+    set.diag_scale_max = Fix16(1.1f);
+    set.curve = Fix16(1.5f);
+    list.push_back({ "curve_frac", set });
+
+    set = JoystickSettings();
+    set.curve = Fix16(2.0f);
+    set.invert_x = true;
+    set.invert_y = true;
+    list.push_back({ "curve_sqrt_inverted", set });
+
+    set = JoystickSettings();
+    set.dz_inner = Fix16(0.05f);
+    set.anti_dz_circle = Fix16(0.2f);
+    set.anti_dz_square = Fix16(0.1f);
+    set.anti_dz_square_y_scale = Fix16(0.15f);
+    list.push_back({ "ellipse", set });
+
+    set = JoystickSettings();
+    set.anti_dz_circle = Fix16(0.1f);
+    set.anti_dz_square = Fix16(0.1f);
+    set.axis_restrict = Fix16(0.1f);
+    set.angle_restrict = Fix16(20.0f);
+    set.curve = Fix16(1.25f);
+    set.uncap_radius = false;
+    list.push_back({ "ellipse_restrict", set });
+
+    return list;
+}
+
+struct Stats
+{
+    uint64_t samples{0};
+    uint64_t mismatches{0};
+    int max_diff{0};
+};
+
+inline int diff(int16_t a, int16_t b)
+{
+    const int d = static_cast<int>(a) - static_cast<int>(b);
+    return (d < 0) ? -d : d;
+}
+
+void compare(const Profile& profile, const JoystickProgram& program, int32_t x, int32_t y, Stats& stats, bool both_inverts = true)
+{
+    //Both invert_y arguments, the profile's own inverts are covered by the profiles
+    for (bool invert_y : { false, true })
+    {
+        if (invert_y && !both_inverts)
+        {
+            break;
+        }
+        const auto expected = apply_joystick_settings_fix16(static_cast<int16_t>(x), static_cast<int16_t>(y), profile.set, invert_y, true);
+        const auto actual = program.apply(static_cast<int16_t>(x), static_cast<int16_t>(y), invert_y);
+        const int d = std::max(diff(expected.first, actual.first), diff(expected.second, actual.second));
+        ++stats.samples;
+        if (d)
+        {
+            ++stats.mismatches;
+            stats.max_diff = std::max(stats.max_diff, d);
+        }
+        CHECK_SWEEP(d == 0, "%s (%d, %d) invert_y %d: fix16 (%d, %d) program (%d, %d)", profile.name, x, y, invert_y,
+            expected.first, expected.second, actual.first, actual.second);
+    }
+}
+
+void sweep_grid(const Profile& profile, const JoystickProgram& program, int32_t stride, Stats& stats)
+{
+    for (int32_t x = INT16_MIN; x <= INT16_MAX; x += stride)
+    {
+        for (int32_t y = INT16_MIN; y <= INT16_MAX; y += stride)
+        {
+            compare(profile, program, x, y, stats);
+        }
+        //Always include the far edge
+        compare(profile, program, x, INT16_MAX, stats);
+    }
+}
+
+void sweep_bands(const Profile& profile, const JoystickProgram& program, int32_t step, Stats& stats)
+{
+    const int32_t axis_restrict = static_cast<int32_t>(
+        (static_cast<int64_t>(profile.set.axis_restrict.value) * INT16_MAX) >> 16);
+
+    for (int32_t x = INT16_MIN; x <= INT16_MAX; x += step)
+    {
+        for (int32_t offset = -2; offset <= 2; ++offset)
+        {
+            //The diagonals, where the raw and axial angles cross 45 degrees
+            const int32_t d = x + offset;
+            if (d >= INT16_MIN && d <= INT16_MAX)
+            {
+                compare(profile, program, x, d, stats);
+                compare(profile, program, x, -d, stats);
+            }
+            //The axes and the axis restrict edges
+            for (int32_t edge : { 0, axis_restrict, -axis_restrict })
+            {
+                const int32_t e = edge + offset;
+                if (e >= INT16_MIN && e <= INT16_MAX)
+                {
+                    compare(profile, program, x, e, stats);
+                    compare(profile, program, e, x, stats);
+                }
+            }
+        }
+    }
+}
+
+void sweep_full(const Profile& profile, const JoystickProgram& program, Stats& stats)
+{
+    for (int32_t x = INT16_MIN; x <= INT16_MAX; ++x)
+    {
+        for (int32_t y = INT16_MIN; y <= INT16_MAX; ++y)
+        {
+            //Inverting y is just another y here
+            compare(profile, program, x, y, stats, false);
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    bool full = false;
+    int32_t stride = 257;
+    const char* filter = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--full") == 0)
+        {
+            full = true;
+        }
+        else if (std::strcmp(argv[i], "--stride") == 0 && i + 1 < argc)
+        {
+            stride = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+        {
+            filter = argv[++i];
+        }
+    }
+
+    std::printf("[\n");
+    bool first = true;
+    for (const Profile& profile : profiles())
+    {
+        if (filter && !std::strstr(profile.name, filter))
+        {
+            continue;
+        }
+
+        JoystickProgram program;
+        program.compile(profile.set);
+
+        Stats stats;
+        if (full)
+        {
+            sweep_full(profile, program, stats);
+        }
+        else
+        {
+            sweep_grid(profile, program, stride, stats);
+            sweep_bands(profile, program, std::max(1, stride / 24), stats);
+        }
+
+        std::printf("%s  {\"profile\": \"%s\", \"samples\": %llu, \"mismatches\": %llu, \"max_diff\": %d}",
+            first ? "" : ",\n", profile.name, static_cast<unsigned long long>(stats.samples),
+            static_cast<unsigned long long>(stats.mismatches), stats.max_diff);
+        std::fflush(stdout);
+        first = false;
+    }
+    std::printf("\n]\n");
+
+    return check::result();
+}
@@ -0,0 +1,170 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "host_usb.h"
+
+#include "Gamepad/Gamepad.h"
+#include "UserSettings/UserProfile.h"
+#include "USBHost/HostManager.h"
+#include "USBHost/PollInterval.h"
+
+#include "Check.h"
+
+// The interrupt IN interval override: a configuration descriptor is fed endpoint by endpoint through
+// the hcd_edpt_open() wrapper, the way the HID and XInput class drivers open them. Only interrupt IN
+// endpoints may reach the HCD with the profile's interval, OUT, isochronous and hub endpoints keep
+// theirs, the profile is that of the gamepad the device will land on, and the descriptor TinyUSB
+// enumerated from is never written.
+// poll_interval
+
+namespace {
+
+//Logitech RumblePad 2, listed as DInput in HardwareIDs.h
+constexpr HardwareID PAD_ID = { 0x046D, 0xC218 };
+//Xbox One controller
+constexpr HardwareID XBOXONE_ID = { 0x045E, 0x02EA };
+
+constexpr uint8_t HID_IN_EP = 0x84;
+constexpr uint8_t HID_OUT_EP = 0x03;
+constexpr uint8_t ISO_IN_EP = 0x82;
+constexpr uint8_t DEVICE_INTERVAL = 5;
+
+//DS4 style: an audio streaming interface with an isochronous IN endpoint, then the HID interface
+const uint8_t HID_CONFIG[] =
+{
+    9, TUSB_DESC_CONFIGURATION, 48, 0, 2, 1, 0, 0xC0, 0xFA,
+    9, TUSB_DESC_INTERFACE, 0, 1, 1, 0x01, 0x02, 0x00, 0,
+    9, TUSB_DESC_ENDPOINT, ISO_IN_EP, TUSB_XFER_ISOCHRONOUS, 0x40, 0x00, 1, 0, 0,
+    9, TUSB_DESC_INTERFACE, 1, 0, 2, TUSB_CLASS_HID, 0x00, 0x00, 0,
+    9, HID_DESC_TYPE_HID, 0x11, 0x01, 0x00, 1, HID_DESC_TYPE_REPORT, 0xFB, 0x01,
+    7, TUSB_DESC_ENDPOINT, HID_IN_EP, TUSB_XFER_INTERRUPT, 0x40, 0x00, DEVICE_INTERVAL,
+    7, TUSB_DESC_ENDPOINT, HID_OUT_EP, TUSB_XFER_INTERRUPT, 0x40, 0x00, DEVICE_INTERVAL,
+};
+
+//Xbox One: vendor class GIP interface, interrupt IN and OUT
+const uint8_t XINPUT_CONFIG[] =
+{
+    9, TUSB_DESC_CONFIGURATION, 32, 0, 1, 1, 0, 0xA0, 0xFA,
+    9, TUSB_DESC_INTERFACE, 0, 0, 2, TUSB_CLASS_VENDOR_SPECIFIC, 0x47, 0xD0, 0,
+    7, TUSB_DESC_ENDPOINT, 0x81, TUSB_XFER_INTERRUPT, 0x40, 0x00, 4,
+    7, TUSB_DESC_ENDPOINT, 0x01, TUSB_XFER_INTERRUPT, 0x40, 0x00, 4,
+};
+
+Gamepad gamepads[MAX_GAMEPADS];
+
+void set_poll_ms(uint8_t gp_idx, uint8_t interval_ms)
+{
+    UserProfile profile;
+    profile.host_poll_ms = interval_ms;
+    gamepads[gp_idx].set_profile(profile);
+}
+
+//Opens every endpoint in config through the wrapper, returns what reached the HCD
+std::vector<host_usb::Endpoint> open_config(uint8_t address, const uint8_t* config, size_t len)
+{
+    std::vector<uint8_t> enum_buffer(config, config + len);
+    const size_t first = host_usb::opened_endpoints().size();
+
+    const uint8_t* p_desc = enum_buffer.data();
+    const uint8_t* desc_end = p_desc + enum_buffer.size();
+    for (; p_desc < desc_end; p_desc = tu_desc_next(p_desc))
+    {
+        if (tu_desc_type(p_desc) == TUSB_DESC_ENDPOINT)
+        {
+            CHECK(__wrap_hcd_edpt_open(BOARD_TUH_RHPORT, address, reinterpret_cast<const tusb_desc_endpoint_t*>(p_desc)));
+        }
+    }
+    CHECK(std::memcmp(enum_buffer.data(), config, len) == 0);
+    return std::vector<host_usb::Endpoint>(host_usb::opened_endpoints().begin() + first, host_usb::opened_endpoints().end());
+}
+
+uint8_t interval_of(const std::vector<host_usb::Endpoint>& endpoints, uint8_t ep_addr)
+{
+    for (const host_usb::Endpoint& endpoint : endpoints)
+    {
+        if (endpoint.ep_addr == ep_addr)
+        {
+            return endpoint.interval;
+        }
+    }
+    return 0xFF;
+}
+
+void check_apply()
+{
+    tusb_desc_endpoint_t desc_ep;
+    std::memcpy(&desc_ep, &HID_CONFIG[sizeof(HID_CONFIG) - 14], sizeof(desc_ep));
+    CHECK(desc_ep.bEndpointAddress == HID_IN_EP);
+
+    tusb_desc_endpoint_t out{};
+    CHECK(!PollInterval::apply(desc_ep, 0, out));
+    CHECK(!PollInterval::apply(desc_ep, DEVICE_INTERVAL, out));
+    CHECK(out.bLength == 0);
+    CHECK(PollInterval::apply(desc_ep, 1, out));
+    CHECK(out.bInterval == 1 && out.bEndpointAddress == HID_IN_EP && out.wMaxPacketSize == 0x40);
+    CHECK(desc_ep.bInterval == DEVICE_INTERVAL);
+}
+
+void check_open(HostManager& manager)
+{
+    const uint8_t address = 1;
+    host_usb::set_vid_pid(address, PAD_ID.vid, PAD_ID.pid);
+
+    //Nothing set, every endpoint reaches the HCD as the device described it
+    std::vector<host_usb::Endpoint> opened = open_config(address, HID_CONFIG, sizeof(HID_CONFIG));
+    CHECK(opened.size() == 3);
+    CHECK(interval_of(opened, ISO_IN_EP) == 1);
+    CHECK(interval_of(opened, HID_IN_EP) == DEVICE_INTERVAL);
+    CHECK(interval_of(opened, HID_OUT_EP) == DEVICE_INTERVAL);
+
+    //1 ms from gamepad 0's profile, only the interrupt IN endpoint changes
+    set_poll_ms(0, 1);
+    opened = open_config(address, HID_CONFIG, sizeof(HID_CONFIG));
+    CHECK(opened.size() == 3);
+    CHECK(interval_of(opened, ISO_IN_EP) == 1);
+    CHECK(interval_of(opened, HID_IN_EP) == 1);
+    CHECK(interval_of(opened, HID_OUT_EP) == DEVICE_INTERVAL);
+
+    //The XInput driver opens its endpoints through the same call
+    host_usb::set_vid_pid(address, XBOXONE_ID.vid, XBOXONE_ID.pid);
+    opened = open_config(address, XINPUT_CONFIG, sizeof(XINPUT_CONFIG));
+    CHECK(interval_of(opened, 0x81) == 1);
+    CHECK(interval_of(opened, 0x01) == 4);
+
+    //A hub's status change endpoint keeps its interval
+    opened = open_config(CFG_TUH_DEVICE_MAX + 1, HID_CONFIG, sizeof(HID_CONFIG));
+    CHECK(interval_of(opened, HID_IN_EP) == DEVICE_INTERVAL);
+
+    //With gamepad 0 taken, the next device lands on gamepad 1 (or nowhere) and gets that profile's interval
+    host_usb::set_vid_pid(address, PAD_ID.vid, PAD_ID.pid);
+    CHECK(manager.setup_driver(HostManager::get_type(PAD_ID), address, 0));
+    const uint8_t next_address = 2;
+    host_usb::set_vid_pid(next_address, PAD_ID.vid, PAD_ID.pid);
+    opened = open_config(next_address, HID_CONFIG, sizeof(HID_CONFIG));
+    CHECK(interval_of(opened, HID_IN_EP) == DEVICE_INTERVAL);
+
+    if (MAX_GAMEPADS > 1)
+    {
+        set_poll_ms(1, 2);
+        opened = open_config(next_address, HID_CONFIG, sizeof(HID_CONFIG));
+        CHECK(interval_of(opened, HID_IN_EP) == 2);
+    }
+
+    manager.deinit_driver(HostManager::DriverClass::HID, address, 0);
+    CHECK(!manager.any_mounted());
+}
+
+} // namespace
+
+int main()
+{
+    HostManager& manager = HostManager::get_instance();
+    manager.initialize(gamepads);
+
+    check_apply();
+    check_open(manager);
+
+    return check::result();
+}
@@ -0,0 +1,266 @@
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include <memory>
+#include <utility>
+
+#include "Gamepad/Gamepad.h"
+#include "Gamepad/ProfileProgram.h"
+#include "reference/ProfilePerBit.h"
+
+#include "Check.h"
+
+// ProfileProgram's tables against the per bit MAP_* mapping they replaced, for the default profile,
+// swaps, random permutations and random masks where one input sets several outputs or none.
+// Every 16 bit button mask goes through the nibble tables: the 12 bits the old code mapped have to
+// match its OR chain, the 4 above it never set pass through unchanged. Every dpad value has to match
+// the per bit mapping and the 9 hat directions the switch on the hat. Every trigger value has to
+// match apply_trigger_settings for a set of trigger settings, disabled settings give the identity,
+// and the same goes through Gamepad::set_profile() and scale_trigger_l/r().
+// Prints how many values were compared as JSON.
+// profile_program
+
+namespace {
+
+uint32_t lcg_state = 3003;
+
+uint32_t lcg()
+{
+    lcg_state = lcg_state * 1664525u + 1013904223u;
+    return lcg_state >> 8;
+}
+
+constexpr uint16_t MAPPED_BUTTONS = 0x0FFF;
+
+uint16_t* button_fields(UserProfile& profile, size_t i)
+{
+    uint16_t* fields[] =
+    {
+        &profile.button_a,  &profile.button_b,  &profile.button_x,    &profile.button_y,
+        &profile.button_l3, &profile.button_r3, &profile.button_back, &profile.button_start,
+        &profile.button_lb, &profile.button_rb, &profile.button_sys,  &profile.button_misc
+    };
+    return fields[i];
+}
+
+uint8_t* dpad_fields(UserProfile& profile, size_t i)
+{
+    uint8_t* fields[] = { &profile.dpad_up, &profile.dpad_down, &profile.dpad_left, &profile.dpad_right };
+    return fields[i];
+}
+
+struct Mapping
+{
+    const char* name;
+    UserProfile profile;
+};
+
+std::vector<Mapping> mappings()
+{
+    std::vector<Mapping> list;
+    list.push_back({ "default", UserProfile() });
+
+    UserProfile profile;
+    std::swap(profile.button_a, profile.button_b);
+    std::swap(profile.button_x, profile.button_y);
+    std::swap(profile.dpad_up, profile.dpad_down);
+    list.push_back({ "swapped", profile });
+
+    for (int i = 0; i < 8; ++i)
+    {
+        //Shuffled, every input still lands on exactly one output
+        profile = UserProfile();
+        for (size_t j = 11; j > 0; --j)
+        {
+            std::swap(*button_fields(profile, j), *button_fields(profile, lcg() % (j + 1)));
+        }
+        for (size_t j = 3; j > 0; --j)
+        {
+            std::swap(*dpad_fields(profile, j), *dpad_fields(profile, lcg() % (j + 1)));
+        }
+        list.push_back({ "permutation", profile });
+    }
+    for (int i = 0; i < 8; ++i)
+    {
+        //Any mask, including none and bits past the ones the old code set
+        profile = UserProfile();
+        for (size_t j = 0; j < 12; ++j)
+        {
+            *button_fields(profile, j) = static_cast<uint16_t>(lcg() & ((j % 3 == 0) ? 0xFFFF : MAPPED_BUTTONS));
+        }
+        for (size_t j = 0; j < 4; ++j)
+        {
+            *dpad_fields(profile, j) = static_cast<uint8_t>(lcg() & 0x0F);
+        }
+        list.push_back({ "random_masks", profile });
+    }
+    return list;
+}
+
+struct Trigger
+{
+    const char* name;
+    TriggerSettings set;
+};
+
+std::vector<Trigger> triggers()
+{
+    std::vector<Trigger> list;
+    list.push_back({ "default", TriggerSettings() });
+
+    TriggerSettings set;
+    set.dz_inner = Fix16(0.1f);
+    list.push_back({ "dz_inner", set });
+
+    set = TriggerSettings();
+    set.dz_outer = Fix16(0.8f);
+    list.push_back({ "dz_outer", set });
+
+    set = TriggerSettings();
+    set.anti_dz_inner = Fix16(0.2f);
+    list.push_back({ "anti_dz_inner", set });
+
+    set = TriggerSettings();
+    set.anti_dz_outer = Fix16(0.9f);
+    list.push_back({ "anti_dz_outer", set });
+
+    set = TriggerSettings();
+    set.curve = Fix16(2.0f);
+    list.push_back({ "curve_2", set });
+
+    set = TriggerSettings();
+    set.curve = Fix16(0.5f);
+    list.push_back({ "curve_half", set });
+
+    set.dz_inner = Fix16(0.05f);
+    set.dz_outer = Fix16(0.95f);
+    set.anti_dz_inner = Fix16(0.1f);
+    set.anti_dz_outer = Fix16(0.85f);
+    list.push_back({ "combined", set });
+    return list;
+}
+
+uint64_t compared = 0;
+
+void check_mappings()
+{
+    for (const Mapping& mapping : mappings())
+    {
+        ProfileProgram program;
+        program.compile(mapping.profile);
+        ProfilePerBit reference;
+        reference.set_profile_mappings(mapping.profile);
+
+        for (uint32_t mask = 0; mask < 0x10000; ++mask)
+        {
+            const uint16_t canonical = static_cast<uint16_t>(mask);
+            const uint16_t expected = reference.buttons(canonical & MAPPED_BUTTONS) | (canonical & ~MAPPED_BUTTONS);
+            CHECK_SWEEP(program.buttons(canonical) == expected, "%s: buttons 0x%04x gave 0x%04x, expected 0x%04x",
+                        mapping.name, canonical, program.buttons(canonical), expected);
+            ++compared;
+        }
+        for (uint8_t dpad = 0; dpad < 16; ++dpad)
+        {
+            CHECK_SWEEP(program.dpad(dpad) == reference.dpad_bits(dpad), "%s: dpad bits 0x%x gave 0x%x, expected 0x%x",
+                        mapping.name, dpad, program.dpad(dpad), reference.dpad_bits(dpad));
+            ++compared;
+        }
+        const uint8_t HAT[] =
+        {
+            Gamepad::DPAD_NONE, Gamepad::DPAD_UP, Gamepad::DPAD_DOWN, Gamepad::DPAD_LEFT, Gamepad::DPAD_RIGHT,
+            Gamepad::DPAD_UP_LEFT, Gamepad::DPAD_UP_RIGHT, Gamepad::DPAD_DOWN_LEFT, Gamepad::DPAD_DOWN_RIGHT
+        };
+        for (uint8_t direction : HAT)
+        {
+            CHECK_SWEEP(program.dpad(direction) == reference.dpad_hat(direction), "%s: hat 0x%x gave 0x%x, expected 0x%x",
+                        mapping.name, direction, program.dpad(direction), reference.dpad_hat(direction));
+            ++compared;
+        }
+    }
+
+    //Nothing compiled yet, the identity
+    ProfileProgram program;
+    for (uint32_t mask = 0; mask < 0x10000; ++mask)
+    {
+        CHECK_SWEEP(program.buttons(static_cast<uint16_t>(mask)) == mask, "identity: buttons 0x%04x", mask);
+    }
+    for (uint8_t dpad = 0; dpad < 16; ++dpad)
+    {
+        CHECK_SWEEP(program.dpad(dpad) == dpad, "identity: dpad 0x%x", dpad);
+    }
+}
+
+void check_triggers()
+{
+    const ProfilePerBit reference;
+    for (const Trigger& trigger : triggers())
+    {
+        ProfileProgram program;
+        program.compile_trigger_l(trigger.set, true);
+        program.compile_trigger_r(trigger.set, false);
+
+        for (uint32_t value = 0; value < 256; ++value)
+        {
+            const uint8_t in = static_cast<uint8_t>(value);
+            const uint8_t expected = reference.apply_trigger_settings(in, trigger.set);
+            CHECK_SWEEP(program.trigger_l(in) == expected, "%s: trigger %u gave %u, expected %u",
+                        trigger.name, value, program.trigger_l(in), expected);
+            CHECK_SWEEP(program.trigger_r(in) == in, "%s: disabled trigger %u gave %u", trigger.name, value, program.trigger_r(in));
+            compared += 2;
+        }
+    }
+}
+
+//Raw settings the way the webapp stores them
+TriggerSettingsRaw to_raw(const TriggerSettings& set)
+{
+    TriggerSettingsRaw raw;
+    raw.dz_inner = set.dz_inner;
+    raw.dz_outer = set.dz_outer;
+    raw.anti_dz_inner = set.anti_dz_inner;
+    raw.anti_dz_outer = set.anti_dz_outer;
+    raw.curve = set.curve;
+    return raw;
+}
+
+void check_gamepad()
+{
+    //Gamepad only turns settings on that differ from what it has, so each profile gets a fresh one
+    const ProfilePerBit reference;
+    const std::vector<Trigger> list = triggers();
+    for (size_t i = 1; i < list.size(); ++i)
+    {
+        UserProfile profile;
+        profile.trigger_settings_l = to_raw(list[i].set);
+        std::swap(profile.button_a, profile.button_y);
+        profile.dpad_left = Gamepad::DPAD_RIGHT;
+
+        auto gamepad = std::make_unique<Gamepad>();
+        gamepad->set_profile(profile);
+
+        TriggerSettings set;
+        set.set_from_raw(profile.trigger_settings_l);
+        for (uint32_t value = 0; value < 256; ++value)
+        {
+            const uint8_t in = static_cast<uint8_t>(value);
+            CHECK_SWEEP(gamepad->scale_trigger_l(in) == reference.apply_trigger_settings(in, set), "gamepad %s: trigger_l %u",
+                        list[i].name, value);
+            CHECK_SWEEP(gamepad->scale_trigger_r(in) == in, "gamepad %s: trigger_r %u", list[i].name, value);
+        }
+        CHECK(gamepad->map_buttons(Gamepad::BUTTON_A | Gamepad::BUTTON_B) == (Gamepad::BUTTON_Y | Gamepad::BUTTON_B));
+        CHECK(gamepad->map_dpad(Gamepad::DPAD_UP_LEFT) == Gamepad::DPAD_UP_RIGHT);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    check_mappings();
+    check_triggers();
+    check_gamepad();
+
+    std::printf("{\"compared\": %llu}\n", static_cast<unsigned long long>(compared));
+
+    return check::result();
+}
@@ -0,0 +1,259 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cstddef>
+#include <array>
+
+#include "host_usb.h"
+
+#include "Gamepad/Gamepad.h"
+#include "USBHost/ReportFilter.h"
+#include "USBHost/HostDriver/PS4/PS4.h"
+#include "USBHost/HostDriver/PS5/PS5.h"
+#include "USBHost/HostDriver/SwitchPro/SwitchPro.h"
+#include "USBHost/HostDriver/HIDGeneric/HIDGeneric.h"
+
+#include "Check.h"
+
+// ReportFilter's word wise XOR and OR compare against a byte by byte reference, over random reports,
+// masks and lengths: the first report and any change under the mask get through, anything else is
+// dropped, short reports compare zero padded and a new mask lets the next report through. Then the
+// drivers' own masks: PS4 ignores its report counter but not the PS and touchpad bits sharing its
+// byte, PS5 ignores its counter and motion data, Switch Pro lets every report through until its init
+// is done and only looks at buttons and sticks after, and HIDGeneric keeps every byte of 64.
+// report_filter
+
+namespace {
+
+uint32_t lcg_state = 2024;
+
+uint32_t lcg()
+{
+    lcg_state = lcg_state * 1664525u + 1013904223u;
+    return lcg_state >> 8;
+}
+
+//Byte by byte version of ReportFilter::changed()
+struct ReferenceFilter
+{
+    std::array<uint8_t, ReportFilter::MAX_REPORT_SIZE> prev{};
+    const uint8_t* mask_data{nullptr};
+    bool has_prev{false};
+
+    bool changed(std::span<const uint8_t> mask, const uint8_t* report, uint16_t len)
+    {
+        if (mask.empty())
+        {
+            has_prev = false;
+            return true;
+        }
+        if (mask.data() != mask_data)
+        {
+            mask_data = mask.data();
+            has_prev = false;
+        }
+        std::array<uint8_t, ReportFilter::MAX_REPORT_SIZE> current{};
+        std::memcpy(current.data(), report, std::min<size_t>(len, mask.size()));
+
+        bool diff = !has_prev;
+        for (size_t i = 0; i < mask.size(); ++i)
+        {
+            diff |= ((current[i] ^ prev[i]) & mask[i]) != 0;
+        }
+        if (diff)
+        {
+            prev = current;
+            has_prev = true;
+        }
+        return diff;
+    }
+};
+
+void check_compare()
+{
+    //Masks of every length that isn't a whole number of words too
+    static std::array<std::array<uint8_t, ReportFilter::MAX_REPORT_SIZE>, 4> masks;
+    const size_t mask_lens[] = { 1, 7, 26, ReportFilter::MAX_REPORT_SIZE };
+    for (auto& mask : masks)
+    {
+        for (uint8_t& byte : mask)
+        {
+            //Mostly whole bytes kept or dropped, some single bits
+            const uint32_t pick = lcg() % 4;
+            byte = (pick == 0) ? 0x00 : (pick == 1) ? 0xFF : static_cast<uint8_t>(1u << (lcg() % 8));
+        }
+    }
+
+    ReportFilter filter;
+    ReferenceFilter reference;
+    uint8_t report[ReportFilter::MAX_REPORT_SIZE]{};
+    uint32_t passed = 0;
+    uint32_t dropped = 0;
+
+    for (uint32_t i = 0; i < 200000; ++i)
+    {
+        //Stay on one mask for a while, then move to another or to none
+        const size_t mask_idx = (i / 5000) % (std::size(masks) + 1);
+        const std::span<const uint8_t> mask = (mask_idx < std::size(masks))
+            ? std::span<const uint8_t>(masks[mask_idx].data(), mask_lens[mask_idx])
+            : std::span<const uint8_t>();
+
+        //Flip a bit or two now and then, most reports repeat the last one
+        if (lcg() % 3 == 0)
+        {
+            report[lcg() % sizeof(report)] ^= static_cast<uint8_t>(1u << (lcg() % 8));
+        }
+        const uint16_t len = static_cast<uint16_t>(1 + lcg() % sizeof(report));
+
+        const bool expected = reference.changed(mask, report, len);
+        CHECK_SWEEP(filter.changed(mask, report, len) == expected, "report %u, mask %zu, len %u", i, mask_idx, len);
+        (expected ? passed : dropped)++;
+    }
+    CHECK(filter.processed() == passed);
+    CHECK(filter.suppressed() == dropped);
+    CHECK(dropped > 10000 && passed > 10000);
+
+    //Short reports compare as if zero padded
+    static constexpr auto KEEP_4 = ReportFilter::Mask<4>().keep_all();
+    const uint8_t long_report[4] = { 1, 2, 0, 0 };
+    const uint8_t short_report[2] = { 1, 2 };
+    filter.reset();
+    CHECK(filter.changed(KEEP_4, long_report, sizeof(long_report)));
+    CHECK(!filter.changed(KEEP_4, short_report, sizeof(short_report)));
+    CHECK(filter.processed() == 1 && filter.suppressed() == 1);
+}
+
+void check_ps4()
+{
+    PS4Host driver(0);
+    ReportFilter filter;
+
+    //The full USB report, motion data and touchpad past the mask
+    uint8_t report[64]{};
+    PS4::InReport& in_report = *reinterpret_cast<PS4::InReport*>(report);
+    in_report.report_id = 1;
+    in_report.joystick_lx = 0x80;
+    CHECK(filter.changed(driver.report_mask(), report, sizeof(report)));
+
+    //Counter ticking every report
+    for (uint8_t counter = 1; counter < 64; ++counter)
+    {
+        in_report.buttons[2] = static_cast<uint8_t>(counter << 2);
+        CHECK_SWEEP(!filter.changed(driver.report_mask(), report, sizeof(report)), "counter %u", counter);
+    }
+    //Gyro and touchpad
+    report[sizeof(PS4::InReport) + 3] ^= 0x55;
+    report[40] ^= 0x01;
+    CHECK(!filter.changed(driver.report_mask(), report, sizeof(report)));
+
+    //PS and touchpad click share the counter's byte
+    in_report.buttons[2] |= 0x01;
+    CHECK(filter.changed(driver.report_mask(), report, sizeof(report)));
+    in_report.buttons[2] |= 0x02;
+    CHECK(filter.changed(driver.report_mask(), report, sizeof(report)));
+
+    in_report.buttons[0] ^= 0x10;
+    CHECK(filter.changed(driver.report_mask(), report, sizeof(report)));
+    in_report.trigger_r = 0xFF;
+    CHECK(filter.changed(driver.report_mask(), report, sizeof(report)));
+    CHECK(!filter.changed(driver.report_mask(), report, sizeof(report)));
+}
+
+void check_ps5()
+{
+    PS5Host driver(0);
+    ReportFilter filter;
+
+    PS5::InReport in_report;
+    CHECK(filter.changed(driver.report_mask(), reinterpret_cast<const uint8_t*>(&in_report), sizeof(in_report)));
+
+    //Counter, timestamps and motion data
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(&in_report);
+    for (size_t i = 0; i < sizeof(in_report); ++i)
+    {
+        const bool kept = (i >= offsetof(PS5::InReport, joystick_lx) && i < offsetof(PS5::InReport, joystick_lx) + 6) ||
+                          (i >= offsetof(PS5::InReport, buttons) && i < offsetof(PS5::InReport, buttons) + sizeof(PS5::InReport::buttons));
+        bytes[i] ^= 0x01;
+        CHECK_SWEEP(filter.changed(driver.report_mask(), bytes, sizeof(in_report)) == kept, "byte %zu", i);
+        if (!kept)
+        {
+            bytes[i] ^= 0x01;
+        }
+    }
+}
+
+void check_switch_pro()
+{
+    constexpr uint8_t ADDRESS = 1;
+    constexpr uint8_t INSTANCE = 0;
+
+    Gamepad gamepad;
+    SwitchProHost driver(0);
+    ReportFilter filter;
+
+    //Init replies all look alike, none may be dropped
+    const uint8_t reply[64] = { 0x21 };
+    CHECK(driver.report_mask().empty());
+    for (int i = 0; i < 4; ++i)
+    {
+        CHECK(filter.changed(driver.report_mask(), reply, sizeof(reply)));
+    }
+
+    //Every step in the hint, each completed send moves straight on to the next
+    driver.set_init_hint(0x3F);
+    driver.initialize(gamepad, ADDRESS, INSTANCE, nullptr, 0);
+    for (int step = 0; step < 6; ++step)
+    {
+        CHECK(!driver.init_done());
+        CHECK(driver.report_mask().empty());
+        driver.report_sent_cb(gamepad, ADDRESS, INSTANCE);
+    }
+    CHECK(driver.init_done());
+    CHECK(driver.report_mask().size() == sizeof(SwitchPro::InReport));
+
+    //Buttons and sticks only, the timer and motion data change every report
+    SwitchPro::InReport in_report{};
+    in_report.report_id = 0x30;
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&in_report);
+    CHECK(filter.changed(driver.report_mask(), bytes, sizeof(in_report)));
+    in_report.timer = 0x42;
+    in_report.info = 0x8E;
+    in_report.accelerX = 0x1234;
+    CHECK(!filter.changed(driver.report_mask(), bytes, sizeof(in_report)));
+    in_report.buttons[1] = SwitchPro::Buttons1::HOME;
+    CHECK(filter.changed(driver.report_mask(), bytes, sizeof(in_report)));
+    in_report.joysticks[5] = 0x80;
+    CHECK(filter.changed(driver.report_mask(), bytes, sizeof(in_report)));
+    CHECK(!filter.changed(driver.report_mask(), bytes, sizeof(in_report)));
+}
+
+void check_hid_generic()
+{
+    HIDHost driver(0);
+    ReportFilter filter;
+
+    CHECK(driver.report_mask().size() == ReportFilter::MAX_REPORT_SIZE);
+
+    //Any bit of any of the 64 bytes
+    uint8_t report[ReportFilter::MAX_REPORT_SIZE]{};
+    CHECK(filter.changed(driver.report_mask(), report, sizeof(report)));
+    for (size_t bit = 0; bit < sizeof(report) * 8; ++bit)
+    {
+        report[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+        CHECK_SWEEP(filter.changed(driver.report_mask(), report, sizeof(report)), "bit %zu", bit);
+        CHECK_SWEEP(!filter.changed(driver.report_mask(), report, sizeof(report)), "bit %zu repeated", bit);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    check_compare();
+    check_ps4();
+    check_ps5();
+    check_switch_pro();
+    check_hid_generic();
+
+    return check::result();
+}
@@ -0,0 +1,247 @@
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+#include "pico/time.h"
+
+#include "Gamepad/SeqLock.h"
+#include "Gamepad/Gamepad.h"
+#include "reference/MutexExchange.h"
+
+#include "Check.h"
+
+// One writer thread hammers a SeqLock<PadIn> and a SeqLock<PadOut> while a reader thread
+// checks every value it gets back is one complete write, and that generations never go backwards.
+// Then the same two thread load runs against the old mutex exchange for per-op latency.
+// seqlock_stress [seconds]
+
+namespace {
+
+//Every byte of a PadIn written as write number k is a function of k, the first four bytes hold k
+Gamepad::PadIn make_pad_in(uint32_t k)
+{
+    Gamepad::PadIn pad;
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(&pad);
+    std::memcpy(bytes, &k, sizeof(k));
+    for (size_t i = sizeof(k); i < sizeof(pad); ++i)
+    {
+        bytes[i] = static_cast<uint8_t>(k * 31 + i * 7);
+    }
+    return pad;
+}
+
+bool pad_in_whole(const Gamepad::PadIn& pad, uint32_t& k)
+{
+    std::memcpy(&k, &pad, sizeof(k));
+    const Gamepad::PadIn expected = make_pad_in(k);
+    return std::memcmp(&pad, &expected, sizeof(pad)) == 0;
+}
+
+Gamepad::PadOut make_pad_out(uint32_t k)
+{
+    Gamepad::PadOut pad;
+    pad.rumble_l = static_cast<uint8_t>(k);
+    pad.rumble_r = static_cast<uint8_t>(k ^ 0x5A);
+    return pad;
+}
+
+bool pad_out_whole(const Gamepad::PadOut& pad)
+{
+    return (pad.rumble_l ^ 0x5A) == pad.rumble_r;
+}
+
+void stress_seqlock(double seconds)
+{
+    static SeqLock<Gamepad::PadIn> pad_in;
+    static SeqLock<Gamepad::PadOut> pad_out;
+    std::atomic<bool> done{false};
+    std::atomic<uint32_t> writes{0};
+
+    //Write 0 goes in before the reader starts, a zeroed PadIn isn't make_pad_in(0)
+    pad_in.store(make_pad_in(0));
+    pad_out.store(make_pad_out(0));
+
+    std::thread writer([&]
+    {
+        uint32_t k = 1;
+        while (!done.load(std::memory_order_relaxed))
+        {
+            pad_in.store(make_pad_in(k));
+            pad_out.store(make_pad_out(k));
+            ++k;
+        }
+        writes.store(k - 1);
+    });
+
+    uint64_t reads = 0;
+    uint32_t torn = 0;
+    uint32_t backwards = 0;
+    uint32_t last_generation = 0;
+    uint32_t last_k = 0;
+    uint32_t last_out_generation = 0;
+
+    const auto end = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+    while (std::chrono::steady_clock::now() < end)
+    {
+        for (int i = 0; i < 256; ++i, ++reads)
+        {
+            const uint32_t polled = pad_in.generation();
+            if (polled < last_generation)
+            {
+                ++backwards;
+            }
+
+            uint32_t generation = 0;
+            uint32_t k = 0;
+            Gamepad::PadIn in = pad_in.load(generation);
+            if (!pad_in_whole(in, k))
+            {
+                ++torn;
+            }
+            //A value is never older than the generation polled before it, and k follows the writes
+            if (generation < polled || generation < last_generation || k < last_k)
+            {
+                ++backwards;
+            }
+            last_generation = generation;
+            last_k = k;
+
+            uint32_t out_generation = 0;
+            if (!pad_out_whole(pad_out.load(out_generation)))
+            {
+                ++torn;
+            }
+            if (out_generation < last_out_generation)
+            {
+                ++backwards;
+            }
+            last_out_generation = out_generation;
+        }
+    }
+    done = true;
+    writer.join();
+
+    std::printf("seqlock: %u writes, %llu reads, %u torn, %u backwards\n",
+        writes.load(), static_cast<unsigned long long>(reads), torn, backwards);
+
+    CHECK(writes.load() > 0);
+    CHECK(torn == 0);
+    CHECK(backwards == 0);
+    //Every store bumps the generation by 2
+    CHECK(pad_in.generation() == (writes.load() + 1) * 2);
+}
+
+//new_pad_in() is per consumer generation tracking, peeks don't consume
+void check_gamepad_generation()
+{
+    static Gamepad gamepad;
+    //The constructor's reset counts as new data, same as the old new_pad_in_ flag
+    CHECK(gamepad.new_pad_in());
+    (void)gamepad.get_pad_in();
+    CHECK(!gamepad.new_pad_in());
+
+    gamepad.set_pad_in(make_pad_in(7));
+    CHECK(gamepad.new_pad_in());
+    (void)gamepad.peek_pad_in();
+    CHECK(gamepad.new_pad_in());
+
+    uint32_t k = 0;
+    CHECK(pad_in_whole(gamepad.get_pad_in(), k) && k == 7);
+    CHECK(!gamepad.new_pad_in());
+
+    const uint32_t generation = gamepad.pad_in_generation();
+    gamepad.set_pad_in(make_pad_in(8));
+    gamepad.set_pad_in(make_pad_in(9));
+    CHECK(gamepad.pad_in_generation() == generation + 4);
+    CHECK(gamepad.new_pad_in());
+    CHECK(pad_in_whole(gamepad.get_pad_in(), k) && k == 9);
+    CHECK(!gamepad.new_pad_in());
+
+    (void)gamepad.get_pad_out();
+    gamepad.set_pad_out(make_pad_out(3));
+    CHECK(gamepad.new_pad_out());
+    CHECK(pad_out_whole(gamepad.get_pad_out()));
+    CHECK(!gamepad.new_pad_out());
+}
+
+struct Latency
+{
+    double store_ns;
+    double load_ns;
+};
+
+//Writer and reader both time their own ops while the other side runs, like core1 and core0 do
+template <typename Exchange>
+Latency measure(Exchange& exchange, double seconds)
+{
+    std::atomic<bool> done{false};
+    std::atomic<bool> started{false};
+    uint64_t stores = 0;
+    double store_ns = 0;
+
+    std::thread writer([&]
+    {
+        uint32_t k = 1;
+        started = true;
+        const auto start = std::chrono::steady_clock::now();
+        while (!done.load(std::memory_order_relaxed))
+        {
+            for (int i = 0; i < 64; ++i)
+            {
+                exchange.store(make_pad_in(k++));
+            }
+            stores += 64;
+        }
+        store_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    });
+    while (!started)
+    {
+        std::this_thread::yield();
+    }
+
+    uint64_t loads = 0;
+    uint32_t sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    const auto end = start + std::chrono::duration<double>(seconds);
+    auto now = start;
+    while (now < end)
+    {
+        for (int i = 0; i < 64; ++i)
+        {
+            sink += exchange.load().buttons;
+        }
+        loads += 64;
+        now = std::chrono::steady_clock::now();
+    }
+    const double load_ns = std::chrono::duration<double, std::nano>(now - start).count();
+    done = true;
+    writer.join();
+    asm volatile("" : : "r"(sink));
+
+    return { store_ns / static_cast<double>(stores), load_ns / static_cast<double>(loads) };
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const double seconds = (argc > 1) ? std::atof(argv[1]) : 1.0;
+
+    check_gamepad_generation();
+    stress_seqlock(seconds);
+
+    static SeqLock<Gamepad::PadIn> seqlock;
+    static MutexExchange<Gamepad::PadIn> mutex;
+    const Latency seq = measure(seqlock, seconds / 2);
+    const Latency mtx = measure(mutex, seconds / 2);
+
+    //With one CPU the two threads time-slice, so these are per-op costs rather than wait times
+    std::printf("{\"seqlock\": {\"store_ns\": %.1f, \"load_ns\": %.1f}, \"mutex\": {\"store_ns\": %.1f, \"load_ns\": %.1f}, \"cpus\": %u}\n",
+        seq.store_ns, seq.load_ns, mtx.store_ns, mtx.load_ns, std::thread::hardware_concurrency());
+
+    return check::result();
+}
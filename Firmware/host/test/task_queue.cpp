@@ -0,0 +1,284 @@
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <vector>
+#include <algorithm>
+
+#include "pico/time.h"
+#include "hardware/timer.h"
+
+#include "TaskQueue/TaskQueue.h"
+#include "TaskQueue/TimerHeap.h"
+
+#include "Check.h"
+
+// TaskQueue's delayed tasks: TimerHeap on its own has to hand timers back in target order, find and
+// cancel them through its id table with colliding ids, skip missed periods of repeating timers and
+// match a reference map through a random insert and cancel soak. Then core 1's queue with its alarm
+// and IRQ driven by the host alarm stand-in: tasks run at their 64-bit target across a 32-bit wrap,
+// a target more than 2^31 us away gets an intermediate wake, a target already reached while arming
+// forces the IRQ through INTF, and a full heap drops the task and counts it.
+// Prints the heap's size on this host as JSON.
+// task_queue
+
+namespace {
+
+constexpr size_t CAPACITY = 64;
+using Heap = TimerHeap<TaskQueue::Function, CAPACITY>;
+
+constexpr uint32_t ALARM_NUM = 1; //Core 1's
+constexpr uint64_t MAX_ALARM_US = 0x7FFFFFFF;
+
+uint32_t lcg_state = 12345;
+
+uint32_t lcg()
+{
+    lcg_state = lcg_state * 1664525u + 1013904223u;
+    return lcg_state >> 8;
+}
+
+//Same hash as TimerHeap's id table
+size_t home_of(uint32_t task_id)
+{
+    return (task_id * 2654435761u) % (CAPACITY * 2);
+}
+
+void check_heap_order()
+{
+    Heap heap;
+    std::vector<uint64_t> fired;
+    uint64_t targets[CAPACITY];
+
+    for (uint32_t id = 1; id <= CAPACITY; ++id)
+    {
+        targets[id - 1] = 1000 + lcg() % 5000;
+        const uint64_t target = targets[id - 1];
+        CHECK(heap.insert(id, target, 0, [&fired, target] { fired.push_back(target); }));
+    }
+    CHECK(heap.size() == CAPACITY);
+    CHECK(!heap.insert(CAPACITY + 1, 0, 0, [] {}));
+    CHECK(!heap.insert(0, 0, 0, [] {}));
+    CHECK(heap.next_target() == *std::min_element(targets, targets + CAPACITY));
+
+    //Half way, only what is due comes out
+    heap.pop_expired(3500, [](const TaskQueue::Function& function) { function(); });
+    const size_t due = static_cast<size_t>(std::count_if(targets, targets + CAPACITY, [](uint64_t t) { return t <= 3500; }));
+    CHECK(fired.size() == due);
+    CHECK(heap.size() == CAPACITY - due);
+
+    heap.pop_expired(UINT64_MAX, [](const TaskQueue::Function& function) { function(); });
+    CHECK(fired.size() == CAPACITY);
+    CHECK(std::is_sorted(fired.begin(), fired.end()));
+    CHECK(heap.empty());
+
+    //A repeating timer fires once for all the periods it missed and keeps its interval from now
+    uint32_t repeats = 0;
+    CHECK(heap.insert(7, 100, 50, [&repeats] { ++repeats; }));
+    heap.pop_expired(420, [](const TaskQueue::Function& function) { function(); });
+    CHECK(repeats == 1);
+    CHECK(heap.next_target() == 470);
+    heap.pop_expired(470, [](const TaskQueue::Function& function) { function(); });
+    CHECK(repeats == 2);
+    CHECK(heap.next_target() == 520);
+    CHECK(heap.cancel(7));
+    CHECK(heap.empty());
+}
+
+void check_heap_cancel()
+{
+    //Ids that share a home in the id table, so they sit in one probe chain
+    std::vector<uint32_t> chain;
+    const size_t home = home_of(1);
+    for (uint32_t id = 1; chain.size() < 6; ++id)
+    {
+        if (home_of(id) == home)
+        {
+            chain.push_back(id);
+        }
+    }
+
+    Heap heap;
+    uint32_t fired_mask = 0;
+    for (size_t i = 0; i < chain.size(); ++i)
+    {
+        CHECK(heap.insert(chain[i], 100 + i, 0, [&fired_mask, i] { fired_mask |= 1u << i; }));
+    }
+    CHECK(!heap.insert(chain[2], 0, 0, [] {}));
+
+    //Out of the middle of the chain, the entries behind it have to stay reachable
+    CHECK(heap.cancel(chain[2]));
+    CHECK(!heap.cancel(chain[2]));
+    CHECK(heap.cancel(chain[0]));
+    for (size_t i = 0; i < chain.size(); ++i)
+    {
+        CHECK_SWEEP(heap.contains(chain[i]) == (i != 0 && i != 2), "chain id %u", chain[i]);
+    }
+    CHECK(heap.next_target() == 101);
+
+    heap.pop_expired(UINT64_MAX, [](const TaskQueue::Function& function) { function(); });
+    CHECK(fired_mask == 0b111010);
+
+    //Random inserts and cancels against a map of what should be left
+    std::map<uint32_t, uint64_t> expected;
+    for (uint32_t step = 0; step < 20000; ++step)
+    {
+        const uint32_t id = 1 + lcg() % (CAPACITY * 3);
+        if (lcg() & 1)
+        {
+            const uint64_t target = lcg();
+            const bool inserted = heap.insert(id, target, 0, [] {});
+            CHECK_SWEEP(inserted == (!expected.count(id) && expected.size() < CAPACITY), "step %u insert %u", step, id);
+            if (inserted)
+            {
+                expected[id] = target;
+            }
+        }
+        else
+        {
+            CHECK_SWEEP(heap.cancel(id) == (expected.erase(id) == 1), "step %u cancel %u", step, id);
+        }
+
+        CHECK_SWEEP(heap.size() == expected.size(), "step %u size", step);
+        if (!expected.empty())
+        {
+            const auto earliest = std::min_element(expected.begin(), expected.end(),
+                [](const auto& a, const auto& b) { return a.second < b.second; });
+            CHECK_SWEEP(heap.next_target() == earliest->second, "step %u next target", step);
+        }
+    }
+    for (uint32_t id = 1; id <= CAPACITY * 3; ++id)
+    {
+        CHECK_SWEEP(heap.contains(id) == (expected.count(id) == 1), "id %u after soak", id);
+    }
+}
+
+uint32_t alarm_value()
+{
+    return timer_hw->alarm[ALARM_NUM];
+}
+
+//Core 1's loop: the alarm IRQ, then the tasks it queued, every STEP_US up to us
+constexpr uint64_t STEP_US = 100;
+
+void run_until(uint64_t us)
+{
+    do
+    {
+        host_alarm::run_until(std::min(host_time::now_us() + STEP_US, us));
+        TaskQueue::Core1::process_tasks();
+    } while (host_time::now_us() < us);
+}
+
+void check_alarm()
+{
+    std::vector<uint64_t> ran_at;
+    auto record = [&ran_at] { ran_at.push_back(time_us_64()); };
+
+    //In target order, each at its own time
+    uint64_t start_us = 1000000;
+    host_time::set_us(start_us);
+    const uint32_t delays_ms[] = { 7, 2, 9, 4, 1 };
+    for (uint32_t delay_ms : delays_ms)
+    {
+        CHECK(TaskQueue::Core1::queue_delayed_task(TaskQueue::Core1::get_new_task_id(), delay_ms, false, record));
+    }
+    CHECK(alarm_value() == static_cast<uint32_t>(start_us + 1000));
+    run_until(start_us + 10000);
+    CHECK(ran_at.size() == 5);
+    const uint64_t expected_ms[] = { 1, 2, 4, 7, 9 };
+    for (size_t i = 0; i < std::min<size_t>(ran_at.size(), 5); ++i)
+    {
+        CHECK_SWEEP(ran_at[i] == start_us + expected_ms[i] * 1000, "task %zu ran at %llu", i,
+                    static_cast<unsigned long long>(ran_at[i] - start_us));
+    }
+
+    //Cancelled, the alarm moves on to the next one
+    ran_at.clear();
+    start_us = host_time::now_us();
+    const uint32_t cancelled = TaskQueue::Core1::get_new_task_id();
+    CHECK(TaskQueue::Core1::queue_delayed_task(cancelled, 3, false, record));
+    CHECK(TaskQueue::Core1::queue_delayed_task(TaskQueue::Core1::get_new_task_id(), 6, false, record));
+    CHECK(!TaskQueue::Core1::queue_delayed_task(cancelled, 1, false, record));
+    TaskQueue::Core1::cancel_delayed_task(cancelled);
+    CHECK(alarm_value() == static_cast<uint32_t>(start_us + 6000));
+    run_until(start_us + 10000);
+    CHECK(ran_at.size() == 1 && ran_at[0] == start_us + 6000);
+
+    //Repeating
+    ran_at.clear();
+    start_us = host_time::now_us();
+    const uint32_t repeating = TaskQueue::Core1::get_new_task_id();
+    CHECK(TaskQueue::Core1::queue_delayed_task(repeating, 10, true, record));
+    run_until(start_us + 55000);
+    TaskQueue::Core1::cancel_delayed_task(repeating);
+    CHECK(ran_at.size() == 5);
+    CHECK(!ran_at.empty() && ran_at.back() == start_us + 50000);
+
+    //Across the 32-bit wrap: the alarm holds the low 32 bits, the task runs at its 64-bit target
+    ran_at.clear();
+    start_us = (5ull << 32) - 2000;
+    host_time::set_us(start_us);
+    CHECK(TaskQueue::Core1::queue_delayed_task(TaskQueue::Core1::get_new_task_id(), 5, false, record));
+    CHECK(alarm_value() == 3000);
+    run_until(start_us + 4900);
+    CHECK(ran_at.empty());
+    run_until(start_us + 10000);
+    CHECK(ran_at.size() == 1 && ran_at[0] == start_us + 5000);
+
+    //Over 2^31 us away: woken at the cap with nothing to run, then re-armed for the target
+    ran_at.clear();
+    start_us = host_time::now_us();
+    const uint32_t far_ms = 3000000;
+    const uint64_t far_us = static_cast<uint64_t>(far_ms) * 1000;
+    CHECK(TaskQueue::Core1::queue_delayed_task(TaskQueue::Core1::get_new_task_id(), far_ms, false, record));
+    CHECK(alarm_value() == static_cast<uint32_t>(start_us + MAX_ALARM_US));
+    host_alarm::run_until(start_us + MAX_ALARM_US);
+    TaskQueue::Core1::process_tasks();
+    CHECK(ran_at.empty());
+    CHECK(alarm_value() == static_cast<uint32_t>(start_us + far_us));
+    host_alarm::run_until(start_us + far_us - 1);
+    run_until(start_us + far_us);
+    CHECK(ran_at.size() == 1 && ran_at[0] == start_us + far_us);
+
+    //Already due when armed: the alarm can't match a time that has come, INTF raises the IRQ
+    ran_at.clear();
+    start_us = host_time::now_us();
+    CHECK(TaskQueue::Core1::queue_delayed_task(TaskQueue::Core1::get_new_task_id(), 0, false, record));
+    CHECK(alarm_value() == static_cast<uint32_t>(start_us));
+    CHECK(timer_hw->intf & (1u << ALARM_NUM));
+    run_until(start_us);
+    CHECK(ran_at.size() == 1 && ran_at[0] == start_us);
+    CHECK(!(timer_hw->intf & (1u << ALARM_NUM)));
+
+    //Full: the next one is refused and counted
+    std::vector<uint32_t> ids;
+    const uint32_t dropped = TaskQueue::Core1::dropped_tasks();
+    for (size_t i = 0; i < CAPACITY; ++i)
+    {
+        ids.push_back(TaskQueue::Core1::get_new_task_id());
+        CHECK(TaskQueue::Core1::queue_delayed_task(ids.back(), 1000, false, record));
+    }
+    CHECK(!TaskQueue::Core1::queue_delayed_task(TaskQueue::Core1::get_new_task_id(), 1000, false, record));
+    CHECK(TaskQueue::Core1::dropped_tasks() == dropped + 1);
+    for (uint32_t id : ids)
+    {
+        TaskQueue::Core1::cancel_delayed_task(id);
+    }
+    ran_at.clear();
+    host_alarm::run_until(host_time::now_us() + 2000000);
+    TaskQueue::Core1::process_tasks();
+    CHECK(ran_at.empty());
+}
+
+} // namespace
+
+int main()
+{
+    check_heap_order();
+    check_heap_cancel();
+    check_alarm();
+
+    std::printf("{\"timer_heap_bytes\": %zu, \"timers\": %zu}\n", sizeof(Heap), CAPACITY);
+
+    return check::result();
+}
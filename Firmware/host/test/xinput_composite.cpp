@@ -0,0 +1,242 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+#include "host_usb.h"
+
+#include "Board/Config.h"
+#include "Descriptors/XInput.h"
+#include "USBDevice/DeviceDriver/XInput/tud_xinput/tud_xinput.h"
+#include "UserSettings/UserSettings.h"
+
+#include "Check.h"
+
+// The composite XInput device, one wired controller interface per gamepad. The descriptors are
+// walked the way a host would: the device class is left to the interfaces, wTotalLength and
+// bNumInterfaces match what follows, and interface n is numbered n with IN endpoint 0x81 + n and
+// OUT endpoint 0x01 + n in both its endpoint descriptors and the unknown 0x21 descriptor. Interface 0
+// is byte for byte the interface of the single pad descriptor from before. Then the real tud_xinput
+// class driver (linked over the host stand-in) opens every interface from that descriptor and each
+// gamepad index has to land on its own endpoints for reports, rumble and report_complete_cb.
+// Finally XINPUT has to be a valid driver with more than one gamepad.
+// xinput_composite
+
+namespace {
+
+constexpr uint8_t RHPORT = 0;
+constexpr uint8_t DESC_INTERFACE = 0x04;
+constexpr uint8_t DESC_ENDPOINT = 0x05;
+constexpr uint8_t DESC_XINPUT = 0x21;
+
+//The single pad configuration before the composite one, interface and endpoints after the 9 byte header
+const uint8_t SINGLE_PAD_INTERFACE[] =
+{
+    0x09, 0x04, 0x00, 0x00, 0x02, 0xFF, 0x5D, 0x01, 0x00,
+    0x10, 0x21, 0x00, 0x01, 0x01, 0x24, 0x81, 0x14, 0x03, 0x00, 0x03, 0x13, 0x01, 0x00, 0x03, 0x00,
+    0x07, 0x05, 0x81, 0x03, 0x20, 0x00, 0x01,
+    0x07, 0x05, 0x01, 0x03, 0x20, 0x00, 0x08,
+};
+static_assert(sizeof(SINGLE_PAD_INTERFACE) == XInput::INTERFACE_DESC_LEN);
+
+struct Interface
+{
+    const uint8_t* desc;
+    uint8_t number;
+    uint8_t xinput_in;
+    uint8_t xinput_out;
+    std::vector<const uint8_t*> endpoints;
+};
+
+std::vector<Interface> walk_configuration()
+{
+    const uint8_t* config = XInput::DESC_CONFIGURATION;
+    const uint16_t total_len = static_cast<uint16_t>(config[2] | (config[3] << 8));
+    CHECK(total_len == sizeof(XInput::DESC_CONFIGURATION));
+    CHECK(total_len == 9 + XInput::INTERFACE_DESC_LEN * XINPUT_MAX_GAMEPADS);
+
+    std::vector<Interface> interfaces;
+    size_t offset = config[0];
+    while (offset < total_len)
+    {
+        const uint8_t* desc = config + offset;
+        const bool fits = desc[0] >= 2 && offset + desc[0] <= total_len;
+        CHECK(fits);
+        if (!fits)
+        {
+            break;
+        }
+
+        if (desc[1] == DESC_INTERFACE)
+        {
+            interfaces.push_back({ desc, desc[2], 0, 0, {} });
+        }
+        else if (!interfaces.empty() && desc[1] == DESC_XINPUT)
+        {
+            interfaces.back().xinput_in = desc[6];
+            interfaces.back().xinput_out = desc[12];
+        }
+        else if (!interfaces.empty() && desc[1] == DESC_ENDPOINT)
+        {
+            interfaces.back().endpoints.push_back(desc);
+        }
+        offset += desc[0];
+    }
+    CHECK(offset == total_len);
+    CHECK(config[4] == interfaces.size());
+    return interfaces;
+}
+
+void check_descriptors()
+{
+    //Class 0 so the host looks at each interface, a single pad keeps the vendor class
+    CHECK(XInput::DESC_DEVICE[4] == ((XINPUT_MAX_GAMEPADS > 1) ? 0x00 : 0xFF));
+    CHECK(XInput::DESC_DEVICE[0] == sizeof(XInput::DESC_DEVICE));
+
+    const std::vector<Interface> interfaces = walk_configuration();
+    CHECK(interfaces.size() == XINPUT_MAX_GAMEPADS);
+
+    std::vector<uint8_t> addresses;
+    for (size_t i = 0; i < interfaces.size(); ++i)
+    {
+        const Interface& itf = interfaces[i];
+        const uint8_t ep_in = static_cast<uint8_t>(0x81 + i);
+        const uint8_t ep_out = static_cast<uint8_t>(0x01 + i);
+
+        CHECK_SWEEP(itf.number == i, "interface %zu numbered %u", i, itf.number);
+        CHECK_SWEEP(itf.desc[5] == 0xFF && itf.desc[6] == 0x5D && itf.desc[7] == 0x01, "interface %zu class", i);
+        CHECK_SWEEP(itf.desc[4] == 2 && itf.endpoints.size() == 2, "interface %zu has %zu endpoints", i, itf.endpoints.size());
+        CHECK_SWEEP(itf.xinput_in == ep_in && itf.xinput_out == ep_out, "interface %zu 0x21 descriptor has %02X %02X",
+                    i, itf.xinput_in, itf.xinput_out);
+        CHECK_SWEEP(itf.endpoints.size() == 2 && itf.endpoints[0][2] == ep_in && itf.endpoints[1][2] == ep_out,
+                    "interface %zu endpoint addresses", i);
+
+        //Same pipes on every interface, only the numbers move
+        CHECK_SWEEP(std::memcmp(itf.desc, SINGLE_PAD_INTERFACE, 2) == 0 &&
+                    std::memcmp(itf.desc + 3, SINGLE_PAD_INTERFACE + 3, 12) == 0 &&
+                    std::memcmp(itf.desc + 16, SINGLE_PAD_INTERFACE + 16, 5) == 0 &&
+                    std::memcmp(itf.desc + 22, SINGLE_PAD_INTERFACE + 22, 5) == 0 &&
+                    std::memcmp(itf.desc + 28, SINGLE_PAD_INTERFACE + 28, 6) == 0 &&
+                    std::memcmp(itf.desc + 35, SINGLE_PAD_INTERFACE + 35, 4) == 0, "interface %zu differs past its numbers", i);
+
+        for (const uint8_t* ep : itf.endpoints)
+        {
+            addresses.push_back(ep[2]);
+        }
+    }
+    std::sort(addresses.begin(), addresses.end());
+    CHECK(std::adjacent_find(addresses.begin(), addresses.end()) == addresses.end());
+
+    CHECK(std::memcmp(XInput::DESC_CONFIGURATION + 9, SINGLE_PAD_INTERFACE, sizeof(SINGLE_PAD_INTERFACE)) == 0);
+}
+
+uint32_t completed_mask = 0;
+
+} // namespace
+
+void tud_xinput::report_complete_cb(uint8_t index)
+{
+    completed_mask |= 1u << index;
+}
+
+namespace {
+
+void check_class_driver()
+{
+    host_usb::reset();
+    const usbd_class_driver_t* driver = tud_xinput::class_driver();
+    driver->init();
+
+    //Before anything is opened no index has endpoints
+    uint8_t report[XInput::ENDPOINT_OUT_SIZE]{};
+    CHECK(!tud_xinput::send_report_ready(0));
+
+    //A HID interface ahead of them isn't claimed
+    const uint8_t HID_INTERFACE[] = { 0x09, 0x04, 0x00, 0x00, 0x01, 0x03, 0x00, 0x00, 0x00 };
+    CHECK(driver->open(RHPORT, reinterpret_cast<const tusb_desc_interface_t*>(HID_INTERFACE), sizeof(HID_INTERFACE)) == 0);
+
+    //usbd hands each interface over with what's left of the configuration
+    const std::vector<Interface> interfaces = walk_configuration();
+    CHECK(interfaces.size() == XINPUT_MAX_GAMEPADS);
+    if (interfaces.empty())
+    {
+        return;
+    }
+    const uint8_t* end = XInput::DESC_CONFIGURATION + sizeof(XInput::DESC_CONFIGURATION);
+    for (size_t i = 0; i < interfaces.size(); ++i)
+    {
+        const uint16_t claimed = driver->open(RHPORT, reinterpret_cast<const tusb_desc_interface_t*>(interfaces[i].desc),
+                                              static_cast<uint16_t>(end - interfaces[i].desc));
+        CHECK_SWEEP(claimed == XInput::INTERFACE_DESC_LEN, "interface %zu claimed %u bytes", i, claimed);
+    }
+
+    const std::vector<uint8_t>& opened = host_usb::device_endpoints();
+    CHECK(opened.size() == 2 * XINPUT_MAX_GAMEPADS);
+    for (size_t i = 0; i < XINPUT_MAX_GAMEPADS && 2 * i + 1 < opened.size(); ++i)
+    {
+        CHECK_SWEEP(opened[2 * i] == 0x81 + i && opened[2 * i + 1] == 0x01 + i, "interface %zu opened %02X %02X",
+                    i, opened[2 * i], opened[2 * i + 1]);
+    }
+
+    //No room for another one
+    CHECK(driver->open(RHPORT, reinterpret_cast<const tusb_desc_interface_t*>(interfaces[0].desc),
+                       XInput::INTERFACE_DESC_LEN) == 0);
+
+    //Each gamepad index on its own endpoints
+    for (uint8_t idx = 0; idx < XINPUT_MAX_GAMEPADS; ++idx)
+    {
+        const size_t transfers = host_usb::device_transfers().size();
+        XInput::InReport in_report;
+        CHECK_SWEEP(tud_xinput::send_report_ready(idx), "gamepad %u not ready", idx);
+        CHECK_SWEEP(tud_xinput::send_report(idx, reinterpret_cast<const uint8_t*>(&in_report), sizeof(in_report)),
+                    "gamepad %u send", idx);
+        CHECK_SWEEP(tud_xinput::receive_report(idx, report, sizeof(report)), "gamepad %u receive", idx);
+
+        const std::vector<host_usb::DeviceTransfer>& sent = host_usb::device_transfers();
+        CHECK_SWEEP(sent.size() == transfers + 2, "gamepad %u started %zu transfers", idx, sent.size() - transfers);
+        if (sent.size() == transfers + 2)
+        {
+            CHECK_SWEEP(sent[transfers].ep_addr == 0x81 + idx && sent[transfers].len == sizeof(XInput::InReport),
+                        "gamepad %u report went to %02X", idx, sent[transfers].ep_addr);
+            CHECK_SWEEP(sent[transfers + 1].ep_addr == 0x01 + idx, "gamepad %u rumble read from %02X", idx, sent[transfers + 1].ep_addr);
+        }
+
+        completed_mask = 0;
+        CHECK_SWEEP(driver->xfer_cb(RHPORT, static_cast<uint8_t>(0x81 + idx), XFER_RESULT_SUCCESS, sizeof(XInput::InReport)),
+                    "gamepad %u xfer_cb", idx);
+        CHECK_SWEEP(completed_mask == (1u << idx), "gamepad %u completion went to %08X", idx, completed_mask);
+
+        //Rumble coming in re-arms the same OUT endpoint
+        const size_t before_out = host_usb::device_transfers().size();
+        driver->xfer_cb(RHPORT, static_cast<uint8_t>(0x01 + idx), XFER_RESULT_SUCCESS, sizeof(XInput::OutReport));
+        CHECK_SWEEP(completed_mask == (1u << idx), "gamepad %u OUT completion counted as IN", idx);
+        CHECK_SWEEP(host_usb::device_transfers().size() == before_out + 1 &&
+                    host_usb::device_transfers().back().ep_addr == 0x01 + idx, "gamepad %u OUT not re-armed", idx);
+    }
+    CHECK(!tud_xinput::send_report_ready(XINPUT_MAX_GAMEPADS));
+
+    //Bus reset forgets the interfaces
+    driver->reset(RHPORT);
+    CHECK(!tud_xinput::send_report_ready(0));
+}
+
+void check_valid_driver()
+{
+    CHECK(UserSettings::get_instance().is_valid_driver(DeviceDriverType::XINPUT));
+}
+
+} // namespace
+
+int main()
+{
+    check_descriptors();
+    check_class_driver();
+    check_valid_driver();
+
+    std::printf("{\"interfaces\": %u, \"config_desc_len\": %u, \"interface_desc_len\": %u}\n",
+        static_cast<unsigned int>(XINPUT_MAX_GAMEPADS), static_cast<unsigned int>(sizeof(XInput::DESC_CONFIGURATION)),
+        static_cast<unsigned int>(XInput::INTERFACE_DESC_LEN));
+
+    return check::result();
+}
@@ -0,0 +1,286 @@
+import sys
+import struct
+import argparse
+import subprocess
+
+# Reads host report captures from firmware built with EN_REPORT_CAPTURE.
+#   dump:   request a capture over the WebApp serial port and save it to a file
+#   replay: walk a saved capture in order, printing each report and its timing
+#           with --native, feed it through the host build's drivers instead (Firmware/host, report_replay)
+#   connect-times: print where the time went in the last few host connects, needs any USB host build
+#   frame-sync: print how host reports line up with the console's frames, needs any USB host build
+
+PACKET_SIZE = 64
+PACKET_HEADER = struct.Struct("<BBBBBBBBB")
+PACKET_ID_GET_CAPTURE = 0x90
+PACKET_ID_GET_CONNECT_TIMES = 0x91
+PACKET_ID_GET_FRAME_SYNC = 0x92
+PACKET_ID_RESP_ERROR = 0xFF
+DEVICE_DRIVER_WEBAPP = 100
+
+DUMP_MAGIC = 0x4F43504E
+DUMP_HEADER = struct.Struct("<IBBHI")
+RECORD_HEADER = struct.Struct("<IBBBBH")
+RECORD_DATA_SIZE = 64
+
+CONNECT_ENTRY = struct.Struct("<HHBBBB5I")
+STAGE_NAMES = ["attach", "enumerated", "driver setup", "init done", "first pad in"]
+
+FRAME_SYNC_STATS = struct.Struct("<BBHIHH8I")
+FRAME_US = 1000
+
+KIND_NAMES = ["REPORT", "MOUNT", "UNMOUNT"]
+
+# Order of HostDriverType in USBHost/HostDriver/HostDriverTypes.h
+HOST_DRIVER_NAMES = [
+    "UNKNOWN", "SWITCH_PRO", "SWITCH", "PSCLASSIC", "DINPUT", "PS3", "PS4", "PS5", "N64",
+    "XBOXOG", "XBOXONE", "XBOX360W", "XBOX360", "XBOX360_CHATPAD", "HID_GENERIC"
+]
+
+# Device drivers report_replay can build, see Firmware/host/replay/Replay.cpp
+DEVICE_DRIVER_NAMES = ["xinput", "ps3", "dinput", "psclassic", "switch", "xboxog", "ps4"]
+
+def packet(packet_id):
+    header = PACKET_HEADER.pack(PACKET_SIZE, packet_id, DEVICE_DRIVER_WEBAPP, 0, 0, 0, 0, 0, 0)
+    return header + bytes(PACKET_SIZE - len(header))
+
+def open_serial(port, timeout):
+    try:
+        import serial
+    except ImportError:
+        print("Error: this command needs pyserial, install it with 'pip install pyserial'")
+        return None
+    return serial.Serial(port, timeout=timeout)
+
+# Sends a request and joins the chunked response, None on error, b"" if the firmware has nothing to send
+def request(ser, packet_id):
+    ser.reset_input_buffer()
+    ser.write(packet(packet_id))
+
+    chunks = {}
+    chunks_total = None
+    while chunks_total is None or len(chunks) < chunks_total:
+        data = ser.read(PACKET_SIZE)
+        if len(data) < PACKET_SIZE:
+            print("Error: timed out waiting for response packets")
+            return None
+
+        _, resp_id, _, _, _, _, total, idx, length = PACKET_HEADER.unpack_from(data)
+        if resp_id == PACKET_ID_RESP_ERROR:
+            print("Error: device failed to send the response")
+            return None
+        if resp_id != packet_id:
+            continue # Gamepad input packets keep arriving in web app mode
+        if total == 0:
+            return b""
+
+        chunks_total = total
+        chunks[idx] = data[PACKET_HEADER.size:PACKET_HEADER.size + length]
+
+    return b"".join(chunks[i] for i in range(chunks_total))
+
+def dump(port, out_path, timeout):
+    ser = open_serial(port, timeout)
+    if ser is None:
+        return 1
+    with ser:
+        capture = request(ser, PACKET_ID_GET_CAPTURE)
+
+    if capture is None:
+        return 1
+    if not capture:
+        print("Error: firmware was built without EN_REPORT_CAPTURE")
+        return 1
+
+    with open(out_path, "wb") as f:
+        f.write(capture)
+
+    print(f"Saved {len(capture)} bytes to {out_path}")
+    return 0
+
+def connect_times(port, timeout):
+    ser = open_serial(port, timeout)
+    if ser is None:
+        return 1
+    with ser:
+        data = request(ser, PACKET_ID_GET_CONNECT_TIMES)
+
+    if data is None:
+        return 1
+    if not data:
+        print("Error: firmware was built without USB host")
+        return 1
+
+    count = data[0]
+    print(f"{count} connects since boot, oldest first, times relative to the first stage seen")
+    for i in range(count):
+        vid, pid, address, instance, driver_type, cached, *stages = CONNECT_ENTRY.unpack_from(data, 1 + i * CONNECT_ENTRY.size)
+        start_us = next((us for us in stages if us), 0)
+        steps = ", ".join(f"{STAGE_NAMES[s]} {(us - start_us) & 0xFFFFFFFF} us" for s, us in enumerate(stages) if us)
+        print(f"{vid:04x}:{pid:04x} addr {address} itf {instance} {name(HOST_DRIVER_NAMES, driver_type)}"
+              f"{' (cached)' if cached else ''}: {steps}")
+
+    return 0
+
+def frame_sync(port, timeout):
+    ser = open_serial(port, timeout)
+    if ser is None:
+        return 1
+    with ser:
+        data = request(ser, PACKET_ID_GET_FRAME_SYNC)
+
+    if data is None:
+        return 1
+    if not data:
+        print("Error: firmware was built without USB host")
+        return 1
+
+    aligned, locked, lead_us, sof_count, sof_min_us, sof_max_us, *buckets = FRAME_SYNC_STATS.unpack_from(data)
+    print(f"host frames {'aligned, ' + ('locked' if locked else 'not locked') if aligned else 'free running'}, "
+          f"target {lead_us} us before the console's SOF")
+    if sof_count < 2:
+        print("No console SOFs seen yet")
+        return 0
+    print(f"{sof_count} console SOFs, interval min {sof_min_us} max {sof_max_us} us")
+
+    total = sum(buckets)
+    if not total:
+        print("No host reports seen yet")
+        return 0
+
+    # Phase is circular, so the spread is measured around the busiest bucket rather than from zero
+    bucket_us = FRAME_US // len(buckets)
+    peak = max(range(len(buckets)), key=lambda i: buckets[i])
+    offsets = [((i - peak + len(buckets) // 2) % len(buckets) - len(buckets) // 2) * bucket_us for i in range(len(buckets))]
+    mean = sum(o * n for o, n in zip(offsets, buckets)) / total
+    jitter = (sum(n * (o - mean) ** 2 for o, n in zip(offsets, buckets)) / total) ** 0.5
+    phase = (peak * bucket_us + bucket_us // 2 + mean) % FRAME_US
+
+    print(f"{total} host reports, phase after the console's SOF {phase:.0f} us, jitter {jitter:.0f} us")
+    for i, count in enumerate(buckets):
+        print(f"  {i * bucket_us:>4}-{(i + 1) * bucket_us - 1:<4} us  {count:>10}  {100 * count / total:5.1f}%")
+
+    return 0
+
+def parse(capture):
+    if len(capture) < DUMP_HEADER.size:
+        raise ValueError("capture is too short")
+
+    magic, version, record_size, record_count, dropped = DUMP_HEADER.unpack_from(capture)
+    if magic != DUMP_MAGIC or version != 1:
+        raise ValueError("not a report capture, or an unsupported version")
+    if len(capture) < DUMP_HEADER.size + record_size * record_count:
+        raise ValueError("capture is truncated")
+
+    records = []
+    for i in range(record_count):
+        offset = DUMP_HEADER.size + i * record_size
+        timestamp_us, kind, address, instance, driver_type, length = RECORD_HEADER.unpack_from(capture, offset)
+        data_offset = offset + RECORD_HEADER.size
+        data = capture[data_offset:data_offset + min(length, RECORD_DATA_SIZE)]
+        records.append((timestamp_us, kind, address, instance, driver_type, length, data))
+
+    return records, dropped
+
+def name(names, idx):
+    return names[idx] if idx < len(names) else str(idx)
+
+# Runs the capture through the host drivers, Gamepad and a device driver built for Linux,
+# printing the device reports each record caused and the time spent, or a benchmark with bench
+def replay_native(binary, in_path, device, changed_only, bench):
+    command = [binary, in_path, "--device", device]
+    if changed_only:
+        command.append("--changed-only")
+    if bench:
+        command.append("--bench")
+    try:
+        return subprocess.run(command).returncode
+    except OSError as e:
+        print(f"Error: can't run {binary}: {e}, build it with cmake -S Firmware/host -B build && cmake --build build --target report_replay")
+        return 1
+
+def replay(in_path, changed_only):
+    with open(in_path, "rb") as f:
+        records, dropped = parse(f.read())
+
+    print(f"{len(records)} records, {dropped} dropped before the dump")
+
+    prev_report = {}
+    prev_time = {}
+    intervals = {}
+    unchanged = {}
+    start_us = records[0][0] if records else 0
+
+    for timestamp_us, kind, address, instance, driver_type, length, data in records:
+        key = (address, instance)
+        elapsed_us = (timestamp_us - start_us) & 0xFFFFFFFF
+
+        if kind != 0:
+            print(f"{elapsed_us:>10} us  addr {address} itf {instance}  {name(KIND_NAMES, kind)} {name(HOST_DRIVER_NAMES, driver_type)}")
+            prev_report.pop(key, None)
+            prev_time.pop(key, None)
+            continue
+
+        if key in prev_time:
+            intervals.setdefault(key, []).append((timestamp_us - prev_time[key]) & 0xFFFFFFFF)
+        prev_time[key] = timestamp_us
+
+        same = prev_report.get(key) == data
+        prev_report[key] = data
+        if same:
+            unchanged[key] = unchanged.get(key, 0) + 1
+            if changed_only:
+                continue
+
+        truncated = "+" if length > len(data) else ""
+        print(f"{elapsed_us:>10} us  addr {address} itf {instance}  {length:>3}{truncated}  {data.hex(' ')}")
+
+    for key, values in sorted(intervals.items()):
+        address, instance = key
+        print(f"addr {address} itf {instance}: {len(values) + 1} reports, {unchanged.get(key, 0)} unchanged, "
+              f"interval min {min(values)} avg {sum(values) // len(values)} max {max(values)} us")
+
+    return 0
+
+def main():
+    parser = argparse.ArgumentParser(description="Dump and replay OGX-Mini host report captures")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    dump_parser = commands.add_parser("dump", help="request a capture from a device in web app mode")
+    dump_parser.add_argument("port", help="serial port of the device, e.g. /dev/ttyACM0 or COM3")
+    dump_parser.add_argument("output", help="file to save the capture to")
+    dump_parser.add_argument("--timeout", type=float, default=2.0, help="seconds to wait for each packet")
+
+    replay_parser = commands.add_parser("replay", help="print the reports and timing in a saved capture")
+    replay_parser.add_argument("input", help="capture file saved by dump")
+    replay_parser.add_argument("--changed-only", action="store_true", help="skip reports identical to the previous one, "
+                               "with --native skip reports that sent no device report")
+    replay_parser.add_argument("--native", metavar="REPORT_REPLAY", help="report_replay binary from the host build, "
+                               "replays through the firmware's drivers and prints device reports and timing")
+    replay_parser.add_argument("--device", default="xinput", choices=DEVICE_DRIVER_NAMES, help="device driver for --native")
+    replay_parser.add_argument("--bench", action="store_true", help="with --native, time whole passes over the capture, JSON output")
+
+    times_parser = commands.add_parser("connect-times", help="print connect timing from a device in web app mode")
+    times_parser.add_argument("port", help="serial port of the device, e.g. /dev/ttyACM0 or COM3")
+    times_parser.add_argument("--timeout", type=float, default=2.0, help="seconds to wait for each packet")
+
+    sync_parser = commands.add_parser("frame-sync", help="print host frame alignment from a device in web app mode")
+    sync_parser.add_argument("port", help="serial port of the device, e.g. /dev/ttyACM0 or COM3")
+    sync_parser.add_argument("--timeout", type=float, default=2.0, help="seconds to wait for each packet")
+
+    args = parser.parse_args()
+    if args.command == "dump":
+        return dump(args.port, args.output, args.timeout)
+    if args.command == "connect-times":
+        return connect_times(args.port, args.timeout)
+    if args.command == "frame-sync":
+        return frame_sync(args.port, args.timeout)
+    if args.native:
+        return replay_native(args.native, args.input, args.device, args.changed_only, args.bench)
+    if args.bench:
+        print("Error: --bench needs --native")
+        return 1
+    return replay(args.input, args.changed_only)
+
+if __name__ == "__main__":
+    sys.exit(main())